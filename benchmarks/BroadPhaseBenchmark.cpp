@@ -0,0 +1,178 @@
+/**
+ * @file BroadPhaseBenchmark.cpp
+ * @brief Scales the BroadPhase spatial hash from a thousand to tens of thousands of moving entities.
+ *
+ * Usage: SunnyLand-BroadPhaseBenchmark [frames]
+ *
+ * The world grows with the entity count so density stays like a busy level. Every frame each entity moves and
+ * updatePairs() runs; the table reports the average time of both. For smaller counts the pairs are checked against
+ * the O(n^2) all-pairs test, which is also timed for comparison. Each frame also queries an entity-sized rect and a
+ * 640x360 camera view; the view query runs through the batch kernel, and both are checked against a linear scan.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "engine/physics/BroadPhase.h"
+
+using engine::physics::BroadPhase;
+using engine::physics::BroadPhasePair;
+using engine::physics::ProxyId;
+using engine::utils::Rect;
+
+namespace
+{
+    constexpr std::size_t BRUTE_FORCE_LIMIT = 5000;  ///< @brief Largest count also run through the all-pairs test
+    constexpr float CELL_SIZE = 32.0f;
+    constexpr float AREA_PER_ENTITY = 48.0f * 48.0f;
+    constexpr glm::vec2 SMALL_QUERY{32.0f, 32.0f};
+    constexpr glm::vec2 VIEW_QUERY{640.0f, 360.0f};
+
+    struct Entity
+    {
+        Rect rect;
+        glm::vec2 velocity;
+        ProxyId proxy;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Player / enemy / item / trigger style layers: items and triggers ignore each other
+     */
+    void pickFilter(std::size_t index, Uint32& layer, Uint32& mask)
+    {
+        layer = 1u << (index % 4);
+        mask = layer >= 4u ? 0b0011u : engine::physics::COLLISION_LAYER_ALL;
+    }
+
+    std::vector<BroadPhasePair> bruteForcePairs(const BroadPhase& broad_phase, const std::vector<Entity>& entities)
+    {
+        std::vector<BroadPhasePair> pairs;
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            const ProxyId a = entities[i].proxy;
+            for (std::size_t j = i + 1; j < entities.size(); ++j)
+            {
+                const ProxyId b = entities[j].proxy;
+                if ((broad_phase.getLayer(a) & broad_phase.getMask(b)) == 0 || (broad_phase.getLayer(b) & broad_phase.getMask(a)) == 0) continue;
+                if (engine::utils::overlaps(entities[i].rect, entities[j].rect)) pairs.push_back({a, b});
+            }
+        }
+        return pairs;
+    }
+
+    /**
+     * @brief Every entity overlapping rect, by proxy id
+     */
+    std::vector<ProxyId> linearQuery(const std::vector<Entity>& entities, const Rect& rect)
+    {
+        std::vector<ProxyId> ids;
+        for (const Entity& entity : entities)
+        {
+            if (engine::utils::overlaps(entity.rect, rect)) ids.push_back(entity.proxy);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    bool runCase(std::size_t count, int frames)
+    {
+        const float world_size = std::sqrt(static_cast<float>(count) * AREA_PER_ENTITY);
+        std::mt19937 random(static_cast<std::mt19937::result_type>(count));
+        std::uniform_real_distribution<float> position(0.0f, world_size);
+        std::uniform_real_distribution<float> extent(8.0f, 32.0f);
+        std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+
+        BroadPhase broad_phase(CELL_SIZE);
+        std::vector<Entity> entities(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Entity& entity = entities[i];
+            entity.rect = Rect{{position(random), position(random)}, {extent(random), extent(random)}};
+            entity.velocity = {speed(random), speed(random)};
+            Uint32 layer, mask;
+            pickFilter(i, layer, mask);
+            entity.proxy = broad_phase.createProxy(entity.rect, layer, mask);
+        }
+
+        double move_ms = 0.0;
+        double pairs_ms = 0.0;
+        double small_query_ms = 0.0;
+        double view_query_ms = 0.0;
+        std::size_t pair_total = 0;
+        std::vector<ProxyId> found;
+        bool ok = true;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            auto start = Clock::now();
+            for (Entity& entity : entities)
+            {
+                entity.rect.position += entity.velocity;
+                if (entity.rect.position.x < 0.0f || entity.rect.position.x > world_size) entity.velocity.x = -entity.velocity.x;
+                if (entity.rect.position.y < 0.0f || entity.rect.position.y > world_size) entity.velocity.y = -entity.velocity.y;
+                broad_phase.moveProxy(entity.proxy, entity.rect);
+            }
+            move_ms += elapsedMs(start);
+
+            start = Clock::now();
+            pair_total += broad_phase.updatePairs().size();
+            pairs_ms += elapsedMs(start);
+
+            for (const glm::vec2 size : {SMALL_QUERY, VIEW_QUERY})
+            {
+                const Rect query{{position(random), position(random)}, size};
+                start = Clock::now();
+                broad_phase.query(query, engine::physics::COLLISION_LAYER_ALL, found);
+                (size == SMALL_QUERY ? small_query_ms : view_query_ms) += elapsedMs(start);
+                if (frame % 10 == 0 && found != linearQuery(entities, query))
+                {
+                    spdlog::error("{} entities: a {}x{} query found {} proxies, the linear scan {}.", count, size.x, size.y, found.size(), linearQuery(entities, query).size());
+                    ok = false;
+                }
+            }
+        }
+
+        std::string brute_force = "-";
+        if (count <= BRUTE_FORCE_LIMIT)
+        {
+            const auto start = Clock::now();
+            const auto expected = bruteForcePairs(broad_phase, entities);
+            brute_force = fmt::format("{:.3f}", elapsedMs(start));
+            if (expected != broad_phase.getPairs())
+            {
+                spdlog::error("{} entities: the broadphase found {} pairs, the all-pairs test {}.", count, broad_phase.getPairs().size(), expected.size());
+                ok = false;
+            }
+        }
+
+        spdlog::info("  {:>8} {:>12.3f} {:>12.3f} {:>10} {:>8} {:>14} {:>12.2f} {:>12.2f}", count, move_ms / frames, pairs_ms / frames, pair_total / frames,
+                     broad_phase.getCellCount(), brute_force, small_query_ms * 1000.0 / frames, view_query_ms * 1000.0 / frames);
+        return ok;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 100;
+
+    spdlog::info("BroadPhase, cell size {}, {} frames per case", CELL_SIZE, frames);
+    spdlog::info("  {:>8} {:>12} {:>12} {:>10} {:>8} {:>14} {:>12} {:>12}", "entities", "move ms", "pairs ms", "pairs", "cells", "all-pairs ms", "small q us",
+                 "view q us");
+    bool ok = true;
+    for (const std::size_t count : {1000u, 2500u, 5000u, 10000u, 20000u, 40000u})
+    {
+        ok = runCase(count, frames) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,403 @@
+/**
+ * @file EngineBenchmark.cpp
+ * @brief Micro-benchmarks of the engine hot paths, with JSON output to track regressions across commits.
+ *
+ * Usage: SunnyLand-EngineBenchmark [--filter <text>] [--samples <n>] [--json <file>] [--label <text>]
+ *                                  [--baseline <file>] [--tolerance <percent>]
+ *
+ * Run from the repository root (textures are loaded from assets/). Rendering goes to an SDL software renderer on an
+ * offscreen surface and audio to the dummy driver, so no window or audio device is needed.
+ *
+ * Every benchmark is calibrated until one sample (a batch of calls) takes about SAMPLE_TARGET_NS, then timed over
+ * --samples samples; results are nanoseconds per call. --json writes them with --label (e.g. the commit hash).
+ * --baseline compares the medians with an earlier JSON file and exits with 1 if one got slower by more than
+ * --tolerance percent (default 10).
+ */
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/Log.h"
+#include "engine/core/Time.h"
+#include "engine/render/Camera.h"
+#include "engine/render/Renderer.h"
+#include "engine/render/Sprite.h"
+#include "engine/resource/ResourceManager.h"
+
+namespace
+{
+    constexpr double SAMPLE_TARGET_NS = 2'000'000.0;  ///< @brief Calibrated duration of one sample
+    constexpr Uint64 MAX_OPS_PER_SAMPLE = 1u << 24;
+    constexpr int SURFACE_WIDTH = 640;
+    constexpr int SURFACE_HEIGHT = 360;
+
+    const std::string TEXTURE_PATH = "assets/textures/Actors/frog.png";
+    const std::string PARALLAX_PATH = "assets/textures/Layers/back.png";
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string filter;
+        int samples = 30;
+        std::string jsonPath;
+        std::string label;
+        std::string baselinePath;
+        double tolerancePercent = 10.0;
+    };
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        int samples = 0;
+        Uint64 opsPerSample = 0;
+        double minNs = 0.0;  ///< @brief Per call
+        double medianNs = 0.0;
+        double meanNs = 0.0;
+        double p90Ns = 0.0;
+    };
+
+    /**
+     * @brief Keeps the compiler from optimising away results that are otherwise unused
+     */
+    volatile std::uintptr_t g_sink = 0;
+
+    void keep(std::uintptr_t value)
+    {
+        g_sink = g_sink + value;
+    }
+
+    void keep(const glm::vec2& value)
+    {
+        keep(static_cast<std::uintptr_t>(static_cast<std::intptr_t>(value.x + value.y)));
+    }
+
+    void keep(const void* pointer)
+    {
+        keep(reinterpret_cast<std::uintptr_t>(pointer));
+    }
+
+    /**
+     * @param op one call of the measured function
+     * @param finish run once at the end of every sample, inside the timing (e.g. flushing queued draw calls)
+     * @param reset run between samples, outside the timing
+     */
+    BenchmarkResult measure(const std::string& name, const Options& options, const std::function<void()>& op, const std::function<void()>& finish = {},
+                            const std::function<void()>& reset = {})
+    {
+        auto run_sample = [&](Uint64 ops) {
+            if (reset) reset();
+            const auto start = Clock::now();
+            for (Uint64 i = 0; i < ops; ++i)
+            {
+                op();
+            }
+            if (finish) finish();
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+
+        // Calibrate (doubles as warm-up): grow the batch until a sample is long enough to time reliably
+        Uint64 ops = 1;
+        while (ops < MAX_OPS_PER_SAMPLE && run_sample(ops) < SAMPLE_TARGET_NS)
+        {
+            ops *= 2;
+        }
+
+        std::vector<double> per_op(static_cast<std::size_t>(options.samples));
+        for (double& sample : per_op)
+        {
+            sample = run_sample(ops) / static_cast<double>(ops);
+        }
+        std::sort(per_op.begin(), per_op.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.samples = options.samples;
+        result.opsPerSample = ops;
+        result.minNs = per_op.front();
+        result.medianNs = per_op[per_op.size() / 2];
+        result.p90Ns = per_op[std::min(per_op.size() - 1, per_op.size() * 9 / 10)];
+        for (const double sample : per_op)
+        {
+            result.meanNs += sample / static_cast<double>(per_op.size());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Software renderer on an offscreen surface plus the engine objects under test
+     */
+    struct Fixture
+    {
+        SDL_Surface* surface = nullptr;
+        SDL_Renderer* sdlRenderer = nullptr;
+        std::unique_ptr<engine::resource::ResourceManager> resourceManager;
+        std::unique_ptr<engine::render::Renderer> renderer;
+        std::unique_ptr<engine::render::Camera> camera;
+
+        Fixture()
+        {
+            // Environment variables still take precedence over these hints
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+            if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
+            {
+                throw std::runtime_error("SDL_Init failed: " + std::string(SDL_GetError()));
+            }
+            surface = SDL_CreateSurface(SURFACE_WIDTH, SURFACE_HEIGHT, SDL_PIXELFORMAT_RGBA8888);
+            sdlRenderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+            if (!sdlRenderer)
+            {
+                throw std::runtime_error("Software renderer creation failed: " + std::string(SDL_GetError()));
+            }
+            resourceManager = std::make_unique<engine::resource::ResourceManager>(sdlRenderer);
+            renderer = std::make_unique<engine::render::Renderer>(sdlRenderer, resourceManager.get());
+            camera = std::make_unique<engine::render::Camera>(glm::vec2(SURFACE_WIDTH, SURFACE_HEIGHT));
+            if (!resourceManager->getTexture(TEXTURE_PATH) || !resourceManager->getTexture(PARALLAX_PATH))
+            {
+                throw std::runtime_error("Benchmark textures not found, run from the repository root.");
+            }
+        }
+
+        ~Fixture()
+        {
+            renderer.reset();
+            resourceManager.reset();
+            if (sdlRenderer) SDL_DestroyRenderer(sdlRenderer);
+            if (surface) SDL_DestroySurface(surface);
+            SDL_Quit();
+        }
+
+        Fixture(const Fixture&) = delete;
+        Fixture& operator=(const Fixture&) = delete;
+        Fixture(Fixture&&) = delete;
+        Fixture& operator=(Fixture&&) = delete;
+    };
+
+    std::vector<BenchmarkResult> runBenchmarks(Fixture& fixture, const Options& options)
+    {
+        std::vector<BenchmarkResult> results;
+        auto run = [&](const std::string& name, const std::function<void()>& op, const std::function<void()>& finish = {}, const std::function<void()>& reset = {}) {
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+            results.push_back(measure(name, options, op, finish, reset));
+        };
+
+        auto& resources = *fixture.resourceManager;
+        auto& renderer = *fixture.renderer;
+        auto& camera = *fixture.camera;
+
+        // --- ResourceManager ---
+        run("resource.getTexture.hit", [&] { keep(resources.getTexture(TEXTURE_PATH)); });
+        run("resource.getTexture.miss", [&] {
+            // Cold path: decode the file and upload a new texture
+            resources.unloadTexture(TEXTURE_PATH);
+            keep(resources.getTexture(TEXTURE_PATH));
+        });
+
+        // --- Renderer (software), queued draws are rasterised by the flush at the end of each sample ---
+        const engine::render::Sprite sprite(TEXTURE_PATH);
+        const engine::render::Sprite parallax(PARALLAX_PATH);
+        auto flush = [&] { SDL_FlushRenderer(fixture.sdlRenderer); };
+        auto clear = [&] {
+            camera.setPosition({0.0f, 0.0f});
+            renderer.clearScreen();
+            renderer.present();
+        };
+        run("render.drawSprite", [&] { renderer.drawSprite(camera, sprite, {200.0f, 150.0f}); }, flush, clear);
+        run("render.drawSprite.culled", [&] { renderer.drawSprite(camera, sprite, {-500.0f, -500.0f}); }, flush, clear);
+        run("render.drawSprite.rotated", [&] { renderer.drawSprite(camera, sprite, {200.0f, 150.0f}, {2.0f, 2.0f}, 30.0); }, flush, clear);
+        run("render.drawParallax.repeatX", [&] { renderer.drawParallax(camera, parallax, {0.0f, 0.0f}, {0.5f, 0.5f}, {true, false}); }, flush, clear);
+        run("render.drawParallax.repeatXY", [&] { renderer.drawParallax(camera, parallax, {0.0f, 0.0f}, {0.5f, 0.5f}, {true, true}); }, flush, clear);
+        run("render.present", [&] { renderer.present(); });
+
+        // --- Camera ---
+        glm::vec2 point{123.0f, 456.0f};
+        run("camera.worldToScreen", [&] {
+            point = camera.worldToScreen(point) + glm::vec2(1.0f, 1.0f);
+            keep(point);
+        });
+        run("camera.screenToWorld", [&] {
+            point = camera.screenToWorld(point) - glm::vec2(1.0f, 1.0f);
+            keep(point);
+        });
+        run("camera.worldToScreenWithParallax", [&] {
+            point = camera.worldToScreenWithParallax(point, {0.5f, 0.25f}) + glm::vec2(1.0f, 1.0f);
+            keep(point);
+        });
+        camera.setLimitBounds(engine::utils::Rect{{0.0f, 0.0f}, {4096.0f, 4096.0f}});
+        run("camera.move.clamped", [&] { camera.move({3.0f, -2.0f}); });
+        keep(camera.getPosition());
+
+        // --- Time ---
+        engine::core::Time time;
+        time.setTargetFPS(0);
+        run("time.update", [&] {
+            time.update();
+            keep(time.getDeltaTime() > 0.0f);
+        });
+
+        return results;
+    }
+
+    nlohmann::json toJson(const std::vector<BenchmarkResult>& results, const Options& options)
+    {
+        nlohmann::json json;
+        json["label"] = options.label;
+        json["unit"] = "ns";
+        json["platform"] = SDL_GetPlatform();
+        json["results"] = nlohmann::json::array();
+        for (const auto& result : results)
+        {
+            json["results"].push_back({{"name", result.name},
+                                       {"samples", result.samples},
+                                       {"ops_per_sample", result.opsPerSample},
+                                       {"min", result.minNs},
+                                       {"median", result.medianNs},
+                                       {"mean", result.meanNs},
+                                       {"p90", result.p90Ns}});
+        }
+        return json;
+    }
+
+    /**
+     * @return false if a benchmark regressed by more than the tolerance
+     */
+    bool compareWithBaseline(const std::vector<BenchmarkResult>& results, const Options& options)
+    {
+        std::ifstream file(options.baselinePath);
+        if (!file)
+        {
+            spdlog::error("Unable to open baseline '{}'.", options.baselinePath);
+            return false;
+        }
+        nlohmann::json baseline;
+        try
+        {
+            file >> baseline;
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            spdlog::error("Baseline '{}' is not valid JSON: {}", options.baselinePath, e.what());
+            return false;
+        }
+
+        std::unordered_map<std::string, double> medians;
+        for (const auto& entry : baseline.value("results", nlohmann::json::array()))
+        {
+            medians[entry.value("name", "")] = entry.value("median", 0.0);
+        }
+
+        bool ok = true;
+        spdlog::info("Compared with '{}' ({}), tolerance {:.1f}%:", options.baselinePath, baseline.value("label", ""), options.tolerancePercent);
+        for (const auto& result : results)
+        {
+            auto it = medians.find(result.name);
+            if (it == medians.end() || it->second <= 0.0)
+            {
+                spdlog::info("  {:<36} new", result.name);
+                continue;
+            }
+            const double change = (result.medianNs / it->second - 1.0) * 100.0;
+            const bool regressed = change > options.tolerancePercent;
+            ok = ok && !regressed;
+            if (regressed)
+            {
+                spdlog::warn("  {:<36} {:>12.1f} -> {:>12.1f} ns {:>+8.1f}%  REGRESSION", result.name, it->second, result.medianNs, change);
+            }
+            else
+            {
+                spdlog::info("  {:<36} {:>12.1f} -> {:>12.1f} ns {:>+8.1f}%", result.name, it->second, result.medianNs, change);
+            }
+        }
+        return ok;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                spdlog::error("Missing value for '{}'.", arg);
+                return false;
+            }
+            const std::string value = argv[++i];
+            if (arg == "--filter")
+                options.filter = value;
+            else if (arg == "--samples")
+                options.samples = std::max(std::atoi(value.c_str()), 1);
+            else if (arg == "--json")
+                options.jsonPath = value;
+            else if (arg == "--label")
+                options.label = value;
+            else if (arg == "--baseline")
+                options.baselinePath = value;
+            else if (arg == "--tolerance")
+                options.tolerancePercent = std::max(std::atof(value.c_str()), 0.0);
+            else
+            {
+                spdlog::error("Unknown option '{}'.", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) return EXIT_FAILURE;
+
+    engine::core::initLogging();
+    spdlog::set_level(spdlog::level::warn);  // keep resource loading chatter out of the table
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+        Fixture fixture;
+        results = runBenchmarks(fixture, options);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Engine benchmark setup failed: {}", e.what());
+        engine::core::shutdownLogging();
+        return EXIT_FAILURE;
+    }
+    spdlog::set_level(spdlog::level::info);
+
+    spdlog::info("  {:<36} {:>10} {:>12} {:>12} {:>12}", "benchmark", "ops", "min ns", "median ns", "p90 ns");
+    for (const auto& result : results)
+    {
+        spdlog::info("  {:<36} {:>10} {:>12.1f} {:>12.1f} {:>12.1f}", result.name, result.opsPerSample, result.minNs, result.medianNs, result.p90Ns);
+    }
+
+    bool ok = true;
+    if (!options.jsonPath.empty())
+    {
+        std::ofstream file(options.jsonPath);
+        file << toJson(results, options).dump(2) << '\n';
+        if (!file)
+        {
+            spdlog::error("Unable to write '{}'.", options.jsonPath);
+            ok = false;
+        }
+    }
+    if (!options.baselinePath.empty())
+    {
+        ok = compareWithBaseline(results, options) && ok;
+    }
+
+    engine::core::shutdownLogging();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file EventBusBenchmark.cpp
+ * @brief Per-event cost of the EventBus against a queue of std::function callbacks, from a thousand to a hundred
+ * thousand events per frame.
+ *
+ * Usage: SunnyLand-EventBusBenchmark [frames]
+ *
+ * Every frame publishes damage, pickup and level-end events in a mixed order and dispatches them to a per-event and a
+ * batch subscriber each. The baseline is what ad-hoc callbacks tend to become: each event captured into a
+ * std::function and run at the end of the frame. The table reports nanoseconds per event for publishing plus
+ * dispatching, and heap allocations per frame after warm-up, which must be zero for the bus.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <type_traits>
+#include <vector>
+
+#include "engine/event/EventBus.h"
+
+using engine::event::EventBus;
+
+namespace
+{
+    std::atomic<std::size_t> heap_allocations{0};
+
+    /**
+     * @brief Not inlined: inlined into the operator new callers, the plain free() would be reported as a new / free mismatch
+     */
+    [[gnu::noinline]] void release(void* memory)
+    {
+        std::free(memory);
+    }
+}  // namespace
+
+// Counts every heap allocation of the process, so the table can show which variant allocates per frame
+void* operator new(std::size_t size)
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    release(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    release(memory);
+}
+
+namespace
+{
+    constexpr int WARMUP_FRAMES = 3;
+
+    struct DamageEvent
+    {
+        Uint32 target;
+        Uint32 source;
+        float amount;
+        float knockbackX;
+        float knockbackY;
+    };
+
+    struct PickupEvent
+    {
+        Uint32 collector;
+        Uint32 item;
+        Uint32 count;
+    };
+
+    struct LevelEndEvent
+    {
+        Uint32 level;
+        Uint32 score;
+    };
+
+    /**
+     * @brief Stands in for the game systems listening to the events
+     */
+    struct Listener
+    {
+        double health = 0.0;
+        Uint64 items = 0;
+        Uint64 score = 0;
+
+        void onDamage(const DamageEvent& event) { health -= event.amount; }
+        void onDamageBatch(std::span<const DamageEvent> events) { health += static_cast<double>(events.size()); }
+        void onPickup(const PickupEvent& event) { items += event.count; }
+        void onPickupBatch(std::span<const PickupEvent> events) { items += events.size(); }
+        void onLevelEnd(const LevelEndEvent& event) { score += event.score; }
+        void onLevelEndBatch(std::span<const LevelEndEvent> events) { score += events.size(); }
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Publishes count events through emit(), mostly damage, some pickups, rarely a level end
+     */
+    template <typename Emit>
+    void produceFrame(std::size_t count, Uint32 frame, Emit&& emit)
+    {
+        for (Uint32 i = 0; i < count; ++i)
+        {
+            if (i % 16 == 15)
+            {
+                emit(PickupEvent{i, frame, 1});
+            }
+            else if (i % 1024 == 1023)
+            {
+                emit(LevelEndEvent{frame, i});
+            }
+            else
+            {
+                emit(DamageEvent{i, frame, 1.0f, 0.5f, -0.5f});
+            }
+        }
+    }
+
+    struct Result
+    {
+        double nsPerEvent = 0.0;
+        double allocationsPerFrame = 0.0;
+    };
+
+    Result runBus(std::size_t count, int frames, Listener& listener)
+    {
+        EventBus bus;
+        bus.subscribe<DamageEvent, &Listener::onDamage>(&listener);
+        bus.subscribeBatch<DamageEvent, &Listener::onDamageBatch>(&listener);
+        bus.subscribe<PickupEvent, &Listener::onPickup>(&listener);
+        bus.subscribeBatch<PickupEvent, &Listener::onPickupBatch>(&listener);
+        bus.subscribe<LevelEndEvent, &Listener::onLevelEnd>(&listener);
+        bus.subscribeBatch<LevelEndEvent, &Listener::onLevelEndBatch>(&listener);
+
+        double total_ms = 0.0;
+        std::size_t allocations = 0;
+        for (int frame = -WARMUP_FRAMES; frame < frames; ++frame)
+        {
+            const std::size_t allocations_before = heap_allocations.load(std::memory_order_relaxed);
+            const auto start = Clock::now();
+            produceFrame(count, static_cast<Uint32>(frame), [&bus](const auto& event) { bus.publish(event); });
+            bus.dispatch();
+            if (frame < 0) continue;
+            total_ms += elapsedMs(start);
+            allocations += heap_allocations.load(std::memory_order_relaxed) - allocations_before;
+        }
+        return {total_ms * 1'000'000.0 / (static_cast<double>(count) * frames), static_cast<double>(allocations) / frames};
+    }
+
+    Result runCallbacks(std::size_t count, int frames, Listener& listener)
+    {
+        std::vector<std::function<void()>> queue;
+
+        double total_ms = 0.0;
+        std::size_t allocations = 0;
+        for (int frame = -WARMUP_FRAMES; frame < frames; ++frame)
+        {
+            const std::size_t allocations_before = heap_allocations.load(std::memory_order_relaxed);
+            const auto start = Clock::now();
+            produceFrame(count, static_cast<Uint32>(frame), [&queue, &listener](const auto& event) {
+                using Event = std::decay_t<decltype(event)>;
+                queue.emplace_back([&listener, event] {
+                    if constexpr (std::is_same_v<Event, DamageEvent>)
+                    {
+                        listener.onDamage(event);
+                        listener.onDamageBatch({&event, 1});
+                    }
+                    else if constexpr (std::is_same_v<Event, PickupEvent>)
+                    {
+                        listener.onPickup(event);
+                        listener.onPickupBatch({&event, 1});
+                    }
+                    else
+                    {
+                        listener.onLevelEnd(event);
+                        listener.onLevelEndBatch({&event, 1});
+                    }
+                });
+            });
+            for (const auto& callback : queue)
+            {
+                callback();
+            }
+            queue.clear();
+            if (frame < 0) continue;
+            total_ms += elapsedMs(start);
+            allocations += heap_allocations.load(std::memory_order_relaxed) - allocations_before;
+        }
+        return {total_ms * 1'000'000.0 / (static_cast<double>(count) * frames), static_cast<double>(allocations) / frames};
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 200;
+
+    spdlog::info("EventBus vs std::function callbacks, {} frames per count", frames);
+    spdlog::info("  {:>8} {:>12} {:>14} {:>12} {:>14}", "events", "bus ns/ev", "bus allocs/fr", "fn ns/ev", "fn allocs/fr");
+    bool ok = true;
+    Listener bus_listener;
+    Listener callback_listener;
+    for (const std::size_t count : {1'000u, 10'000u, 100'000u})
+    {
+        const Result bus = runBus(count, frames, bus_listener);
+        const Result callbacks = runCallbacks(count, frames, callback_listener);
+        spdlog::info("  {:>8} {:>12.2f} {:>14.1f} {:>12.2f} {:>14.1f}", count, bus.nsPerEvent, bus.allocationsPerFrame, callbacks.nsPerEvent, callbacks.allocationsPerFrame);
+        if (bus.allocationsPerFrame > 0.0)
+        {
+            spdlog::error("The event bus allocated after warm-up with {} events per frame.", count);
+            ok = false;
+        }
+    }
+
+    // Both listeners saw the same events, or one variant lost some
+    if (bus_listener.health != callback_listener.health || bus_listener.items != callback_listener.items || bus_listener.score != callback_listener.score)
+    {
+        spdlog::error("The listeners disagree: health {} / {}, items {} / {}, score {} / {}.", bus_listener.health, callback_listener.health, bus_listener.items,
+                      callback_listener.items, bus_listener.score, callback_listener.score);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file NavigationBenchmark.cpp
+ * @brief Frame cost of enemy path requests with and without the PathQueue frame budget.
+ *
+ * Usage: SunnyLand-NavigationBenchmark [frames]
+ *
+ * Each case generates a platformer map (ground with gaps, solid and one-way platforms, ladders), builds its
+ * TileCollisionMap and NavGraph, then lets a number of enemies ask for a path to the moving player every half second,
+ * staggered over the frames. The table reports the average and worst PathQueue::update() time, how many frames a
+ * request waited, and how many requests were answered from the kept search tree. The unbudgeted rows show the spikes
+ * that running every search in the frame it was asked for would cause. A sample of the paths is checked against a
+ * plain Dijkstra search.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+#include "engine/level/LevelData.h"
+#include "engine/navigation/NavGraph.h"
+#include "engine/navigation/PathQueue.h"
+#include "engine/physics/TileCollisionMap.h"
+
+using engine::navigation::INVALID_NAV_NODE;
+using engine::navigation::NavGraph;
+using engine::navigation::NavNodeId;
+using engine::navigation::PathQueue;
+using engine::navigation::PathRequestId;
+using engine::navigation::PathStatus;
+
+namespace
+{
+    constexpr int TILE = 16;
+    constexpr Uint32 GID_SOLID = 1;
+    constexpr Uint32 GID_ONE_WAY = 2;
+    constexpr Uint32 GID_LADDER = 3;
+    constexpr int REQUEST_INTERVAL = 30;   ///< @brief Frames between two requests of the same enemy
+    constexpr int PLAYER_STEP_FRAMES = 8;  ///< @brief Frames between two player moves
+    constexpr std::size_t CHECKED_PATHS = 64;
+    constexpr double BUDGET_MS = 1.0;
+    constexpr double UNBUDGETED_MS = 1'000'000.0;
+
+    using Clock = std::chrono::steady_clock;
+
+    engine::level::Property boolProperty(const char* name)
+    {
+        engine::level::Property property;
+        property.name = name;
+        property.type = engine::level::PropertyType::Bool;
+        property.number = 1.0;
+        return property;
+    }
+
+    engine::level::LevelData generateLevel(int width, int height, std::mt19937& random)
+    {
+        engine::level::LevelData level;
+        level.path = "generated";
+        level.width = width;
+        level.height = height;
+        level.tileSize = {TILE, TILE};
+
+        engine::level::Tileset tileset;
+        tileset.firstGid = 1;
+        tileset.tileSize = {TILE, TILE};
+        tileset.tiles.resize(3);
+        tileset.tiles[0].properties.push_back(boolProperty("solid"));
+        tileset.tiles[1].properties.push_back(boolProperty("unisolid"));
+        tileset.tiles[2].properties.push_back(boolProperty("ladder"));
+        level.tilesets.push_back(std::move(tileset));
+
+        engine::level::Layer layer;
+        layer.width = width;
+        layer.height = height;
+        layer.tiles.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0);
+        auto set = [&](int x, int y, Uint32 gid) {
+            if (x >= 0 && y >= 0 && x < width && y < height) layer.tiles[static_cast<std::size_t>(y) * width + x] = gid;
+        };
+
+        // Ground two tiles thick with gaps of up to three tiles
+        std::uniform_int_distribution<int> gap(0, 9);
+        for (int x = 0; x < width; ++x)
+        {
+            const bool hole = x > 4 && x < width - 4 && gap(random) == 0;
+            for (int y = height - 2; y < height && !hole; ++y) set(x, y, GID_SOLID);
+        }
+
+        // Platforms in bands above the ground, each band within jump height of the one below, some with ladders
+        std::uniform_int_distribution<int> length(3, 9);
+        std::uniform_int_distribution<int> spacing(2, 6);
+        std::uniform_int_distribution<int> kind(0, 3);
+        for (int band = height - 5; band > 2; band -= 3)
+        {
+            for (int x = spacing(random); x < width - 2; x += spacing(random))
+            {
+                const int end = std::min(x + length(random), width - 1);
+                const int type = kind(random);
+                for (int px = x; px < end; ++px) set(px, band, type == 0 ? GID_SOLID : GID_ONE_WAY);
+                if (type == 3)
+                {
+                    for (int y = band; y < band + 3; ++y) set(x, y, GID_LADDER);
+                }
+                x = end;
+            }
+        }
+
+        level.layers.push_back(std::move(layer));
+        return level;
+    }
+
+    /**
+     * @brief Reference cost of the cheapest path, forward over the outgoing links
+     */
+    float dijkstra(const NavGraph& graph, NavNodeId start, NavNodeId goal)
+    {
+        std::vector<float> cost(graph.getNodeCount(), -1.0f);
+        using Entry = std::pair<float, NavNodeId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        open.push({0.0f, start});
+        while (!open.empty())
+        {
+            const auto [g, node] = open.top();
+            open.pop();
+            if (cost[node] >= 0.0f) continue;
+            cost[node] = g;
+            if (node == goal) return g;
+            for (const auto& edge : graph.getEdges(node))
+            {
+                if (cost[edge.to] < 0.0f) open.push({g + edge.cost, edge.to});
+            }
+        }
+        return -1.0f;
+    }
+
+    struct Enemy
+    {
+        glm::vec2 feet{0.0f, 0.0f};
+        PathRequestId request = engine::navigation::INVALID_PATH_REQUEST;
+        int requestFrame = 0;
+    };
+
+    bool runCase(int width, int height, std::size_t enemy_count, double budget_ms, int frames)
+    {
+        std::mt19937 random(static_cast<std::mt19937::result_type>(width * 31 + enemy_count));
+        const engine::level::LevelData level = generateLevel(width, height, random);
+        engine::physics::TileCollisionMap collision;
+        collision.build(level);
+
+        NavGraph graph;
+        const auto build_start = Clock::now();
+        graph.build(collision);
+        const double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - build_start).count();
+
+        // Enemies and the player stand on random nodes
+        std::uniform_int_distribution<std::size_t> pick(0, graph.getNodeCount() - 1);
+        std::vector<Enemy> enemies(enemy_count);
+        for (Enemy& enemy : enemies)
+        {
+            enemy.feet = graph.getNodePosition(static_cast<NavNodeId>(pick(random)));
+        }
+        NavNodeId player = static_cast<NavNodeId>(pick(random));
+
+        PathQueue queue(graph);
+        double total_ms = 0.0;
+        double worst_ms = 0.0;
+        std::size_t completed = 0;
+        std::size_t tree_hits = 0;
+        std::size_t waited_frames = 0;
+        std::size_t checked = 0;
+        bool ok = true;
+
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            // The player wanders along the links, like someone running through the level
+            if (frame % PLAYER_STEP_FRAMES == 0)
+            {
+                const auto edges = graph.getEdges(player);
+                if (!edges.empty()) player = edges[random() % edges.size()].to;
+            }
+
+            for (std::size_t i = 0; i < enemies.size(); ++i)
+            {
+                Enemy& enemy = enemies[i];
+                if ((frame + static_cast<int>(i)) % REQUEST_INTERVAL != 0 || enemy.request != engine::navigation::INVALID_PATH_REQUEST) continue;
+                enemy.request = queue.request(enemy.feet, graph.getNodePosition(player));
+                enemy.requestFrame = frame;
+            }
+
+            queue.update(budget_ms);
+            total_ms += queue.getStats().updateMs;
+            worst_ms = std::max(worst_ms, queue.getStats().updateMs);
+            tree_hits += queue.getStats().treeHits;
+
+            for (Enemy& enemy : enemies)
+            {
+                if (enemy.request == engine::navigation::INVALID_PATH_REQUEST) continue;
+                const PathStatus status = queue.getStatus(enemy.request);
+                if (status == PathStatus::Queued) continue;
+
+                ++completed;
+                waited_frames += static_cast<std::size_t>(frame - enemy.requestFrame);
+                if (const auto* path = queue.getPath(enemy.request); path && checked < CHECKED_PATHS)
+                {
+                    ++checked;
+                    const NavNodeId start = graph.findNode(enemy.feet);
+                    const NavNodeId goal = graph.findNode(path->waypoints.back().position);
+                    const float expected = dijkstra(graph, start, goal);
+                    if (std::abs(expected - path->cost) > 1e-3f)
+                    {
+                        spdlog::error("Path cost {} differs from Dijkstra's {}.", path->cost, expected);
+                        ok = false;
+                    }
+                }
+                queue.release(enemy.request);
+                enemy.request = engine::navigation::INVALID_PATH_REQUEST;
+            }
+        }
+
+        spdlog::info("  {:>5}x{:<3} {:>6} {:>6} {:>8} {:>10} {:>10.3f} {:>10.3f} {:>10.2f} {:>9.1f}% {:>9.2f}", width, height, graph.getNodeCount(), enemy_count,
+                     budget_ms < UNBUDGETED_MS ? fmt::format("{:.1f}", budget_ms) : std::string("none"), completed, total_ms / frames, worst_ms,
+                     completed ? static_cast<double>(waited_frames) / completed : 0.0, completed ? 100.0 * tree_hits / completed : 0.0, build_ms);
+        return ok;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 600;
+
+    spdlog::info("PathQueue, requests every {} frames per enemy, {} frames per case", REQUEST_INTERVAL, frames);
+    spdlog::info("  {:>9} {:>6} {:>6} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>9}", "map", "nodes", "enemies", "budget", "paths", "avg ms", "worst ms", "wait frm",
+                 "tree hits", "build ms");
+    bool ok = true;
+    for (const auto& [width, height] : {std::pair{200, 30}, std::pair{800, 60}, std::pair{2000, 90}})
+    {
+        for (const std::size_t enemies : {32u, 256u})
+        {
+            for (const double budget : {BUDGET_MS, UNBUDGETED_MS})
+            {
+                ok = runCase(width, height, enemies, budget, frames) && ok;
+            }
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
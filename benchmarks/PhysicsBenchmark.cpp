@@ -0,0 +1,178 @@
+/**
+ * @file PhysicsBenchmark.cpp
+ * @brief Step cost of PhysicsWorld against the total and the awake body count.
+ *
+ * Usage: SunnyLand-PhysicsBenchmark [frames]
+ *
+ * Each case drops stacks of boxes onto static platforms and lets them settle until every island sleeps. It then
+ * kicks a fixed number of stacks per frame, so the awake count stays about the same whatever the level size; the
+ * "settled" column should stay flat while "all awake" grows with the body count. Cases run without and with solver
+ * threads, then once more with the floors as rows of a TileCollisionMap and the boxes resting exactly on tile
+ * boundaries, where the tile sweeps see the solver's float-noise corrections.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <vector>
+
+#include "engine/level/LevelData.h"
+#include "engine/physics/PhysicsWorld.h"
+#include "engine/physics/TileCollisionMap.h"
+
+using engine::physics::BodyDef;
+using engine::physics::BodyId;
+using engine::physics::BodyType;
+using engine::physics::PhysicsConfig;
+using engine::physics::PhysicsWorld;
+using engine::physics::TileCollisionMap;
+
+namespace
+{
+    constexpr int STACK_HEIGHT = 4;
+    constexpr int KICKED_STACKS = 16;  ///< @brief Stacks woken per frame in the settled phase
+    constexpr int SETTLE_STEPS = 600;  ///< @brief Upper bound on the steps waited for everything to sleep
+    constexpr float BOX_SIZE = 16.0f;
+    constexpr float STACK_SPACING = 64.0f;
+    constexpr int STACKS_PER_ROW = 128;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief One solid tile row under each row of stacks, BOX_SIZE tiles
+     */
+    engine::level::LevelData floorLevel(std::size_t stacks)
+    {
+        const int tiles_per_spacing = static_cast<int>(STACK_SPACING / BOX_SIZE);
+        const int rows = static_cast<int>((stacks + STACKS_PER_ROW - 1) / STACKS_PER_ROW);
+
+        engine::level::LevelData level;
+        level.path = "generated";
+        level.width = STACKS_PER_ROW * tiles_per_spacing;
+        level.height = (rows + 1) * tiles_per_spacing * 2 + 1;
+        level.tileSize = {static_cast<int>(BOX_SIZE), static_cast<int>(BOX_SIZE)};
+
+        engine::level::Tileset tileset;
+        tileset.firstGid = 1;
+        tileset.tileSize = level.tileSize;
+        tileset.tiles.resize(1);
+        engine::level::Property solid;
+        solid.name = "solid";
+        solid.type = engine::level::PropertyType::Bool;
+        solid.number = 1.0;
+        tileset.tiles[0].properties.push_back(solid);
+        level.tilesets.push_back(std::move(tileset));
+
+        engine::level::Layer layer;
+        layer.width = level.width;
+        layer.height = level.height;
+        layer.tiles.assign(static_cast<std::size_t>(level.width) * static_cast<std::size_t>(level.height), 0);
+        for (int row = 1; row <= rows; ++row)
+        {
+            const std::size_t y = static_cast<std::size_t>(row * tiles_per_spacing * 2);
+            std::fill_n(layer.tiles.begin() + static_cast<std::ptrdiff_t>(y * static_cast<std::size_t>(level.width)), level.width, 1u);
+        }
+        level.layers.push_back(std::move(layer));
+        return level;
+    }
+
+    bool runCase(std::size_t stacks, int threads, bool on_tiles, int frames)
+    {
+        PhysicsConfig config;
+        config.solverThreads = threads;
+        PhysicsWorld world(config);
+        TileCollisionMap tiles;
+        if (on_tiles)
+        {
+            tiles.build(floorLevel(stacks));
+            world.setTileMap(&tiles);
+        }
+
+        std::vector<BodyId> bottoms;
+        bottoms.reserve(stacks);
+        for (std::size_t i = 0; i < stacks; ++i)
+        {
+            const float x = static_cast<float>(i % STACKS_PER_ROW) * STACK_SPACING;
+            const float floor_y = static_cast<float>(i / STACKS_PER_ROW + 1) * STACK_SPACING * 2.0f;
+            if (!on_tiles) world.createBody({BodyType::Static, {x, floor_y}, {STACK_SPACING - 8.0f, BOX_SIZE}});
+            for (int k = 0; k < STACK_HEIGHT; ++k)
+            {
+                // On tiles, every box edge starts on a tile boundary, touching its neighbours
+                BodyDef box;
+                box.position = on_tiles ? glm::vec2{x + BOX_SIZE, floor_y - (k + 1) * BOX_SIZE} : glm::vec2{x + 8.0f + static_cast<float>(k), floor_y - (k + 1) * (BOX_SIZE + 2.0f)};
+                box.size = {BOX_SIZE, BOX_SIZE};
+                const BodyId id = world.createBody(box);
+                if (k == 0) bottoms.push_back(id);
+            }
+        }
+
+        // Everything awake: the cost without sleeping
+        const float dt = config.fixedStep;
+        auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            world.step();
+        }
+        const double awake_ms = elapsedMs(start) / frames;
+
+        int settle = 0;
+        while (world.getAwakeCount() > 0 && settle < SETTLE_STEPS)
+        {
+            world.step();
+            ++settle;
+        }
+        if (world.getAwakeCount() > 0)
+        {
+            spdlog::error("{} stacks{}: {} bodies still awake after {} steps.", stacks, on_tiles ? " on tiles" : "", world.getAwakeCount(), SETTLE_STEPS);
+            return false;
+        }
+
+        // Settled: a few stacks kicked per frame, the rest asleep
+        std::size_t awake_total = 0;
+        std::size_t next = 0;
+        start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (int k = 0; k < KICKED_STACKS; ++k)
+            {
+                world.applyImpulse(bottoms[next], {0.0f, -120.0f});
+                next = (next + 1) % bottoms.size();
+            }
+            world.update(dt);
+            awake_total += world.getStats().awake;
+        }
+        const double settled_ms = elapsedMs(start) / frames;
+
+        spdlog::info("  {:>8} {:>8} {:>6} {:>14.3f} {:>14.3f} {:>10} {:>8}", world.getBodyCount(), threads, on_tiles ? "tiles" : "bodies", awake_ms, settled_ms, awake_total / frames,
+                     settle);
+        return true;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 100;
+    const int threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)) - 1;
+
+    spdlog::info("PhysicsWorld, stacks of {} boxes, {} stacks kicked per frame, {} frames per case", STACK_HEIGHT, KICKED_STACKS, frames);
+    spdlog::info("  {:>8} {:>8} {:>6} {:>14} {:>14} {:>10} {:>8}", "bodies", "threads", "floor", "all awake ms", "settled ms", "awake", "settle");
+    bool ok = true;
+    for (const int solver_threads : {0, threads})
+    {
+        for (const std::size_t stacks : {256u, 1024u, 4096u, 16384u})
+        {
+            ok = runCase(stacks, solver_threads, false, frames) && ok;
+        }
+    }
+    for (const std::size_t stacks : {256u, 4096u})
+    {
+        ok = runCase(stacks, threads, true, frames) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
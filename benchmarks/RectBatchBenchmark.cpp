@@ -0,0 +1,247 @@
+/**
+ * @file RectBatchBenchmark.cpp
+ * @brief Compares the RectBatch kernels (scalar, SSE2, AVX2) with testing engine::utils::Rect values one at a time.
+ *
+ * Usage: SunnyLand-RectBatchBenchmark [repetitions]
+ *
+ * Each case runs the per-rect loop the engine used before (an array of Rect and one overlaps() call per rect), then
+ * the batch kernel at every SIMD level the CPU supports. Times are the average per call in microseconds; the last
+ * column is the per-rect loop divided by the best kernel. Every level must produce the per-rect loop's result.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "engine/utils/Math.h"
+
+using engine::utils::Rect;
+using engine::utils::RectBatch;
+using engine::utils::SimdLevel;
+
+namespace
+{
+    constexpr float WORLD_SIZE = 4096.0f;
+    constexpr std::size_t MATRIX_ROWS = 256;  ///< @brief Query rects of the many-against-many case
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Scene
+    {
+        std::vector<Rect> rects;  ///< @brief Array-of-structs copy, for the per-rect loop
+        RectBatch batch;
+        std::vector<Rect> queries;  ///< @brief Viewport-sized rects spread over the world
+        RectBatch queryBatch;
+    };
+
+    Scene makeScene(std::size_t count)
+    {
+        std::mt19937 random(static_cast<std::mt19937::result_type>(count));
+        std::uniform_real_distribution<float> position(-64.0f, WORLD_SIZE);
+        std::uniform_real_distribution<float> extent(8.0f, 64.0f);
+
+        Scene scene;
+        scene.batch.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Rect rect{{position(random), position(random)}, {extent(random), extent(random)}};
+            scene.rects.push_back(rect);
+            scene.batch.push(rect);
+        }
+        for (std::size_t i = 0; i < MATRIX_ROWS; ++i)
+        {
+            const Rect query{{position(random), position(random)}, {640.0f, 360.0f}};
+            scene.queries.push_back(query);
+            scene.queryBatch.push(query);
+        }
+        return scene;
+    }
+
+    /**
+     * @return average microseconds per call of fn(repetition)
+     */
+    double timeUs(int repetitions, const std::function<void(int)>& fn)
+    {
+        const auto start = Clock::now();
+        for (int i = 0; i < repetitions; ++i)
+        {
+            fn(i);
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repetitions;
+    }
+
+    std::vector<Uint64> toMask(const std::vector<bool>& flags)
+    {
+        std::vector<Uint64> mask(engine::utils::maskWordCount(flags.size()), 0);
+        for (std::size_t i = 0; i < flags.size(); ++i)
+        {
+            if (flags[i]) mask[i / 64] |= Uint64{1} << (i % 64);
+        }
+        return mask;
+    }
+
+    const std::vector<SimdLevel>& supportedLevels()
+    {
+        static const std::vector<SimdLevel> levels = [] {
+            std::vector<SimdLevel> result;
+            for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2})
+            {
+                if (level <= engine::utils::getSupportedSimdLevel()) result.push_back(level);
+            }
+            return result;
+        }();
+        return levels;
+    }
+
+    /**
+     * @brief One table row: the per-rect loop, then `kernel` at every supported level; `check` compares the last run
+     */
+    bool runRow(const std::string& name, std::size_t count, int repetitions, const std::function<void(int)>& per_rect, const std::function<void(int)>& kernel,
+                const std::function<bool()>& check)
+    {
+        const double per_rect_us = timeUs(repetitions, per_rect);
+        std::string columns;
+        double best_us = per_rect_us;
+        bool ok = true;
+        for (const SimdLevel level : supportedLevels())
+        {
+            engine::utils::setSimdLevel(level);
+            const double us = timeUs(repetitions, kernel);
+            best_us = std::min(best_us, us);
+            columns += fmt::format(" {:>10.2f}", us);
+            if (!check())
+            {
+                spdlog::error("{} x {}: the {} kernel disagrees with the per-rect loop.", name, count, engine::utils::getSimdLevelName(level));
+                ok = false;
+            }
+        }
+        for (std::size_t i = supportedLevels().size(); i < 3; ++i)
+        {
+            columns += fmt::format(" {:>10}", "-");
+        }
+        spdlog::info("  {:<10} {:>8} {:>12.2f}{} {:>8.1f}x", name, count, per_rect_us, columns, per_rect_us / best_us);
+        return ok;
+    }
+
+    bool runCases(std::size_t count, int repetitions)
+    {
+        Scene scene = makeScene(count);
+        const std::size_t query_count = scene.queries.size();
+        bool ok = true;
+
+        // Many against one: viewport culling
+        std::vector<Uint32> expected_indices;
+        std::vector<Uint32> indices;
+        ok = runRow(
+                 "overlap", count, repetitions,
+                 [&](int rep) {
+                     const Rect& query = scene.queries[rep % query_count];
+                     expected_indices.clear();
+                     for (std::size_t i = 0; i < scene.rects.size(); ++i)
+                     {
+                         if (engine::utils::overlaps(scene.rects[i], query)) expected_indices.push_back(static_cast<Uint32>(i));
+                     }
+                 },
+                 [&](int rep) { engine::utils::collectOverlaps(scene.batch, scene.queries[rep % query_count], indices); },
+                 [&] { return indices == expected_indices; }) &&
+             ok;
+
+        // Many against many: a row of bits per query rect
+        const std::size_t rows = std::min<std::size_t>(MATRIX_ROWS, std::max<std::size_t>(1, 2'000'000 / count));
+        RectBatch row_batch;
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            row_batch.push(scene.queries[row]);
+        }
+        std::vector<Uint64> expected_matrix;
+        std::vector<Uint64> matrix;
+        ok = runRow(
+                 "matrix", count, std::max(1, repetitions / 10),
+                 [&](int) {
+                     const std::size_t row_words = engine::utils::maskWordCount(count);
+                     expected_matrix.assign(rows * row_words, 0);
+                     for (std::size_t row = 0; row < rows; ++row)
+                     {
+                         for (std::size_t i = 0; i < count; ++i)
+                         {
+                             if (engine::utils::overlaps(scene.queries[row], scene.rects[i])) expected_matrix[row * row_words + i / 64] |= Uint64{1} << (i % 64);
+                         }
+                     }
+                 },
+                 [&](int) { engine::utils::overlapMatrix(row_batch, scene.batch, matrix); }, [&] { return matrix == expected_matrix; }) &&
+             ok;
+
+        // Containment: which rects are fully on screen
+        std::vector<bool> expected_flags;
+        std::vector<Uint64> mask;
+        ok = runRow(
+                 "contained", count, repetitions,
+                 [&](int rep) {
+                     const Rect& query = scene.queries[rep % query_count];
+                     expected_flags.assign(count, false);
+                     for (std::size_t i = 0; i < count; ++i)
+                     {
+                         const Rect& rect = scene.rects[i];
+                         expected_flags[i] = rect.position.x >= query.position.x && rect.position.x + rect.size.x <= query.position.x + query.size.x &&
+                                             rect.position.y >= query.position.y && rect.position.y + rect.size.y <= query.position.y + query.size.y;
+                     }
+                 },
+                 [&](int rep) { engine::utils::containedMask(scene.batch, scene.queries[rep % query_count], mask); }, [&] { return mask == toMask(expected_flags); }) &&
+             ok;
+
+        // Clamping: keep every rect inside the world; each repetition starts from the original positions
+        const Rect world{{0.0f, 0.0f}, {WORLD_SIZE, WORLD_SIZE}};
+        std::vector<Rect> clamped_rects;
+        RectBatch clamped_batch;
+        ok = runRow(
+                 "clamp", count, repetitions,
+                 [&](int) {
+                     clamped_rects = scene.rects;
+                     for (Rect& rect : clamped_rects)
+                     {
+                         rect.position = glm::vec2(std::max(std::min(rect.position.x, world.size.x - rect.size.x), 0.0f),
+                                                   std::max(std::min(rect.position.y, world.size.y - rect.size.y), 0.0f));
+                     }
+                 },
+                 [&](int) {
+                     clamped_batch = scene.batch;
+                     engine::utils::clampToBounds(clamped_batch, world);
+                 },
+                 [&] {
+                     // The batch works on edges, so compare with a tolerance of a rounding step
+                     for (std::size_t i = 0; i < count; ++i)
+                     {
+                         const Rect rect = clamped_batch.get(i);
+                         if (std::abs(rect.position.x - clamped_rects[i].position.x) > 1e-3f || std::abs(rect.position.y - clamped_rects[i].position.y) > 1e-3f ||
+                             rect.position.x < 0.0f || rect.position.y < 0.0f)
+                         {
+                             return false;
+                         }
+                     }
+                     return true;
+                 }) &&
+             ok;
+
+        engine::utils::setSimdLevel(SimdLevel::AVX2);
+        return ok;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int repetitions = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 200;
+
+    spdlog::info("RectBatch kernels, best supported level {}, {} repetitions per case", engine::utils::getSimdLevelName(engine::utils::getSupportedSimdLevel()),
+                 repetitions);
+    spdlog::info("  {:<10} {:>8} {:>12} {:>10} {:>10} {:>10} {:>9}", "case", "rects", "per-rect us", "scalar us", "sse2 us", "avx2 us", "speedup");
+    bool ok = true;
+    for (const std::size_t count : {1000u, 10000u, 100000u})
+    {
+        ok = runCases(count, repetitions) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
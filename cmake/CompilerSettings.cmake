@@ -26,3 +26,15 @@ function(setup_compiler_options TARGET_NAME)
         target_compile_options(${TARGET_NAME} PRIVATE -Wall -Wextra -Wpedantic)
     endif()
 endfunction()
+
+# 命令行工具 / 基准测试的编译选项：与游戏相同的警告，但保留控制台窗口
+# 用法：setup_tool_compiler_options(目标名称)
+function(setup_tool_compiler_options TARGET_NAME)
+    if(MSVC)
+        target_compile_options(${TARGET_NAME} PRIVATE /W4 /utf-8)
+    elseif(WIN32 AND (CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "Clang"))
+        target_compile_options(${TARGET_NAME} PRIVATE -Wall -Wextra -Wpedantic -finput-charset=utf-8 -fexec-charset=utf-8)
+    else()
+        target_compile_options(${TARGET_NAME} PRIVATE -Wall -Wextra -Wpedantic)
+    endif()
+endfunction()
@@ -0,0 +1,248 @@
+#include "AudioPlayer.h"
+
+#include <SDL3_mixer/SDL_mixer.h>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+#include "../resource/ResourceManager.h"
+
+namespace engine::audio
+{
+    namespace
+    {
+        int toMixVolume(float volume) { return static_cast<int>(std::clamp(volume, 0.0f, 1.0f) * MIX_MAX_VOLUME); }
+    }  // namespace
+
+    AudioPlayer::AudioPlayer(engine::resource::ResourceManager* resource_manager, std::size_t capacity) : resourceManager_(resource_manager), queue_(capacity)
+    {
+        if (!resourceManager_)
+        {
+            throw std::runtime_error("AudioPlayer construction failed: Provided ResourceManager pointer is null.");
+        }
+        SPDLOG_TRACE("AudioPlayer constructed with {} command slots.", queue_.capacity());
+    }
+
+    AudioPlayer::~AudioPlayer()
+    {
+        stopThread();
+        drain();  // Execute whatever is left so no command is silently lost
+        SPDLOG_TRACE("AudioPlayer destructed.");
+    }
+
+    bool AudioPlayer::push(const AudioCommand& command)
+    {
+        if (!queue_.tryPush(command))
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        if (threadRunning_.load(std::memory_order_relaxed))
+        {
+            wakeCounter_.fetch_add(1, std::memory_order_release);
+            wakeCounter_.notify_one();
+        }
+        return true;
+    }
+
+    bool AudioPlayer::playSound(engine::resource::SoundHandle sound, int channel, int loops)
+    {
+        return push({.type = AudioCommandType::PlaySound, .sound = sound, .channel = channel, .loops = loops});
+    }
+
+    bool AudioPlayer::fadeInSound(engine::resource::SoundHandle sound, int fade_ms, int channel, int loops)
+    {
+        return push({.type = AudioCommandType::FadeInSound, .sound = sound, .channel = channel, .loops = loops, .fadeMs = fade_ms});
+    }
+
+    bool AudioPlayer::stopChannel(int channel) { return push({.type = AudioCommandType::StopChannel, .channel = channel}); }
+
+    bool AudioPlayer::fadeOutChannel(int fade_ms, int channel) { return push({.type = AudioCommandType::FadeOutChannel, .channel = channel, .fadeMs = fade_ms}); }
+
+    bool AudioPlayer::setChannelVolume(float volume, int channel) { return push({.type = AudioCommandType::SetChannelVolume, .channel = channel, .volume = volume}); }
+
+    bool AudioPlayer::playMusic(engine::resource::MusicHandle music, int loops, int fade_ms)
+    {
+        return push({.type = AudioCommandType::PlayMusic, .music = music, .loops = loops, .fadeMs = fade_ms});
+    }
+
+    bool AudioPlayer::stopMusic(int fade_ms) { return push({.type = AudioCommandType::StopMusic, .fadeMs = fade_ms}); }
+
+    bool AudioPlayer::pauseMusic() { return push({.type = AudioCommandType::PauseMusic}); }
+
+    bool AudioPlayer::resumeMusic() { return push({.type = AudioCommandType::ResumeMusic}); }
+
+    bool AudioPlayer::setMusicVolume(float volume) { return push({.type = AudioCommandType::SetMusicVolume, .volume = volume}); }
+
+    bool AudioPlayer::playSound(const std::string& file_path, int channel, int loops)
+    {
+        const engine::resource::SoundHandle sound = resourceManager_->getSoundHandle(file_path);
+        if (!sound.isValid())
+        {
+            spdlog::error("Unable to play sound '{}': sound could not be loaded.", file_path);
+            return false;
+        }
+        return playSound(sound, channel, loops);
+    }
+
+    bool AudioPlayer::playMusic(const std::string& file_path, int loops, int fade_ms)
+    {
+        const engine::resource::MusicHandle music = resourceManager_->getMusicHandle(file_path);
+        if (!music.isValid())
+        {
+            spdlog::error("Unable to play music '{}': music could not be loaded.", file_path);
+            return false;
+        }
+        return playMusic(music, loops, fade_ms);
+    }
+
+    std::size_t AudioPlayer::update()
+    {
+        ENGINE_ALLOC_SCOPE(Audio);
+        if (threadRunning_.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+        return drain();
+    }
+
+    void AudioPlayer::startThread()
+    {
+        if (threadRunning_.exchange(true))
+        {
+            spdlog::warn("AudioPlayer thread is already running.");
+            return;
+        }
+        audioThread_ = std::thread(&AudioPlayer::threadLoop, this);
+        SPDLOG_DEBUG("AudioPlayer thread started.");
+    }
+
+    void AudioPlayer::stopThread()
+    {
+        if (!threadRunning_.exchange(false))
+        {
+            return;
+        }
+
+        wakeCounter_.fetch_add(1, std::memory_order_release);
+        wakeCounter_.notify_one();
+        if (audioThread_.joinable())
+        {
+            audioThread_.join();
+        }
+        drain();  // Commands pushed after the thread's last drain
+        SPDLOG_DEBUG("AudioPlayer thread stopped.");
+    }
+
+    AudioQueueStats AudioPlayer::getStats() const
+    {
+        AudioQueueStats stats;
+        stats.depth = queue_.sizeApprox();
+        stats.highWater = highWater_.load(std::memory_order_relaxed);
+        stats.capacity = queue_.capacity();
+        stats.enqueued = enqueued_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.executed = executed_.load(std::memory_order_relaxed);
+        stats.failed = failed_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    std::size_t AudioPlayer::drain()
+    {
+        const std::size_t depth = queue_.sizeApprox();
+        if (depth > highWater_.load(std::memory_order_relaxed))
+        {
+            highWater_.store(depth, std::memory_order_relaxed);
+        }
+
+        // Bounded to one ring's worth, so a flood of producers cannot keep the consumer here forever
+        std::size_t count = 0;
+        AudioCommand command;
+        while (count < queue_.capacity() && queue_.tryPop(command))
+        {
+            if (!execute(command))
+            {
+                failed_.fetch_add(1, std::memory_order_relaxed);
+            }
+            ++count;
+        }
+
+        executed_.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    bool AudioPlayer::execute(const AudioCommand& command)
+    {
+        switch (command.type)
+        {
+            case AudioCommandType::PlaySound:
+            {
+                const auto lock = resourceManager_->lockAudio();
+                Mix_Chunk* chunk = resourceManager_->getSound(command.sound);
+                return chunk && Mix_PlayChannel(command.channel, chunk, command.loops) >= 0;
+            }
+            case AudioCommandType::FadeInSound:
+            {
+                const auto lock = resourceManager_->lockAudio();
+                Mix_Chunk* chunk = resourceManager_->getSound(command.sound);
+                return chunk && Mix_FadeInChannel(command.channel, chunk, command.loops, command.fadeMs) >= 0;
+            }
+            case AudioCommandType::StopChannel:
+                Mix_HaltChannel(command.channel);
+                return true;
+            case AudioCommandType::FadeOutChannel:
+                Mix_FadeOutChannel(command.channel, command.fadeMs);
+                return true;
+            case AudioCommandType::SetChannelVolume:
+                Mix_Volume(command.channel, toMixVolume(command.volume));
+                return true;
+            case AudioCommandType::PlayMusic:
+            {
+                const auto lock = resourceManager_->lockAudio();
+                Mix_Music* music = resourceManager_->getMusic(command.music);
+                if (!music) return false;
+                return command.fadeMs > 0 ? Mix_FadeInMusic(music, command.loops, command.fadeMs) : Mix_PlayMusic(music, command.loops);
+            }
+            case AudioCommandType::StopMusic:
+                if (command.fadeMs > 0)
+                {
+                    Mix_FadeOutMusic(command.fadeMs);
+                }
+                else
+                {
+                    Mix_HaltMusic();
+                }
+                return true;
+            case AudioCommandType::PauseMusic:
+                Mix_PauseMusic();
+                return true;
+            case AudioCommandType::ResumeMusic:
+                Mix_ResumeMusic();
+                return true;
+            case AudioCommandType::SetMusicVolume:
+                Mix_VolumeMusic(toMixVolume(command.volume));
+                return true;
+        }
+        return false;
+    }
+
+    void AudioPlayer::threadLoop()
+    {
+        ENGINE_PROFILE_THREAD("Audio");
+        ENGINE_ALLOC_SCOPE(Audio);
+        while (threadRunning_.load(std::memory_order_acquire))
+        {
+            const Uint32 seen = wakeCounter_.load(std::memory_order_acquire);
+            drain();
+            if (queue_.sizeApprox() == 0)
+            {
+                wakeCounter_.wait(seen, std::memory_order_acquire);  // Sleep until a producer pushes or stopThread() is called
+            }
+        }
+    }
+
+}  // namespace engine::audio
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "../resource/ResourceHandle.h"
+#include "../utils/MPSCQueue.h"
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::audio
+{
+    /**
+     * @brief Kind of operation carried by an AudioCommand
+     */
+    enum class AudioCommandType : Uint8
+    {
+        PlaySound,
+        FadeInSound,
+        StopChannel,
+        FadeOutChannel,
+        SetChannelVolume,
+        PlayMusic,
+        StopMusic,
+        PauseMusic,
+        ResumeMusic,
+        SetMusicVolume,
+    };
+
+    /**
+     * @brief A single audio request. Plain data so it can be copied through the lock-free queue.
+     *
+     * Resources are referenced by handles, resolved by the thread executing the command under
+     * ResourceManager::lockAudio(). A sound unloaded after the command was queued is skipped and counted as failed,
+     * a reloaded one plays its new data; the mixer is never handed freed memory.
+     */
+    struct AudioCommand
+    {
+        AudioCommandType type = AudioCommandType::PlaySound;
+        engine::resource::SoundHandle sound{};  ///< @brief Sound for PlaySound / FadeInSound
+        engine::resource::MusicHandle music{};  ///< @brief Music for PlayMusic
+        int channel = -1;                       ///< @brief Mixer channel, -1 means first free channel (play) or all channels (stop / volume)
+        int loops = 0;                          ///< @brief Extra loops for sounds, -1 loops forever
+        int fadeMs = 0;                         ///< @brief Fade duration in milliseconds, 0 for no fade
+        float volume = 1.0f;                    ///< @brief Volume in [0, 1] for the Set*Volume commands
+    };
+
+    /**
+     * @brief Snapshot of the queue counters
+     */
+    struct AudioQueueStats
+    {
+        std::size_t depth = 0;      ///< @brief Commands currently waiting
+        std::size_t highWater = 0;  ///< @brief Largest depth observed while draining
+        std::size_t capacity = 0;   ///< @brief Number of slots of the ring
+        Uint64 enqueued = 0;        ///< @brief Commands accepted by the queue
+        Uint64 dropped = 0;         ///< @brief Commands rejected because the queue was full
+        Uint64 executed = 0;        ///< @brief Commands handed to SDL_mixer
+        Uint64 failed = 0;          ///< @brief Commands SDL_mixer reported as failed
+    };
+
+    /**
+     * @brief Front end of the audio system. Every Mix_* playback call goes through here.
+     *
+     * Producers on any thread push AudioCommands into a lock-free ring; the commands are executed either once per frame
+     * by update() on the main thread, or continuously on a dedicated audio thread started by startThread().
+     * Either way playback is only ever driven from one thread; the main thread only touches the mixer to unload or
+     * reload a sound, under the same ResourceManager::lockAudio() the commands run under. When the ring is full the
+     * command is dropped and counted, producers never block.
+     */
+    class AudioPlayer final
+    {
+      private:
+        engine::resource::ResourceManager* resourceManager_ = nullptr;  ///< @brief Non owning pointer, resolves paths on the main thread and handles on the consumer thread
+        engine::utils::MPSCQueue<AudioCommand> queue_;                  ///< @brief Pending commands
+
+        std::atomic<Uint64> enqueued_{0};
+        std::atomic<Uint64> dropped_{0};
+        std::atomic<Uint64> executed_{0};
+        std::atomic<Uint64> failed_{0};
+        std::atomic<std::size_t> highWater_{0};
+
+        std::thread audioThread_;                 ///< @brief Optional dedicated consumer thread
+        std::atomic<bool> threadRunning_{false};  ///< @brief Whether audioThread_ is the consumer
+        std::atomic<Uint32> wakeCounter_{0};      ///< @brief Bumped on every push to wake the audio thread
+
+      public:
+        /**
+         * @brief Construct the AudioPlayer
+         * @param resource_manager points to a valid ResourceManager, could not be null
+         * @param capacity number of command slots, rounded up to a power of two
+         * @throws std::runtime_error if resource_manager is nullptr
+         */
+        explicit AudioPlayer(engine::resource::ResourceManager* resource_manager, std::size_t capacity = 256);
+        ~AudioPlayer();
+
+        // Delete copy and move constructors and assignment operators
+        AudioPlayer(const AudioPlayer&) = delete;
+        AudioPlayer& operator=(const AudioPlayer&) = delete;
+        AudioPlayer(AudioPlayer&&) = delete;
+        AudioPlayer& operator=(AudioPlayer&&) = delete;
+
+        // --- Thread-safe producer interface, never blocks and never calls SDL_mixer ---
+        bool push(const AudioCommand& command);                                                               ///< @brief Enqueue a raw command, returns false if it was dropped
+        bool playSound(engine::resource::SoundHandle sound, int channel = -1, int loops = 0);                 ///< @brief Play a sound on a channel (-1 = first free)
+        bool fadeInSound(engine::resource::SoundHandle sound, int fade_ms, int channel = -1, int loops = 0);  ///< @brief Play a sound fading in
+        bool stopChannel(int channel = -1);                                                                   ///< @brief Halt a channel (-1 = all channels)
+        bool fadeOutChannel(int fade_ms, int channel = -1);                                                   ///< @brief Fade out a channel (-1 = all channels)
+        bool setChannelVolume(float volume, int channel = -1);                                                ///< @brief Set channel volume in [0, 1] (-1 = all channels)
+        bool playMusic(engine::resource::MusicHandle music, int loops = -1, int fade_ms = 0);                 ///< @brief Start music, optionally fading in
+        bool stopMusic(int fade_ms = 0);                                                                      ///< @brief Stop music, optionally fading out
+        bool pauseMusic();                                                                                    ///< @brief Pause music
+        bool resumeMusic();                                                                                   ///< @brief Resume paused music
+        bool setMusicVolume(float volume);                                                                    ///< @brief Set music volume in [0, 1]
+
+        // --- Main thread helpers, resolve the path through the ResourceManager then enqueue ---
+        bool playSound(const std::string& file_path, int channel = -1, int loops = 0);  ///< @brief Resolve a sound by path and play it. Main thread only.
+        bool playMusic(const std::string& file_path, int loops = -1, int fade_ms = 0);  ///< @brief Resolve a music by path and play it. Main thread only.
+
+        /**
+         * @brief Execute the queued commands. Called once per frame by GameApp; does nothing while the audio thread is running.
+         * @return Number of commands executed
+         */
+        std::size_t update();
+
+        void startThread();  ///< @brief Move command execution to a dedicated audio thread
+        void stopThread();   ///< @brief Stop the audio thread and drain the remaining commands on the calling thread
+
+        [[nodiscard]] bool isThreadRunning() const { return threadRunning_.load(std::memory_order_relaxed); }  ///< @brief Whether the audio thread is the consumer
+        [[nodiscard]] AudioQueueStats getStats() const;                                                        ///< @brief Get a snapshot of the queue counters
+
+      private:
+        std::size_t drain();                        ///< @brief Pop and execute everything currently queued
+        bool execute(const AudioCommand& command);  ///< @brief Translate one command into SDL_mixer calls, returns false on failure
+        void threadLoop();                          ///< @brief Body of the audio thread
+    };
+}  // namespace engine::audio
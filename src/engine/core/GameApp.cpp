@@ -1,14 +1,35 @@
 #include "GameApp.h"
 
 #include <SDL3/SDL.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include "../audio/AudioPlayer.h"
+#include "../event/EventBus.h"
+#include "../input/InputManager.h"
+#include "../level/LevelManager.h"
+#include "../memory/AllocationTracker.h"
 #include "../render/Camera.h"
 #include "../render/Renderer.h"
 #include "../resource/ResourceManager.h"
+#include "../save/SaveService.h"
+#include "Profiler.h"
 
 namespace engine::core
 {
+    namespace
+    {
+        /// @brief Resolution the game is drawn at, whatever the window size
+        constexpr int LOGICAL_WIDTH = 640;
+        constexpr int LOGICAL_HEIGHT = 360;
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        /// @brief Frames after which the game is considered warmed up and SUNNYLAND_ASSERT_NO_ALLOC starts checking
+        constexpr Uint64 ALLOC_STEADY_STATE_FRAMES = 300;
+#endif
+    }  // namespace
+
     GameApp::GameApp() {};
 
     GameApp::~GameApp()
@@ -28,16 +49,58 @@ namespace engine::core
             return;
         }
 
-        time_->setTargetFPS(165);
+        // The stress test measures raw frame time, so it runs unlimited
+        time_->setTargetFPS(stressTest_ ? 0 : 165);
+
+#ifdef SUNNYLAND_ENABLE_PROFILER
+        // A frame taking twice its target is a visible hitch: capture a trace of it
+        ENGINE_PROFILE_THREAD("Main");
+        if (time_->getTargetFPS() > 0) Profiler::setFrameBudget(2'000'000'000ULL / static_cast<Uint64>(time_->getTargetFPS()));
+#endif
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        // Startup allocations are expected, counting starts with the first frame
+        const char* assert_no_alloc = SDL_getenv("SUNNYLAND_ASSERT_NO_ALLOC");
+        const bool expect_no_alloc = assert_no_alloc != nullptr && assert_no_alloc[0] != '\0' && assert_no_alloc[0] != '0';
+        Uint64 tracked_frames = 0;
+        engine::memory::AllocationTracker::enable();
+#endif
 
         while (isRunning_)
         {
+#ifdef SUNNYLAND_ENABLE_PROFILER
+            const Uint64 frame_start = SDL_GetTicksNS();
+#endif
             time_->update();
             float deltaTime = time_->getDeltaTime();
+            if (stressTest_) stressTest_->beginFrame();
+
+            // Safe point: nothing is holding resources between frames
+            {
+                ENGINE_ALLOC_SCOPE(Resource);
+                resourceManager_->beginFrame();
+                resourceManager_->processHotReloads();
+                levelManager_->update();
+            }
 
             handleEvents();
             update(deltaTime);
+            {
+                // Second dispatch point: gameplay events raised during update, before the frame is drawn
+                ENGINE_ALLOC_SCOPE(Core);
+                eventBus_->dispatch();
+            }
+            latencyTracer_.markUpdateEnd(SDL_GetTicksNS());
             render();
+
+            if (stressTest_ && !stressTest_->endFrame()) isRunning_ = false;
+#ifdef SUNNYLAND_ENABLE_PROFILER
+            Profiler::endFrame(frame_start, SDL_GetTicksNS());
+#endif
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+            engine::memory::AllocationTracker::endFrame();
+            if (expect_no_alloc && ++tracked_frames == ALLOC_STEADY_STATE_FRAMES) engine::memory::AllocationTracker::expectNoAllocations(true);
+#endif
         }
 
         close();
@@ -45,7 +108,7 @@ namespace engine::core
 
     bool GameApp::init()
     {
-        spdlog::trace("Initializing GameApp...");
+        SPDLOG_TRACE("Initializing GameApp...");
 
         if (!initSDL())
         {
@@ -75,8 +138,51 @@ namespace engine::core
             return false;
         }
 
+        if (!initAudioPlayer())
+        {
+            spdlog::error("Failed to initialize Audio Player.");
+            return false;
+        }
+
+        if (!initSaveService())
+        {
+            spdlog::error("Failed to initialize Save Service.");
+            return false;
+        }
+
+        if (!initInputManager())
+        {
+            spdlog::error("Failed to initialize Input Manager.");
+            return false;
+        }
+
+        if (!initLevelManager())
+        {
+            spdlog::error("Failed to initialize Level Manager.");
+            return false;
+        }
+
+        if (!initEventBus())
+        {
+            spdlog::error("Failed to initialize Event Bus.");
+            return false;
+        }
+
+        if (stressConfig_ && !initStressTest())
+        {
+            spdlog::error("Failed to initialize Stress Test.");
+            return false;
+        }
+
         testResourceManager();
 
+#ifdef SUNNYLAND_ENABLE_HOT_RELOAD
+        if (!resourceManager_->enableHotReload("assets"))
+        {
+            spdlog::warn("Asset hot-reload requested but not supported on this platform.");
+        }
+#endif
+
         isRunning_ = true;
 
         spdlog::info("GameApp initialized successfully.");
@@ -86,36 +192,105 @@ namespace engine::core
 
     void GameApp::handleEvents()
     {
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Core);
+        inputManager_->beginFrame();
+        latencyTracer_.beginFrame(time_->getSleepStartNS(), time_->getSleepEndNS(), SDL_GetTicksNS());
+
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
-            if (event.type == SDL_EVENT_QUIT)
-            {
-                isRunning_ = false;
-            }
-            else if (event.type == SDL_EVENT_WINDOW_RESIZED)
-            {
-                spdlog::debug("Window resized to {}x{}", event.window.data1, event.window.data2);
-            }
+            eventBus_->publish(event);
         }
+
+        // First dispatch point: input is up to date before update() reads it
+        eventBus_->dispatch();
     }
 
-    void GameApp::update(float deltaTime) { testCamera(); }
+    void GameApp::onSdlEvent(const SDL_Event& event)
+    {
+        if ((event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat) || event.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+        {
+            latencyTracer_.onInput(event.common.timestamp);
+        }
+        if (event.type == SDL_EVENT_QUIT)
+        {
+            isRunning_ = false;
+        }
+        else if (event.type == SDL_EVENT_WINDOW_RESIZED)
+        {
+            SPDLOG_DEBUG("Window resized to {}x{}", event.window.data1, event.window.data2);
+        }
+    }
+
+    void GameApp::update(float deltaTime)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Core);
+#ifdef SUNNYLAND_ENABLE_PROFILER
+        static const engine::input::ActionId profile_capture = inputManager_->getActionId("profile_capture");
+        if (inputManager_->isActionPressed(profile_capture)) Profiler::requestCapture("manual");
+#endif
+
+        if (stressTest_)
+        {
+            stressTest_->update();
+        }
+        else
+        {
+            testCamera();
+            testLevelManager();
+        }
+
+        // Execute the audio commands queued during this frame (no-op when the audio thread owns the queue)
+        audioPlayer_->update();
+    }
 
     void GameApp::render()
     {
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Render);
         renderer_->clearScreen();
 
-        testRenderer();
+        if (stressTest_)
+        {
+            stressTest_->render(*renderer_, *camera_);
+        }
+        else
+        {
+            testRenderer();
+        }
 
         renderer_->present();
     }
 
     void GameApp::close()
     {
-        spdlog::trace("Closing GameApp...");
-
+        SPDLOG_TRACE("Closing GameApp...");
+
+        // Its subscribers are the components below
+        eventBus_.reset();
+        // Writes any save still queued before the process exits
+        saveService_.reset();
+        stressTest_.reset();
+        latencyTracer_.logStats();
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        engine::memory::AllocationTracker::logReport();
+        engine::memory::AllocationTracker::disable();
+#endif
+
+        // Joins the loader thread before the textures it prepares go away
+        levelManager_.reset();
+        // The audio player executes queued commands on destruction, so it must go before the resources they reference
+        audioPlayer_.reset();
+        if (resourceManager_)
+        {
+            resourceManager_->logTextureMemoryReport();
+            resourceManager_->logStats();
+        }
         resourceManager_.reset();
+        // Owns the low resolution target, a texture of sdl_renderer_
+        renderer_.reset();
 
         if (sdl_renderer_)
         {
@@ -128,6 +303,9 @@ namespace engine::core
             window_ = nullptr;
         }
         SDL_Quit();
+#ifdef SUNNYLAND_ENABLE_PROFILER
+        Profiler::shutdown();
+#endif
         isRunning_ = false;
         spdlog::info("GameApp closed ...");
     }
@@ -153,8 +331,7 @@ namespace engine::core
             spdlog::error("Renderer could not be created! SDL_Error: {}", SDL_GetError());
             return false;
         }
-        SDL_SetRenderLogicalPresentation(sdl_renderer_, 640, 360, SDL_LOGICAL_PRESENTATION_LETTERBOX);
-        spdlog::trace("SDL initialized successfully.");
+        SPDLOG_TRACE("SDL initialized successfully.");
         return true;
     }
 
@@ -170,7 +347,7 @@ namespace engine::core
             return false;
         }
 
-        spdlog::trace("Time component initialized successfully.");
+        SPDLOG_TRACE("Time component initialized successfully.");
         return true;
     }
 
@@ -186,6 +363,20 @@ namespace engine::core
             return false;
         }
 
+        // Texture memory budget in MiB from performance.texture_budget_mb; missing or 0 leaves it disabled
+        std::ifstream file("assets/config.json");
+        const nlohmann::json config = nlohmann::json::parse(file, nullptr, false);
+        const auto performance = config.is_object() ? config.find("performance") : config.end();
+        if (performance != config.end() && performance->is_object())
+        {
+            const auto budget = performance->find("texture_budget_mb");
+            if (budget != performance->end() && budget->is_number() && budget->get<double>() > 0.0)
+            {
+                resourceManager_->setTextureBudget(static_cast<std::size_t>(budget->get<double>() * 1024.0 * 1024.0));
+                SPDLOG_DEBUG("Texture memory budget set to {} MiB.", budget->get<double>());
+            }
+        }
+
         return true;
     }
     bool GameApp::initRenderer()
@@ -193,27 +384,141 @@ namespace engine::core
         try
         {
             renderer_ = std::make_unique<engine::render::Renderer>(sdl_renderer_, resourceManager_.get());
+            renderer_->setLatencyTracer(&latencyTracer_);
         }
         catch (const std::exception& e)
         {
             spdlog::error("Failed to initialize Renderer: {}", e.what());
             return false;
         }
-        spdlog::trace("Renderer initialized successfully.");
+
+        // Draw at the art's resolution and upscale once, so fill cost does not grow with the window. SUNNYLAND_FULL_RES_RENDER=1
+        // keeps rasterising every sprite at the output resolution, for comparison.
+        const char* full_res = SDL_getenv("SUNNYLAND_FULL_RES_RENDER");
+        const bool want_full_res = full_res != nullptr && full_res[0] != '\0' && full_res[0] != '0';
+        if (want_full_res || !renderer_->setLowResolutionTarget({LOGICAL_WIDTH, LOGICAL_HEIGHT}))
+        {
+            SDL_SetRenderLogicalPresentation(sdl_renderer_, LOGICAL_WIDTH, LOGICAL_HEIGHT, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+        }
+        SPDLOG_TRACE("Renderer initialized successfully.");
         return true;
     }
     bool GameApp::initCamera()
     {
         try
         {
-            camera_ = std::make_unique<engine::render::Camera>(glm::vec2(640, 360));
+            camera_ = std::make_unique<engine::render::Camera>(glm::vec2(LOGICAL_WIDTH, LOGICAL_HEIGHT));
         }
         catch (const std::exception& e)
         {
             spdlog::error("Failed to initialize Camera: {}", e.what());
             return false;
         }
-        spdlog::trace("Camera initialized successfully.");
+        SPDLOG_TRACE("Camera initialized successfully.");
+        return true;
+    }
+    bool GameApp::initAudioPlayer()
+    {
+        try
+        {
+            audioPlayer_ = std::make_unique<engine::audio::AudioPlayer>(resourceManager_.get());
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize AudioPlayer: {}", e.what());
+            return false;
+        }
+        SPDLOG_TRACE("AudioPlayer initialized successfully.");
+        return true;
+    }
+
+    bool GameApp::initSaveService()
+    {
+        try
+        {
+            saveService_ = std::make_unique<engine::save::SaveService>("assets/save.json");
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize SaveService: {}", e.what());
+            return false;
+        }
+
+        if (const auto save = saveService_->load())
+        {
+            spdlog::info("Save loaded: high score {}, resuming '{}'.", save->highScore, save->mapPath);
+        }
+        SPDLOG_TRACE("SaveService initialized successfully.");
+        return true;
+    }
+
+    bool GameApp::initInputManager()
+    {
+        try
+        {
+            inputManager_ = std::make_unique<engine::input::InputManager>("assets/config.json");
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize InputManager: {}", e.what());
+            return false;
+        }
+        SPDLOG_TRACE("InputManager initialized successfully.");
+        return true;
+    }
+
+    bool GameApp::initLevelManager()
+    {
+        try
+        {
+            levelManager_ = std::make_unique<engine::level::LevelManager>(*resourceManager_);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize LevelManager: {}", e.what());
+            return false;
+        }
+        SPDLOG_TRACE("LevelManager initialized successfully.");
+        return true;
+    }
+
+    bool GameApp::initEventBus()
+    {
+        try
+        {
+            eventBus_ = std::make_unique<engine::event::EventBus>();
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize EventBus: {}", e.what());
+            return false;
+        }
+
+        // Input first, so the handlers after it see the state the event produced
+        eventBus_->subscribe<SDL_Event, &engine::input::InputManager::processEvent>(inputManager_.get());
+        eventBus_->subscribe<SDL_Event, &GameApp::onSdlEvent>(this);
+        SPDLOG_TRACE("EventBus initialized successfully.");
+        return true;
+    }
+
+    bool GameApp::initStressTest()
+    {
+        try
+        {
+            stressTest_ = std::make_unique<StressTest>(*stressConfig_, *resourceManager_, camera_->getViewportSize());
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Failed to initialize StressTest: {}", e.what());
+            return false;
+        }
+
+        // Present must not wait for vsync, or every step would measure the refresh rate
+        if (!SDL_SetRenderVSync(sdl_renderer_, 0))
+        {
+            spdlog::warn("Unable to disable vsync for the stress test: {}", SDL_GetError());
+        }
+        SPDLOG_TRACE("StressTest initialized successfully.");
         return true;
     }
 
@@ -232,9 +537,10 @@ namespace engine::core
 
     void GameApp::testRenderer()
     {
-        const render::Sprite sprite_world("assets/textures/Actors/frog.png");
-        const render::Sprite sprite_ui("assets/textures/UI/buttons/Start1.png");
-        const render::Sprite sprite_parallax("assets/textures/Layers/back.png");
+        // Built once: a Sprite owns its texture id string, constructing them per frame would allocate every frame
+        static const render::Sprite sprite_world("assets/textures/Actors/frog.png");
+        static const render::Sprite sprite_ui("assets/textures/UI/buttons/Start1.png");
+        static const render::Sprite sprite_parallax("assets/textures/Layers/back.png");
 
         static float rotation = 0.0f;
         rotation += 0.1f;
@@ -245,13 +551,31 @@ namespace engine::core
         renderer_->drawUISprite(sprite_ui, glm::vec2(100, 100));
     }
 
+    void GameApp::testLevelManager()
+    {
+        // level2 shares the tilesets and parallax layers of level1: only its own images are loaded, in the background
+        static bool started = false;
+        if (!started)
+        {
+            started = true;
+            levelManager_->loadLevel("assets/maps/level1.tmj");
+            levelManager_->prepareLevel("assets/maps/level2.tmj");
+        }
+        if (levelManager_->isReady()) levelManager_->switchLevel();
+    }
+
     void GameApp::testCamera()
     {
-        const auto key_state = SDL_GetKeyboardState(nullptr);
-        if (key_state[SDL_SCANCODE_UP]) camera_->move(glm::vec2(0, -1));
-        if (key_state[SDL_SCANCODE_DOWN]) camera_->move(glm::vec2(0, 1));
-        if (key_state[SDL_SCANCODE_LEFT]) camera_->move(glm::vec2(-1, 0));
-        if (key_state[SDL_SCANCODE_RIGHT]) camera_->move(glm::vec2(1, 0));
+        // Resolved once, every later query is a bit test
+        static const engine::input::ActionId move_up = inputManager_->getActionId("move_up");
+        static const engine::input::ActionId move_down = inputManager_->getActionId("move_down");
+        static const engine::input::ActionId move_left = inputManager_->getActionId("move_left");
+        static const engine::input::ActionId move_right = inputManager_->getActionId("move_right");
+
+        if (inputManager_->isActionHeld(move_up)) camera_->move(glm::vec2(0, -1));
+        if (inputManager_->isActionHeld(move_down)) camera_->move(glm::vec2(0, 1));
+        if (inputManager_->isActionHeld(move_left)) camera_->move(glm::vec2(-1, 0));
+        if (inputManager_->isActionHeld(move_right)) camera_->move(glm::vec2(1, 0));
     }
 
 }  // namespace engine::core
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "../resource/ResourceManager.h"
+#include "LatencyTracer.h"
+#include "StressTest.h"
 #include "Time.h"
 
 // Forward declarations for SDL structures
 struct SDL_Window;
 struct SDL_Renderer;
+union SDL_Event;
 
 namespace engine::resource
 {
@@ -20,6 +24,31 @@ namespace engine::render
     class Camera;
 }  // namespace engine::render
 
+namespace engine::audio
+{
+    class AudioPlayer;
+}
+
+namespace engine::save
+{
+    class SaveService;
+}
+
+namespace engine::input
+{
+    class InputManager;
+}
+
+namespace engine::level
+{
+    class LevelManager;
+}
+
+namespace engine::event
+{
+    class EventBus;
+}
+
 namespace engine::core
 {
     /**
@@ -38,6 +67,14 @@ namespace engine::core
         std::unique_ptr<resource::ResourceManager> resourceManager_;
         std::unique_ptr<render::Renderer> renderer_;
         std::unique_ptr<render::Camera> camera_;
+        std::unique_ptr<audio::AudioPlayer> audioPlayer_;
+        std::unique_ptr<save::SaveService> saveService_;
+        std::unique_ptr<input::InputManager> inputManager_;
+        std::unique_ptr<level::LevelManager> levelManager_;
+        std::unique_ptr<event::EventBus> eventBus_;  ///< @brief SDL and gameplay events, dispatched after polling and after update
+        LatencyTracer latencyTracer_;                ///< @brief Input-to-present latency, reported on close
+        std::optional<StressTestConfig> stressConfig_;
+        std::unique_ptr<StressTest> stressTest_;  ///< @brief Replaces the test scene when --stress was given
 
       public:
         GameApp();
@@ -49,6 +86,11 @@ namespace engine::core
          */
         void run();
 
+        /**
+         * @brief Run the sprite stress sweep instead of the test scene; the app quits when it is done. Call before run().
+         */
+        void setStressTest(const StressTestConfig& config) { stressConfig_ = config; }
+
         // Delete copy and move constructors and assignment operators
         GameApp(const GameApp&) = delete;
 
@@ -63,6 +105,8 @@ namespace engine::core
 
         void handleEvents();
 
+        void onSdlEvent(const SDL_Event& event);
+
         void update(float deltaTime);
 
         void render();
@@ -79,10 +123,24 @@ namespace engine::core
 
         [[nodiscard]] bool initCamera();
 
+        [[nodiscard]] bool initAudioPlayer();
+
+        [[nodiscard]] bool initSaveService();
+
+        [[nodiscard]] bool initInputManager();
+
+        [[nodiscard]] bool initLevelManager();
+
+        [[nodiscard]] bool initEventBus();
+
+        [[nodiscard]] bool initStressTest();
+
         void testResourceManager();
 
         void testRenderer();
 
         void testCamera();
+
+        void testLevelManager();
     };
 }  // namespace engine::core
@@ -0,0 +1,111 @@
+#include "LatencyTracer.h"
+
+#include <algorithm>
+#include <limits>
+#include <spdlog/spdlog.h>
+#include <string>
+
+namespace engine::core
+{
+    namespace
+    {
+        constexpr std::array<const char*, LatencyStats::PHASE_COUNT> PHASE_NAMES = {"queue", "limiter sleep", "update", "render", "present"};
+    }  // namespace
+
+    Uint64 LatencyStats::quantileUpperBoundNs(double quantile) const
+    {
+        if (traced == 0) return 0;
+        const auto rank = static_cast<Uint64>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(traced - 1)) + 1;
+        Uint64 seen = 0;
+        for (std::size_t i = 0; i < LATENCY_BUCKET_BOUNDS_NS.size(); ++i)
+        {
+            seen += latency[i];
+            if (seen >= rank) return LATENCY_BUCKET_BOUNDS_NS[i];
+        }
+        return std::numeric_limits<Uint64>::max();
+    }
+
+    LatencyPhase LatencyStats::getDominantPhase() const
+    {
+        return static_cast<LatencyPhase>(std::max_element(phaseNs.begin(), phaseNs.end()) - phaseNs.begin());
+    }
+
+    void LatencyTracer::beginFrame(Uint64 sleep_start_ns, Uint64 sleep_end_ns, Uint64 poll_start_ns)
+    {
+        sleepStartNs_ = sleep_start_ns;
+        sleepEndNs_ = sleep_end_ns;
+        pollStartNs_ = poll_start_ns;
+        updateEndNs_ = poll_start_ns;
+        renderEndNs_ = 0;
+    }
+
+    void LatencyTracer::markPresented(Uint64 now_ns)
+    {
+        const Uint64 input = inputNs_;
+        inputNs_ = 0;
+        if (input == 0 || now_ns < input) return;
+
+        // Split [input, now] at the frame marks; an input stamped after the poll started (pumped mid-poll) starts in Update
+        const Uint64 poll = std::max(pollStartNs_, input);
+        const Uint64 update_end = std::clamp(updateEndNs_, poll, now_ns);
+        const Uint64 render_end = std::clamp(renderEndNs_, update_end, now_ns);
+        const Uint64 overlap_start = std::max(sleepStartNs_, input);
+        const Uint64 overlap_end = std::min(sleepEndNs_, poll);
+        const Uint64 sleep = overlap_end > overlap_start ? overlap_end - overlap_start : 0;
+
+        const std::array<Uint64, LatencyStats::PHASE_COUNT> phases = {
+            poll - input - sleep, sleep, update_end - poll, render_end - update_end, now_ns - render_end,
+        };
+        const Uint64 total = now_ns - input;
+
+        ++stats_.traced;
+        stats_.totalNs += total;
+        stats_.maxNs = std::max(stats_.maxNs, total);
+        for (std::size_t i = 0; i < phases.size(); ++i)
+        {
+            stats_.phaseNs[i] += phases[i];
+            stats_.phaseMaxNs[i] = std::max(stats_.phaseMaxNs[i], phases[i]);
+        }
+        const auto bucket = std::lower_bound(LatencyStats::LATENCY_BUCKET_BOUNDS_NS.begin(), LatencyStats::LATENCY_BUCKET_BOUNDS_NS.end(), total);
+        ++stats_.latency[static_cast<std::size_t>(bucket - LatencyStats::LATENCY_BUCKET_BOUNDS_NS.begin())];
+    }
+
+    void LatencyTracer::logStats() const
+    {
+        if (stats_.traced == 0)
+        {
+            spdlog::info("Input latency: no input was traced.");
+            return;
+        }
+
+        auto quantile_text = [this](double quantile) {
+            const Uint64 bound = stats_.quantileUpperBoundNs(quantile);
+            return bound == std::numeric_limits<Uint64>::max() ? fmt::format(">{:.0f}ms", LatencyStats::LATENCY_BUCKET_BOUNDS_NS.back() / 1e6)
+                                                               : fmt::format("<={:.0f}ms", bound / 1e6);
+        };
+        spdlog::info("Input latency: {} inputs traced, mean {:.2f} ms, max {:.2f} ms, p50 {}, p95 {}, p99 {}", stats_.traced, stats_.totalNs / 1e6 / stats_.traced,
+                     stats_.maxNs / 1e6, quantile_text(0.50), quantile_text(0.95), quantile_text(0.99));
+
+        for (std::size_t i = 0; i < LatencyStats::PHASE_COUNT; ++i)
+        {
+            spdlog::info("  {:<13} mean {:>7.2f} ms, max {:>7.2f} ms, {:>5.1f}% of the latency", PHASE_NAMES[i], stats_.phaseNs[i] / 1e6 / stats_.traced,
+                         stats_.phaseMaxNs[i] / 1e6, stats_.totalNs > 0 ? 100.0 * stats_.phaseNs[i] / stats_.totalNs : 0.0);
+        }
+        spdlog::info("  dominant phase: {}", PHASE_NAMES[static_cast<std::size_t>(stats_.getDominantPhase())]);
+
+        std::string histogram;
+        for (std::size_t i = 0; i < stats_.latency.size(); ++i)
+        {
+            if (stats_.latency[i] == 0) continue;
+            if (i < LatencyStats::LATENCY_BUCKET_BOUNDS_NS.size())
+            {
+                histogram += fmt::format(" <={:.0f}ms:{}", LatencyStats::LATENCY_BUCKET_BOUNDS_NS[i] / 1e6, stats_.latency[i]);
+            }
+            else
+            {
+                histogram += fmt::format(" >{:.0f}ms:{}", LatencyStats::LATENCY_BUCKET_BOUNDS_NS.back() / 1e6, stats_.latency[i]);
+            }
+        }
+        spdlog::info("  latency{}", histogram);
+    }
+}  // namespace engine::core
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
+
+namespace engine::core
+{
+    /**
+     * @brief Stages an input goes through between its SDL timestamp and the present of the frame that handled it
+     */
+    enum class LatencyPhase : Uint8
+    {
+        Queue,         ///< @brief Waiting in the event queue for the next poll (rest of the previous frame, hot reloads, ...)
+        LimiterSleep,  ///< @brief Time::limitFrameRate() sleeping while the input was already queued
+        Update,        ///< @brief Event polling and GameApp::update()
+        Render,        ///< @brief Building the frame, up to Renderer::present()
+        Present,       ///< @brief SDL_RenderPresent(), including any vsync wait
+        Count,
+    };
+
+    /**
+     * @brief Input-to-present latency distribution with a per-phase breakdown. Main thread only.
+     */
+    struct LatencyStats
+    {
+        static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(LatencyPhase::Count);
+        static constexpr std::size_t LATENCY_BUCKET_COUNT = 12;
+
+        /// @brief Upper bound (inclusive, nanoseconds) of each latency bucket; the last bucket collects everything slower
+        static constexpr std::array<Uint64, LATENCY_BUCKET_COUNT - 1> LATENCY_BUCKET_BOUNDS_NS = {
+            2'000'000, 4'000'000, 8'000'000, 12'000'000, 16'000'000, 20'000'000, 25'000'000, 33'000'000, 50'000'000, 66'000'000, 100'000'000,
+        };
+
+        Uint64 traced = 0;                                   ///< @brief Frames that carried an input to present
+        Uint64 totalNs = 0;                                  ///< @brief Sum of input-to-present latencies
+        Uint64 maxNs = 0;                                    ///< @brief Slowest input-to-present latency
+        std::array<Uint64, PHASE_COUNT> phaseNs{};           ///< @brief Sum of each phase over all traces
+        std::array<Uint64, PHASE_COUNT> phaseMaxNs{};        ///< @brief Longest single occurrence of each phase
+        std::array<Uint64, LATENCY_BUCKET_COUNT> latency{};  ///< @brief Input-to-present histogram, see LATENCY_BUCKET_BOUNDS_NS
+
+        /**
+         * @brief Upper bound of the bucket holding the given quantile (0..1), an estimate good to one bucket
+         * @return 0 when nothing was traced, UINT64_MAX when the quantile lies in the open-ended last bucket
+         */
+        Uint64 quantileUpperBoundNs(double quantile) const;
+
+        /**
+         * @brief The phase that contributed the most latency over all traces
+         */
+        LatencyPhase getDominantPhase() const;
+    };
+
+    /**
+     * @brief Measures how long an input takes to reach the screen.
+     *
+     * The earliest input event polled in a frame (by its SDL timestamp) is carried through update and render into
+     * Renderer::present(); when present returns, the elapsed time is recorded and split into LatencyPhase segments.
+     * Later inputs of the same frame are shown by the same present, so the earliest one is the worst case.
+     * GameApp drives the frame marks; Renderer reports the two present marks.
+     */
+    class LatencyTracer final
+    {
+      private:
+        LatencyStats stats_;
+        Uint64 inputNs_ = 0;       ///< @brief Earliest unconsumed input of this frame, 0 if none
+        Uint64 sleepStartNs_ = 0;  ///< @brief Frame limiter sleep that preceded this frame's poll
+        Uint64 sleepEndNs_ = 0;
+        Uint64 pollStartNs_ = 0;
+        Uint64 updateEndNs_ = 0;
+        Uint64 renderEndNs_ = 0;
+
+      public:
+        LatencyTracer() = default;
+
+        // Delete copy and move constructors and assignment operators
+        LatencyTracer(const LatencyTracer&) = delete;
+        LatencyTracer& operator=(const LatencyTracer&) = delete;
+        LatencyTracer(LatencyTracer&&) = delete;
+        LatencyTracer& operator=(LatencyTracer&&) = delete;
+
+        /**
+         * @brief Start of event polling
+         * @param sleep_start_ns, sleep_end_ns the frame limiter sleep of this frame, equal if it did not sleep
+         */
+        void beginFrame(Uint64 sleep_start_ns, Uint64 sleep_end_ns, Uint64 poll_start_ns);
+
+        /**
+         * @brief An input event was polled; only the earliest of the frame is traced
+         * @param timestamp_ns SDL event timestamp (SDL_GetTicksNS() clock)
+         */
+        void onInput(Uint64 timestamp_ns)
+        {
+            if (inputNs_ == 0 || timestamp_ns < inputNs_) inputNs_ = timestamp_ns;
+        }
+
+        void markUpdateEnd(Uint64 now_ns) { updateEndNs_ = now_ns; }
+        void markRenderEnd(Uint64 now_ns) { renderEndNs_ = now_ns; }  ///< @brief Called by Renderer::present() before SDL_RenderPresent()
+
+        /**
+         * @brief Called by Renderer::present() after SDL_RenderPresent(); records the frame's input, if any
+         */
+        void markPresented(Uint64 now_ns);
+
+        const LatencyStats& getStats() const { return stats_; }
+        void logStats() const;
+    };
+}  // namespace engine::core
@@ -0,0 +1,54 @@
+#include "Log.h"
+
+#include <SDL3/SDL_timer.h>
+#include <chrono>
+#include <memory>
+#include <spdlog/async.h>
+#include <spdlog/sinks/dup_filter_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+namespace engine::core
+{
+    void initLogging(spdlog::level::level_enum level)
+    {
+        // One background thread; 8192 queued messages is several frames of heavy logging
+        spdlog::init_thread_pool(8192, 1);
+
+        // Collapse identical consecutive messages (e.g. the same error every frame) into one line plus a skip count
+        auto dup_filter = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(std::chrono::seconds(5));
+        dup_filter->add_sink(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+
+        // overrun_oldest: a full queue drops old messages instead of blocking the game thread
+        auto logger = std::make_shared<spdlog::async_logger>("engine", dup_filter, spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+        logger->set_level(level);
+        logger->flush_on(spdlog::level::err);
+
+        spdlog::set_default_logger(logger);
+        spdlog::flush_every(std::chrono::seconds(1));
+        SPDLOG_TRACE("Async logging initialized.");
+    }
+
+    void shutdownLogging()
+    {
+        spdlog::shutdown();  // Flushes the queue and joins the background thread
+    }
+
+    bool LogRateLimiter::allow(Uint32& suppressed)
+    {
+        const Uint64 now = SDL_GetTicksNS();
+        Uint64 start = windowStart_.load(std::memory_order_relaxed);
+        if (now - start >= WINDOW_NS && windowStart_.compare_exchange_strong(start, now, std::memory_order_relaxed))
+        {
+            count_.store(0, std::memory_order_relaxed);
+        }
+
+        if (count_.fetch_add(1, std::memory_order_relaxed) < MAX_PER_WINDOW)
+        {
+            suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+}  // namespace engine::core
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <atomic>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    /**
+     * @brief Install the engine logger as spdlog's default logger.
+     *
+     * Messages are formatted on the calling thread and written by a background thread, so a slow console never stalls a frame.
+     * If the queue is full the oldest messages are dropped instead of blocking. Consecutive identical messages are collapsed.
+     * trace/debug calls written with SPDLOG_TRACE / SPDLOG_DEBUG are compiled out unless SPDLOG_ACTIVE_LEVEL allows them (see CMakeLists.txt).
+     *
+     * @param level runtime log level
+     */
+    void initLogging(spdlog::level::level_enum level = spdlog::level::info);
+
+    /**
+     * @brief Flush and stop the background logging thread. Call once before exiting.
+     */
+    void shutdownLogging();
+
+    /**
+     * @brief Per call site limiter used by ENGINE_LOG_RATE_LIMITED.
+     *
+     * Allows at most MAX_PER_WINDOW messages per WINDOW_NS; the rest are only counted. Lock-free, safe to share between threads.
+     */
+    class LogRateLimiter final
+    {
+      public:
+        static constexpr Uint32 MAX_PER_WINDOW = 5;             ///< @brief Messages let through per window
+        static constexpr Uint64 WINDOW_NS = 2'000'000'000ULL;  ///< @brief Window length: 2 seconds
+
+      private:
+        std::atomic<Uint64> windowStart_{0};  ///< @brief Start of the current window, SDL_GetTicksNS()
+        std::atomic<Uint32> count_{0};        ///< @brief Messages seen in the current window
+        std::atomic<Uint32> suppressed_{0};   ///< @brief Messages dropped since the last one let through
+
+      public:
+        /**
+         * @brief Decide whether the next message may be logged
+         * @param suppressed receives the number of messages dropped since the previous allowed one
+         * @return true if the message should be logged
+         */
+        bool allow(Uint32& suppressed);
+    };
+}  // namespace engine::core
+
+/**
+ * @brief Log through spdlog with per call site rate limiting. Arguments are only formatted when the message is let through.
+ * @param level spdlog::level::level_enum
+ */
+#define ENGINE_LOG_RATE_LIMITED(level, ...)                                                                 \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (spdlog::should_log(level))                                                                      \
+        {                                                                                                   \
+            static ::engine::core::LogRateLimiter engine_log_limiter_;                                      \
+            Uint32 engine_log_suppressed_ = 0;                                                              \
+            if (engine_log_limiter_.allow(engine_log_suppressed_))                                          \
+            {                                                                                               \
+                if (engine_log_suppressed_ > 0)                                                             \
+                {                                                                                           \
+                    spdlog::log(level, "({} similar messages suppressed)", engine_log_suppressed_);         \
+                }                                                                                           \
+                spdlog::log(level, __VA_ARGS__);                                                            \
+            }                                                                                               \
+        }                                                                                                   \
+    } while (0)
+
+#define ENGINE_LOG_ERROR_LIMITED(...) ENGINE_LOG_RATE_LIMITED(spdlog::level::err, __VA_ARGS__)
+#define ENGINE_LOG_WARN_LIMITED(...) ENGINE_LOG_RATE_LIMITED(spdlog::level::warn, __VA_ARGS__)
@@ -0,0 +1,343 @@
+#include "Profiler.h"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <vector>
+
+#include "../utils/AtomicFile.h"
+
+namespace engine::core
+{
+    namespace
+    {
+        constexpr std::size_t EVENT_MASK = Profiler::EVENTS_PER_THREAD - 1;
+        static_assert((Profiler::EVENTS_PER_THREAD & EVENT_MASK) == 0, "EVENTS_PER_THREAD must be a power of two");
+
+        /**
+         * @brief One closed zone. Fields are relaxed atomics so a capture may read a slot the owner is overwriting
+         * without a data race; such slots are detected and dropped (see copyEvents()).
+         */
+        struct EventSlot
+        {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<Uint64> startNs{0};
+            std::atomic<Uint64> durationNs{0};
+        };
+
+        struct ThreadBuffer
+        {
+            Uint32 threadId = 0;
+            std::string name;  ///< @brief Guarded by the registry mutex
+            std::unique_ptr<EventSlot[]> slots = std::make_unique<EventSlot[]>(Profiler::EVENTS_PER_THREAD);
+            std::atomic<Uint64> written{0};  ///< @brief Events recorded so far; slot index is written & EVENT_MASK
+        };
+
+        struct CapturedEvent
+        {
+            const char* name;
+            Uint64 startNs;
+            Uint64 durationNs;
+            Uint32 threadId;
+        };
+
+        struct Capture
+        {
+            std::string path;
+            std::string reason;
+            std::vector<CapturedEvent> events;
+            std::vector<std::pair<Uint32, std::string>> threadNames;
+        };
+
+        /**
+         * @brief Process-wide state. Buffers of finished threads are kept, their last zones still belong in a capture.
+         */
+        struct ProfilerState
+        {
+            std::mutex registryMutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+            // --- Main thread only ---
+            Uint64 frameBudgetNs = 0;
+            std::string outputDirectory = "profiles";
+            std::optional<std::string> pendingReason;
+            Uint64 lastAutoCaptureNs = 0;
+            int autoCaptures = 0;
+            int captureCount = 0;
+
+            // --- Writer thread, guarded by writerMutex ---
+            std::mutex writerMutex;
+            std::condition_variable writerWake;
+            std::optional<Capture> queued;
+            bool writing = false;
+            bool stopping = false;
+            std::thread writer;
+
+            ~ProfilerState() { stopWriter(); }
+
+            void stopWriter()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(writerMutex);
+                    stopping = true;
+                }
+                writerWake.notify_one();
+                if (writer.joinable()) writer.join();
+            }
+        };
+
+        ProfilerState& state()
+        {
+            static ProfilerState instance;
+            return instance;
+        }
+
+        ThreadBuffer& threadBuffer()
+        {
+            thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+                auto created = std::make_shared<ThreadBuffer>();
+                ProfilerState& profiler = state();
+                std::lock_guard<std::mutex> lock(profiler.registryMutex);
+                created->threadId = static_cast<Uint32>(profiler.buffers.size() + 1);
+                created->name = fmt::format("Thread {}", created->threadId);
+                profiler.buffers.push_back(created);
+                return created;
+            }();
+            return *buffer;
+        }
+
+        void record(const char* name, Uint64 start_ns, Uint64 duration_ns)
+        {
+            ThreadBuffer& buffer = threadBuffer();
+            const Uint64 index = buffer.written.load(std::memory_order_relaxed);
+            EventSlot& slot = buffer.slots[index & EVENT_MASK];
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.startNs.store(start_ns, std::memory_order_relaxed);
+            slot.durationNs.store(duration_ns, std::memory_order_relaxed);
+            buffer.written.store(index + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Append the events of one buffer. The owner keeps recording meanwhile; slots it may have overwritten
+         * during the copy (those within one ring length of its new position) are dropped.
+         */
+        void copyEvents(const ThreadBuffer& buffer, std::vector<CapturedEvent>& out)
+        {
+            const Uint64 end = buffer.written.load(std::memory_order_acquire);
+            const Uint64 begin = end > Profiler::EVENTS_PER_THREAD ? end - Profiler::EVENTS_PER_THREAD : 0;
+            const std::size_t first = out.size();
+            for (Uint64 i = begin; i < end; ++i)
+            {
+                const EventSlot& slot = buffer.slots[i & EVENT_MASK];
+                out.push_back({slot.name.load(std::memory_order_relaxed), slot.startNs.load(std::memory_order_relaxed), slot.durationNs.load(std::memory_order_relaxed),
+                               buffer.threadId});
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const Uint64 now = buffer.written.load(std::memory_order_relaxed);
+            const Uint64 safe_begin = now + 1 > Profiler::EVENTS_PER_THREAD ? now + 1 - Profiler::EVENTS_PER_THREAD : 0;
+            if (safe_begin > begin)
+            {
+                const auto torn = static_cast<std::size_t>(std::min(safe_begin - begin, end - begin));
+                out.erase(out.begin() + static_cast<std::ptrdiff_t>(first), out.begin() + static_cast<std::ptrdiff_t>(first + torn));
+            }
+        }
+
+        void appendEscaped(std::string& out, const char* text)
+        {
+            for (; *text; ++text)
+            {
+                const char c = *text;
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                    out += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out += fmt::format("\\u{:04x}", static_cast<int>(c));
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+
+        /**
+         * @brief Chrome trace-event JSON: one complete ("X") event per zone plus thread name metadata, times in microseconds
+         */
+        std::string toTraceJson(const Capture& capture)
+        {
+            std::string json;
+            json.reserve(capture.events.size() * 96 + 256);
+            json += "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"reason\":\"";
+            appendEscaped(json, capture.reason.c_str());
+            json += "\"},\"traceEvents\":[\n";
+            bool first = true;
+            for (const auto& [thread_id, name] : capture.threadNames)
+            {
+                json += first ? "" : ",\n";
+                first = false;
+                json += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", thread_id);
+                appendEscaped(json, name.c_str());
+                json += "\"}}";
+            }
+            for (const CapturedEvent& event : capture.events)
+            {
+                json += first ? "" : ",\n";
+                first = false;
+                json += "{\"name\":\"";
+                appendEscaped(json, event.name ? event.name : "?");
+                json += fmt::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", event.threadId, event.startNs / 1000.0, event.durationNs / 1000.0);
+            }
+            json += "\n]}\n";
+            return json;
+        }
+
+        void writerLoop(ProfilerState& profiler)
+        {
+            std::unique_lock<std::mutex> lock(profiler.writerMutex);
+            while (true)
+            {
+                profiler.writerWake.wait(lock, [&] { return profiler.stopping || profiler.queued.has_value(); });
+                if (!profiler.queued) return;  // stopping with nothing left to write
+
+                Capture capture = std::move(*profiler.queued);
+                profiler.queued.reset();
+                lock.unlock();
+
+                const std::string json = toTraceJson(capture);
+                std::error_code error;
+                std::filesystem::create_directories(std::filesystem::path(capture.path).parent_path(), error);
+                if (engine::utils::writeFileAtomically(capture.path, std::as_bytes(std::span(json.data(), json.size()))))
+                {
+                    spdlog::info("Profiler capture '{}' written: {} zones ({}).", capture.path, capture.events.size(), capture.reason);
+                }
+
+                lock.lock();
+                profiler.writing = false;
+            }
+        }
+
+        /**
+         * @brief File name friendly form of a capture reason
+         */
+        std::string slug(std::string_view reason)
+        {
+            std::string result;
+            for (const char c : reason)
+            {
+                const bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+                if (keep)
+                    result += c;
+                else if (!result.empty() && result.back() != '_')
+                    result += '_';
+            }
+            while (!result.empty() && result.back() == '_') result.pop_back();
+            return result.empty() ? "capture" : result;
+        }
+    }  // namespace
+
+    ProfileScope::ProfileScope(const char* name) : name_(name), startNs_(SDL_GetTicksNS()) {}
+
+    ProfileScope::~ProfileScope()
+    {
+        record(name_, startNs_, SDL_GetTicksNS() - startNs_);
+    }
+
+    void Profiler::setThreadName(std::string_view name)
+    {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(state().registryMutex);
+        buffer.name = name;
+    }
+
+    void Profiler::setFrameBudget(Uint64 budget_ns)
+    {
+        state().frameBudgetNs = budget_ns;
+    }
+
+    void Profiler::setOutputDirectory(const std::string& directory)
+    {
+        state().outputDirectory = directory;
+    }
+
+    void Profiler::endFrame(Uint64 frame_start_ns, Uint64 frame_end_ns)
+    {
+        ProfilerState& profiler = state();
+        const Uint64 duration = frame_end_ns - frame_start_ns;
+        record("Frame", frame_start_ns, duration);
+
+        if (profiler.pendingReason)
+        {
+            const std::string reason = std::move(*profiler.pendingReason);
+            profiler.pendingReason.reset();
+            capture(reason);
+        }
+        else if (profiler.frameBudgetNs > 0 && duration > profiler.frameBudgetNs && profiler.autoCaptures < MAX_AUTO_CAPTURES &&
+                 (profiler.lastAutoCaptureNs == 0 || frame_end_ns - profiler.lastAutoCaptureNs >= AUTO_CAPTURE_COOLDOWN_NS))
+        {
+            // The cooldown also starts on a dropped attempt, so a long stall does not retry every frame
+            profiler.lastAutoCaptureNs = frame_end_ns;
+            if (capture(fmt::format("frame {:.1f} ms over {:.1f} ms budget", duration / 1'000'000.0, profiler.frameBudgetNs / 1'000'000.0)))
+            {
+                ++profiler.autoCaptures;
+            }
+        }
+    }
+
+    void Profiler::requestCapture(std::string_view reason)
+    {
+        state().pendingReason = std::string(reason);
+    }
+
+    bool Profiler::capture(std::string_view reason)
+    {
+        ProfilerState& profiler = state();
+        {
+            std::lock_guard<std::mutex> lock(profiler.writerMutex);
+            if (profiler.writing)
+            {
+                spdlog::warn("Profiler capture '{}' dropped, the previous one is still being written.", reason);
+                return false;
+            }
+        }
+
+        Capture snapshot;
+        snapshot.reason = std::string(reason);
+        snapshot.path = (std::filesystem::path(profiler.outputDirectory) / fmt::format("profile_{}_{}.json", ++profiler.captureCount, slug(reason))).generic_string();
+        {
+            std::lock_guard<std::mutex> lock(profiler.registryMutex);
+            snapshot.events.reserve(profiler.buffers.size() * EVENTS_PER_THREAD / 4);
+            for (const auto& buffer : profiler.buffers)
+            {
+                copyEvents(*buffer, snapshot.events);
+                snapshot.threadNames.emplace_back(buffer->threadId, buffer->name);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(profiler.writerMutex);
+            if (profiler.stopping) return false;
+            profiler.queued = std::move(snapshot);
+            profiler.writing = true;
+            if (!profiler.writer.joinable()) profiler.writer = std::thread(writerLoop, std::ref(profiler));
+        }
+        profiler.writerWake.notify_one();
+        return true;
+    }
+
+    void Profiler::shutdown()
+    {
+        state().stopWriter();
+    }
+}  // namespace engine::core
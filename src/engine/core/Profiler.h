@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <string>
+#include <string_view>
+
+namespace engine::core
+{
+    /**
+     * @brief Times the enclosing scope into the calling thread's profiler buffer. Use ENGINE_PROFILE_SCOPE instead of naming it.
+     */
+    class ProfileScope final
+    {
+      private:
+        const char* name_;
+        Uint64 startNs_;
+
+      public:
+        /**
+         * @param name zone name; it must outlive the process (a string literal or __func__), only the pointer is stored
+         */
+        explicit ProfileScope(const char* name);
+        ~ProfileScope();
+
+        // Delete copy and move constructors and assignment operators
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&&) = delete;
+        ProfileScope& operator=(ProfileScope&&) = delete;
+    };
+
+    /**
+     * @brief Hierarchical zone profiler with Chrome trace-event export.
+     *
+     * Every thread records the zones it closes into its own fixed ring buffer (the last EVENTS_PER_THREAD zones), so
+     * recording takes no lock and never allocates after the first zone of a thread. Nesting needs no bookkeeping: the
+     * trace viewer rebuilds it from the start and end times of the zones of each thread.
+     *
+     * A capture copies every ring buffer and hands it to a background thread that writes
+     * "<output directory>/profile_<n>_<reason>.json", loadable in chrome://tracing or ui.perfetto.dev. Captures happen
+     * on demand (capture(), requestCapture()) or automatically from endFrame() when a frame exceeds the frame budget;
+     * automatic ones are rate limited so a slow stretch does not flood the disk.
+     *
+     * The ENGINE_PROFILE_* macros compile to nothing unless SUNNYLAND_ENABLE_PROFILER is defined (see CMakeLists.txt).
+     */
+    class Profiler final
+    {
+      public:
+        static constexpr std::size_t EVENTS_PER_THREAD = 1u << 16;        ///< @brief Ring buffer size of each thread, a power of two
+        static constexpr Uint64 AUTO_CAPTURE_COOLDOWN_NS = 5'000'000'000;  ///< @brief Minimum time between two automatic captures
+        static constexpr int MAX_AUTO_CAPTURES = 10;                       ///< @brief Automatic captures per session
+
+        Profiler() = delete;
+
+        /**
+         * @brief Name the calling thread in the traces
+         */
+        static void setThreadName(std::string_view name);
+
+        /**
+         * @brief Frames longer than this trigger an automatic capture; 0 disables it
+         */
+        static void setFrameBudget(Uint64 budget_ns);
+
+        /**
+         * @brief Where captures are written, created on demand. Default "profiles".
+         */
+        static void setOutputDirectory(const std::string& directory);
+
+        /**
+         * @brief Record a "Frame" zone on the calling thread, then run the pending or automatic capture if any.
+         * Call once per frame from the main loop.
+         */
+        static void endFrame(Uint64 frame_start_ns, Uint64 frame_end_ns);
+
+        /**
+         * @brief Capture at the next endFrame(), so the trace ends with a complete frame
+         */
+        static void requestCapture(std::string_view reason);
+
+        /**
+         * @brief Copy the buffers now and write them in the background
+         * @return false if a previous capture is still being written (the request is dropped)
+         */
+        static bool capture(std::string_view reason);
+
+        /**
+         * @brief Wait for the capture being written, then stop the writer thread. Call before shutting down logging.
+         */
+        static void shutdown();
+    };
+}  // namespace engine::core
+
+#define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SUNNYLAND_ENABLE_PROFILER
+/// @brief Time the rest of the enclosing scope; name must be a string literal
+#define ENGINE_PROFILE_SCOPE(name) ::engine::core::ProfileScope ENGINE_PROFILE_CONCAT(engine_profile_scope_, __LINE__)(name)
+/// @brief Time the rest of the enclosing function under its name
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+/// @brief Name the calling thread in the traces
+#define ENGINE_PROFILE_THREAD(name) ::engine::core::Profiler::setThreadName(name)
+#else
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#define ENGINE_PROFILE_FUNCTION() ((void)0)
+#define ENGINE_PROFILE_THREAD(name) ((void)0)
+#endif
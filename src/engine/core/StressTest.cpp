@@ -0,0 +1,269 @@
+#include "StressTest.h"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <cstdlib>
+#include <numbers>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+#include "../render/Camera.h"
+#include "../render/Renderer.h"
+#include "../resource/ResourceManager.h"
+
+namespace engine::core
+{
+    namespace
+    {
+        constexpr float FIXED_DELTA = 1.0f / 60.0f;
+        constexpr float AREA_MARGIN = 32.0f;
+
+        /**
+         * @brief The actor sprite sheets and the frames taken from their first row
+         */
+        struct ActorSheet
+        {
+            const char* path;
+            float frameWidth;
+            float frameHeight;
+            int frames;
+        };
+
+        constexpr ActorSheet ACTOR_SHEETS[] = {
+            {"assets/textures/Actors/eagle-attack.png", 40.0f, 41.0f, 4},
+            {"assets/textures/Actors/foxy.png", 33.0f, 32.0f, 6},
+            {"assets/textures/Actors/frog.png", 35.0f, 32.0f, 4},
+            {"assets/textures/Actors/opossum.png", 36.0f, 28.0f, 6},
+        };
+
+        /**
+         * @brief min, then the 1-2-5 values strictly between min and max, then max
+         */
+        std::vector<int> sweepSteps(int min_sprites, int max_sprites)
+        {
+            std::vector<int> steps{min_sprites};
+            for (long long decade = 1; decade <= max_sprites; decade *= 10)
+            {
+                for (const long long factor : {1, 2, 5})
+                {
+                    const long long count = factor * decade;
+                    if (count > min_sprites && count < max_sprites) steps.push_back(static_cast<int>(count));
+                }
+            }
+            if (max_sprites > min_sprites) steps.push_back(max_sprites);
+            return steps;
+        }
+
+        double percentile(const std::vector<double>& sorted, double quantile)
+        {
+            const auto index = static_cast<std::size_t>(quantile * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+    }  // namespace
+
+    std::optional<StressTestConfig> StressTestConfig::fromArgs(int argc, char* argv[], bool& ok)
+    {
+        ok = true;
+        StressTestConfig config;
+        bool enabled = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--stress")
+            {
+                enabled = true;
+                continue;
+            }
+            // Arguments before --stress belong to the game or the platform (e.g. macOS -psn_*), not to the stress test
+            if (!enabled) continue;
+            if (arg != "--sprites" && arg != "--frames" && arg != "--out")
+            {
+                spdlog::error("Unknown option '{}'. Usage: --stress [--sprites MIN:MAX] [--frames N] [--out FILE]", arg);
+                ok = false;
+                return std::nullopt;
+            }
+            if (i + 1 >= argc)
+            {
+                spdlog::error("Missing value for '{}'.", arg);
+                ok = false;
+                return std::nullopt;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--sprites")
+            {
+                const auto colon = value.find(':');
+                config.minSprites = std::atoi(value.substr(0, colon).c_str());
+                config.maxSprites = colon == std::string::npos ? config.minSprites : std::atoi(value.substr(colon + 1).c_str());
+            }
+            else if (arg == "--frames")
+            {
+                config.frames = std::atoi(value.c_str());
+            }
+            else
+            {
+                config.outputPath = value;
+            }
+        }
+
+        if (!enabled) return std::nullopt;
+        if (config.minSprites <= 0 || config.maxSprites < config.minSprites || config.frames <= 0 || config.outputPath.empty())
+        {
+            spdlog::error("Invalid stress options: sprites {}:{}, {} frames, output '{}'.", config.minSprites, config.maxSprites, config.frames, config.outputPath);
+            ok = false;
+            return std::nullopt;
+        }
+        return config;
+    }
+
+    StressTest::StressTest(const StressTestConfig& config, engine::resource::ResourceManager& resource_manager, const glm::vec2& viewport_size)
+        : config_(config),
+          resourceManager_(resource_manager),
+          background_("assets/textures/Layers/back.png"),
+          middleground_("assets/textures/Layers/middle.png"),
+          areaMin_(-AREA_MARGIN, -AREA_MARGIN),
+          areaMax_(viewport_size.x + AREA_MARGIN, viewport_size.y + AREA_MARGIN),
+          steps_(sweepSteps(config.minSprites, config.maxSprites)),
+          csv_(config.outputPath, std::ios::trunc)
+    {
+        if (!csv_)
+        {
+            throw std::runtime_error("Unable to create stress test output '" + config.outputPath + "'.");
+        }
+        csv_ << "sprites,frames,fps,frame_mean_ms,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms,update_ms,draw_ms,present_ms,draw_us_per_sprite,"
+                "texture_lookups_per_frame,texture_misses\n";
+
+        for (const ActorSheet& sheet : ACTOR_SHEETS)
+        {
+            for (int frame = 0; frame < sheet.frames; ++frame)
+            {
+                sprites_.emplace_back(sheet.path, SDL_FRect{static_cast<float>(frame) * sheet.frameWidth, 0.0f, sheet.frameWidth, sheet.frameHeight});
+            }
+            // Loaded up front so the first step does not time the decode
+            resourceManager_.getTexture(sheet.path);
+        }
+        resourceManager_.getTexture(background_.getTextureId());
+        resourceManager_.getTexture(middleground_.getTextureId());
+
+        entities_.reserve(static_cast<std::size_t>(config_.maxSprites));
+        spdlog::info("Stress test: {} steps from {} to {} sprites, {} frames each, writing '{}'.", steps_.size(), steps_.front(), steps_.back(), config_.frames,
+                     config_.outputPath);
+        startStep();
+    }
+
+    void StressTest::beginFrame()
+    {
+        frameStartNs_ = SDL_GetTicksNS();
+        if (frame_ == config_.warmupFrames)
+        {
+            const auto stats = resourceManager_.getStats();
+            textureHits_ = stats.textures.hits;
+            textureMisses_ = stats.textures.misses;
+        }
+    }
+
+    void StressTest::update()
+    {
+        const Uint64 start = SDL_GetTicksNS();
+        for (StressSprite& entity : entities_)
+        {
+            entity.position += entity.velocity * FIXED_DELTA;
+            if (entity.position.x < areaMin_.x || entity.position.x > areaMax_.x) entity.velocity.x = -entity.velocity.x;
+            if (entity.position.y < areaMin_.y || entity.position.y > areaMax_.y) entity.velocity.y = -entity.velocity.y;
+        }
+        updateNs_ = SDL_GetTicksNS() - start;
+    }
+
+    void StressTest::render(engine::render::Renderer& renderer, const engine::render::Camera& camera)
+    {
+        const Uint64 start = SDL_GetTicksNS();
+        renderer.drawParallax(camera, background_, glm::vec2(0.0f, 0.0f), glm::vec2(0.2f, 0.2f), glm::bvec2(true, true));
+        renderer.drawParallax(camera, middleground_, glm::vec2(0.0f, 0.0f), glm::vec2(0.5f, 0.5f), glm::bvec2(true, false));
+        // Only needed until drawSprites() returns: frame scratch, released by present()
+        const auto draw_list = renderer.getFrameArena().createArray<engine::render::SpriteInstance>(entities_.size());
+        for (std::size_t i = 0; i < entities_.size(); ++i)
+        {
+            draw_list[i] = {&sprites_[entities_[i].sprite], entities_[i].position};
+        }
+        renderer.drawSprites(camera, draw_list);
+        renderEndNs_ = SDL_GetTicksNS();
+        drawNs_ = renderEndNs_ - start;
+    }
+
+    bool StressTest::endFrame()
+    {
+        const Uint64 now = SDL_GetTicksNS();
+        if (frame_ >= config_.warmupFrames)
+        {
+            frameMs_.push_back((now - frameStartNs_) / 1'000'000.0);
+            updateMs_ += updateNs_ / 1'000'000.0;
+            drawMs_ += drawNs_ / 1'000'000.0;
+            presentMs_ += (now - renderEndNs_) / 1'000'000.0;
+        }
+        if (++frame_ < config_.warmupFrames + config_.frames) return true;
+
+        finishStep();
+        const bool collapsed = percentile(frameMs_, 0.5) > STOP_FRAME_MS;
+        if (collapsed && step_ + 1 < steps_.size())
+        {
+            spdlog::warn("Stress test stopped at {} sprites: median frame above {} ms.", steps_[step_], STOP_FRAME_MS);
+        }
+        if (collapsed || ++step_ >= steps_.size())
+        {
+            spdlog::info("Stress test complete, results in '{}'.", config_.outputPath);
+            return false;
+        }
+        startStep();
+        return true;
+    }
+
+    void StressTest::startStep()
+    {
+        spawn(static_cast<std::size_t>(steps_[step_]) - entities_.size());
+        frame_ = 0;
+        frameMs_.clear();
+        frameMs_.reserve(static_cast<std::size_t>(config_.frames));
+        updateMs_ = 0.0;
+        drawMs_ = 0.0;
+        presentMs_ = 0.0;
+    }
+
+    void StressTest::finishStep()
+    {
+        std::sort(frameMs_.begin(), frameMs_.end());
+        const double frames = static_cast<double>(frameMs_.size());
+        double total_ms = 0.0;
+        for (const double ms : frameMs_)
+        {
+            total_ms += ms;
+        }
+        const double mean_ms = total_ms / frames;
+        const auto stats = resourceManager_.getStats();
+        const Uint64 lookups = (stats.textures.hits - textureHits_) + (stats.textures.misses - textureMisses_);
+        const int sprites = steps_[step_];
+
+        csv_ << fmt::format("{},{},{:.1f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.4f},{:.1f},{}\n", sprites, frameMs_.size(), 1000.0 / mean_ms, mean_ms,
+                            percentile(frameMs_, 0.5), percentile(frameMs_, 0.95), percentile(frameMs_, 0.99), frameMs_.back(), updateMs_ / frames, drawMs_ / frames,
+                            presentMs_ / frames, drawMs_ / frames * 1000.0 / sprites, static_cast<double>(lookups) / frames,
+                            stats.textures.misses - textureMisses_);
+        csv_.flush();
+
+        spdlog::info("  {:>7} sprites: {:>7.1f} fps, frame {:.2f} ms (p99 {:.2f}), update {:.2f}, draw {:.2f}, present {:.2f} ms", sprites, 1000.0 / mean_ms, mean_ms,
+                     percentile(frameMs_, 0.99), updateMs_ / frames, drawMs_ / frames, presentMs_ / frames);
+    }
+
+    void StressTest::spawn(std::size_t count)
+    {
+        std::uniform_real_distribution<float> x(areaMin_.x, areaMax_.x);
+        std::uniform_real_distribution<float> y(areaMin_.y, areaMax_.y);
+        std::uniform_real_distribution<float> angle(0.0f, 2.0f * std::numbers::pi_v<float>);
+        std::uniform_real_distribution<float> speed(30.0f, 120.0f);
+        std::uniform_int_distribution<std::size_t> sprite(0, sprites_.size() - 1);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float direction = angle(random_);
+            const float magnitude = speed(random_);
+            entities_.push_back({glm::vec2(x(random_), y(random_)), glm::vec2(std::cos(direction) * magnitude, std::sin(direction) * magnitude), sprite(random_)});
+        }
+    }
+}  // namespace engine::core
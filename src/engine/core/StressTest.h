@@ -0,0 +1,119 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <fstream>
+#include <glm/glm.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../render/Renderer.h"
+#include "../render/Sprite.h"
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::render
+{
+    class Camera;
+}  // namespace engine::render
+
+namespace engine::core
+{
+    /**
+     * @brief Settings of the sprite stress sweep, from the command line
+     */
+    struct StressTestConfig
+    {
+        int minSprites = 1000;                  ///< @brief First step of the sweep
+        int maxSprites = 100000;                ///< @brief Last step of the sweep
+        int warmupFrames = 30;                  ///< @brief Frames run but not recorded after each step's spawn
+        int frames = 300;                       ///< @brief Frames recorded per step
+        std::string outputPath = "stress.csv";  ///< @brief CSV curve, one row per step
+
+        /**
+         * @brief Read `--stress [--sprites MIN:MAX] [--frames N] [--out FILE]` from the command line. Only the arguments
+         * after --stress are checked; without it every argument is ignored.
+         * @return nullopt without --stress, or with ok set to false on an invalid option (which is logged)
+         */
+        static std::optional<StressTestConfig> fromArgs(int argc, char* argv[], bool& ok);
+    };
+
+    /**
+     * @brief Sprite stress scene: N moving sprites from the actor textures over two parallax layers.
+     *
+     * N grows along a 1-2-5 sweep from minSprites to maxSprites. Each step spawns the extra sprites, runs warmupFrames
+     * frames, then records frames frames: frame time percentiles, the update / draw / present split and the texture
+     * cache lookups. A CSV row is written after each step, so an interrupted sweep keeps the steps already done.
+     * Movement uses a fixed time step, so every machine draws the same frames.
+     * The sweep ends early once the median frame takes more than STOP_FRAME_MS; scaling has clearly broken down there.
+     */
+    class StressTest final
+    {
+      private:
+        static constexpr double STOP_FRAME_MS = 250.0;
+
+        struct StressSprite
+        {
+            glm::vec2 position;
+            glm::vec2 velocity;
+            std::size_t sprite;  ///< @brief Index into sprites_
+        };
+
+        const StressTestConfig config_;
+        engine::resource::ResourceManager& resourceManager_;
+        std::vector<engine::render::Sprite> sprites_;  ///< @brief One per actor frame, built once
+        engine::render::Sprite background_;
+        engine::render::Sprite middleground_;
+        glm::vec2 areaMin_;  ///< @brief Sprites bounce inside [areaMin_, areaMax_], the viewport plus a margin so some are culled
+        glm::vec2 areaMax_;
+        std::vector<StressSprite> entities_;
+        std::vector<int> steps_;
+        std::size_t step_ = 0;
+        std::mt19937 random_{1234};
+        std::ofstream csv_;
+
+        // --- Current step ---
+        int frame_ = 0;  ///< @brief Frame within the step, warm-up included
+        Uint64 frameStartNs_ = 0;
+        Uint64 updateNs_ = 0;  ///< @brief update() of this frame
+        Uint64 drawNs_ = 0;    ///< @brief render() of this frame
+        Uint64 renderEndNs_ = 0;
+        std::vector<double> frameMs_;
+        double updateMs_ = 0.0;
+        double drawMs_ = 0.0;
+        double presentMs_ = 0.0;
+        Uint64 textureHits_ = 0;    ///< @brief Texture cache hits when recording started
+        Uint64 textureMisses_ = 0;  ///< @brief Texture cache misses when recording started
+
+      public:
+        /**
+         * @throws std::runtime_error if the CSV file cannot be created
+         */
+        StressTest(const StressTestConfig& config, engine::resource::ResourceManager& resource_manager, const glm::vec2& viewport_size);
+
+        // Delete copy and move constructors and assignment operators
+        StressTest(const StressTest&) = delete;
+        StressTest& operator=(const StressTest&) = delete;
+        StressTest(StressTest&&) = delete;
+        StressTest& operator=(StressTest&&) = delete;
+
+        void beginFrame();                                                                      ///< @brief Start of the frame, before events
+        void update();                                                                          ///< @brief Move every sprite by one fixed step
+        void render(engine::render::Renderer& renderer, const engine::render::Camera& camera);  ///< @brief Draw the layers and sprites, before present
+
+        /**
+         * @brief End of the frame, after present
+         * @return false once the sweep is complete
+         */
+        bool endFrame();
+
+      private:
+        void startStep();
+        void finishStep();
+        void spawn(std::size_t count);
+    };
+}  // namespace engine::core
@@ -10,12 +10,14 @@ namespace engine::core
         // Initialize lastTick_ and frameStartTime_ to the current SDL tick to avoid large delta time on the first update
         lastTick_ = SDL_GetTicksNS();
         frameStartTime_ = lastTick_;
-        spdlog::trace("Time initialized. lastTick_: {}", lastTick_);
+        SPDLOG_TRACE("Time initialized. lastTick_: {}", lastTick_);
     }
 
     void Time::update()
     {
         frameStartTime_ = SDL_GetTicksNS();  // record the time enters the frame
+        sleepStartNs_ = 0;
+        sleepEndNs_ = 0;
 
         auto currentDeltaTime = static_cast<float>(frameStartTime_ - lastTick_) / 1'000'000'000.0;
 
@@ -79,7 +81,9 @@ namespace engine::core
         if (currentDeltaTime < targetFrameTime_)
         {
             auto timeToWait = static_cast<Uint64>((targetFrameTime_ - currentDeltaTime) * 1'000'000'000.0);
+            sleepStartNs_ = SDL_GetTicksNS();
             SDL_DelayNS(timeToWait);
+            sleepEndNs_ = SDL_GetTicksNS();
             deltaTime_ = static_cast<double>(SDL_GetTicksNS() - lastTick_) / 1'000'000'000.0f;
         }
     }
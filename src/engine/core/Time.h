@@ -21,6 +21,8 @@ namespace engine::core
         // Frame limiting
         int targetFPS_ = 0;             ///< @brief Target frames per second. 0 for unlimited.
         double targetFrameTime_ = 0.0;  ///< @brief Target duration of each frame in seconds.
+        Uint64 sleepStartNs_ = 0;       ///< @brief When the frame limiter started sleeping this frame, 0 if it did not sleep.
+        Uint64 sleepEndNs_ = 0;         ///< @brief When the frame limiter woke up this frame, 0 if it did not sleep.
 
        public:
         Time();
@@ -78,6 +80,12 @@ namespace engine::core
          */
         int getTargetFPS() const;
 
+        /**
+         * @brief The frame limiter sleep of the current frame, in SDL_GetTicksNS() time. Both are 0 if it did not sleep.
+         */
+        Uint64 getSleepStartNS() const { return sleepStartNs_; }
+        Uint64 getSleepEndNS() const { return sleepEndNs_; }
+
        private:
         /**
          * @brief Used in update() to limit the frame rate to the target FPS.
@@ -0,0 +1,112 @@
+#include "Archetype.h"
+
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace engine::ecs
+{
+    namespace
+    {
+        std::size_t alignUp(std::size_t value, std::size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+    }  // namespace
+
+    Archetype::Archetype(ComponentMask mask) : mask_(mask)
+    {
+        columnOf_.fill(NO_COLUMN);
+        std::size_t row_bytes = sizeof(Entity);
+        for (std::size_t id = 0; id < MAX_COMPONENTS; ++id)
+        {
+            if (!((mask >> id) & 1u)) continue;
+            columnOf_[id] = static_cast<Uint8>(components_.size());
+            components_.push_back(static_cast<ComponentId>(id));
+            infos_.push_back(&getComponentInfo(static_cast<ComponentId>(id)));
+            row_bytes += infos_.back()->size;
+        }
+
+        // Start from the unpadded estimate and shrink until the aligned columns fit
+        columnOffsets_.resize(components_.size());
+        for (std::size_t capacity = CHUNK_BYTES / row_bytes; capacity > 0; --capacity)
+        {
+            std::size_t offset = capacity * sizeof(Entity);
+            for (std::size_t column = 0; column < infos_.size(); ++column)
+            {
+                offset = alignUp(offset, infos_[column]->alignment);
+                columnOffsets_[column] = static_cast<Uint32>(offset);
+                offset += capacity * infos_[column]->size;
+            }
+            if (offset <= CHUNK_BYTES)
+            {
+                chunkCapacity_ = static_cast<Uint32>(capacity);
+                break;
+            }
+        }
+        if (chunkCapacity_ == 0)
+        {
+            throw std::runtime_error("Archetype construction failed: one row of its components is larger than a chunk.");
+        }
+        SPDLOG_TRACE("Archetype {:#x} created: {} components, {} rows per chunk.", mask_, components_.size(), chunkCapacity_);
+    }
+
+    Archetype::~Archetype()
+    {
+        for (std::size_t chunk = 0; chunk < usedChunks_; ++chunk)
+        {
+            for (Uint32 index = 0; index < chunks_[chunk].count; ++index)
+            {
+                for (const ComponentId id : components_)
+                {
+                    if (const auto destroy = infos_[columnOf_[id]]->destroy) destroy(getComponent({static_cast<Uint32>(chunk), index}, id));
+                }
+            }
+        }
+    }
+
+    Archetype::Row Archetype::allocateRow(Entity entity)
+    {
+        if (usedChunks_ == 0 || chunks_[usedChunks_ - 1].count == chunkCapacity_)
+        {
+            if (usedChunks_ == chunks_.size())
+            {
+                // Default-initialised: the bytes are written by the rows themselves
+                chunks_.push_back(Chunk{std::unique_ptr<ChunkStorage>(new ChunkStorage), 0});
+            }
+            ++usedChunks_;
+        }
+
+        const auto chunk = static_cast<Uint32>(usedChunks_ - 1);
+        const Row row{chunk, chunks_[chunk].count++};
+        getEntities(chunk)[row.index] = entity;
+        ++size_;
+        return row;
+    }
+
+    Entity Archetype::eraseRow(Row row)
+    {
+        const auto last_chunk = static_cast<Uint32>(usedChunks_ - 1);
+        const Row last{last_chunk, chunks_[last_chunk].count - 1};
+
+        Entity moved = NULL_ENTITY;
+        if (row.chunk != last.chunk || row.index != last.index)
+        {
+            for (const ComponentId id : components_)
+            {
+                infos_[columnOf_[id]]->relocate(getComponent(row, id), getComponent(last, id));
+            }
+            moved = getEntities(last.chunk)[last.index];
+            getEntities(row.chunk)[row.index] = moved;
+        }
+
+        if (--chunks_[last_chunk].count == 0) --usedChunks_;
+        --size_;
+        return moved;
+    }
+
+    Entity Archetype::destroyRow(Row row)
+    {
+        for (const ComponentId id : components_)
+        {
+            if (const auto destroy = infos_[columnOf_[id]]->destroy) destroy(getComponent(row, id));
+        }
+        return eraseRow(row);
+    }
+}  // namespace engine::ecs
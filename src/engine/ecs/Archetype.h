@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+namespace engine::ecs
+{
+    constexpr std::size_t CHUNK_BYTES = 16 * 1024;  ///< @brief Size of one archetype chunk
+
+    /**
+     * @brief Storage of every entity that has exactly one set of components.
+     *
+     * Rows live in fixed-size chunks; inside a chunk each component is one contiguous column (structure of arrays),
+     * preceded by the column of entity handles. Rows stay packed: removing one moves the archetype's last row into
+     * the hole, so every chunk but the last is full. Chunks emptied this way keep their storage for later rows.
+     */
+    class Archetype final
+    {
+      public:
+        /**
+         * @brief Location of a row
+         */
+        struct Row
+        {
+            Uint32 chunk = 0;
+            Uint32 index = 0;
+        };
+
+      private:
+        static constexpr Uint8 NO_COLUMN = 0xFF;
+
+        struct alignas(MAX_COMPONENT_ALIGNMENT) ChunkStorage
+        {
+            std::byte bytes[CHUNK_BYTES];
+        };
+
+        struct Chunk
+        {
+            std::unique_ptr<ChunkStorage> storage;
+            Uint32 count = 0;  ///< @brief Rows in use
+        };
+
+        ComponentMask mask_;                                    ///< @brief Components of the archetype
+        std::vector<ComponentId> components_;                   ///< @brief Same set, ascending
+        std::vector<const ComponentInfo*> infos_;               ///< @brief Per column
+        std::vector<Uint32> columnOffsets_;                     ///< @brief Byte offset of each column inside a chunk
+        std::array<Uint8, MAX_COMPONENTS> columnOf_;            ///< @brief ComponentId -> column, NO_COLUMN if absent
+        Uint32 chunkCapacity_ = 0;                              ///< @brief Rows per chunk
+        std::vector<Chunk> chunks_;                             ///< @brief Allocated chunks; the first usedChunks_ hold rows
+        std::size_t usedChunks_ = 0;                            ///< @brief Chunks with at least one row
+        std::size_t size_ = 0;                                  ///< @brief Rows in the archetype
+        std::array<Archetype*, MAX_COMPONENTS> addEdges_{};     ///< @brief Archetype reached by adding a component, filled lazily
+        std::array<Archetype*, MAX_COMPONENTS> removeEdges_{};  ///< @brief Archetype reached by removing a component, filled lazily
+
+      public:
+        /**
+         * @throws std::runtime_error if a single row of these components does not fit in a chunk
+         */
+        explicit Archetype(ComponentMask mask);
+        ~Archetype();
+
+        // Delete copy and move constructors and assignment operators
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+        Archetype(Archetype&&) = delete;
+        Archetype& operator=(Archetype&&) = delete;
+
+        ComponentMask getMask() const { return mask_; }
+        std::span<const ComponentId> getComponents() const { return components_; }
+        bool has(ComponentId id) const { return (mask_ >> id) & 1u; }
+
+        std::size_t getSize() const { return size_; }
+        std::size_t getChunkCount() const { return usedChunks_; }
+        Uint32 getChunkCapacity() const { return chunkCapacity_; }
+        Uint32 getChunkSize(std::size_t chunk) const { return chunks_[chunk].count; }
+
+        Entity* getEntities(std::size_t chunk) { return reinterpret_cast<Entity*>(chunks_[chunk].storage->bytes); }
+
+        /**
+         * @brief Start of a component column in a chunk, nullptr if the archetype does not have the component
+         */
+        void* getColumn(std::size_t chunk, ComponentId id)
+        {
+            const Uint8 column = columnOf_[id];
+            return column == NO_COLUMN ? nullptr : chunks_[chunk].storage->bytes + columnOffsets_[column];
+        }
+
+        void* getComponent(Row row, ComponentId id)
+        {
+            const Uint8 column = columnOf_[id];
+            return chunks_[row.chunk].storage->bytes + columnOffsets_[column] + static_cast<std::size_t>(row.index) * infos_[column]->size;
+        }
+
+        /**
+         * @brief Append a row for an entity. Its components are left uninitialised for the caller to construct.
+         */
+        Row allocateRow(Entity entity);
+
+        /**
+         * @brief Remove a row whose components were already moved out or destroyed, refilling it with the last row
+         * @return the entity moved into the row, or NULL_ENTITY if the removed row was the last one
+         */
+        Entity eraseRow(Row row);
+
+        /**
+         * @brief Destroy the components of a row, then erase it
+         * @return see eraseRow()
+         */
+        Entity destroyRow(Row row);
+
+        Archetype* getAddEdge(ComponentId id) const { return addEdges_[id]; }
+        Archetype* getRemoveEdge(ComponentId id) const { return removeEdges_[id]; }
+        void setAddEdge(ComponentId id, Archetype* archetype) { addEdges_[id] = archetype; }
+        void setRemoveEdge(ComponentId id, Archetype* archetype) { removeEdges_[id] = archetype; }
+    };
+}  // namespace engine::ecs
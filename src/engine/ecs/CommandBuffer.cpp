@@ -0,0 +1,108 @@
+#include "CommandBuffer.h"
+
+#include <spdlog/spdlog.h>
+
+#include "World.h"
+
+namespace engine::ecs
+{
+    CommandBuffer::~CommandBuffer()
+    {
+        clear();
+    }
+
+    Entity CommandBuffer::create()
+    {
+        const Entity placeholder{pendingCount_++, PENDING_ENTITY_GENERATION};
+        commands_.push_back(Command{CommandType::Create, 0, placeholder, nullptr});
+        return placeholder;
+    }
+
+    void CommandBuffer::destroy(Entity entity)
+    {
+        commands_.push_back(Command{CommandType::Destroy, 0, entity, nullptr});
+    }
+
+    void CommandBuffer::flush(World& world)
+    {
+        if (world.isIterating())
+        {
+            spdlog::error("CommandBuffer: flush() called while a query is iterating, commands kept for later.");
+            return;
+        }
+
+        createdEntities_.clear();
+        for (Command& command : commands_)
+        {
+            const Entity entity = resolve(command.entity);
+            switch (command.type)
+            {
+                case CommandType::Create:
+                    createdEntities_.push_back(world.create());
+                    break;
+                case CommandType::Destroy:
+                    world.destroy(entity);
+                    break;
+                case CommandType::Add:
+                {
+                    const ComponentInfo& info = getComponentInfo(command.component);
+                    if (void* storage = world.emplaceComponent(entity, command.component))
+                    {
+                        info.relocate(storage, command.value);
+                    }
+                    else if (info.destroy)
+                    {
+                        info.destroy(command.value);
+                    }
+                    command.value = nullptr;
+                    break;
+                }
+                case CommandType::Remove:
+                    world.removeComponent(entity, command.component);
+                    break;
+            }
+        }
+
+        commands_.clear();
+        blockIndex_ = 0;
+        blockOffset_ = 0;
+        pendingCount_ = 0;
+    }
+
+    void CommandBuffer::clear()
+    {
+        for (const Command& command : commands_)
+        {
+            if (command.type != CommandType::Add || !command.value) continue;
+            if (const auto destroy = getComponentInfo(command.component).destroy) destroy(command.value);
+        }
+        commands_.clear();
+        blockIndex_ = 0;
+        blockOffset_ = 0;
+        pendingCount_ = 0;
+    }
+
+    void* CommandBuffer::allocateValue(std::size_t size, std::size_t alignment)
+    {
+        std::size_t offset = (blockOffset_ + alignment - 1) / alignment * alignment;
+        if (blockIndex_ < blocks_.size() && offset + size > BLOCK_BYTES)
+        {
+            ++blockIndex_;
+            offset = 0;
+        }
+        if (blockIndex_ == blocks_.size())
+        {
+            blocks_.push_back(std::unique_ptr<Block>(new Block));
+            offset = 0;
+        }
+
+        blockOffset_ = offset + size;
+        return blocks_[blockIndex_]->bytes + offset;
+    }
+
+    Entity CommandBuffer::resolve(Entity entity) const
+    {
+        if (entity.generation != PENDING_ENTITY_GENERATION) return entity;
+        return entity.index < createdEntities_.size() ? createdEntities_[entity.index] : NULL_ENTITY;
+    }
+}  // namespace engine::ecs
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+namespace engine::ecs
+{
+    class World;
+
+    /**
+     * @brief Records structural changes (create / destroy / add / remove) to apply to a World later, in recording order.
+     *
+     * Systems record into a buffer while a query iterates and the owner flushes it once iteration is over. A buffer is
+     * not thread-safe: give each worker its own and flush them one after the other on the world's thread.
+     * Component values are moved into fixed-size blocks that are reused after flush(), so a steady-state frame does not allocate.
+     */
+    class CommandBuffer final
+    {
+      private:
+        static constexpr std::size_t BLOCK_BYTES = 16 * 1024;
+
+        enum class CommandType : Uint8
+        {
+            Create,
+            Destroy,
+            Add,
+            Remove,
+        };
+
+        struct Command
+        {
+            CommandType type;
+            ComponentId component;
+            Entity entity;
+            void* value;  ///< @brief Component value of an Add, inside blocks_
+        };
+
+        struct alignas(MAX_COMPONENT_ALIGNMENT) Block
+        {
+            std::byte bytes[BLOCK_BYTES];
+        };
+
+        std::vector<Command> commands_;
+        std::vector<std::unique_ptr<Block>> blocks_;  ///< @brief Value storage, kept across flushes
+        std::size_t blockIndex_ = 0;                  ///< @brief Block being filled
+        std::size_t blockOffset_ = 0;                 ///< @brief First free byte in that block
+        Uint32 pendingCount_ = 0;                     ///< @brief Entities created by this buffer since the last flush
+        std::vector<Entity> createdEntities_;         ///< @brief Pending index -> real entity, filled during flush()
+
+      public:
+        CommandBuffer() = default;
+        ~CommandBuffer();
+
+        // Delete copy and move constructors and assignment operators
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+        CommandBuffer(CommandBuffer&&) = delete;
+        CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+        /**
+         * @brief Record the creation of an entity
+         * @return a placeholder usable with this buffer's add / remove / destroy until flush()
+         */
+        Entity create();
+
+        void destroy(Entity entity);
+
+        template <typename T>
+        void add(Entity entity, T&& component)
+        {
+            using Component = std::remove_cvref_t<T>;
+            static_assert(sizeof(Component) <= BLOCK_BYTES, "Component too large for a command buffer block");
+
+            void* value = allocateValue(sizeof(Component), alignof(Component));
+            ::new (value) Component(std::forward<T>(component));
+            commands_.push_back(Command{CommandType::Add, componentId<Component>(), entity, value});
+        }
+
+        template <typename T>
+        void remove(Entity entity)
+        {
+            commands_.push_back(Command{CommandType::Remove, componentId<T>(), entity, nullptr});
+        }
+
+        /**
+         * @brief Apply every command to the world, then clear the buffer. Commands on dead entities are skipped.
+         */
+        void flush(World& world);
+
+        /**
+         * @brief Drop every command without applying it
+         */
+        void clear();
+
+        bool isEmpty() const { return commands_.empty(); }
+        std::size_t getCommandCount() const { return commands_.size(); }
+
+      private:
+        void* allocateValue(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Real entity of a placeholder from create(), other entities unchanged
+         */
+        Entity resolve(Entity entity) const;
+    };
+}  // namespace engine::ecs
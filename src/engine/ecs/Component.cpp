@@ -0,0 +1,36 @@
+#include "Component.h"
+
+#include <array>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+
+namespace engine::ecs
+{
+    namespace
+    {
+        // Slots are written once, before their id is handed out, and never move: reads need no lock
+        std::array<ComponentInfo, MAX_COMPONENTS> component_infos;
+        std::size_t component_count = 0;
+        std::mutex registry_mutex;
+    }  // namespace
+
+    ComponentId registerComponent(const ComponentInfo& info)
+    {
+        std::lock_guard lock(registry_mutex);
+        if (component_count == MAX_COMPONENTS)
+        {
+            throw std::runtime_error("Too many ECS component types, cannot register " + std::string(info.name));
+        }
+
+        component_infos[component_count] = info;
+        SPDLOG_DEBUG("ECS component {} registered: '{}', {} bytes.", component_count, info.name, info.size);
+        return static_cast<ComponentId>(component_count++);
+    }
+
+    const ComponentInfo& getComponentInfo(ComponentId id)
+    {
+        return component_infos[id];
+    }
+}  // namespace engine::ecs
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace engine::ecs
+{
+    using ComponentId = Uint8;
+    using ComponentMask = Uint64;  ///< @brief One bit per ComponentId
+
+    constexpr std::size_t MAX_COMPONENTS = 64;  ///< @brief Component types per process, bounded by ComponentMask
+    constexpr std::size_t MAX_COMPONENT_ALIGNMENT = 64;
+
+    /**
+     * @brief Type-erased description of a component type, enough for archetype storage to move and destroy values
+     */
+    struct ComponentInfo
+    {
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        void (*relocate)(void* destination, void* source) = nullptr;  ///< @brief Move-construct at destination, then destroy source
+        void (*destroy)(void* value) = nullptr;                       ///< @brief nullptr for trivially destructible types
+        const char* name = "";
+    };
+
+    /**
+     * @brief Register a component type. Called once per type through componentId<T>().
+     * @throws std::runtime_error when more than MAX_COMPONENTS types are registered
+     */
+    ComponentId registerComponent(const ComponentInfo& info);
+
+    const ComponentInfo& getComponentInfo(ComponentId id);
+
+    namespace detail
+    {
+        template <typename T>
+        ComponentInfo makeComponentInfo()
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T>, "Components are moved between chunks and must be nothrow move constructible");
+            static_assert(alignof(T) <= MAX_COMPONENT_ALIGNMENT, "Component alignment exceeds the chunk alignment");
+
+            ComponentInfo info;
+            info.size = sizeof(T);
+            info.alignment = alignof(T);
+            info.relocate = [](void* destination, void* source) {
+                T* value = static_cast<T*>(source);
+                ::new (destination) T(std::move(*value));
+                value->~T();
+            };
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                info.destroy = [](void* value) { static_cast<T*>(value)->~T(); };
+            }
+            info.name = typeid(T).name();
+            return info;
+        }
+
+        template <typename T>
+        ComponentId componentIdOf()
+        {
+            static const ComponentId id = registerComponent(makeComponentInfo<T>());
+            return id;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Id of a component type, assigned on first use. const / reference qualifiers are ignored.
+     */
+    template <typename T>
+    ComponentId componentId()
+    {
+        return detail::componentIdOf<std::remove_cvref_t<T>>();
+    }
+
+    template <typename... Ts>
+    ComponentMask componentMask()
+    {
+        return (ComponentMask{0} | ... | (ComponentMask{1} << componentId<Ts>()));
+    }
+}  // namespace engine::ecs
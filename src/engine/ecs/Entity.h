@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::ecs
+{
+    /**
+     * @brief Handle of an entity: a slot index plus the slot's generation, so handles to destroyed entities go stale
+     */
+    struct Entity
+    {
+        Uint32 index = ~Uint32{0};  ///< @brief Slot in the world's entity table
+        Uint32 generation = 0;      ///< @brief Bumped every time the slot is freed
+
+        bool isNull() const { return index == ~Uint32{0}; }
+        bool operator==(const Entity&) const = default;
+    };
+
+    constexpr Entity NULL_ENTITY{};
+
+    /// @brief Generation never used by World; marks entities created by a CommandBuffer that has not been flushed yet
+    constexpr Uint32 PENDING_ENTITY_GENERATION = ~Uint32{0};
+}  // namespace engine::ecs
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Archetype.h"
+
+namespace engine::ecs
+{
+    /**
+     * @brief Archetypes matching one (include, exclude) pair, kept by the World and extended as new archetypes appear
+     */
+    struct QueryCache
+    {
+        ComponentMask include = 0;
+        ComponentMask exclude = 0;
+        std::vector<Archetype*> archetypes;                               ///< @brief Matches, in creation order
+        const std::vector<std::unique_ptr<Archetype>>* source = nullptr;  ///< @brief Every archetype of the world
+        std::size_t seen = 0;                                             ///< @brief Prefix of *source already tested
+        int* iterationDepth = nullptr;                                    ///< @brief World counter that blocks structural changes
+
+        /**
+         * @brief Test the archetypes created since the last call; existing matches never change
+         */
+        void refresh()
+        {
+            for (; seen < source->size(); ++seen)
+            {
+                Archetype* archetype = (*source)[seen].get();
+                if ((archetype->getMask() & include) == include && (archetype->getMask() & exclude) == 0) archetypes.push_back(archetype);
+            }
+        }
+    };
+
+    /**
+     * @brief Columns of one chunk for a query: the same row index addresses the entity and each of its components
+     */
+    template <typename... Ts>
+    struct QueryChunk
+    {
+        const Entity* entities = nullptr;
+        std::tuple<Ts*...> columns{};
+        Uint32 count = 0;
+
+        std::span<const Entity> getEntities() const { return {entities, count}; }
+
+        template <typename T>
+        std::span<T> get() const
+        {
+            return {std::get<T*>(columns), count};
+        }
+    };
+
+    /**
+     * @brief Iterates the entities having all of Ts (and none of the excluded components), chunk by chunk.
+     *
+     * Components are accessed in place through references into the chunk columns; declare read-only components as
+     * `const T`. Obtained from World::query(). The matching archetypes are cached by the world, so creating a query
+     * every frame is cheap. Structural changes (create / destroy / add / remove) are refused while each() or
+     * forEachChunk() runs; record them in a CommandBuffer instead.
+     */
+    template <typename... Ts>
+    class Query final
+    {
+      private:
+        QueryCache* cache_;
+        std::array<ComponentId, sizeof...(Ts)> ids_;
+
+        /**
+         * @brief Marks the world as iterating for the lifetime of the scope
+         */
+        struct IterationScope
+        {
+            int* depth;
+            explicit IterationScope(int* iteration_depth) : depth(iteration_depth) { ++*depth; }
+            ~IterationScope() { --*depth; }
+        };
+
+      public:
+        explicit Query(QueryCache* cache) : cache_(cache), ids_{componentId<Ts>()...} {}
+
+        /**
+         * @brief Call fn(Ts&...) or fn(Entity, Ts&...) for every matching entity
+         */
+        template <typename Fn>
+        void each(Fn&& fn)
+        {
+            forEachChunk([&fn](const QueryChunk<Ts...>& chunk) {
+                for (Uint32 row = 0; row < chunk.count; ++row)
+                {
+                    if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>)
+                    {
+                        fn(chunk.entities[row], std::get<Ts*>(chunk.columns)[row]...);
+                    }
+                    else
+                    {
+                        fn(std::get<Ts*>(chunk.columns)[row]...);
+                    }
+                }
+            });
+        }
+
+        /**
+         * @brief Call fn(const QueryChunk<Ts...>&) for every non-empty matching chunk, for loops over whole columns
+         */
+        template <typename Fn>
+        void forEachChunk(Fn&& fn)
+        {
+            cache_->refresh();
+            IterationScope scope(cache_->iterationDepth);
+            for (Archetype* archetype : cache_->archetypes)
+            {
+                for (std::size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk)
+                {
+                    fn(makeChunk(*archetype, chunk));
+                }
+            }
+        }
+
+        /**
+         * @brief Append every non-empty matching chunk to out, e.g. to split them between worker threads.
+         *
+         * The views stay valid until the next structural change; the world must not be modified until the workers finish.
+         */
+        void collectChunks(std::vector<QueryChunk<Ts...>>& out)
+        {
+            cache_->refresh();
+            for (Archetype* archetype : cache_->archetypes)
+            {
+                for (std::size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk)
+                {
+                    out.push_back(makeChunk(*archetype, chunk));
+                }
+            }
+        }
+
+        /**
+         * @brief Number of matching entities
+         */
+        std::size_t count()
+        {
+            cache_->refresh();
+            std::size_t total = 0;
+            for (const Archetype* archetype : cache_->archetypes) total += archetype->getSize();
+            return total;
+        }
+
+      private:
+        QueryChunk<Ts...> makeChunk(Archetype& archetype, std::size_t chunk) const
+        {
+            QueryChunk<Ts...> view;
+            view.entities = archetype.getEntities(chunk);
+            view.count = archetype.getChunkSize(chunk);
+            std::size_t column = 0;
+            ((std::get<Ts*>(view.columns) = static_cast<Ts*>(archetype.getColumn(chunk, ids_[column++]))), ...);
+            return view;
+        }
+    };
+}  // namespace engine::ecs
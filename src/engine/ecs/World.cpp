@@ -0,0 +1,157 @@
+#include "World.h"
+
+namespace engine::ecs
+{
+    World::World()
+    {
+        emptyArchetype_ = findOrCreateArchetype(0);
+    }
+
+    World::~World() = default;
+
+    Entity World::create()
+    {
+        if (!checkMutable("create()")) return NULL_ENTITY;
+        return allocateEntity(emptyArchetype_);
+    }
+
+    bool World::destroy(Entity entity)
+    {
+        if (!isAlive(entity) || !checkMutable("destroy()")) return false;
+
+        EntityRecord& record = records_[entity.index];
+        patchMovedEntity(record.archetype->destroyRow(record.row), record.row);
+        record.archetype = nullptr;
+        if (++record.generation == PENDING_ENTITY_GENERATION) record.generation = 0;
+        freeIndices_.push_back(entity.index);
+        --entityCount_;
+        return true;
+    }
+
+    void* World::emplaceComponent(Entity entity, ComponentId id)
+    {
+        if (!isAlive(entity) || !checkMutable("add()")) return nullptr;
+
+        EntityRecord& record = records_[entity.index];
+        if (record.archetype->has(id))
+        {
+            void* storage = record.archetype->getComponent(record.row, id);
+            if (const auto destroy = getComponentInfo(id).destroy) destroy(storage);
+            return storage;
+        }
+
+        Archetype* target = record.archetype->getAddEdge(id);
+        if (!target)
+        {
+            target = findOrCreateArchetype(record.archetype->getMask() | (ComponentMask{1} << id));
+            record.archetype->setAddEdge(id, target);
+            target->setRemoveEdge(id, record.archetype);
+        }
+        moveEntity(entity, target);
+        return target->getComponent(record.row, id);
+    }
+
+    bool World::removeComponent(Entity entity, ComponentId id)
+    {
+        if (!hasComponent(entity, id) || !checkMutable("remove()")) return false;
+
+        EntityRecord& record = records_[entity.index];
+        Archetype* target = record.archetype->getRemoveEdge(id);
+        if (!target)
+        {
+            target = findOrCreateArchetype(record.archetype->getMask() & ~(ComponentMask{1} << id));
+            record.archetype->setRemoveEdge(id, target);
+            target->setAddEdge(id, record.archetype);
+        }
+        moveEntity(entity, target);
+        return true;
+    }
+
+    bool World::hasComponent(Entity entity, ComponentId id) const
+    {
+        return isAlive(entity) && records_[entity.index].archetype->has(id);
+    }
+
+    void* World::getComponent(Entity entity, ComponentId id)
+    {
+        if (!hasComponent(entity, id)) return nullptr;
+        const EntityRecord& record = records_[entity.index];
+        return record.archetype->getComponent(record.row, id);
+    }
+
+    Archetype* World::findOrCreateArchetype(ComponentMask mask)
+    {
+        if (auto it = archetypeByMask_.find(mask); it != archetypeByMask_.end()) return it->second;
+
+        // Query caches pick the new archetype up on their next refresh()
+        archetypes_.push_back(std::make_unique<Archetype>(mask));
+        Archetype* archetype = archetypes_.back().get();
+        archetypeByMask_.emplace(mask, archetype);
+        return archetype;
+    }
+
+    QueryCache& World::getQueryCache(ComponentMask include, ComponentMask exclude)
+    {
+        // Systems use a handful of distinct queries, a linear scan beats hashing here
+        for (const auto& cache : queryCaches_)
+        {
+            if (cache->include == include && cache->exclude == exclude) return *cache;
+        }
+
+        auto cache = std::make_unique<QueryCache>();
+        cache->include = include;
+        cache->exclude = exclude;
+        cache->source = &archetypes_;
+        cache->iterationDepth = &iterationDepth_;
+        queryCaches_.push_back(std::move(cache));
+        return *queryCaches_.back();
+    }
+
+    Entity World::allocateEntity(Archetype* archetype)
+    {
+        Uint32 index;
+        if (!freeIndices_.empty())
+        {
+            index = freeIndices_.back();
+            freeIndices_.pop_back();
+        }
+        else
+        {
+            index = static_cast<Uint32>(records_.size());
+            records_.emplace_back();
+        }
+
+        EntityRecord& record = records_[index];
+        const Entity entity{index, record.generation};
+        record.archetype = archetype;
+        record.row = archetype->allocateRow(entity);
+        ++entityCount_;
+        return entity;
+    }
+
+    void World::moveEntity(Entity entity, Archetype* target)
+    {
+        EntityRecord& record = records_[entity.index];
+        Archetype* source = record.archetype;
+        const Archetype::Row old_row = record.row;
+        const Archetype::Row new_row = target->allocateRow(entity);
+
+        for (const ComponentId id : source->getComponents())
+        {
+            const ComponentInfo& info = getComponentInfo(id);
+            void* value = source->getComponent(old_row, id);
+            if (target->has(id))
+            {
+                info.relocate(target->getComponent(new_row, id), value);
+            }
+            else if (info.destroy)
+            {
+                info.destroy(value);
+            }
+        }
+        patchMovedEntity(source->eraseRow(old_row), old_row);
+
+        record.archetype = target;
+        record.row = new_row;
+    }
+}  // namespace engine::ecs
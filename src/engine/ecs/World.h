@@ -0,0 +1,175 @@
+#pragma once
+
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Archetype.h"
+#include "Query.h"
+
+namespace engine::ecs
+{
+    /**
+     * @brief Entity storage of the engine: an archetype ECS.
+     *
+     * Each entity lives in the archetype matching its exact component set; adding or removing a component moves the
+     * entity to the neighbouring archetype (the transition is cached on both archetypes). Systems iterate dense
+     * component columns through query(). Only the thread that owns the world may change it, and not while a query is
+     * iterating: structural changes made inside systems go through a CommandBuffer that is flushed afterwards.
+     * Components must be nothrow move constructible; they are moved whenever their entity changes archetype.
+     */
+    class World final
+    {
+      private:
+        struct EntityRecord
+        {
+            Archetype* archetype = nullptr;  ///< @brief nullptr while the slot is free
+            Archetype::Row row;
+            Uint32 generation = 0;
+        };
+
+        std::vector<EntityRecord> records_;                              ///< @brief Indexed by Entity::index
+        std::vector<Uint32> freeIndices_;                                ///< @brief Free slots in records_
+        std::vector<std::unique_ptr<Archetype>> archetypes_;             ///< @brief Every archetype, in creation order
+        std::unordered_map<ComponentMask, Archetype*> archetypeByMask_;  ///< @brief Archetype lookup by component set
+        std::vector<std::unique_ptr<QueryCache>> queryCaches_;           ///< @brief One per distinct (include, exclude) pair
+        Archetype* emptyArchetype_ = nullptr;                            ///< @brief Entities without components
+        std::size_t entityCount_ = 0;                                    ///< @brief Live entities
+        int iterationDepth_ = 0;                                         ///< @brief Queries currently iterating
+
+      public:
+        World();
+        ~World();
+
+        // Delete copy and move constructors and assignment operators
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+        World(World&&) = delete;
+        World& operator=(World&&) = delete;
+
+        /**
+         * @brief Create an entity without components
+         * @return NULL_ENTITY while a query is iterating
+         */
+        Entity create();
+
+        /**
+         * @brief Create an entity directly in the archetype of its components, without intermediate moves
+         */
+        template <typename... Ts>
+        Entity create(Ts&&... components)
+        {
+            if (!checkMutable("create()")) return NULL_ENTITY;
+
+            Archetype* archetype = findOrCreateArchetype(componentMask<Ts...>());
+            const Entity entity = allocateEntity(archetype);
+            const Archetype::Row row = records_[entity.index].row;
+            (::new (archetype->getComponent(row, componentId<Ts>())) std::remove_cvref_t<Ts>(std::forward<Ts>(components)), ...);
+            return entity;
+        }
+
+        /**
+         * @brief Destroy an entity and its components
+         * @return false if the entity was not alive or a query is iterating
+         */
+        bool destroy(Entity entity);
+
+        bool isAlive(Entity entity) const
+        {
+            return entity.index < records_.size() && records_[entity.index].generation == entity.generation && records_[entity.index].archetype != nullptr;
+        }
+
+        /**
+         * @brief Add a component, or replace it if the entity already has one
+         * @return the stored component, nullptr if the entity is not alive or a query is iterating
+         */
+        template <typename T>
+        std::remove_cvref_t<T>* add(Entity entity, T&& component)
+        {
+            using Component = std::remove_cvref_t<T>;
+            // component may live in the world: the replaced one is destroyed, a move to another archetype relocates the others
+            Component value(std::forward<T>(component));
+            void* storage = emplaceComponent(entity, componentId<Component>());
+            return storage ? ::new (storage) Component(std::move(value)) : nullptr;
+        }
+
+        /**
+         * @brief Remove a component
+         * @return false if the entity is not alive, does not have it, or a query is iterating
+         */
+        template <typename T>
+        bool remove(Entity entity)
+        {
+            return removeComponent(entity, componentId<T>());
+        }
+
+        template <typename T>
+        bool has(Entity entity) const
+        {
+            return hasComponent(entity, componentId<T>());
+        }
+
+        /**
+         * @brief Component of an entity, nullptr if it does not have one. Valid until the next structural change.
+         */
+        template <typename T>
+        T* get(Entity entity)
+        {
+            return static_cast<T*>(getComponent(entity, componentId<T>()));
+        }
+
+        /**
+         * @brief Entities having every component of Ts and none of exclude (see componentMask())
+         */
+        template <typename... Ts>
+        Query<Ts...> query(ComponentMask exclude = 0)
+        {
+            return Query<Ts...>(&getQueryCache(componentMask<Ts...>(), exclude));
+        }
+
+        std::size_t getEntityCount() const { return entityCount_; }
+        std::size_t getArchetypeCount() const { return archetypes_.size(); }
+        bool isIterating() const { return iterationDepth_ > 0; }
+
+        // --- Type-erased access, used by CommandBuffer ---
+
+        /**
+         * @brief Storage for a new component value: the caller constructs the value in place.
+         *
+         * A value the entity already had is destroyed first; otherwise the entity moves to the archetype with the component.
+         * @return nullptr if the entity is not alive or a query is iterating
+         */
+        void* emplaceComponent(Entity entity, ComponentId id);
+        bool removeComponent(Entity entity, ComponentId id);
+        bool hasComponent(Entity entity, ComponentId id) const;
+        void* getComponent(Entity entity, ComponentId id);
+
+      private:
+        Archetype* findOrCreateArchetype(ComponentMask mask);
+        QueryCache& getQueryCache(ComponentMask include, ComponentMask exclude);
+
+        Entity allocateEntity(Archetype* archetype);
+
+        /**
+         * @brief Move an entity to another archetype: shared components move, components the target lacks are destroyed
+         */
+        void moveEntity(Entity entity, Archetype* target);
+
+        /**
+         * @brief Update the record of the entity an archetype moved into a freed row
+         */
+        void patchMovedEntity(Entity moved, Archetype::Row row)
+        {
+            if (!moved.isNull()) records_[moved.index].row = row;
+        }
+
+        bool checkMutable(const char* operation) const
+        {
+            if (iterationDepth_ == 0) return true;
+            spdlog::error("World: {} refused while a query is iterating, record it in a CommandBuffer.", operation);
+            return false;
+        }
+    };
+}  // namespace engine::ecs
@@ -0,0 +1,159 @@
+#include "EventBus.h"
+
+#include <algorithm>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+
+#include "../core/Profiler.h"
+
+namespace engine::event
+{
+    namespace
+    {
+        constexpr Uint32 SERIAL_BITS = 24;
+        constexpr Uint32 SERIAL_MASK = (1u << SERIAL_BITS) - 1;
+
+        // Slots are written once, before their id is handed out, and never move: reads need no lock
+        std::array<const char*, MAX_EVENT_TYPES> event_type_names;
+        std::size_t event_type_count = 0;
+        std::mutex registry_mutex;
+    }  // namespace
+
+    EventTypeId registerEventType(const char* name)
+    {
+        std::lock_guard lock(registry_mutex);
+        if (event_type_count == MAX_EVENT_TYPES)
+        {
+            throw std::runtime_error("Too many event types, cannot register " + std::string(name));
+        }
+
+        event_type_names[event_type_count] = name;
+        SPDLOG_DEBUG("Event type {} registered: '{}'.", event_type_count, name);
+        return static_cast<EventTypeId>(event_type_count++);
+    }
+
+    const char* getEventTypeName(EventTypeId id)
+    {
+        return event_type_names[id];
+    }
+
+    EventBus::EventBus()
+    {
+        // At most one entry per type: listing a type never allocates
+        queuedTypes_.reserve(MAX_EVENT_TYPES);
+        dispatchTypes_.reserve(MAX_EVENT_TYPES);
+    }
+
+    EventBus::~EventBus() = default;
+
+    void EventBus::unsubscribe(SubscriptionId id)
+    {
+        ChannelBase* channel = id != INVALID_SUBSCRIPTION ? findChannel(static_cast<EventTypeId>(id >> SERIAL_BITS)) : nullptr;
+        const auto it = channel ? std::find_if(channel->subscribers.begin(), channel->subscribers.end(),
+                                               [id](const Subscriber& subscriber) { return subscriber.id == id && subscriber.call; })
+                                : std::vector<Subscriber>::iterator{};
+        if (!channel || it == channel->subscribers.end())
+        {
+            spdlog::warn("EventBus: unsubscribe() called with invalid subscription {}.", id);
+            return;
+        }
+
+        // The dispatch loop indexes the subscribers: only blank the entry while it runs
+        if (dispatching_)
+        {
+            it->call = nullptr;
+            channel->removed = true;
+        }
+        else
+        {
+            channel->subscribers.erase(it);
+        }
+    }
+
+    void EventBus::dispatch()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        if (dispatching_)
+        {
+            spdlog::warn("EventBus: dispatch() called from an event handler, ignored.");
+            return;
+        }
+        dispatching_ = true;
+        lastDispatched_ = 0;
+
+        // Swap every queue first: whatever the handlers publish waits for the next dispatch point
+        std::swap(queuedTypes_, dispatchTypes_);
+        for (const EventTypeId type : dispatchTypes_)
+        {
+            ChannelBase& channel = *channels_[type];
+            channel.queued = false;
+            channel.swapQueues();
+        }
+
+        for (const EventTypeId type : dispatchTypes_)
+        {
+            ChannelBase& channel = *channels_[type];
+            const void* events = channel.getReadData();
+            const std::size_t count = channel.getReadCount();
+            lastDispatched_ += count;
+
+            // Handlers may subscribe to this type: those added now wait for the next dispatch
+            const std::size_t subscriber_count = channel.subscribers.size();
+            for (std::size_t i = 0; i < subscriber_count; ++i)
+            {
+                const Subscriber subscriber = channel.subscribers[i];
+                if (subscriber.call) subscriber.call(subscriber.context, events, count);
+            }
+            if (channel.removed)
+            {
+                std::erase_if(channel.subscribers, [](const Subscriber& subscriber) { return !subscriber.call; });
+                channel.removed = false;
+            }
+        }
+
+        dispatchTypes_.clear();
+        dispatching_ = false;
+    }
+
+    void EventBus::clear()
+    {
+        for (const auto& channel : channels_)
+        {
+            if (channel) channel->clear();
+        }
+        for (const EventTypeId type : queuedTypes_)
+        {
+            channels_[type]->queued = false;
+        }
+        queuedTypes_.clear();
+    }
+
+    std::size_t EventBus::getPendingCount() const
+    {
+        std::size_t pending = 0;
+        for (const EventTypeId type : queuedTypes_)
+        {
+            pending += channels_[type]->getWriteCount();
+        }
+        return pending;
+    }
+
+    std::size_t EventBus::getStorageBytes() const
+    {
+        std::size_t bytes = 0;
+        for (const auto& channel : channels_)
+        {
+            if (channel) bytes += channel->getStorageBytes();
+        }
+        return bytes;
+    }
+
+    SubscriptionId EventBus::addSubscriber(ChannelBase& channel, EventTypeId type, void* context, Trampoline call)
+    {
+        const SubscriptionId id = (static_cast<SubscriptionId>(type) << SERIAL_BITS) | (nextSerial_++ & SERIAL_MASK);
+        channel.subscribers.push_back({id, context, call});
+        return id;
+    }
+}  // namespace engine::event
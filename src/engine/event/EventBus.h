@@ -0,0 +1,259 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace engine::event
+{
+    using EventTypeId = Uint8;
+    constexpr std::size_t MAX_EVENT_TYPES = 64;  ///< @brief Event types per process
+
+    using SubscriptionId = Uint32;  ///< @brief Event type in the top 8 bits, a serial number below
+    constexpr SubscriptionId INVALID_SUBSCRIPTION = ~SubscriptionId{0};
+
+    /**
+     * @brief Register an event type. Called once per type through eventTypeId<T>().
+     * @throws std::runtime_error when more than MAX_EVENT_TYPES types are registered
+     */
+    EventTypeId registerEventType(const char* name);
+
+    const char* getEventTypeName(EventTypeId id);
+
+    namespace detail
+    {
+        template <typename T>
+        EventTypeId eventTypeIdOf()
+        {
+            static const EventTypeId id = registerEventType(typeid(T).name());
+            return id;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Id of an event type, assigned on first use. const / reference qualifiers are ignored.
+     */
+    template <typename T>
+    EventTypeId eventTypeId()
+    {
+        return detail::eventTypeIdOf<std::remove_cvref_t<T>>();
+    }
+
+    /**
+     * @brief Typed, batched event queues for SDL and gameplay events (damage, pickups, level end, ...).
+     *
+     * Each event type has its own pair of queues: publish() appends a copy to the write queue, dispatch() swaps the
+     * pair and hands every subscriber the whole read queue of the type in one call. The queues keep their capacity
+     * across swaps, so after warm-up publishing is a copy into pooled storage and never touches the heap; per event,
+     * dispatch costs one call per subscriber, and a batch subscriber only one call per type.
+     *
+     * The game calls dispatch() at fixed points of the frame. Events published by a handler go to the write queue and
+     * are delivered at the next dispatch point, so a handler never sees its own events mid-dispatch and a chain of
+     * events cannot loop within one call. Types are dispatched in the order their first event since the last dispatch
+     * was published, events of one type in publish order, subscribers in subscription order.
+     *
+     * Events must be trivially copyable: they are copied in bulk and dropped without running destructors. Carry ids
+     * and values, not strings. Handlers are member functions or free functions bound at compile time, so subscribing
+     * does not allocate a closure either. Main thread only.
+     */
+    class EventBus final
+    {
+      private:
+        /**
+         * @brief Calls a handler with count events of the subscriber's type
+         */
+        using Trampoline = void (*)(void* context, const void* events, std::size_t count);
+
+        struct Subscriber
+        {
+            SubscriptionId id = INVALID_SUBSCRIPTION;
+            void* context = nullptr;
+            Trampoline call = nullptr;  ///< @brief nullptr once unsubscribed during a dispatch, erased right after it
+        };
+
+        struct ChannelBase
+        {
+            std::vector<Subscriber> subscribers;
+            bool queued = false;   ///< @brief Listed in queuedTypes_
+            bool removed = false;  ///< @brief A subscriber was unsubscribed during a dispatch
+
+            virtual ~ChannelBase() = default;
+            virtual void swapQueues() = 0;  ///< @brief Drop the read queue, make the write queue the read queue
+            virtual const void* getReadData() const = 0;
+            virtual std::size_t getReadCount() const = 0;
+            virtual std::size_t getWriteCount() const = 0;
+            virtual void clear() = 0;  ///< @brief Drop the write queue
+            virtual std::size_t getStorageBytes() const = 0;
+        };
+
+        template <typename T>
+        struct Channel final : ChannelBase
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Events are copied in bulk and dropped without destructors and must be trivially copyable");
+
+            std::vector<T> writing;
+            std::vector<T> reading;
+
+            void swapQueues() override
+            {
+                reading.clear();
+                std::swap(reading, writing);
+            }
+            const void* getReadData() const override { return reading.data(); }
+            std::size_t getReadCount() const override { return reading.size(); }
+            std::size_t getWriteCount() const override { return writing.size(); }
+            void clear() override { writing.clear(); }
+            std::size_t getStorageBytes() const override { return (reading.capacity() + writing.capacity()) * sizeof(T); }
+        };
+
+        std::array<std::unique_ptr<ChannelBase>, MAX_EVENT_TYPES> channels_;  ///< @brief Indexed by EventTypeId, created on first use
+        std::vector<EventTypeId> queuedTypes_;                                ///< @brief Types with events in their write queue
+        std::vector<EventTypeId> dispatchTypes_;                              ///< @brief Types being dispatched, swapped with queuedTypes_
+        Uint32 nextSerial_ = 0;
+        bool dispatching_ = false;
+        std::size_t lastDispatched_ = 0;  ///< @brief Events delivered by the last dispatch()
+
+      public:
+        EventBus();
+        ~EventBus();
+
+        // Delete copy and move constructors and assignment operators
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+        EventBus(EventBus&&) = delete;
+        EventBus& operator=(EventBus&&) = delete;
+
+        /**
+         * @brief Queue a copy of an event for the next dispatch()
+         */
+        template <typename T>
+        void publish(const T& event)
+        {
+            writeQueue<T>().push_back(event);
+        }
+
+        template <typename T>
+        void publish(std::span<const T> events)
+        {
+            auto& queue = writeQueue<T>();
+            queue.insert(queue.end(), events.begin(), events.end());
+        }
+
+        template <typename T, typename... Args>
+        void emplace(Args&&... args)
+        {
+            writeQueue<T>().emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Size both queues of a type for count events per dispatch, so the first frames do not grow them. Not from
+         * a handler.
+         */
+        template <typename T>
+        void reserve(std::size_t count)
+        {
+            Channel<T>& channel = getChannel<T>();
+            channel.writing.reserve(count);
+            channel.reading.reserve(count);
+        }
+
+        /**
+         * @brief Call (owner->*Method)(const T&) for every event of type T
+         * @return an id for unsubscribe(); owner must stay alive until then or until the bus is destroyed
+         */
+        template <typename T, auto Method, typename Owner>
+        SubscriptionId subscribe(Owner* owner)
+        {
+            return addSubscriber(getChannel<T>(), eventTypeId<T>(), owner, [](void* context, const void* events, std::size_t count) {
+                Owner* target = static_cast<Owner*>(context);
+                const T* first = static_cast<const T*>(events);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    (target->*Method)(first[i]);
+                }
+            });
+        }
+
+        /**
+         * @brief Call Function(const T&) for every event of type T
+         */
+        template <typename T, auto Function>
+        SubscriptionId subscribe()
+        {
+            return addSubscriber(getChannel<T>(), eventTypeId<T>(), nullptr, [](void*, const void* events, std::size_t count) {
+                const T* first = static_cast<const T*>(events);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    Function(first[i]);
+                }
+            });
+        }
+
+        /**
+         * @brief Call (owner->*Method)(std::span<const T>) once per dispatch with all events of type T
+         */
+        template <typename T, auto Method, typename Owner>
+        SubscriptionId subscribeBatch(Owner* owner)
+        {
+            return addSubscriber(getChannel<T>(), eventTypeId<T>(), owner, [](void* context, const void* events, std::size_t count) {
+                (static_cast<Owner*>(context)->*Method)(std::span<const T>(static_cast<const T*>(events), count));
+            });
+        }
+
+        /**
+         * @brief Stop calling a handler. Safe from inside a handler: a subscriber removed during dispatch() is not called
+         * again, even if its type is still being delivered, so its owner may be destroyed right after. A per-event handler
+         * that unsubscribes itself still gets the rest of the events of the call it is in.
+         */
+        void unsubscribe(SubscriptionId id);
+
+        /**
+         * @brief Deliver every event published since the last dispatch()
+         */
+        void dispatch();
+
+        /**
+         * @brief Drop all queued events, e.g. when the level they refer to is unloaded
+         */
+        void clear();
+
+        std::size_t getPendingCount() const;  ///< @brief Events waiting for the next dispatch()
+        std::size_t getLastDispatchCount() const { return lastDispatched_; }
+        std::size_t getStorageBytes() const;  ///< @brief Capacity of all event queues
+
+      private:
+        template <typename T>
+        Channel<T>& getChannel()
+        {
+            const EventTypeId type = eventTypeId<T>();
+            if (!channels_[type]) channels_[type] = std::make_unique<Channel<T>>();
+            return static_cast<Channel<T>&>(*channels_[type]);
+        }
+
+        template <typename T>
+        std::vector<T>& writeQueue()
+        {
+            const EventTypeId type = eventTypeId<T>();
+            Channel<T>& channel = getChannel<T>();
+            if (!channel.queued)
+            {
+                channel.queued = true;
+                queuedTypes_.push_back(type);
+            }
+            return channel.writing;
+        }
+
+        SubscriptionId addSubscriber(ChannelBase& channel, EventTypeId type, void* context, Trampoline call);
+
+        /**
+         * @return nullptr if nothing was published or subscribed for the type yet
+         */
+        ChannelBase* findChannel(EventTypeId type) const { return type < MAX_EVENT_TYPES ? channels_[type].get() : nullptr; }
+    };
+}  // namespace engine::event
@@ -0,0 +1,155 @@
+#include "InputManager.h"
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_keyboard.h>
+#include <SDL3/SDL_mouse.h>
+#include <bit>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace engine::input
+{
+    namespace
+    {
+        /**
+         * @brief Mouse button names accepted in the mappings, next to SDL scancode names ("Space", "Left", "J", ...)
+         */
+        Uint8 mouseButtonFromName(std::string_view name)
+        {
+            if (name == "MouseLeft") return SDL_BUTTON_LEFT;
+            if (name == "MouseMiddle") return SDL_BUTTON_MIDDLE;
+            if (name == "MouseRight") return SDL_BUTTON_RIGHT;
+            if (name == "MouseX1") return SDL_BUTTON_X1;
+            if (name == "MouseX2") return SDL_BUTTON_X2;
+            return 0;
+        }
+    }  // namespace
+
+    InputManager::InputManager(const std::string& config_path)
+    {
+        std::ifstream file(config_path);
+        const nlohmann::json config = nlohmann::json::parse(file, nullptr, false);
+        if (!file.is_open() || config.is_discarded())
+        {
+            throw std::runtime_error("Failed to read input config '" + config_path + "'.");
+        }
+        const auto mappings = config.find("input_mappings");
+        if (mappings == config.end() || !mappings->is_object())
+        {
+            throw std::runtime_error("Config '" + config_path + "' has no 'input_mappings' object.");
+        }
+
+        for (const auto& [name, inputs] : mappings->items())
+        {
+            if (actionNames_.size() == MAX_ACTIONS)
+            {
+                spdlog::error("Config '{}' defines more than {} input actions; '{}' and later ones are ignored.", config_path, MAX_ACTIONS, name);
+                break;
+            }
+            const auto action = static_cast<ActionId>(actionNames_.size());
+            actionNames_.push_back(name);
+
+            // A single input may be written as a plain string
+            const nlohmann::json list = inputs.is_array() ? inputs : nlohmann::json::array({inputs});
+            for (const auto& input : list)
+            {
+                if (!input.is_string() || !bindInput(input.get_ref<const std::string&>(), action))
+                {
+                    spdlog::warn("Input action '{}' in '{}': unknown input {}.", name, config_path, input.dump());
+                }
+            }
+        }
+        SPDLOG_DEBUG("Input mappings compiled from '{}': {} actions.", config_path, actionNames_.size());
+    }
+
+    bool InputManager::bindInput(std::string_view input, ActionId action)
+    {
+        if (const Uint8 button = mouseButtonFromName(input); button != 0)
+        {
+            mouseActions_[button] |= bit(action);
+            return true;
+        }
+
+        const SDL_Scancode scancode = SDL_GetScancodeFromName(std::string(input).c_str());
+        if (scancode == SDL_SCANCODE_UNKNOWN) return false;
+        keyActions_[scancode] |= bit(action);
+        return true;
+    }
+
+    void InputManager::processEvent(const SDL_Event& event)
+    {
+        switch (event.type)
+        {
+            case SDL_EVENT_KEY_DOWN:
+            case SDL_EVENT_KEY_UP:
+            {
+                const auto scancode = static_cast<std::size_t>(event.key.scancode);
+                if (scancode >= keyDown_.size() || event.key.repeat) break;
+                const bool down = event.type == SDL_EVENT_KEY_DOWN;
+                if (keyDown_[scancode] == down) break;
+                keyDown_[scancode] = down;
+                down ? inputDown(keyActions_[scancode]) : inputUp(keyActions_[scancode]);
+                break;
+            }
+            case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            case SDL_EVENT_MOUSE_BUTTON_UP:
+            {
+                const std::size_t button = event.button.button;
+                if (button >= mouseDown_.size()) break;
+                const bool down = event.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+                if (mouseDown_[button] == down) break;
+                mouseDown_[button] = down;
+                down ? inputDown(mouseActions_[button]) : inputUp(mouseActions_[button]);
+                break;
+            }
+            case SDL_EVENT_WINDOW_FOCUS_LOST:
+                releaseAll();
+                break;
+            default:
+                break;
+        }
+    }
+
+    void InputManager::releaseAll()
+    {
+        keyDown_.fill(false);
+        mouseDown_.fill(false);
+        activeInputs_.fill(0);
+        released_ |= held_;
+        held_ = 0;
+    }
+
+    ActionId InputManager::getActionId(std::string_view name) const
+    {
+        for (std::size_t i = 0; i < actionNames_.size(); ++i)
+        {
+            if (actionNames_[i] == name) return static_cast<ActionId>(i);
+        }
+        spdlog::warn("Unknown input action '{}'.", name);
+        return INVALID_ACTION;
+    }
+
+    void InputManager::inputDown(ActionMask actions)
+    {
+        for (; actions != 0; actions &= actions - 1)
+        {
+            const int action = std::countr_zero(actions);
+            if (activeInputs_[action]++ != 0) continue;
+            held_ |= ActionMask{1} << action;
+            pressed_ |= ActionMask{1} << action;
+        }
+    }
+
+    void InputManager::inputUp(ActionMask actions)
+    {
+        for (; actions != 0; actions &= actions - 1)
+        {
+            const int action = std::countr_zero(actions);
+            if (activeInputs_[action] == 0 || --activeInputs_[action] != 0) continue;
+            held_ &= ~(ActionMask{1} << action);
+            released_ |= ActionMask{1} << action;
+        }
+    }
+}  // namespace engine::input
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL3/SDL_scancode.h>
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+union SDL_Event;
+
+namespace engine::input
+{
+    using ActionId = Uint8;  ///< @brief Dense index of an action, assigned when the mappings are compiled
+    using ActionMask = Uint64;
+
+    constexpr std::size_t MAX_ACTIONS = 64;  ///< @brief One bit per action in an ActionMask
+    constexpr ActionId INVALID_ACTION = 0xFF;
+
+    /**
+     * @brief Maps keyboard keys and mouse buttons to named actions ("jump", "move_left", ...).
+     *
+     * The "input_mappings" of the config are compiled once into dense tables: scancode / mouse button -> mask of the
+     * actions bound to it. Events from SDL_PollEvent() update three bit sets, so every query is a single bit test and
+     * no string is looked at after startup. Callers resolve action names to ActionIds once with getActionId().
+     *
+     * An action stays held while any of its inputs is down, so releasing one of two bound keys does not release it.
+     */
+    class InputManager final
+    {
+      private:
+        static constexpr std::size_t MOUSE_BUTTON_COUNT = 8;
+
+        std::array<ActionMask, SDL_SCANCODE_COUNT> keyActions_{};    ///< @brief Scancode -> actions bound to it
+        std::array<ActionMask, MOUSE_BUTTON_COUNT> mouseActions_{};  ///< @brief SDL mouse button -> actions bound to it
+        std::array<bool, SDL_SCANCODE_COUNT> keyDown_{};             ///< @brief Physical key state, filters repeats and stray key-ups
+        std::array<bool, MOUSE_BUTTON_COUNT> mouseDown_{};           ///< @brief Physical button state
+        std::array<Uint8, MAX_ACTIONS> activeInputs_{};              ///< @brief Inputs currently down, per action
+        std::vector<std::string> actionNames_;                       ///< @brief Indexed by ActionId
+
+        ActionMask held_ = 0;      ///< @brief Actions down now
+        ActionMask pressed_ = 0;   ///< @brief Actions that went down this frame
+        ActionMask released_ = 0;  ///< @brief Actions that went up this frame
+
+      public:
+        /**
+         * @brief Compile the "input_mappings" object of a config file
+         * @param config_path JSON config, e.g. "assets/config.json"
+         * @throws std::runtime_error if the file cannot be read or has no "input_mappings" object
+         */
+        explicit InputManager(const std::string& config_path = "assets/config.json");
+
+        // Delete copy and move constructors and assignment operators
+        InputManager(const InputManager&) = delete;
+        InputManager& operator=(const InputManager&) = delete;
+        InputManager(InputManager&&) = delete;
+        InputManager& operator=(InputManager&&) = delete;
+
+        /**
+         * @brief Clear the pressed / released sets. Call once per frame before polling events.
+         */
+        void beginFrame()
+        {
+            pressed_ = 0;
+            released_ = 0;
+        }
+
+        /**
+         * @brief Feed one event from SDL_PollEvent(); events that are not input are ignored
+         */
+        void processEvent(const SDL_Event& event);
+
+        /**
+         * @brief Release everything, e.g. when the window loses focus and the key-ups would never arrive
+         */
+        void releaseAll();
+
+        /**
+         * @return the id of an action, or INVALID_ACTION if the config does not define it. Resolve once, not per frame.
+         */
+        ActionId getActionId(std::string_view name) const;
+        const std::string& getActionName(ActionId action) const { return actionNames_[action]; }
+        std::size_t getActionCount() const { return actionNames_.size(); }
+
+        bool isActionHeld(ActionId action) const { return (held_ & bit(action)) != 0; }
+        bool isActionPressed(ActionId action) const { return (pressed_ & bit(action)) != 0; }
+        bool isActionReleased(ActionId action) const { return (released_ & bit(action)) != 0; }
+
+        ActionMask getHeld() const { return held_; }
+        ActionMask getPressed() const { return pressed_; }
+        ActionMask getReleased() const { return released_; }
+
+      private:
+        static ActionMask bit(ActionId action) { return action < MAX_ACTIONS ? ActionMask{1} << action : 0; }
+
+        bool bindInput(std::string_view input, ActionId action);
+        void inputDown(ActionMask actions);
+        void inputUp(ActionMask actions);
+    };
+}  // namespace engine::input
@@ -0,0 +1,166 @@
+#include "BakedLevel.h"
+
+#include <SDL3/SDL_timer.h>
+#include <cstring>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+#include "../utils/Hash.h"
+#include "LevelData.h"
+
+namespace engine::level
+{
+    std::unique_ptr<BakedLevel> BakedLevel::open(const std::string& file_path)
+    {
+        [[maybe_unused]] const Uint64 start = SDL_GetTicksNS();  // Only read by SPDLOG_DEBUG
+        std::unique_ptr<BakedLevel> level(new BakedLevel());
+        if (!level->file_.open(file_path)) return nullptr;
+
+        level->path_ = file_path;
+        if (!level->validate()) return nullptr;
+
+        SPDLOG_DEBUG("Baked level '{}' mapped: {} bytes, {} layers, validated in {:.3f} ms.", file_path, level->file_.size(), level->getLayers().size(),
+                     (SDL_GetTicksNS() - start) / 1'000'000.0);
+        return level;
+    }
+
+    std::string BakedLevel::bakedPathFor(const std::string& map_path)
+    {
+        return std::filesystem::path(map_path).replace_extension(BAKED_LEVEL_EXTENSION).generic_string();
+    }
+
+    std::span<const Uint16> BakedLevel::getCells(const BakedLayer& layer) const
+    {
+        if (layer.type != BakedLayerType::Tile) return {};
+        return section<Uint16>(header_->tileData).subspan(layer.firstCell, static_cast<std::size_t>(layer.width) * layer.height);
+    }
+
+    std::string_view BakedLevel::getString(BakedString string) const
+    {
+        return {reinterpret_cast<const char*>(file_.data() + header_->strings.offset + string.offset), string.length};
+    }
+
+    const BakedLayer* BakedLevel::findLayer(std::string_view name) const
+    {
+        for (const auto& layer : getLayers())
+        {
+            if (getString(layer.name) == name) return &layer;
+        }
+        return nullptr;
+    }
+
+    const BakedProperty* BakedLevel::findProperty(BakedRange properties, std::string_view name) const
+    {
+        for (const auto& property : getProperties(properties))
+        {
+            if (getString(property.name) == name) return &property;
+        }
+        return nullptr;
+    }
+
+    const BakedTile* BakedLevel::findTile(Uint32 gid, const BakedTileset** tileset) const
+    {
+        gid &= GID_MASK;
+        if (gid == 0) return nullptr;
+
+        const BakedTileset* owner = nullptr;
+        for (const auto& candidate : getTilesets())
+        {
+            if (gid >= candidate.firstGid) owner = &candidate;
+        }
+        if (!owner || gid - owner->firstGid >= owner->tiles.count) return nullptr;
+
+        if (tileset) *tileset = owner;
+        return &getTiles(*owner)[gid - owner->firstGid];
+    }
+
+    bool BakedLevel::validate()
+    {
+        const std::size_t size = file_.size();
+        if (size < sizeof(BakedHeader))
+        {
+            spdlog::error("Baked level '{}' is truncated ({} bytes).", path_, size);
+            return false;
+        }
+
+        header_ = reinterpret_cast<const BakedHeader*>(file_.data());
+        if (std::memcmp(header_->magic, BAKED_LEVEL_MAGIC, sizeof(header_->magic)) != 0)
+        {
+            spdlog::error("'{}' is not a baked level.", path_);
+            return false;
+        }
+        if (header_->version != BAKED_LEVEL_VERSION)
+        {
+            spdlog::warn("Baked level '{}' has version {}, expected {}; rebake it.", path_, header_->version, BAKED_LEVEL_VERSION);
+            return false;
+        }
+        if (header_->fileSize != size)
+        {
+            spdlog::error("Baked level '{}' size mismatch: header says {}, file has {}.", path_, header_->fileSize, size);
+            return false;
+        }
+
+        // Section bounds and alignment: records are read in place, so every record must lie inside the mapping
+        auto section_ok = [size](const BakedSection& section, std::size_t record_size) {
+            return section.offset % 8 == 0 && section.offset >= sizeof(BakedHeader) && section.offset + static_cast<std::size_t>(section.count) * record_size <= size;
+        };
+        if (!section_ok(header_->tilesets, sizeof(BakedTileset)) || !section_ok(header_->tiles, sizeof(BakedTile)) || !section_ok(header_->shapes, sizeof(BakedRect)) ||
+            !section_ok(header_->properties, sizeof(BakedProperty)) || !section_ok(header_->layers, sizeof(BakedLayer)) ||
+            !section_ok(header_->objects, sizeof(BakedObject)) || !section_ok(header_->chunks, sizeof(BakedChunk)) || !section_ok(header_->tileData, sizeof(Uint16)) ||
+            !section_ok(header_->strings, 1))
+        {
+            spdlog::error("Baked level '{}' has a section outside the file.", path_);
+            return false;
+        }
+
+        const Uint64 checksum = engine::utils::fnv1a64(file_.data() + sizeof(BakedHeader), size - sizeof(BakedHeader));
+        if (checksum != header_->checksum)
+        {
+            spdlog::error("Baked level '{}' checksum mismatch, the file is corrupt.", path_);
+            return false;
+        }
+
+        // Cross references: after this every accessor can index without checks
+        auto range_ok = [](BakedRange range, const BakedSection& table) { return static_cast<Uint64>(range.first) + range.count <= table.count; };
+        auto string_ok = [this](BakedString string) { return static_cast<Uint64>(string.offset) + string.length <= header_->strings.count; };
+
+        bool ok = range_ok(header_->mapProperties, header_->properties);
+        for (const auto& property : section<BakedProperty>(header_->properties))
+        {
+            ok = ok && string_ok(property.name);
+            if (property.type == BakedPropertyType::String) ok = ok && string_ok(property.string);
+            if (property.type == BakedPropertyType::Object || property.type == BakedPropertyType::Array) ok = ok && range_ok(property.children, header_->properties);
+        }
+        for (const auto& tileset : section<BakedTileset>(header_->tilesets))
+        {
+            ok = ok && string_ok(tileset.name) && string_ok(tileset.source) && string_ok(tileset.image) && range_ok(tileset.tiles, header_->tiles);
+        }
+        for (const auto& tile : section<BakedTile>(header_->tiles))
+        {
+            ok = ok && string_ok(tile.image) && range_ok(tile.shapes, header_->shapes) && range_ok(tile.properties, header_->properties);
+        }
+        for (const auto& layer : section<BakedLayer>(header_->layers))
+        {
+            ok = ok && string_ok(layer.name) && string_ok(layer.image) && range_ok(layer.properties, header_->properties) && range_ok(layer.objects, header_->objects) &&
+                 range_ok(layer.chunks, header_->chunks);
+            if (layer.type == BakedLayerType::Tile)
+            {
+                ok = ok && static_cast<Uint64>(layer.firstCell) + static_cast<Uint64>(layer.width) * layer.height <= header_->tileData.count;
+            }
+        }
+        for (const auto& chunk : section<BakedChunk>(header_->chunks))
+        {
+            ok = ok && static_cast<Uint64>(chunk.firstCell) + static_cast<Uint64>(chunk.width) * chunk.height <= header_->tileData.count;
+        }
+        for (const auto& object : section<BakedObject>(header_->objects))
+        {
+            ok = ok && string_ok(object.name) && string_ok(object.type) && range_ok(object.properties, header_->properties);
+        }
+
+        if (!ok)
+        {
+            spdlog::error("Baked level '{}' has an out of range reference.", path_);
+        }
+        return ok;
+    }
+}  // namespace engine::level
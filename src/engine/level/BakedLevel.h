@@ -0,0 +1,126 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../utils/MappedFile.h"
+#include "BakedLevelFormat.h"
+
+namespace engine::level
+{
+    /**
+     * @brief A baked level (.slvl) read in place from a memory mapping.
+     *
+     * Nothing is copied or allocated after open(): every accessor returns a span / string_view into the mapping,
+     * valid as long as the BakedLevel lives. The file is validated once (magic, version, size, section bounds, checksum).
+     */
+    class BakedLevel final
+    {
+      private:
+        engine::utils::MappedFile file_;       ///< @brief The mapped file
+        const BakedHeader* header_ = nullptr;  ///< @brief Header at the start of the mapping
+        std::string path_;                     ///< @brief Path of the file
+
+      public:
+        /**
+         * @brief Map and validate a baked level
+         * @param file_path path of the .slvl file
+         * @return the level, or nullptr if the file is missing, stale or corrupt; errors are logged
+         */
+        static std::unique_ptr<BakedLevel> open(const std::string& file_path);
+
+        /**
+         * @brief Path of the baked file that belongs to a Tiled map: "assets/maps/level1.tmj" -> "assets/maps/level1.slvl"
+         */
+        static std::string bakedPathFor(const std::string& map_path);
+
+        // Delete copy and move constructors and assignment operators
+        BakedLevel(const BakedLevel&) = delete;
+        BakedLevel& operator=(const BakedLevel&) = delete;
+        BakedLevel(BakedLevel&&) = delete;
+        BakedLevel& operator=(BakedLevel&&) = delete;
+
+        // --- Map ---
+        const std::string& getPath() const { return path_; }
+        Uint32 getWidth() const { return header_->width; }
+        Uint32 getHeight() const { return header_->height; }
+        Uint32 getTileWidth() const { return header_->tileWidth; }
+        Uint32 getTileHeight() const { return header_->tileHeight; }
+        bool isInfinite() const { return (header_->flags & BAKED_MAP_INFINITE) != 0; }
+        std::span<const BakedProperty> getMapProperties() const { return getProperties(header_->mapProperties); }
+
+        // --- Tables ---
+        std::span<const BakedTileset> getTilesets() const { return section<BakedTileset>(header_->tilesets); }
+        std::span<const BakedLayer> getLayers() const { return section<BakedLayer>(header_->layers); }
+
+        /**
+         * @brief Tile table of a tileset, indexed by local tile id
+         */
+        std::span<const BakedTile> getTiles(const BakedTileset& tileset) const { return range<BakedTile>(header_->tiles, tileset.tiles); }
+
+        /**
+         * @brief Collision sub-shapes of a tile
+         */
+        std::span<const BakedRect> getShapes(const BakedTile& tile) const { return range<BakedRect>(header_->shapes, tile.shapes); }
+
+        /**
+         * @brief width * height cells of a tile layer; decode with unpackBakedGid()
+         */
+        std::span<const Uint16> getCells(const BakedLayer& layer) const;
+
+        /**
+         * @brief Chunks of a tile layer of an infinite map (empty otherwise)
+         */
+        std::span<const BakedChunk> getChunks(const BakedLayer& layer) const { return range<BakedChunk>(header_->chunks, layer.chunks); }
+
+        /**
+         * @brief width * height cells of a chunk; decode with unpackBakedGid()
+         */
+        std::span<const Uint16> getCells(const BakedChunk& chunk) const
+        {
+            return section<Uint16>(header_->tileData).subspan(chunk.firstCell, static_cast<std::size_t>(chunk.width) * chunk.height);
+        }
+
+        /**
+         * @brief Objects of an object layer
+         */
+        std::span<const BakedObject> getObjects(const BakedLayer& layer) const { return range<BakedObject>(header_->objects, layer.objects); }
+
+        /**
+         * @brief A run of properties: a properties field of any record, or the children of an Object / Array property
+         */
+        std::span<const BakedProperty> getProperties(BakedRange properties) const { return range<BakedProperty>(header_->properties, properties); }
+
+        std::string_view getString(BakedString string) const;
+
+        // --- Lookup helpers ---
+        const BakedLayer* findLayer(std::string_view name) const;
+        const BakedProperty* findProperty(BakedRange properties, std::string_view name) const;
+
+        /**
+         * @brief Find the tileset and tile of a gid (flip flags are ignored)
+         * @return nullptr for gid 0 or an unknown gid
+         */
+        const BakedTile* findTile(Uint32 gid, const BakedTileset** tileset = nullptr) const;
+
+      private:
+        BakedLevel() = default;
+
+        bool validate();
+
+        template <typename T>
+        std::span<const T> section(const BakedSection& section) const
+        {
+            return {reinterpret_cast<const T*>(file_.data() + section.offset), section.count};
+        }
+
+        template <typename T>
+        std::span<const T> range(const BakedSection& table, BakedRange range) const
+        {
+            // Ranges were bounds-checked against their section in validate()
+            return section<T>(table).subspan(range.first, range.count);
+        }
+    };
+}  // namespace engine::level
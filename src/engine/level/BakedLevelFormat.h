@@ -0,0 +1,227 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @file BakedLevelFormat.h
+ * @brief On-disk layout of baked levels (.slvl), produced by the LevelBaker tool and read in place by BakedLevel.
+ *
+ * File layout (little-endian, every section 8-byte aligned, offsets are from the start of the file):
+ *
+ *   BakedHeader
+ *   BakedTileset[]   tilesets, sorted by firstGid
+ *   BakedTile[]      dense per-tileset tile tables
+ *   BakedRect[]      tile collision sub-shapes
+ *   BakedProperty[]  all properties; Object / Array children are contiguous runs
+ *   BakedLayer[]     layers in draw order
+ *   BakedObject[]    objects of all object layers
+ *   BakedChunk[]     tile chunks of infinite maps, grouped by layer
+ *   Uint16[]         tile grids and chunk cells, see packBakedGid()
+ *   char[]           string table, referenced by BakedString
+ *
+ * The checksum covers everything after the header. Bump BAKED_LEVEL_VERSION whenever a struct below changes.
+ */
+namespace engine::level
+{
+    static_assert(std::endian::native == std::endian::little, "Baked levels are stored little-endian and mapped directly");
+
+    constexpr char BAKED_LEVEL_MAGIC[4] = {'S', 'L', 'V', 'L'};
+    constexpr Uint32 BAKED_LEVEL_VERSION = 2;
+    constexpr const char* BAKED_LEVEL_EXTENSION = ".slvl";
+
+    // --- Baked tile grid cell: 3 flip bits + 13-bit gid ---
+    constexpr Uint16 BAKED_GID_BITS = 13;
+    constexpr Uint16 BAKED_GID_MASK = (1u << BAKED_GID_BITS) - 1;  ///< @brief Largest gid a baked grid can hold (8191)
+    constexpr Uint16 BAKED_FLAGS_SHIFT = 32 - 16;                  ///< @brief Shift from Tiled gid flip bits to baked flip bits
+
+    /**
+     * @brief Pack a Tiled gid (with flip flags) into a baked grid cell
+     * @return false if the gid does not fit into 13 bits
+     */
+    constexpr bool packBakedGid(Uint32 gid, Uint16& cell)
+    {
+        const Uint32 id = gid & 0x1FFFFFFFu;
+        if (id > BAKED_GID_MASK) return false;
+        cell = static_cast<Uint16>(((gid & 0xE0000000u) >> BAKED_FLAGS_SHIFT) | id);
+        return true;
+    }
+
+    /**
+     * @brief Expand a baked grid cell back into a Tiled gid with flip flags
+     */
+    constexpr Uint32 unpackBakedGid(Uint16 cell)
+    {
+        return ((static_cast<Uint32>(cell) & 0xE000u) << BAKED_FLAGS_SHIFT) | (cell & BAKED_GID_MASK);
+    }
+
+    /**
+     * @brief Reference into the string table (not null-terminated)
+     */
+    struct BakedString
+    {
+        Uint32 offset;  ///< @brief Byte offset inside the string table
+        Uint32 length;  ///< @brief Length in bytes
+    };
+
+    /**
+     * @brief A run of records in one of the tables: [first, first + count)
+     */
+    struct BakedRange
+    {
+        Uint32 first;
+        Uint32 count;
+    };
+
+    /**
+     * @brief Location of a section in the file
+     */
+    struct BakedSection
+    {
+        Uint32 offset;  ///< @brief Byte offset from the start of the file
+        Uint32 count;   ///< @brief Number of records (bytes for the string table)
+    };
+
+    constexpr Uint32 BAKED_MAP_INFINITE = 1u << 0;  ///< @brief Tile layers are stored as chunks, width / height are not meaningful
+
+    struct BakedHeader
+    {
+        char magic[4];
+        Uint32 version;
+        Uint64 checksum;  ///< @brief engine::utils::fnv1a64() of everything after the header
+        Uint64 fileSize;
+        Uint32 width;  ///< @brief Map width in tiles
+        Uint32 height;
+        Uint32 tileWidth;
+        Uint32 tileHeight;
+        Uint32 flags;  ///< @brief BAKED_MAP_* bits
+        BakedRange mapProperties;
+        BakedSection tilesets;
+        BakedSection tiles;
+        BakedSection shapes;
+        BakedSection properties;
+        BakedSection layers;
+        BakedSection objects;
+        BakedSection chunks;
+        BakedSection tileData;  ///< @brief count = number of Uint16 cells
+        BakedSection strings;   ///< @brief count = size in bytes
+        Uint32 reserved;
+    };
+
+    struct BakedRect
+    {
+        float x, y, width, height;
+    };
+
+    struct BakedTileset
+    {
+        Uint32 firstGid;
+        Uint32 columns;  ///< @brief 0 for collection tilesets
+        Uint32 tileWidth;
+        Uint32 tileHeight;
+        Uint32 imageWidth;
+        Uint32 imageHeight;
+        BakedString name;
+        BakedString source;
+        BakedString image;  ///< @brief Empty for collection tilesets
+        BakedRange tiles;   ///< @brief Dense: tiles.first + local id
+    };
+
+    struct BakedTile
+    {
+        BakedRect frame;    ///< @brief Pre-resolved source rectangle
+        BakedString image;  ///< @brief Collection tilesets only
+        BakedRange shapes;  ///< @brief Collision sub-shapes
+        BakedRange properties;
+    };
+
+    enum class BakedPropertyType : Uint32
+    {
+        Bool,
+        Int,
+        Float,
+        String,
+        Object,
+        Array,
+    };
+
+    struct BakedProperty
+    {
+        BakedString name;
+        BakedPropertyType type;
+        Uint32 reserved;
+        union
+        {
+            double number;        ///< @brief Bool / Int / Float
+            BakedString string;   ///< @brief String
+            BakedRange children;  ///< @brief Object / Array
+        };
+    };
+
+    enum class BakedLayerType : Uint32
+    {
+        Tile,
+        Image,
+        Object,
+    };
+
+    constexpr Uint32 BAKED_LAYER_VISIBLE = 1u << 0;
+    constexpr Uint32 BAKED_LAYER_REPEAT_X = 1u << 1;
+    constexpr Uint32 BAKED_LAYER_REPEAT_Y = 1u << 2;
+
+    struct BakedLayer
+    {
+        BakedLayerType type;
+        Uint32 id;
+        BakedString name;
+        Uint32 flags;  ///< @brief BAKED_LAYER_* bits
+        float opacity;
+        float offsetX, offsetY;
+        float parallaxX, parallaxY;
+        BakedRange properties;
+        // Tile layer
+        Uint32 width, height;  ///< @brief 0 x 0 for chunked layers
+        Uint32 firstCell;      ///< @brief Index of the first cell in the tile data section
+        BakedRange chunks;     ///< @brief Infinite maps only
+        // Image layer
+        BakedString image;
+        Uint32 imageWidth, imageHeight;
+        // Object layer
+        BakedRange objects;
+    };
+
+    /**
+     * @brief A block of tiles of an infinite map's tile layer
+     */
+    struct BakedChunk
+    {
+        Sint32 x, y;  ///< @brief Top-left tile, in tiles
+        Uint32 width, height;
+        Uint32 firstCell;  ///< @brief Index of the first cell in the tile data section
+        Uint32 reserved;
+    };
+
+    constexpr Uint32 BAKED_OBJECT_VISIBLE = 1u << 0;
+    constexpr Uint32 BAKED_OBJECT_POINT = 1u << 1;
+
+    struct BakedObject
+    {
+        Uint32 id;
+        Uint32 gid;  ///< @brief Full Tiled gid including flip flags, 0 if not a tile object
+        BakedString name;
+        BakedString type;
+        float x, y, width, height;
+        float rotation;
+        Uint32 flags;  ///< @brief BAKED_OBJECT_* bits
+        BakedRange properties;
+    };
+
+    // Records are read straight from the mapping, they must stay plain data with a fixed layout
+    static_assert(std::is_trivial_v<BakedHeader> && sizeof(BakedHeader) % 8 == 0);
+    static_assert(std::is_trivially_copyable_v<BakedProperty> && sizeof(BakedProperty) == 24);
+    static_assert(std::is_trivially_copyable_v<BakedTileset> && std::is_trivially_copyable_v<BakedTile>);
+    static_assert(std::is_trivially_copyable_v<BakedLayer> && std::is_trivially_copyable_v<BakedObject>);
+    static_assert(std::is_trivial_v<BakedChunk> && sizeof(BakedChunk) == 24);
+}  // namespace engine::level
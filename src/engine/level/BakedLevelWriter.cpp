@@ -0,0 +1,324 @@
+#include "BakedLevelWriter.h"
+
+#include <cstring>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <string_view>
+#include <unordered_map>
+
+#include "../utils/Hash.h"
+#include "BakedLevelFormat.h"
+
+namespace engine::level
+{
+    namespace
+    {
+        /**
+         * @brief Collects the baked tables while walking a LevelData, then lays them out into one buffer
+         */
+        class BakedLevelBuilder
+        {
+          private:
+            std::vector<BakedTileset> tilesets_;
+            std::vector<BakedTile> tiles_;
+            std::vector<BakedRect> shapes_;
+            std::vector<BakedProperty> properties_;
+            std::vector<BakedLayer> layers_;
+            std::vector<BakedObject> objects_;
+            std::vector<BakedChunk> chunks_;
+            std::vector<Uint16> cells_;
+            std::string strings_;
+            std::unordered_map<std::string, BakedString> stringIndex_;  ///< @brief Deduplicates the string table
+            bool infinite_ = false;                                     ///< @brief Tile layers are baked as chunks
+
+          public:
+            bool build(const LevelData& level, std::vector<std::byte>& out);
+
+          private:
+            BakedString addString(const std::string& text);
+            BakedRange addProperties(const std::vector<Property>& properties);
+            BakedRange addShapes(const std::vector<engine::utils::Rect>& shapes);
+            bool addCells(const std::vector<Uint32>& tiles, const Layer& layer, const std::string& level_path);
+            bool addLayer(const Layer& layer, const std::string& level_path);
+        };
+
+        BakedRect toBakedRect(const engine::utils::Rect& rect)
+        {
+            return BakedRect{rect.position.x, rect.position.y, rect.size.x, rect.size.y};
+        }
+
+        Uint32 alignTo8(std::size_t offset)
+        {
+            return static_cast<Uint32>((offset + 7) & ~std::size_t{7});
+        }
+
+        template <typename T>
+        void copySection(std::vector<std::byte>& out, const BakedSection& section, const std::vector<T>& records)
+        {
+            if (!records.empty()) std::memcpy(out.data() + section.offset, records.data(), records.size() * sizeof(T));
+        }
+
+        BakedString BakedLevelBuilder::addString(const std::string& text)
+        {
+            if (text.empty()) return BakedString{0, 0};
+
+            auto it = stringIndex_.find(text);
+            if (it != stringIndex_.end()) return it->second;
+
+            const BakedString ref{static_cast<Uint32>(strings_.size()), static_cast<Uint32>(text.size())};
+            strings_ += text;
+            stringIndex_.emplace(text, ref);
+            return ref;
+        }
+
+        BakedRange BakedLevelBuilder::addProperties(const std::vector<Property>& properties)
+        {
+            // Siblings are reserved first so they stay contiguous; children are appended after them
+            const BakedRange range{static_cast<Uint32>(properties_.size()), static_cast<Uint32>(properties.size())};
+            properties_.resize(properties_.size() + properties.size(), BakedProperty{});
+
+            for (std::size_t i = 0; i < properties.size(); ++i)
+            {
+                const Property& property = properties[i];
+                BakedProperty baked{};
+                baked.name = addString(property.name);
+                switch (property.type)
+                {
+                    case PropertyType::Bool:
+                        baked.type = BakedPropertyType::Bool;
+                        baked.number = property.number;
+                        break;
+                    case PropertyType::Int:
+                        baked.type = BakedPropertyType::Int;
+                        baked.number = property.number;
+                        break;
+                    case PropertyType::Float:
+                        baked.type = BakedPropertyType::Float;
+                        baked.number = property.number;
+                        break;
+                    case PropertyType::String:
+                        baked.type = BakedPropertyType::String;
+                        baked.string = addString(property.string);
+                        break;
+                    case PropertyType::Object:
+                    case PropertyType::Array:
+                        baked.type = property.type == PropertyType::Object ? BakedPropertyType::Object : BakedPropertyType::Array;
+                        baked.children = addProperties(property.children);
+                        break;
+                }
+                properties_[range.first + i] = baked;
+            }
+            return range;
+        }
+
+        BakedRange BakedLevelBuilder::addShapes(const std::vector<engine::utils::Rect>& shapes)
+        {
+            const BakedRange range{static_cast<Uint32>(shapes_.size()), static_cast<Uint32>(shapes.size())};
+            for (const auto& shape : shapes)
+            {
+                shapes_.push_back(toBakedRect(shape));
+            }
+            return range;
+        }
+
+        bool BakedLevelBuilder::addCells(const std::vector<Uint32>& tiles, const Layer& layer, const std::string& level_path)
+        {
+            for (const Uint32 gid : tiles)
+            {
+                Uint16 cell = 0;
+                if (!packBakedGid(gid, cell))
+                {
+                    spdlog::error("Layer '{}' in '{}' uses gid {}, baked grids hold at most {}.", layer.name, level_path, gid & GID_MASK, BAKED_GID_MASK);
+                    return false;
+                }
+                cells_.push_back(cell);
+            }
+            return true;
+        }
+
+        bool BakedLevelBuilder::addLayer(const Layer& layer, const std::string& level_path)
+        {
+            BakedLayer baked{};
+            baked.id = static_cast<Uint32>(layer.id);
+            baked.name = addString(layer.name);
+            baked.flags = (layer.visible ? BAKED_LAYER_VISIBLE : 0) | (layer.repeatX ? BAKED_LAYER_REPEAT_X : 0) | (layer.repeatY ? BAKED_LAYER_REPEAT_Y : 0);
+            baked.opacity = layer.opacity;
+            baked.offsetX = layer.offset.x;
+            baked.offsetY = layer.offset.y;
+            baked.parallaxX = layer.parallax.x;
+            baked.parallaxY = layer.parallax.y;
+            baked.properties = addProperties(layer.properties);
+
+            switch (layer.type)
+            {
+                case LayerType::Tile:
+                {
+                    baked.type = BakedLayerType::Tile;
+                    baked.firstCell = static_cast<Uint32>(cells_.size());
+                    if (infinite_)
+                    {
+                        baked.chunks = BakedRange{static_cast<Uint32>(chunks_.size()), static_cast<Uint32>(layer.chunks.size())};
+                        for (const auto& chunk : layer.chunks)
+                        {
+                            chunks_.push_back(BakedChunk{chunk.x, chunk.y, static_cast<Uint32>(chunk.width), static_cast<Uint32>(chunk.height),
+                                                         static_cast<Uint32>(cells_.size()), 0});
+                            if (!addCells(chunk.tiles, layer, level_path)) return false;
+                        }
+                        break;
+                    }
+
+                    baked.width = static_cast<Uint32>(layer.width);
+                    baked.height = static_cast<Uint32>(layer.height);
+                    if (layer.tiles.size() != static_cast<std::size_t>(layer.width) * static_cast<std::size_t>(layer.height))
+                    {
+                        spdlog::error("Layer '{}' in '{}' has {} tiles, expected {}x{}.", layer.name, level_path, layer.tiles.size(), layer.width, layer.height);
+                        return false;
+                    }
+                    if (!addCells(layer.tiles, layer, level_path)) return false;
+                    break;
+                }
+                case LayerType::Image:
+                    baked.type = BakedLayerType::Image;
+                    baked.image = addString(layer.image);
+                    baked.imageWidth = static_cast<Uint32>(layer.imageSize.x);
+                    baked.imageHeight = static_cast<Uint32>(layer.imageSize.y);
+                    break;
+                case LayerType::Object:
+                    baked.type = BakedLayerType::Object;
+                    baked.objects.first = static_cast<Uint32>(objects_.size());
+                    baked.objects.count = static_cast<Uint32>(layer.objects.size());
+                    for (const auto& object : layer.objects)
+                    {
+                        BakedObject baked_object{};
+                        baked_object.id = static_cast<Uint32>(object.id);
+                        baked_object.gid = object.gid;
+                        baked_object.name = addString(object.name);
+                        baked_object.type = addString(object.type);
+                        baked_object.x = object.position.x;
+                        baked_object.y = object.position.y;
+                        baked_object.width = object.size.x;
+                        baked_object.height = object.size.y;
+                        baked_object.rotation = object.rotation;
+                        baked_object.flags = (object.visible ? BAKED_OBJECT_VISIBLE : 0) | (object.point ? BAKED_OBJECT_POINT : 0);
+                        baked_object.properties = addProperties(object.properties);
+                        objects_.push_back(baked_object);
+                    }
+                    break;
+            }
+
+            layers_.push_back(baked);
+            return true;
+        }
+
+        bool BakedLevelBuilder::build(const LevelData& level, std::vector<std::byte>& out)
+        {
+            infinite_ = level.infinite;
+
+            BakedHeader header{};
+            std::memcpy(header.magic, BAKED_LEVEL_MAGIC, sizeof(header.magic));
+            header.version = BAKED_LEVEL_VERSION;
+            header.width = static_cast<Uint32>(level.width);
+            header.height = static_cast<Uint32>(level.height);
+            header.tileWidth = static_cast<Uint32>(level.tileSize.x);
+            header.tileHeight = static_cast<Uint32>(level.tileSize.y);
+            header.flags = level.infinite ? BAKED_MAP_INFINITE : 0;
+            header.mapProperties = addProperties(level.properties);
+
+            for (const auto& tileset : level.tilesets)
+            {
+                BakedTileset baked{};
+                baked.firstGid = static_cast<Uint32>(tileset.firstGid);
+                baked.columns = static_cast<Uint32>(tileset.columns);
+                baked.tileWidth = static_cast<Uint32>(tileset.tileSize.x);
+                baked.tileHeight = static_cast<Uint32>(tileset.tileSize.y);
+                baked.imageWidth = static_cast<Uint32>(tileset.imageSize.x);
+                baked.imageHeight = static_cast<Uint32>(tileset.imageSize.y);
+                baked.name = addString(tileset.name);
+                baked.source = addString(tileset.source);
+                baked.image = addString(tileset.image);
+                baked.tiles = BakedRange{static_cast<Uint32>(tiles_.size()), static_cast<Uint32>(tileset.tiles.size())};
+
+                // Reserve the dense run first, nested properties are appended to other tables
+                tiles_.resize(tiles_.size() + tileset.tiles.size(), BakedTile{});
+                for (std::size_t id = 0; id < tileset.tiles.size(); ++id)
+                {
+                    const TileDefinition& tile = tileset.tiles[id];
+                    BakedTile baked_tile{};
+                    baked_tile.frame = toBakedRect(tile.frame);
+                    baked_tile.image = addString(tile.image);
+                    baked_tile.shapes = addShapes(tile.shapes);
+                    baked_tile.properties = addProperties(tile.properties);
+                    tiles_[baked.tiles.first + id] = baked_tile;
+                }
+                tilesets_.push_back(baked);
+            }
+
+            for (const auto& layer : level.layers)
+            {
+                if (!addLayer(layer, level.path)) return false;
+            }
+
+            // Lay out the sections, each 8-byte aligned
+            std::size_t offset = sizeof(BakedHeader);
+            auto place = [&offset](BakedSection& section, std::size_t count, std::size_t record_size) {
+                offset = alignTo8(offset);
+                section = BakedSection{static_cast<Uint32>(offset), static_cast<Uint32>(count)};
+                offset += count * record_size;
+            };
+            place(header.tilesets, tilesets_.size(), sizeof(BakedTileset));
+            place(header.tiles, tiles_.size(), sizeof(BakedTile));
+            place(header.shapes, shapes_.size(), sizeof(BakedRect));
+            place(header.properties, properties_.size(), sizeof(BakedProperty));
+            place(header.layers, layers_.size(), sizeof(BakedLayer));
+            place(header.objects, objects_.size(), sizeof(BakedObject));
+            place(header.chunks, chunks_.size(), sizeof(BakedChunk));
+            place(header.tileData, cells_.size(), sizeof(Uint16));
+            place(header.strings, strings_.size(), 1);
+            header.fileSize = alignTo8(offset);
+
+            out.assign(header.fileSize, std::byte{0});
+            copySection(out, header.tilesets, tilesets_);
+            copySection(out, header.tiles, tiles_);
+            copySection(out, header.shapes, shapes_);
+            copySection(out, header.properties, properties_);
+            copySection(out, header.layers, layers_);
+            copySection(out, header.objects, objects_);
+            copySection(out, header.chunks, chunks_);
+            copySection(out, header.tileData, cells_);
+            if (!strings_.empty()) std::memcpy(out.data() + header.strings.offset, strings_.data(), strings_.size());
+
+            header.checksum = engine::utils::fnv1a64(out.data() + sizeof(BakedHeader), out.size() - sizeof(BakedHeader));
+            std::memcpy(out.data(), &header, sizeof(header));
+            return true;
+        }
+    }  // namespace
+
+    bool bakeLevel(const LevelData& level, std::vector<std::byte>& out)
+    {
+        BakedLevelBuilder builder;
+        return builder.build(level, out);
+    }
+
+    bool writeBakedLevel(const LevelData& level, const std::string& file_path)
+    {
+        std::vector<std::byte> bytes;
+        if (!bakeLevel(level, bytes)) return false;
+
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            spdlog::error("Failed to open '{}' for writing.", file_path);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file)
+        {
+            spdlog::error("Failed to write baked level '{}'.", file_path);
+            return false;
+        }
+
+        spdlog::info("Baked '{}' -> '{}' ({} bytes).", level.path, file_path, bytes.size());
+        return true;
+    }
+}  // namespace engine::level
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "LevelData.h"
+
+namespace engine::level
+{
+    /**
+     * @brief Serialize a level into the baked (.slvl) format described in BakedLevelFormat.h
+     * @param level the level, usually from loadTiledMapJson()
+     * @param out receives the file contents
+     * @return false if the level cannot be baked (e.g. a gid above 8191); errors are logged
+     */
+    bool bakeLevel(const LevelData& level, std::vector<std::byte>& out);
+
+    /**
+     * @brief Bake a level and write it to disk
+     * @param level the level
+     * @param file_path output path, conventionally next to the .tmj with the .slvl extension
+     * @return true on success; errors are logged
+     */
+    bool writeBakedLevel(const LevelData& level, const std::string& file_path);
+}  // namespace engine::level
@@ -0,0 +1,386 @@
+#include "ChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+#include "../render/Camera.h"
+#include "BakedLevel.h"
+
+namespace engine::level
+{
+    namespace
+    {
+        int floorDiv(int value, int divisor)
+        {
+            const int quotient = value / divisor;
+            return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+        }
+
+        int ceilDiv(int value, int divisor)
+        {
+            return floorDiv(value + divisor - 1, divisor);
+        }
+    }  // namespace
+
+    std::size_t ChunkStreamer::ChunkCoordHash::operator()(const ChunkCoord& coord) const
+    {
+        // splitmix64 finaliser: neighbouring chunks land in unrelated buckets
+        Uint64 key = (static_cast<Uint64>(static_cast<Uint32>(coord.x)) << 32) | static_cast<Uint32>(coord.y);
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<std::size_t>(key);
+    }
+
+    ChunkStreamer::ChunkStreamer(const BakedLevel& level, int radius, int chunk_size) : level_(level), chunkSize_(chunk_size), radius_(std::max(radius, 0))
+    {
+        if (chunk_size <= 0 || level.getTileWidth() == 0 || level.getTileHeight() == 0)
+        {
+            throw std::runtime_error("ChunkStreamer needs a positive chunk size and a level with a tile size.");
+        }
+        chunkPixels_ = glm::vec2(static_cast<float>(chunk_size * static_cast<int>(level.getTileWidth())), static_cast<float>(chunk_size * static_cast<int>(level.getTileHeight())));
+
+        buildIndex();
+        worker_ = std::thread(&ChunkStreamer::workerLoop, this);
+        SPDLOG_DEBUG("ChunkStreamer for '{}': {}x{} tile chunks, radius {}, {} indexed chunks, {} tile layers.", level.getPath(), chunk_size, chunk_size, radius_,
+                     index_.size(), tileLayerCount_);
+    }
+
+    ChunkStreamer::~ChunkStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    void ChunkStreamer::buildIndex()
+    {
+        const auto layers = level_.getLayers();
+        Uint32 tile_layer = 0;
+        int max_width = 0;
+        int max_height = 0;
+        for (std::size_t i = 0; i < layers.size(); ++i)
+        {
+            const BakedLayer& layer = layers[i];
+            if (layer.type == BakedLayerType::Tile)
+            {
+                if (level_.isInfinite())
+                {
+                    // A baked chunk is registered with every streaming chunk it overlaps; Tiled chunks are usually 16x16 and aligned
+                    for (const auto& chunk : level_.getChunks(layer))
+                    {
+                        const int min_x = floorDiv(chunk.x, chunkSize_);
+                        const int min_y = floorDiv(chunk.y, chunkSize_);
+                        const int max_x = ceilDiv(chunk.x + static_cast<int>(chunk.width), chunkSize_);
+                        const int max_y = ceilDiv(chunk.y + static_cast<int>(chunk.height), chunkSize_);
+                        for (int y = min_y; y < max_y; ++y)
+                        {
+                            for (int x = min_x; x < max_x; ++x)
+                            {
+                                index_[ChunkCoord{x, y}].tiles.push_back(TileSpan{tile_layer, &chunk, &layer});
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    const int chunks_x = ceilDiv(static_cast<int>(layer.width), chunkSize_);
+                    const int chunks_y = ceilDiv(static_cast<int>(layer.height), chunkSize_);
+                    for (int y = 0; y < chunks_y; ++y)
+                    {
+                        for (int x = 0; x < chunks_x; ++x)
+                        {
+                            index_[ChunkCoord{x, y}].tiles.push_back(TileSpan{tile_layer, nullptr, &layer});
+                        }
+                    }
+                    max_width = std::max(max_width, static_cast<int>(layer.width));
+                    max_height = std::max(max_height, static_cast<int>(layer.height));
+                }
+                ++tile_layer;
+            }
+            else if (layer.type == BakedLayerType::Object)
+            {
+                for (const auto& object : level_.getObjects(layer))
+                {
+                    index_[chunkAt({object.x, object.y})].objects.push_back(ChunkObject{&object, static_cast<Uint32>(i)});
+                }
+            }
+        }
+        tileLayerCount_ = tile_layer;
+
+        if (!level_.isInfinite())
+        {
+            // Objects may sit outside the grid (spawners beyond the edge), so the bounds are not clamped to it
+            ChunkRange bounds;
+            bounds.max = glm::ivec2(ceilDiv(std::max(max_width, static_cast<int>(level_.getWidth())), chunkSize_) - 1,
+                                    ceilDiv(std::max(max_height, static_cast<int>(level_.getHeight())), chunkSize_) - 1);
+            for (const auto& [coord, entry] : index_)
+            {
+                bounds.min = glm::min(bounds.min, glm::ivec2(coord.x, coord.y));
+                bounds.max = glm::max(bounds.max, glm::ivec2(coord.x, coord.y));
+            }
+            bounds_ = bounds;
+        }
+    }
+
+    ChunkCoord ChunkStreamer::chunkAt(const glm::vec2& world_pos) const
+    {
+        return ChunkCoord{static_cast<int>(std::floor(world_pos.x / chunkPixels_.x)), static_cast<int>(std::floor(world_pos.y / chunkPixels_.y))};
+    }
+
+    ChunkStreamer::ChunkRange ChunkStreamer::rangeAround(const engine::render::Camera& camera, int margin) const
+    {
+        const glm::vec2 min_pos = camera.getPosition();
+        const glm::vec2 max_pos = min_pos + glm::max(camera.getViewportSize() - glm::vec2(1.0f), glm::vec2(0.0f));
+        const ChunkCoord first = chunkAt(min_pos);
+        const ChunkCoord last = chunkAt(max_pos);
+
+        ChunkRange range{glm::ivec2(first.x - margin, first.y - margin), glm::ivec2(last.x + margin, last.y + margin)};
+        if (bounds_)
+        {
+            range.min = glm::max(range.min, bounds_->min);
+            range.max = glm::min(range.max, bounds_->max);
+        }
+        return range;
+    }
+
+    void ChunkStreamer::update(const engine::render::Camera& camera)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Level);
+        const ChunkRange load_range = rangeAround(camera, radius_);
+        keepRange_ = rangeAround(camera, radius_ + 1);
+
+        // Swap out the finished chunks, drop requests that left the range before the worker got to them
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            focus_ = (camera.getPosition() + camera.getViewportSize() * 0.5f) / chunkPixels_;
+            for (std::size_t i = 0; i < pending_.size();)
+            {
+                if (keepRange_.contains(pending_[i]->coord))
+                {
+                    ++i;
+                    continue;
+                }
+                requested_.erase(pending_[i]->coord);
+                ++stats_.cancelled;
+                releaseChunk(std::move(pending_[i]));
+                pending_[i] = std::move(pending_.back());
+                pending_.pop_back();
+            }
+
+            const std::size_t count = std::min(completed_.size(), maxIntegrationsPerFrame_);
+            batch_.clear();
+            std::move(completed_.begin(), completed_.begin() + static_cast<std::ptrdiff_t>(count), std::back_inserter(batch_));
+            completed_.erase(completed_.begin(), completed_.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+        for (auto& chunk : batch_)
+        {
+            integrate(std::move(chunk));
+        }
+
+        // Release what left the range
+        for (auto it = resident_.begin(); it != resident_.end();)
+        {
+            if (keepRange_.contains(it->first))
+            {
+                ++it;
+                continue;
+            }
+            if (onUnload_) onUnload_(*it->second);
+            releaseChunk(std::move(it->second));
+            it = resident_.erase(it);
+            ++stats_.unloaded;
+        }
+
+        // Request what entered it
+        batch_.clear();
+        for (int y = load_range.min.y; y <= load_range.max.y; ++y)
+        {
+            for (int x = load_range.min.x; x <= load_range.max.x; ++x)
+            {
+                const ChunkCoord coord{x, y};
+                if (resident_.contains(coord) || requested_.contains(coord)) continue;
+                requested_.insert(coord);
+                batch_.push_back(acquireChunk(coord));
+            }
+        }
+        if (!batch_.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::move(batch_.begin(), batch_.end(), std::back_inserter(pending_));
+            }
+            wake_.notify_one();
+        }
+        batch_.clear();
+    }
+
+    void ChunkStreamer::preload(const engine::render::Camera& camera)
+    {
+        const ChunkRange load_range = rangeAround(camera, radius_);
+        keepRange_ = rangeAround(camera, radius_ + 1);
+        for (int y = load_range.min.y; y <= load_range.max.y; ++y)
+        {
+            for (int x = load_range.min.x; x <= load_range.max.x; ++x)
+            {
+                // Chunks already in flight arrive through update() as usual
+                const ChunkCoord coord{x, y};
+                if (resident_.contains(coord) || requested_.contains(coord)) continue;
+                auto chunk = acquireChunk(coord);
+                fillChunk(*chunk);
+                requested_.insert(coord);
+                integrate(std::move(chunk));
+            }
+        }
+    }
+
+    void ChunkStreamer::setCallbacks(ChunkCallback on_load, ChunkCallback on_unload)
+    {
+        onLoad_ = std::move(on_load);
+        onUnload_ = std::move(on_unload);
+    }
+
+    const LevelChunk* ChunkStreamer::findChunk(ChunkCoord coord) const
+    {
+        const auto it = resident_.find(coord);
+        return it != resident_.end() ? it->second.get() : nullptr;
+    }
+
+    Uint32 ChunkStreamer::getTile(std::size_t tile_layer, int tile_x, int tile_y) const
+    {
+        if (tile_layer >= tileLayerCount_) return 0;
+        const ChunkCoord coord{floorDiv(tile_x, chunkSize_), floorDiv(tile_y, chunkSize_)};
+        const LevelChunk* chunk = findChunk(coord);
+        if (!chunk) return 0;
+
+        const int local_x = tile_x - coord.x * chunkSize_;
+        const int local_y = tile_y - coord.y * chunkSize_;
+        return chunk->getLayerTiles(tile_layer)[static_cast<std::size_t>(local_y) * static_cast<std::size_t>(chunkSize_) + static_cast<std::size_t>(local_x)];
+    }
+
+    ChunkStreamerStats ChunkStreamer::getStats() const
+    {
+        ChunkStreamerStats stats = stats_;
+        stats.resident = resident_.size();
+        stats.inFlight = requested_.size();
+        stats.pooled = pool_.size();
+        return stats;
+    }
+
+    void ChunkStreamer::fillChunk(LevelChunk& chunk) const
+    {
+        const std::size_t cells = static_cast<std::size_t>(chunkSize_) * static_cast<std::size_t>(chunkSize_);
+        chunk.size = chunkSize_;
+        chunk.tiles.assign(tileLayerCount_ * cells, 0);
+        chunk.objects.clear();
+
+        const auto it = index_.find(chunk.coord);
+        if (it == index_.end()) return;
+
+        const int origin_x = chunk.coord.x * chunkSize_;
+        const int origin_y = chunk.coord.y * chunkSize_;
+        for (const TileSpan& span : it->second.tiles)
+        {
+            // Source rectangle in tiles: a baked chunk, or the whole dense grid
+            const auto source = span.chunk ? level_.getCells(*span.chunk) : level_.getCells(*span.layer);
+            const int source_x = span.chunk ? span.chunk->x : 0;
+            const int source_y = span.chunk ? span.chunk->y : 0;
+            const int source_width = static_cast<int>(span.chunk ? span.chunk->width : span.layer->width);
+            const int source_height = static_cast<int>(span.chunk ? span.chunk->height : span.layer->height);
+
+            const int min_x = std::max(origin_x, source_x);
+            const int max_x = std::min(origin_x + chunkSize_, source_x + source_width);
+            const int min_y = std::max(origin_y, source_y);
+            const int max_y = std::min(origin_y + chunkSize_, source_y + source_height);
+            Uint32* out = chunk.tiles.data() + span.tileLayer * cells;
+            for (int y = min_y; y < max_y; ++y)
+            {
+                const Uint16* row = source.data() + static_cast<std::size_t>(y - source_y) * static_cast<std::size_t>(source_width);
+                Uint32* out_row = out + static_cast<std::size_t>(y - origin_y) * static_cast<std::size_t>(chunkSize_);
+                for (int x = min_x; x < max_x; ++x)
+                {
+                    out_row[x - origin_x] = unpackBakedGid(row[x - source_x]);
+                }
+            }
+        }
+        chunk.objects.assign(it->second.objects.begin(), it->second.objects.end());
+    }
+
+    std::unique_ptr<LevelChunk> ChunkStreamer::acquireChunk(ChunkCoord coord)
+    {
+        std::unique_ptr<LevelChunk> chunk;
+        if (pool_.empty())
+        {
+            chunk = std::make_unique<LevelChunk>();
+            ++stats_.peakChunks;  // The pool never frees, so chunks allocated so far is the peak
+        }
+        else
+        {
+            chunk = std::move(pool_.back());
+            pool_.pop_back();
+        }
+        chunk->coord = coord;
+        return chunk;
+    }
+
+    void ChunkStreamer::releaseChunk(std::unique_ptr<LevelChunk> chunk)
+    {
+        pool_.push_back(std::move(chunk));
+    }
+
+    void ChunkStreamer::integrate(std::unique_ptr<LevelChunk> chunk)
+    {
+        const ChunkCoord coord = chunk->coord;
+        requested_.erase(coord);
+        if (!keepRange_.contains(coord))
+        {
+            ++stats_.cancelled;
+            releaseChunk(std::move(chunk));
+            return;
+        }
+
+        const LevelChunk& resident = *(resident_[coord] = std::move(chunk));
+        ++stats_.loaded;
+        if (onLoad_) onLoad_(resident);
+    }
+
+    void ChunkStreamer::workerLoop()
+    {
+        ENGINE_PROFILE_THREAD("Chunk streaming");
+        ENGINE_ALLOC_SCOPE(Level);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            if (stopping_) return;
+
+            // Nearest to the camera first, so the chunks about to become visible are never stuck behind the far ring
+            auto nearest = std::min_element(pending_.begin(), pending_.end(), [this](const auto& a, const auto& b) {
+                const glm::vec2 da = glm::vec2(a->coord.x + 0.5f, a->coord.y + 0.5f) - focus_;
+                const glm::vec2 db = glm::vec2(b->coord.x + 0.5f, b->coord.y + 0.5f) - focus_;
+                return glm::dot(da, da) < glm::dot(db, db);
+            });
+            std::unique_ptr<LevelChunk> chunk = std::move(*nearest);
+            *nearest = std::move(pending_.back());
+            pending_.pop_back();
+
+            lock.unlock();
+            {
+                ENGINE_PROFILE_SCOPE("ChunkStreamer::fillChunk");
+                fillChunk(*chunk);
+            }
+            lock.lock();
+            completed_.push_back(std::move(chunk));
+        }
+    }
+}  // namespace engine::level
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <condition_variable>
+#include <functional>
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "BakedLevelFormat.h"
+
+namespace engine::render
+{
+    class Camera;
+}
+
+namespace engine::level
+{
+    class BakedLevel;
+
+    /**
+     * @brief Position of a streaming chunk, in chunks (may be negative on infinite maps)
+     */
+    struct ChunkCoord
+    {
+        int x = 0;
+        int y = 0;
+
+        bool operator==(const ChunkCoord&) const = default;
+    };
+
+    /**
+     * @brief An object of an object layer that lies inside a chunk
+     */
+    struct ChunkObject
+    {
+        const BakedObject* object = nullptr;  ///< @brief Record inside the BakedLevel mapping
+        Uint32 layer = 0;                     ///< @brief Index of its layer in BakedLevel::getLayers()
+    };
+
+    /**
+     * @brief Tiles and objects of one streaming chunk. Recycled by the ChunkStreamer, so the vectors keep their capacity.
+     */
+    struct LevelChunk
+    {
+        ChunkCoord coord;
+        int size = 0;                      ///< @brief Edge length in tiles
+        std::vector<Uint32> tiles;         ///< @brief size * size gids per tile layer, tile layer after tile layer, flip flags included
+        std::vector<ChunkObject> objects;  ///< @brief Objects whose position lies inside the chunk
+
+        /**
+         * @param tile_layer ordinal among the tile layers (not the index in BakedLevel::getLayers())
+         */
+        std::span<const Uint32> getLayerTiles(std::size_t tile_layer) const
+        {
+            const std::size_t count = static_cast<std::size_t>(size) * static_cast<std::size_t>(size);
+            return std::span<const Uint32>(tiles).subspan(tile_layer * count, count);
+        }
+    };
+
+    /**
+     * @brief Snapshot of the streamer counters
+     */
+    struct ChunkStreamerStats
+    {
+        std::size_t resident = 0;    ///< @brief Chunks integrated and visible to getTile()
+        std::size_t inFlight = 0;    ///< @brief Chunks requested but not integrated yet
+        std::size_t pooled = 0;      ///< @brief Recycled chunks waiting for reuse
+        std::size_t peakChunks = 0;  ///< @brief Most chunks allocated at once
+        Uint64 loaded = 0;           ///< @brief Chunks integrated since construction
+        Uint64 unloaded = 0;         ///< @brief Chunks released since construction
+        Uint64 cancelled = 0;        ///< @brief Requests dropped because the camera moved away first
+    };
+
+    /**
+     * @brief Streams the tiles and objects of a baked level in square chunks around the camera.
+     *
+     * Chunks within `radius` chunks of the visible area are requested, read from the memory-mapped BakedLevel on a worker
+     * thread (nearest to the camera first) and integrated by update() on the main thread, at most a few per frame so
+     * crossing a chunk boundary never costs a burst of work. Chunks more than radius + 1 chunks away are released;
+     * the extra ring of hysteresis stops a camera oscillating on a boundary from reloading the same chunks.
+     * Released chunks go back to a pool, so resident memory depends on the radius and the viewport, not on the world size.
+     *
+     * Works on finite maps (the dense grids are sliced into chunks) and on infinite maps (the baked chunk table is
+     * re-tiled to the streaming chunk size). Only the chunk index built by the constructor grows with the level: a few
+     * bytes per baked chunk and per object. Not thread-safe: every public member is for the main thread.
+     */
+    class ChunkStreamer final
+    {
+      public:
+        using ChunkCallback = std::function<void(const LevelChunk&)>;
+
+      private:
+        struct ChunkCoordHash
+        {
+            std::size_t operator()(const ChunkCoord& coord) const;
+        };
+
+        struct TileSpan
+        {
+            Uint32 tileLayer = 0;               ///< @brief Ordinal among the tile layers
+            const BakedChunk* chunk = nullptr;  ///< @brief Baked chunk of an infinite map, nullptr for a dense layer
+            const BakedLayer* layer = nullptr;  ///< @brief Its layer
+        };
+
+        /**
+         * @brief What the worker needs to fill one streaming chunk, built once from the level
+         */
+        struct ChunkIndex
+        {
+            std::vector<TileSpan> tiles;
+            std::vector<ChunkObject> objects;
+        };
+
+        /**
+         * @brief Inclusive range of chunk coordinates
+         */
+        struct ChunkRange
+        {
+            glm::ivec2 min{0, 0};
+            glm::ivec2 max{-1, -1};
+
+            bool contains(const ChunkCoord& coord) const { return coord.x >= min.x && coord.y >= min.y && coord.x <= max.x && coord.y <= max.y; }
+        };
+
+        const BakedLevel& level_;                                                               ///< @brief Must outlive the streamer
+        int chunkSize_;                                                                         ///< @brief Edge length of a chunk in tiles
+        int radius_;                                                                            ///< @brief Chunks kept loaded around the visible area
+        glm::vec2 chunkPixels_{0.0f, 0.0f};                                                     ///< @brief Size of a chunk in pixels
+        std::size_t tileLayerCount_ = 0;                                                        ///< @brief Tile layers in the level
+        std::optional<ChunkRange> bounds_;                                                      ///< @brief Chunks of a finite map; nullopt for infinite maps
+        std::unordered_map<ChunkCoord, ChunkIndex, ChunkCoordHash> index_;                      ///< @brief Read-only after construction
+        std::unordered_map<ChunkCoord, std::unique_ptr<LevelChunk>, ChunkCoordHash> resident_;  ///< @brief Integrated chunks
+        std::unordered_set<ChunkCoord, ChunkCoordHash> requested_;                              ///< @brief In flight, pending or being filled
+        std::vector<std::unique_ptr<LevelChunk>> pool_;                                         ///< @brief Released chunks, reused by the next requests
+        std::vector<std::unique_ptr<LevelChunk>> batch_;                                        ///< @brief Scratch for requests and completions, keeps its capacity
+        std::size_t maxIntegrationsPerFrame_ = 4;                                               ///< @brief Completed chunks integrated per update()
+        ChunkCallback onLoad_;                                                                  ///< @brief Called when a chunk becomes resident
+        ChunkCallback onUnload_;                                                                ///< @brief Called before a chunk is released
+        ChunkRange keepRange_;                                                                  ///< @brief Range of the last update()
+        ChunkStreamerStats stats_;
+
+        // --- Shared with the worker, guarded by mutex_ ---
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::vector<std::unique_ptr<LevelChunk>> pending_;    ///< @brief Requests not picked up yet, coord already set
+        std::vector<std::unique_ptr<LevelChunk>> completed_;  ///< @brief Filled chunks waiting for update()
+        glm::vec2 focus_{0.0f, 0.0f};                         ///< @brief Camera centre in chunks, nearest requests go first
+        bool stopping_ = false;
+        std::thread worker_;
+
+      public:
+        /**
+         * @param level baked level to stream; it must outlive the streamer
+         * @param radius chunks kept loaded beyond the visible area
+         * @param chunk_size edge length of a chunk in tiles
+         * @throws std::runtime_error if the level has no tile size or chunk_size is not positive
+         */
+        explicit ChunkStreamer(const BakedLevel& level, int radius = 1, int chunk_size = 16);
+        ~ChunkStreamer();
+
+        // Delete copy and move constructors and assignment operators
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        ChunkStreamer(ChunkStreamer&&) = delete;
+        ChunkStreamer& operator=(ChunkStreamer&&) = delete;
+
+        /**
+         * @brief Request chunks entering the radius, integrate finished ones and release the ones that left. Once per frame.
+         */
+        void update(const engine::render::Camera& camera);
+
+        /**
+         * @brief Load everything update() would request, synchronously. For level start and teleports, where pop-in is worse than a stall.
+         */
+        void preload(const engine::render::Camera& camera);
+
+        /**
+         * @brief Callbacks run on the main thread: on_load after a chunk became resident, on_unload before it is released
+         */
+        void setCallbacks(ChunkCallback on_load, ChunkCallback on_unload);
+        void setMaxIntegrationsPerFrame(std::size_t count) { maxIntegrationsPerFrame_ = count > 0 ? count : 1; }
+
+        /**
+         * @return the resident chunk, or nullptr if it is not loaded (yet)
+         */
+        const LevelChunk* findChunk(ChunkCoord coord) const;
+
+        /**
+         * @brief Gid at a tile position, through the resident chunks
+         * @param tile_layer ordinal among the tile layers
+         * @return the gid with flip flags, 0 if empty or not loaded
+         */
+        Uint32 getTile(std::size_t tile_layer, int tile_x, int tile_y) const;
+
+        ChunkCoord chunkAt(const glm::vec2& world_pos) const;
+        int getChunkSize() const { return chunkSize_; }
+        int getRadius() const { return radius_; }
+        std::size_t getTileLayerCount() const { return tileLayerCount_; }
+        ChunkStreamerStats getStats() const;
+
+      private:
+        void buildIndex();
+        ChunkRange rangeAround(const engine::render::Camera& camera, int margin) const;
+        void fillChunk(LevelChunk& chunk) const;  ///< @brief Worker side: copy tiles and objects of chunk.coord out of the level
+        std::unique_ptr<LevelChunk> acquireChunk(ChunkCoord coord);
+        void releaseChunk(std::unique_ptr<LevelChunk> chunk);
+        void integrate(std::unique_ptr<LevelChunk> chunk);
+        void workerLoop();
+    };
+}  // namespace engine::level
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../utils/Math.h"
+
+namespace engine::level
+{
+    // --- Tiled global tile id (gid) layout ---
+    constexpr Uint32 GID_FLIPPED_HORIZONTALLY = 0x80000000u;
+    constexpr Uint32 GID_FLIPPED_VERTICALLY = 0x40000000u;
+    constexpr Uint32 GID_FLIPPED_DIAGONALLY = 0x20000000u;
+    constexpr Uint32 GID_FLAGS_MASK = 0xE0000000u;
+    constexpr Uint32 GID_MASK = ~GID_FLAGS_MASK;
+
+    /**
+     * @brief Value type of a custom property
+     */
+    enum class PropertyType : Uint8
+    {
+        Bool,
+        Int,
+        Float,
+        String,
+        Object,  ///< @brief Named children; produced from string properties holding a JSON object (e.g. "animation")
+        Array,   ///< @brief Unnamed children; produced from JSON arrays (e.g. animation "frames")
+    };
+
+    /**
+     * @brief A Tiled custom property. String properties that contain JSON are parsed at load time into Object / Array trees.
+     */
+    struct Property
+    {
+        std::string name;
+        PropertyType type = PropertyType::String;
+        double number = 0.0;             ///< @brief Value of Bool (0 / 1), Int and Float properties
+        std::string string;              ///< @brief Value of String properties
+        std::vector<Property> children;  ///< @brief Members of Object / elements of Array properties
+
+        bool asBool() const { return number != 0.0; }
+        int asInt() const { return static_cast<int>(number); }
+        float asFloat() const { return static_cast<float>(number); }
+    };
+
+    /**
+     * @brief Find a property by name in a property list
+     * @return nullptr if there is no property with this name
+     */
+    inline const Property* findProperty(const std::vector<Property>& properties, std::string_view name)
+    {
+        for (const auto& property : properties)
+        {
+            if (property.name == name) return &property;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief One tile of a tileset, with its source rectangle already resolved
+     */
+    struct TileDefinition
+    {
+        std::string image;                        ///< @brief Image of collection tilesets; empty when the tileset image is used
+        engine::utils::Rect frame{};              ///< @brief Source rectangle inside the image
+        std::vector<engine::utils::Rect> shapes;  ///< @brief Collision sub-shapes (tile local coordinates) from the tile's objectgroup
+        std::vector<Property> properties;         ///< @brief Custom properties
+    };
+
+    /**
+     * @brief A tileset referenced by a map. tiles is dense: tiles[local id].
+     */
+    struct Tileset
+    {
+        int firstGid = 1;  ///< @brief Gid of the first tile in the map that references the tileset
+        std::string name;
+        std::string source;  ///< @brief Path of the .tsj file
+        std::string image;   ///< @brief Tileset image, empty for collection tilesets
+        glm::ivec2 tileSize{0, 0};
+        glm::ivec2 imageSize{0, 0};
+        int columns = 0;  ///< @brief 0 for collection tilesets (one image per tile)
+        std::vector<TileDefinition> tiles;
+
+        /**
+         * @brief Get a tile by its local id
+         * @return nullptr if the id is outside the tileset
+         */
+        const TileDefinition* getTile(Uint32 local_id) const { return local_id < tiles.size() ? &tiles[local_id] : nullptr; }
+    };
+
+    enum class LayerType : Uint8
+    {
+        Tile,
+        Image,
+        Object,
+    };
+
+    /**
+     * @brief An object of an object layer (player spawn, enemy, item, trigger, ...)
+     */
+    struct MapObject
+    {
+        int id = 0;
+        Uint32 gid = 0;  ///< @brief Tile gid for tile objects, 0 otherwise
+        std::string name;
+        std::string type;
+        glm::vec2 position{0.0f, 0.0f};
+        glm::vec2 size{0.0f, 0.0f};
+        float rotation = 0.0f;
+        bool visible = true;
+        bool point = false;  ///< @brief Point object (size is zero)
+        std::vector<Property> properties;
+    };
+
+    /**
+     * @brief A rectangular block of tiles of an infinite map's tile layer
+     */
+    struct TileChunk
+    {
+        int x = 0;  ///< @brief Position of the top-left tile, in tiles (may be negative)
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<Uint32> tiles;  ///< @brief width * height gids, row major, flip flags included
+    };
+
+    /**
+     * @brief A map layer. Only the members of its type are filled.
+     */
+    struct Layer
+    {
+        LayerType type = LayerType::Tile;
+        int id = 0;
+        std::string name;
+        bool visible = true;
+        float opacity = 1.0f;
+        glm::vec2 offset{0.0f, 0.0f};
+        glm::vec2 parallax{1.0f, 1.0f};
+        std::vector<Property> properties;
+
+        // -- Tile layer --
+        int width = 0;
+        int height = 0;
+        std::vector<Uint32> tiles;      ///< @brief width * height gids, row major, flip flags included; empty for infinite maps
+        std::vector<TileChunk> chunks;  ///< @brief Infinite maps only: the layer's tiles, in the order Tiled stored them
+
+        // -- Image layer --
+        std::string image;
+        glm::ivec2 imageSize{0, 0};
+        bool repeatX = false;
+        bool repeatY = false;
+
+        // -- Object layer --
+        std::vector<MapObject> objects;
+    };
+
+    /**
+     * @brief A fully loaded Tiled map. All asset paths are resolved relative to the working directory (e.g. "assets/textures/...").
+     */
+    struct LevelData
+    {
+        std::string path;               ///< @brief Path of the map the data was loaded from
+        int width = 0;                  ///< @brief Map width in tiles
+        int height = 0;                 ///< @brief Map height in tiles
+        glm::ivec2 tileSize{0, 0};      ///< @brief Tile size in pixels
+        bool infinite = false;          ///< @brief Tile layers store chunks instead of a dense grid; width / height are not meaningful
+        std::vector<Tileset> tilesets;  ///< @brief Sorted by firstGid
+        std::vector<Layer> layers;      ///< @brief In draw order
+        std::vector<Property> properties;
+
+        /**
+         * @brief Find the tileset a gid belongs to (flip flags are ignored)
+         * @return nullptr for gid 0 or an unknown gid
+         */
+        const Tileset* findTileset(Uint32 gid) const
+        {
+            gid &= GID_MASK;
+            const Tileset* result = nullptr;
+            for (const auto& tileset : tilesets)
+            {
+                if (gid >= static_cast<Uint32>(tileset.firstGid)) result = &tileset;
+            }
+            return gid != 0 ? result : nullptr;
+        }
+
+        /**
+         * @brief Find a layer by name
+         * @return nullptr if there is no layer with this name
+         */
+        const Layer* findLayer(std::string_view name) const
+        {
+            for (const auto& layer : layers)
+            {
+                if (layer.name == name) return &layer;
+            }
+            return nullptr;
+        }
+    };
+}  // namespace engine::level
@@ -0,0 +1,361 @@
+#include "LevelManager.h"
+
+#include <SDL3/SDL_surface.h>
+#include <SDL3/SDL_timer.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+#include "../resource/ResourceManager.h"
+#include "BakedLevel.h"
+#include "TiledMapStream.h"
+
+namespace engine::level
+{
+    namespace
+    {
+        constexpr double KIB = 1024.0;
+
+        /**
+         * @brief Texture accounting name of a map: "assets/maps/level1.tmj" -> "level1"
+         */
+        std::string levelName(const std::string& map_path)
+        {
+            return std::filesystem::path(map_path).stem().string();
+        }
+
+        void addTexture(std::vector<std::string>& textures, std::string_view path)
+        {
+            if (!path.empty()) textures.emplace_back(path);
+        }
+
+        void collectBaked(const BakedLevel& level, std::vector<std::string>& textures)
+        {
+            for (const BakedTileset& tileset : level.getTilesets())
+            {
+                addTexture(textures, level.getString(tileset.image));
+                for (const BakedTile& tile : level.getTiles(tileset))
+                {
+                    addTexture(textures, level.getString(tile.image));
+                }
+            }
+            for (const BakedLayer& layer : level.getLayers())
+            {
+                if (layer.type == BakedLayerType::Image) addTexture(textures, level.getString(layer.image));
+            }
+        }
+
+        void collectTiled(const LevelData& level, std::vector<std::string>& textures)
+        {
+            for (const Tileset& tileset : level.tilesets)
+            {
+                addTexture(textures, tileset.image);
+                for (const TileDefinition& tile : tileset.tiles)
+                {
+                    addTexture(textures, tile.image);
+                }
+            }
+            for (const Layer& layer : level.layers)
+            {
+                if (layer.type == LayerType::Image) addTexture(textures, layer.image);
+            }
+        }
+    }  // namespace
+
+    bool LevelAssets::hasTexture(const std::string& path) const
+    {
+        return std::binary_search(textures.begin(), textures.end(), path);
+    }
+
+    std::optional<LevelAssets> collectLevelAssets(const std::string& map_path)
+    {
+        LevelAssets assets;
+        assets.mapPath = map_path;
+
+        // The baked level is read in place; the .tmj is the fallback when it was not baked or is out of date
+        const std::string baked_path = BakedLevel::bakedPathFor(map_path);
+        std::unique_ptr<BakedLevel> baked;
+        std::error_code error;
+        if (std::filesystem::exists(baked_path, error)) baked = BakedLevel::open(baked_path);
+
+        if (baked)
+        {
+            collectBaked(*baked, assets.textures);
+        }
+        else
+        {
+            const auto level = loadTiledMapStreaming(map_path);
+            if (!level)
+            {
+                spdlog::error("Unable to compute the assets of level '{}'.", map_path);
+                return std::nullopt;
+            }
+            collectTiled(*level, assets.textures);
+        }
+
+        std::sort(assets.textures.begin(), assets.textures.end());
+        assets.textures.erase(std::unique(assets.textures.begin(), assets.textures.end()), assets.textures.end());
+        return assets;
+    }
+
+    void LevelManager::SurfaceDeleter::operator()(SDL_Surface* surface) const
+    {
+        SDL_DestroySurface(surface);
+    }
+
+    LevelManager::LevelManager(engine::resource::ResourceManager& resource_manager) : resourceManager_(resource_manager)
+    {
+        loader_ = std::thread(&LevelManager::loaderLoop, this);
+        SPDLOG_TRACE("LevelManager constructed successfully.");
+    }
+
+    LevelManager::~LevelManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        if (loader_.joinable()) loader_.join();
+    }
+
+    bool LevelManager::loadLevel(const std::string& map_path)
+    {
+        cancelPreparation();
+
+        LoadJob job{++generation_, map_path, resourceManager_.getCachedTexturePaths()};
+        LoadResult result = runJob(job);
+        if (!result.assets) return false;
+
+        target_ = map_path;
+        acceptResult(std::move(result));
+        uploadStaged(staged_.size());
+        return switchLevel();
+    }
+
+    void LevelManager::prepareLevel(const std::string& map_path)
+    {
+        if (map_path == target_) return;
+        cancelPreparation();
+        target_ = map_path;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = LoadJob{++generation_, map_path, resourceManager_.getCachedTexturePaths()};
+        }
+        wake_.notify_one();
+        spdlog::info("Preparing level '{}' in the background.", map_path);
+    }
+
+    void LevelManager::update()
+    {
+        std::optional<LoadResult> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result.swap(result_);
+        }
+        if (result)
+        {
+            if (result->generation != generation_)
+            {
+                // Finished after being replaced by a newer request
+            }
+            else if (!result->assets)
+            {
+                spdlog::error("Level '{}' could not be prepared.", target_);
+                target_.clear();
+            }
+            else
+            {
+                acceptResult(std::move(*result));
+            }
+        }
+
+        uploadStaged(UPLOADS_PER_FRAME);
+    }
+
+    bool LevelManager::isReady() const
+    {
+        return prepared_.has_value() && staged_.empty();
+    }
+
+    bool LevelManager::switchLevel()
+    {
+        if (!isReady()) return false;
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Resource);
+
+        // Textures loaded from here on, and those the new level reuses, count for it in the memory report
+        const std::string level_name = levelName(prepared_->mapPath);
+        resourceManager_.setCurrentLevel(level_name);
+
+        LevelTransitionStats stats;
+        stats.decodeMs = decodeMs_;
+        stats.uploadMs = uploadNs_ / 1'000'000.0;
+        std::sort(uploaded_.begin(), uploaded_.end());
+        for (const std::string& texture : prepared_->textures)
+        {
+            const engine::resource::TextureInfo* info = resourceManager_.getTextureInfo(texture);
+            bool loaded = std::binary_search(uploaded_.begin(), uploaded_.end(), texture);
+            if (!info && resourceManager_.loadTexture(texture))
+            {
+                // Unloaded by someone else since the job started: loaded here, synchronously
+                info = resourceManager_.getTextureInfo(texture);
+                loaded = true;
+            }
+
+            if (!info)
+            {
+                ++stats.missingTextures;
+            }
+            else if (loaded)
+            {
+                ++stats.loadedTextures;
+                stats.loadedBytes += info->bytes;
+            }
+            else
+            {
+                resourceManager_.addTextureLevel(texture, level_name);
+                ++stats.reusedTextures;
+                stats.reusedBytes += info->bytes;
+            }
+        }
+
+        if (current_)
+        {
+            for (const std::string& texture : current_->textures)
+            {
+                if (prepared_->hasTexture(texture)) continue;
+                if (const engine::resource::TextureInfo* info = resourceManager_.getTextureInfo(texture))
+                {
+                    ++stats.releasedTextures;
+                    stats.releasedBytes += info->bytes;
+                    resourceManager_.unloadTexture(texture);
+                }
+            }
+        }
+
+        const std::string previous = current_ ? current_->mapPath : std::string("(none)");
+        current_ = std::move(prepared_);
+        prepared_.reset();
+        uploaded_.clear();
+        target_.clear();
+        lastTransition_ = stats;
+
+        spdlog::info("Level '{}' -> '{}': {} textures reused ({:.1f} KiB), {} loaded ({:.1f} KiB, decode {:.2f} ms, upload {:.2f} ms), {} released ({:.1f} KiB).", previous,
+                     current_->mapPath, stats.reusedTextures, stats.reusedBytes / KIB, stats.loadedTextures, stats.loadedBytes / KIB, stats.decodeMs, stats.uploadMs,
+                     stats.releasedTextures, stats.releasedBytes / KIB);
+        if (stats.missingTextures > 0)
+        {
+            spdlog::warn("Level '{}' is missing {} textures.", current_->mapPath, stats.missingTextures);
+        }
+        return true;
+    }
+
+    LevelManager::LoadResult LevelManager::runJob(const LoadJob& job)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        LoadResult result;
+        result.generation = job.generation;
+        result.mapPath = job.mapPath;
+        result.assets = collectLevelAssets(job.mapPath);
+        if (!result.assets) return result;
+
+        const Uint64 start = SDL_GetTicksNS();
+        for (const std::string& texture : result.assets->textures)
+        {
+            if (std::binary_search(job.resident.begin(), job.resident.end(), texture)) continue;
+
+            const Uint64 decode_start = SDL_GetTicksNS();
+            SDL_Surface* surface = IMG_Load(texture.c_str());
+            if (!surface)
+            {
+                spdlog::error("Failed to decode texture '{}' of level '{}': {}", texture, job.mapPath, SDL_GetError());
+                continue;
+            }
+            result.images.push_back({texture, std::unique_ptr<SDL_Surface, SurfaceDeleter>(surface), SDL_GetTicksNS() - decode_start});
+        }
+        result.decodeNs = SDL_GetTicksNS() - start;
+        return result;
+    }
+
+    void LevelManager::loaderLoop()
+    {
+        ENGINE_PROFILE_THREAD("Level loader");
+        ENGINE_ALLOC_SCOPE(Level);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this] { return stopping_ || job_.has_value(); });
+            if (stopping_) return;
+
+            LoadJob job = std::move(*job_);
+            job_.reset();
+            lock.unlock();
+
+            LoadResult result = runJob(job);
+
+            lock.lock();
+            // Only the newest request matters: drop the result if another one is already queued
+            if (!job_) result_ = std::move(result);
+        }
+    }
+
+    void LevelManager::acceptResult(LoadResult&& result)
+    {
+        prepared_ = std::move(result.assets);
+        staged_ = std::move(result.images);
+        decodeMs_ = result.decodeNs / 1'000'000.0;
+        uploadNs_ = 0;
+    }
+
+    void LevelManager::uploadStaged(std::size_t max_uploads)
+    {
+        if (staged_.empty()) return;
+        ENGINE_PROFILE_FUNCTION();
+        ENGINE_ALLOC_SCOPE(Resource);
+
+        // Counted for the level being prepared, not for the one still running
+        const std::string level_name = levelName(prepared_->mapPath);
+        const Uint64 start = SDL_GetTicksNS();
+        std::size_t uploads = 0;
+        while (!staged_.empty() && uploads < max_uploads)
+        {
+            DecodedImage image = std::move(staged_.back());
+            staged_.pop_back();
+            // Something else may have loaded it since the job started; then it counts as reused
+            if (resourceManager_.getTextureInfo(image.path)) continue;
+
+            if (resourceManager_.loadTexture(image.path, image.surface.get(), level_name, image.decodeNs))
+            {
+                uploaded_.push_back(std::move(image.path));
+            }
+            ++uploads;
+        }
+        uploadNs_ += SDL_GetTicksNS() - start;
+    }
+
+    void LevelManager::cancelPreparation()
+    {
+        if (target_.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_.reset();
+            result_.reset();
+        }
+
+        // Textures uploaded for the abandoned level are released unless the current level uses them
+        for (const std::string& texture : uploaded_)
+        {
+            if (!current_ || !current_->hasTexture(texture)) resourceManager_.unloadTexture(texture);
+        }
+        spdlog::info("Preparation of level '{}' cancelled.", target_);
+        target_.clear();
+        prepared_.reset();
+        staged_.clear();
+        uploaded_.clear();
+    }
+}  // namespace engine::level
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SDL_Surface;
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::level
+{
+    /**
+     * @brief Files a level needs loaded before it can be shown
+     */
+    struct LevelAssets
+    {
+        std::string mapPath;                ///< @brief The .tmj the set was computed from
+        std::vector<std::string> textures;  ///< @brief Tileset images, collection tile images and image layers; sorted, unique
+
+        /**
+         * @return true if path is in textures
+         */
+        bool hasTexture(const std::string& path) const;
+    };
+
+    /**
+     * @brief Compute the asset set of a level from its baked .slvl when there is one, from the .tmj otherwise. Errors are logged.
+     * @return std::nullopt if the level cannot be read
+     */
+    std::optional<LevelAssets> collectLevelAssets(const std::string& map_path);
+
+    /**
+     * @brief What a level switch kept, loaded and released
+     */
+    struct LevelTransitionStats
+    {
+        std::size_t reusedTextures = 0;    ///< @brief Needed by the new level and already cached
+        std::size_t loadedTextures = 0;    ///< @brief Decoded and uploaded for the new level
+        std::size_t releasedTextures = 0;  ///< @brief Used by the old level only, unloaded by the switch
+        std::size_t missingTextures = 0;   ///< @brief Needed by the new level but could not be loaded
+        std::size_t reusedBytes = 0;
+        std::size_t loadedBytes = 0;
+        std::size_t releasedBytes = 0;
+        double decodeMs = 0.0;  ///< @brief Reading and decoding the new images, on the loader thread
+        double uploadMs = 0.0;  ///< @brief Creating their textures, on the main thread
+    };
+
+    /**
+     * @brief Switches levels while keeping the textures they share.
+     *
+     * prepareLevel() hands the next map to a loader thread, which computes its asset set and decodes the images that are
+     * not cached already. update() uploads the decoded images as textures, a few per frame, so the
+     * current level keeps running meanwhile. Once isReady(), switchLevel() makes the new level current and unloads only
+     * the textures the old level used and the new one does not; shared tilesets and parallax layers stay cached.
+     *
+     * loadLevel() does the same synchronously, for the first level or when no preparation was possible.
+     * Every method is main thread only.
+     */
+    class LevelManager final
+    {
+      public:
+        static constexpr std::size_t UPLOADS_PER_FRAME = 4;  ///< @brief Textures created per update(), bounds the time taken from a frame
+
+      private:
+        struct SurfaceDeleter
+        {
+            void operator()(SDL_Surface* surface) const;
+        };
+
+        struct DecodedImage
+        {
+            std::string path;
+            std::unique_ptr<SDL_Surface, SurfaceDeleter> surface;
+            Uint64 decodeNs = 0;
+        };
+
+        /**
+         * @brief A map to prepare, with the textures that need no decoding because they are cached already
+         */
+        struct LoadJob
+        {
+            Uint64 generation = 0;
+            std::string mapPath;
+            std::vector<std::string> resident;  ///< @brief Sorted
+        };
+
+        struct LoadResult
+        {
+            Uint64 generation = 0;
+            std::string mapPath;
+            std::optional<LevelAssets> assets;
+            std::vector<DecodedImage> images;
+            Uint64 decodeNs = 0;
+        };
+
+        engine::resource::ResourceManager& resourceManager_;
+        std::optional<LevelAssets> current_;
+
+        // --- Preparation of the next level, main thread ---
+        std::string target_;                   ///< @brief Map being prepared, empty when none
+        Uint64 generation_ = 0;                ///< @brief Incremented by every request, so results of replaced ones are recognised
+        std::optional<LevelAssets> prepared_;  ///< @brief Asset set of target_ once the loader is done with it
+        std::vector<DecodedImage> staged_;     ///< @brief Decoded images of target_ waiting for upload
+        std::vector<std::string> uploaded_;    ///< @brief Textures uploaded for target_ so far
+        double decodeMs_ = 0.0;
+        Uint64 uploadNs_ = 0;
+        LevelTransitionStats lastTransition_;
+
+        // --- Loader thread ---
+        std::mutex mutex_;
+        std::condition_variable wake_;      ///< @brief Signals the loader: a job is pending or the manager stops
+        std::optional<LoadJob> job_;        ///< @brief Next map to prepare; a newer request replaces it
+        std::optional<LoadResult> result_;  ///< @brief Finished preparation, taken by update()
+        bool stopping_ = false;
+        std::thread loader_;
+
+      public:
+        explicit LevelManager(engine::resource::ResourceManager& resource_manager);
+        ~LevelManager();
+
+        // Delete copy and move constructors and assignment operators
+        LevelManager(const LevelManager&) = delete;
+        LevelManager& operator=(const LevelManager&) = delete;
+        LevelManager(LevelManager&&) = delete;
+        LevelManager& operator=(LevelManager&&) = delete;
+
+        /**
+         * @brief Load a level and make it current now, blocking until its textures are loaded. Cancels any preparation.
+         * @return false if the map cannot be read (the current level stays)
+         */
+        bool loadLevel(const std::string& map_path);
+
+        /**
+         * @brief Start preparing the next level in the background; replaces a preparation still in progress
+         */
+        void prepareLevel(const std::string& map_path);
+
+        /**
+         * @brief Collect the loader's result and upload up to UPLOADS_PER_FRAME textures. Call once per frame.
+         */
+        void update();
+
+        /**
+         * @return true once the prepared level has all its textures and switchLevel() will not block
+         */
+        bool isReady() const;
+
+        /**
+         * @brief Make the prepared level current and release what only the previous level used
+         * @return false if no level is ready
+         */
+        bool switchLevel();
+
+        const std::string& getPreparingLevel() const { return target_; }                   ///< @brief Map being prepared, empty when none
+        const std::optional<LevelAssets>& getCurrentLevel() const { return current_; }     ///< @brief Asset set of the current level
+        const LevelTransitionStats& getLastTransition() const { return lastTransition_; }  ///< @brief Stats of the last switch
+
+      private:
+        static LoadResult runJob(const LoadJob& job);
+
+        void loaderLoop();
+        void acceptResult(LoadResult&& result);
+        void uploadStaged(std::size_t max_uploads);
+        void cancelPreparation();
+    };
+}  // namespace engine::level
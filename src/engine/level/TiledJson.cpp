@@ -0,0 +1,335 @@
+#include "TiledJson.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::level
+{
+    namespace
+    {
+        bool readJsonFile(const std::string& file_path, nlohmann::json& json)
+        {
+            std::ifstream file(file_path);
+            if (!file.is_open())
+            {
+                spdlog::error("Failed to open '{}'.", file_path);
+                return false;
+            }
+
+            json = nlohmann::json::parse(file, nullptr, false);
+            if (json.is_discarded())
+            {
+                spdlog::error("Failed to parse '{}': invalid JSON.", file_path);
+                return false;
+            }
+            return true;
+        }
+
+        Property propertyFromJson(std::string name, const nlohmann::json& value)
+        {
+            Property property;
+            property.name = std::move(name);
+            if (value.is_boolean())
+            {
+                property.type = PropertyType::Bool;
+                property.number = value.get<bool>() ? 1.0 : 0.0;
+            }
+            else if (value.is_number_integer())
+            {
+                property.type = PropertyType::Int;
+                property.number = value.get<double>();
+            }
+            else if (value.is_number())
+            {
+                property.type = PropertyType::Float;
+                property.number = value.get<double>();
+            }
+            else if (value.is_object())
+            {
+                property.type = PropertyType::Object;
+                for (const auto& [key, child] : value.items())
+                {
+                    property.children.push_back(propertyFromJson(key, child));
+                }
+            }
+            else if (value.is_array())
+            {
+                property.type = PropertyType::Array;
+                for (const auto& child : value)
+                {
+                    property.children.push_back(propertyFromJson({}, child));
+                }
+            }
+            else
+            {
+                property.type = PropertyType::String;
+                property.string = value.is_string() ? value.get<std::string>() : std::string();
+            }
+            return property;
+        }
+
+        engine::utils::Rect rectFromJson(const nlohmann::json& json)
+        {
+            return engine::utils::Rect{{json.value("x", 0.0f), json.value("y", 0.0f)}, {json.value("width", 0.0f), json.value("height", 0.0f)}};
+        }
+
+        void parseTileChunks(const nlohmann::json& json, Layer& layer, const std::string& map_path)
+        {
+            const auto chunks = json.find("chunks");
+            if (chunks == json.end() || !chunks->is_array())
+            {
+                spdlog::error("Layer '{}' in infinite map '{}' has no plain 'chunks' array, tiles are left empty.", layer.name, map_path);
+                return;
+            }
+
+            layer.chunks.reserve(chunks->size());
+            for (const auto& chunk_json : *chunks)
+            {
+                TileChunk chunk;
+                chunk.x = chunk_json.value("x", 0);
+                chunk.y = chunk_json.value("y", 0);
+                chunk.width = chunk_json.value("width", 0);
+                chunk.height = chunk_json.value("height", 0);
+                const auto data = chunk_json.find("data");
+                if (data == chunk_json.end() || !data->is_array() || data->size() != static_cast<std::size_t>(chunk.width) * static_cast<std::size_t>(chunk.height))
+                {
+                    spdlog::error("Skipping malformed chunk ({}, {}) of layer '{}' in '{}'.", chunk.x, chunk.y, layer.name, map_path);
+                    continue;
+                }
+                chunk.tiles.reserve(data->size());
+                for (const auto& gid : *data)
+                {
+                    chunk.tiles.push_back(gid.get<Uint32>());
+                }
+                layer.chunks.push_back(std::move(chunk));
+            }
+        }
+
+        void parseTileLayer(const nlohmann::json& json, Layer& layer, bool infinite, const std::string& map_path)
+        {
+            layer.width = json.value("width", 0);
+            layer.height = json.value("height", 0);
+            if (infinite)
+            {
+                parseTileChunks(json, layer, map_path);
+                return;
+            }
+
+            const auto data = json.find("data");
+            if (data == json.end() || !data->is_array())
+            {
+                // Base64 / compressed layer data is not supported, export maps with the CSV layer format
+                spdlog::error("Layer '{}' in '{}' has no plain 'data' array, tiles are left empty.", layer.name, map_path);
+                layer.tiles.assign(static_cast<std::size_t>(layer.width) * static_cast<std::size_t>(layer.height), 0);
+                return;
+            }
+
+            layer.tiles.reserve(data->size());
+            for (const auto& gid : *data)
+            {
+                layer.tiles.push_back(gid.get<Uint32>());
+            }
+        }
+
+        void parseObjectLayer(const nlohmann::json& json, Layer& layer)
+        {
+            const auto objects = json.find("objects");
+            if (objects == json.end() || !objects->is_array()) return;
+
+            layer.objects.reserve(objects->size());
+            for (const auto& object_json : *objects)
+            {
+                MapObject& object = layer.objects.emplace_back();
+                object.id = object_json.value("id", 0);
+                object.gid = object_json.value("gid", Uint32{0});
+                object.name = object_json.value("name", "");
+                object.type = object_json.value("type", "");
+                object.position = {object_json.value("x", 0.0f), object_json.value("y", 0.0f)};
+                object.size = {object_json.value("width", 0.0f), object_json.value("height", 0.0f)};
+                object.rotation = object_json.value("rotation", 0.0f);
+                object.visible = object_json.value("visible", true);
+                object.point = object_json.value("point", false);
+                if (object_json.contains("properties")) parseProperties(object_json["properties"], object.properties);
+            }
+        }
+    }  // namespace
+
+    std::string resolveTiledPath(const std::string& owner_path, const std::string& relative_path)
+    {
+        const std::filesystem::path owner(owner_path);
+        return (owner.parent_path() / relative_path).lexically_normal().generic_string();
+    }
+
+    void parseProperties(const nlohmann::json& properties, std::vector<Property>& out)
+    {
+        if (!properties.is_array()) return;
+
+        out.reserve(out.size() + properties.size());
+        for (const auto& entry : properties)
+        {
+            const auto value_it = entry.find("value");
+            if (value_it == entry.end()) continue;
+
+            std::string name = entry.value("name", "");
+            const auto& value = *value_it;
+            if (value.is_string())
+            {
+                // Tiled has no nested property values; JSON-in-string ("animation", "sound") is parsed once here instead of by every consumer
+                const std::string& text = value.get_ref<const std::string&>();
+                const auto first = text.find_first_not_of(" \t\r\n");
+                if (first != std::string::npos && (text[first] == '{' || text[first] == '['))
+                {
+                    nlohmann::json nested = nlohmann::json::parse(text, nullptr, false);
+                    if (!nested.is_discarded())
+                    {
+                        out.push_back(propertyFromJson(std::move(name), nested));
+                        continue;
+                    }
+                }
+            }
+            out.push_back(propertyFromJson(std::move(name), value));
+        }
+    }
+
+    bool loadTilesetJson(const std::string& tileset_path, int first_gid, Tileset& tileset)
+    {
+        nlohmann::json json;
+        if (!readJsonFile(tileset_path, json)) return false;
+
+        tileset.firstGid = first_gid;
+        tileset.source = tileset_path;
+        tileset.name = json.value("name", "");
+        tileset.tileSize = {json.value("tilewidth", 0), json.value("tileheight", 0)};
+        tileset.columns = json.value("columns", 0);
+        const int tile_count = json.value("tilecount", 0);
+        const int margin = json.value("margin", 0);
+        const int spacing = json.value("spacing", 0);
+
+        if (json.contains("image"))
+        {
+            tileset.image = resolveTiledPath(tileset_path, json["image"].get<std::string>());
+            tileset.imageSize = {json.value("imagewidth", 0), json.value("imageheight", 0)};
+        }
+
+        // Collection tilesets may skip ids, so the dense table covers the largest id
+        int max_id = tile_count - 1;
+        static const nlohmann::json no_tiles = nlohmann::json::array();
+        const auto& tiles = json.contains("tiles") ? json["tiles"] : no_tiles;
+        for (const auto& tile : tiles)
+        {
+            max_id = std::max(max_id, tile.value("id", 0));
+        }
+        tileset.tiles.assign(static_cast<std::size_t>(std::max(max_id + 1, 0)), TileDefinition{});
+
+        // Grid tilesets: the frame follows from the tile id
+        if (tileset.columns > 0)
+        {
+            for (std::size_t id = 0; id < tileset.tiles.size(); ++id)
+            {
+                const int column = static_cast<int>(id) % tileset.columns;
+                const int row = static_cast<int>(id) / tileset.columns;
+                tileset.tiles[id].frame = engine::utils::Rect{{static_cast<float>(margin + column * (tileset.tileSize.x + spacing)),
+                                                               static_cast<float>(margin + row * (tileset.tileSize.y + spacing))},
+                                                              {static_cast<float>(tileset.tileSize.x), static_cast<float>(tileset.tileSize.y)}};
+            }
+        }
+
+        for (const auto& tile_json : tiles)
+        {
+            TileDefinition& tile = tileset.tiles[static_cast<std::size_t>(tile_json.value("id", 0))];
+            if (tile_json.contains("image"))
+            {
+                // Collection tileset: the whole image, or the sub-rectangle set with x / y / width / height
+                tile.image = resolveTiledPath(tileset_path, tile_json["image"].get<std::string>());
+                const float image_width = tile_json.value("imagewidth", 0.0f);
+                const float image_height = tile_json.value("imageheight", 0.0f);
+                tile.frame = engine::utils::Rect{{tile_json.value("x", 0.0f), tile_json.value("y", 0.0f)},
+                                                 {tile_json.value("width", image_width), tile_json.value("height", image_height)}};
+            }
+            if (tile_json.contains("objectgroup"))
+            {
+                for (const auto& shape : tile_json["objectgroup"].value("objects", nlohmann::json::array()))
+                {
+                    tile.shapes.push_back(rectFromJson(shape));
+                }
+            }
+            if (tile_json.contains("properties")) parseProperties(tile_json["properties"], tile.properties);
+        }
+
+        SPDLOG_TRACE("Tileset '{}' loaded: {} tiles.", tileset_path, tileset.tiles.size());
+        return true;
+    }
+
+    std::optional<LevelData> loadTiledMapJson(const std::string& map_path)
+    {
+        nlohmann::json json;
+        if (!readJsonFile(map_path, json)) return std::nullopt;
+
+        LevelData level;
+        level.path = map_path;
+        level.width = json.value("width", 0);
+        level.height = json.value("height", 0);
+        level.tileSize = {json.value("tilewidth", 0), json.value("tileheight", 0)};
+        level.infinite = json.value("infinite", false);
+        if (json.contains("properties")) parseProperties(json["properties"], level.properties);
+
+        for (const auto& tileset_json : json.value("tilesets", nlohmann::json::array()))
+        {
+            if (!tileset_json.contains("source"))
+            {
+                spdlog::error("Map '{}' embeds a tileset; only external .tsj tilesets are supported.", map_path);
+                return std::nullopt;
+            }
+            Tileset& tileset = level.tilesets.emplace_back();
+            if (!loadTilesetJson(resolveTiledPath(map_path, tileset_json["source"].get<std::string>()), tileset_json.value("firstgid", 1), tileset))
+            {
+                return std::nullopt;
+            }
+        }
+        std::sort(level.tilesets.begin(), level.tilesets.end(), [](const Tileset& a, const Tileset& b) { return a.firstGid < b.firstGid; });
+
+        for (const auto& layer_json : json.value("layers", nlohmann::json::array()))
+        {
+            const std::string type = layer_json.value("type", "");
+            Layer layer;
+            layer.id = layer_json.value("id", 0);
+            layer.name = layer_json.value("name", "");
+            layer.visible = layer_json.value("visible", true);
+            layer.opacity = layer_json.value("opacity", 1.0f);
+            layer.offset = {layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f)};
+            layer.parallax = {layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f)};
+            if (layer_json.contains("properties")) parseProperties(layer_json["properties"], layer.properties);
+
+            if (type == "tilelayer")
+            {
+                layer.type = LayerType::Tile;
+                parseTileLayer(layer_json, layer, level.infinite, map_path);
+            }
+            else if (type == "imagelayer")
+            {
+                layer.type = LayerType::Image;
+                layer.image = resolveTiledPath(map_path, layer_json.value("image", ""));
+                layer.imageSize = {layer_json.value("imagewidth", 0), layer_json.value("imageheight", 0)};
+                layer.repeatX = layer_json.value("repeatx", false);
+                layer.repeatY = layer_json.value("repeaty", false);
+            }
+            else if (type == "objectgroup")
+            {
+                layer.type = LayerType::Object;
+                parseObjectLayer(layer_json, layer);
+            }
+            else
+            {
+                spdlog::warn("Skipping layer '{}' of unsupported type '{}' in '{}'.", layer.name, type, map_path);
+                continue;
+            }
+            level.layers.push_back(std::move(layer));
+        }
+
+        SPDLOG_DEBUG("Map '{}' loaded: {}x{} tiles, {} layers, {} tilesets.", map_path, level.width, level.height, level.layers.size(), level.tilesets.size());
+        return level;
+    }
+}  // namespace engine::level
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "LevelData.h"
+
+namespace engine::level
+{
+    /**
+     * @brief Load a Tiled map (.tmj) and every external tileset (.tsj) it references by parsing them into a JSON DOM.
+     *
+     * This is the reference loader used by the level baker. Errors are logged.
+     * @param map_path path of the .tmj file
+     * @return the level, or std::nullopt on failure
+     */
+    std::optional<LevelData> loadTiledMapJson(const std::string& map_path);
+
+    /**
+     * @brief Load an external Tiled tileset (.tsj)
+     * @param tileset_path path of the .tsj file
+     * @param first_gid first gid assigned to the tileset by the map
+     * @param tileset receives the tileset
+     * @return true on success; errors are logged
+     */
+    bool loadTilesetJson(const std::string& tileset_path, int first_gid, Tileset& tileset);
+
+    /**
+     * @brief Convert a Tiled "properties" array. String values that hold a JSON object or array are parsed into Object / Array properties.
+     */
+    void parseProperties(const nlohmann::json& properties, std::vector<Property>& out);
+
+    /**
+     * @brief Resolve a path stored in a Tiled file (relative to that file) to a normalized path relative to the working directory
+     * @param owner_path path of the .tmj / .tsj file containing the reference
+     * @param relative_path path as written in the file, e.g. "../textures/Layers/back.png"
+     */
+    std::string resolveTiledPath(const std::string& owner_path, const std::string& relative_path);
+}  // namespace engine::level
@@ -0,0 +1,490 @@
+#include "TiledMapStream.h"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+#include "../utils/MappedFile.h"
+#include "TiledJson.h"
+
+namespace engine::level
+{
+    namespace
+    {
+        using json = nlohmann::json;
+
+        /**
+         * @brief Where the parser currently is in the map document
+         */
+        enum class Scope : Uint8
+        {
+            Map,         ///< @brief Root object
+            Layers,      ///< @brief Root "layers" array
+            Layer,       ///< @brief A layer object
+            Data,        ///< @brief A tile layer or chunk "data" array
+            Chunks,      ///< @brief An infinite map tile layer "chunks" array
+            Chunk,       ///< @brief A chunk object
+            Objects,     ///< @brief An object layer "objects" array
+            Object,      ///< @brief A map object
+            Tilesets,    ///< @brief Root "tilesets" array
+            TilesetRef,  ///< @brief A {firstgid, source} entry
+            Properties,  ///< @brief A "properties" array being collected into JSON
+            Skip,        ///< @brief An ignored subtree (group layers, polygons, text, ...)
+        };
+
+        struct TilesetRef
+        {
+            int firstGid = 1;
+            std::string source;
+        };
+
+        /**
+         * @brief SAX handler that writes a .tmj document straight into a LevelData
+         */
+        class TiledMapSaxHandler final : public nlohmann::json_sax<json>
+        {
+          private:
+            LevelData& level_;
+            std::vector<Scope> scopes_;
+            std::string key_;              ///< @brief Last key seen in the current object
+            std::vector<Uint32> scratch_;  ///< @brief Receives "data" arrays; capacity is kept across layers
+            Layer layer_;                  ///< @brief Layer being parsed
+            TileChunk chunk_;              ///< @brief Chunk being parsed
+            std::string layerType_;        ///< @brief Its "type", which comes after most other keys
+            MapObject object_;             ///< @brief Object being parsed
+            std::vector<TilesetRef> tilesetRefs_;
+            int skipDepth_ = 0;
+
+            json captured_;                                   ///< @brief The "properties" array being collected
+            std::vector<json*> captureStack_;                 ///< @brief Open containers inside captured_
+            std::string captureKey_;                          ///< @brief Last key inside captured_
+            std::vector<Property>* captureTarget_ = nullptr;  ///< @brief Where the parsed properties go
+
+          public:
+            explicit TiledMapSaxHandler(LevelData& level) : level_(level) {}
+
+            const std::vector<TilesetRef>& getTilesetRefs() const { return tilesetRefs_; }
+
+            bool null() override
+            {
+                if (scope() == Scope::Properties) capture(json(nullptr));
+                return true;
+            }
+
+            bool boolean(bool value) override
+            {
+                if (scope() == Scope::Properties) return capture(json(value));
+                return onNumber(value ? 1.0 : 0.0);
+            }
+
+            bool number_integer(json::number_integer_t value) override
+            {
+                if (scope() == Scope::Properties) return capture(json(value));
+                if (scope() == Scope::Data) return onGid(static_cast<Uint64>(value));
+                return onNumber(static_cast<double>(value));
+            }
+
+            bool number_unsigned(json::number_unsigned_t value) override
+            {
+                if (scope() == Scope::Properties) return capture(json(value));
+                if (scope() == Scope::Data) return onGid(value);
+                return onNumber(static_cast<double>(value));
+            }
+
+            bool number_float(json::number_float_t value, const json::string_t&) override
+            {
+                if (scope() == Scope::Properties) return capture(json(value));
+                return onNumber(value);
+            }
+
+            bool string(json::string_t& value) override
+            {
+                if (scope() == Scope::Properties) return capture(json(value));
+                return onString(value);
+            }
+
+            bool binary(json::binary_t&) override { return true; }
+
+            bool key(json::string_t& value) override
+            {
+                if (scope() == Scope::Properties)
+                {
+                    captureKey_ = value;
+                }
+                else if (scope() != Scope::Skip)
+                {
+                    key_ = value;
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t) override
+            {
+                if (scopes_.empty())
+                {
+                    scopes_.push_back(Scope::Map);
+                    return true;
+                }
+
+                switch (scope())
+                {
+                    case Scope::Skip:
+                        ++skipDepth_;
+                        break;
+                    case Scope::Properties:
+                        captureStack_.push_back(captureInsert(json::object()));
+                        break;
+                    case Scope::Layers:
+                        layer_ = Layer{};
+                        layerType_.clear();
+                        scopes_.push_back(Scope::Layer);
+                        break;
+                    case Scope::Objects:
+                        object_ = MapObject{};
+                        scopes_.push_back(Scope::Object);
+                        break;
+                    case Scope::Chunks:
+                        chunk_ = TileChunk{};
+                        scopes_.push_back(Scope::Chunk);
+                        break;
+                    case Scope::Tilesets:
+                        tilesetRefs_.emplace_back();
+                        scopes_.push_back(Scope::TilesetRef);
+                        break;
+                    default:
+                        beginSkip();  // e.g. an object's "text"
+                        break;
+                }
+                return true;
+            }
+
+            bool end_object() override
+            {
+                switch (scope())
+                {
+                    case Scope::Skip:
+                        endSkip();
+                        break;
+                    case Scope::Properties:
+                        captureStack_.pop_back();
+                        break;
+                    case Scope::Layer:
+                        scopes_.pop_back();
+                        finishLayer();
+                        break;
+                    case Scope::Object:
+                        scopes_.pop_back();
+                        layer_.objects.push_back(std::move(object_));
+                        break;
+                    case Scope::Chunk:
+                        scopes_.pop_back();
+                        finishChunk();
+                        break;
+                    default:
+                        scopes_.pop_back();
+                        break;
+                }
+                return true;
+            }
+
+            bool start_array(std::size_t) override
+            {
+                const Scope current = scope();
+                if (current == Scope::Skip)
+                {
+                    ++skipDepth_;
+                }
+                else if (current == Scope::Properties)
+                {
+                    captureStack_.push_back(captureInsert(json::array()));
+                }
+                else if (key_ == "properties" && (current == Scope::Map || current == Scope::Layer || current == Scope::Object))
+                {
+                    captureTarget_ = current == Scope::Map ? &level_.properties : current == Scope::Layer ? &layer_.properties : &object_.properties;
+                    captured_ = json::array();
+                    captureStack_.assign(1, &captured_);
+                    scopes_.push_back(Scope::Properties);
+                }
+                else if (current == Scope::Map && key_ == "layers")
+                {
+                    scopes_.push_back(Scope::Layers);
+                }
+                else if (current == Scope::Map && key_ == "tilesets")
+                {
+                    scopes_.push_back(Scope::Tilesets);
+                }
+                else if ((current == Scope::Layer || current == Scope::Chunk) && key_ == "data")
+                {
+                    scratch_.clear();
+                    reserveData(current == Scope::Chunk ? chunk_.width : layer_.width, current == Scope::Chunk ? chunk_.height : layer_.height);
+                    scopes_.push_back(Scope::Data);
+                }
+                else if (current == Scope::Layer && key_ == "objects")
+                {
+                    scopes_.push_back(Scope::Objects);
+                }
+                else if (current == Scope::Layer && key_ == "chunks")
+                {
+                    scopes_.push_back(Scope::Chunks);
+                }
+                else
+                {
+                    beginSkip();  // group layer "layers", polygons, ...
+                }
+                return true;
+            }
+
+            bool end_array() override
+            {
+                switch (scope())
+                {
+                    case Scope::Skip:
+                        endSkip();
+                        break;
+                    case Scope::Properties:
+                        if (captureStack_.size() > 1)
+                        {
+                            captureStack_.pop_back();
+                            break;
+                        }
+                        scopes_.pop_back();
+                        captureStack_.clear();
+                        parseProperties(captured_, *captureTarget_);
+                        break;
+                    case Scope::Data:
+                        scopes_.pop_back();
+                        if (scope() == Scope::Chunk)
+                        {
+                            chunk_.tiles.assign(scratch_.begin(), scratch_.end());
+                        }
+                        else
+                        {
+                            layer_.tiles.assign(scratch_.begin(), scratch_.end());  // The only allocation per tile layer
+                        }
+                        break;
+                    default:
+                        scopes_.pop_back();
+                        break;
+                }
+                return true;
+            }
+
+            bool parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex) override
+            {
+                spdlog::error("Failed to parse '{}' at byte {} near '{}': {}", level_.path, position, last_token, ex.what());
+                return false;
+            }
+
+          private:
+            Scope scope() const { return scopes_.empty() ? Scope::Map : scopes_.back(); }
+
+            void beginSkip()
+            {
+                scopes_.push_back(Scope::Skip);
+                skipDepth_ = 1;
+            }
+
+            void endSkip()
+            {
+                if (--skipDepth_ == 0) scopes_.pop_back();
+            }
+
+            /**
+             * @brief Size scratch_ for the "data" array about to be read, from the layer or chunk size if it came first, else
+             * the map size. Tiled writes "data" before "width" / "height"; then the first layer grows scratch_ and later ones
+             * reuse its capacity, so the peak stays around one layer rather than the whole file.
+             */
+            void reserveData(int width, int height)
+            {
+                if (width <= 0 || height <= 0)
+                {
+                    width = level_.width;
+                    height = level_.height;
+                }
+                if (width > 0 && height > 0) scratch_.reserve(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+            }
+
+            bool capture(json value)
+            {
+                captureInsert(std::move(value));
+                return true;
+            }
+
+            json* captureInsert(json value)
+            {
+                json* parent = captureStack_.back();
+                if (parent->is_array())
+                {
+                    parent->push_back(std::move(value));
+                    return &parent->back();
+                }
+                json& slot = (*parent)[captureKey_];
+                slot = std::move(value);
+                return &slot;
+            }
+
+            bool onGid(Uint64 gid)
+            {
+                scratch_.push_back(static_cast<Uint32>(gid));
+                return true;
+            }
+
+            bool onNumber(double value)
+            {
+                switch (scope())
+                {
+                    case Scope::Map:
+                        if (key_ == "width") level_.width = static_cast<int>(value);
+                        else if (key_ == "height") level_.height = static_cast<int>(value);
+                        else if (key_ == "tilewidth") level_.tileSize.x = static_cast<int>(value);
+                        else if (key_ == "tileheight") level_.tileSize.y = static_cast<int>(value);
+                        else if (key_ == "infinite") level_.infinite = value != 0.0;
+                        break;
+                    case Scope::Layer:
+                        if (key_ == "id") layer_.id = static_cast<int>(value);
+                        else if (key_ == "visible") layer_.visible = value != 0.0;
+                        else if (key_ == "opacity") layer_.opacity = static_cast<float>(value);
+                        else if (key_ == "offsetx") layer_.offset.x = static_cast<float>(value);
+                        else if (key_ == "offsety") layer_.offset.y = static_cast<float>(value);
+                        else if (key_ == "parallaxx") layer_.parallax.x = static_cast<float>(value);
+                        else if (key_ == "parallaxy") layer_.parallax.y = static_cast<float>(value);
+                        else if (key_ == "width") layer_.width = static_cast<int>(value);
+                        else if (key_ == "height") layer_.height = static_cast<int>(value);
+                        else if (key_ == "imagewidth") layer_.imageSize.x = static_cast<int>(value);
+                        else if (key_ == "imageheight") layer_.imageSize.y = static_cast<int>(value);
+                        else if (key_ == "repeatx") layer_.repeatX = value != 0.0;
+                        else if (key_ == "repeaty") layer_.repeatY = value != 0.0;
+                        break;
+                    case Scope::Object:
+                        if (key_ == "id") object_.id = static_cast<int>(value);
+                        else if (key_ == "gid") object_.gid = static_cast<Uint32>(value);
+                        else if (key_ == "x") object_.position.x = static_cast<float>(value);
+                        else if (key_ == "y") object_.position.y = static_cast<float>(value);
+                        else if (key_ == "width") object_.size.x = static_cast<float>(value);
+                        else if (key_ == "height") object_.size.y = static_cast<float>(value);
+                        else if (key_ == "rotation") object_.rotation = static_cast<float>(value);
+                        else if (key_ == "visible") object_.visible = value != 0.0;
+                        else if (key_ == "point") object_.point = value != 0.0;
+                        break;
+                    case Scope::Chunk:
+                        if (key_ == "x") chunk_.x = static_cast<int>(value);
+                        else if (key_ == "y") chunk_.y = static_cast<int>(value);
+                        else if (key_ == "width") chunk_.width = static_cast<int>(value);
+                        else if (key_ == "height") chunk_.height = static_cast<int>(value);
+                        break;
+                    case Scope::TilesetRef:
+                        if (key_ == "firstgid") tilesetRefs_.back().firstGid = static_cast<int>(value);
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            bool onString(json::string_t& value)
+            {
+                switch (scope())
+                {
+                    case Scope::Layer:
+                        if (key_ == "name") layer_.name = value;
+                        else if (key_ == "type") layerType_ = value;
+                        else if (key_ == "image") layer_.image = resolveTiledPath(level_.path, value);
+                        break;
+                    case Scope::Object:
+                        if (key_ == "name") object_.name = value;
+                        else if (key_ == "type") object_.type = value;
+                        break;
+                    case Scope::TilesetRef:
+                        if (key_ == "source") tilesetRefs_.back().source = value;
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            void finishChunk()
+            {
+                if (chunk_.tiles.size() != static_cast<std::size_t>(chunk_.width) * static_cast<std::size_t>(chunk_.height))
+                {
+                    spdlog::error("Skipping malformed chunk ({}, {}) of layer '{}' in '{}'.", chunk_.x, chunk_.y, layer_.name, level_.path);
+                    return;
+                }
+                layer_.chunks.push_back(std::move(chunk_));
+            }
+
+            void finishLayer()
+            {
+                if (layerType_ == "tilelayer" && (level_.infinite || !layer_.chunks.empty()))
+                {
+                    // Infinite maps keep their chunks; there is no dense grid to check
+                    layer_.type = LayerType::Tile;
+                    layer_.tiles.clear();
+                }
+                else if (layerType_ == "tilelayer")
+                {
+                    layer_.type = LayerType::Tile;
+                    const std::size_t expected = static_cast<std::size_t>(layer_.width) * static_cast<std::size_t>(layer_.height);
+                    if (layer_.tiles.size() != expected)
+                    {
+                        // Base64 / compressed layer data is not supported, export maps with the CSV layer format
+                        spdlog::error("Layer '{}' in '{}' has no plain 'data' array, tiles are left empty.", layer_.name, level_.path);
+                        layer_.tiles.assign(expected, 0);
+                    }
+                }
+                else if (layerType_ == "imagelayer")
+                {
+                    layer_.type = LayerType::Image;
+                }
+                else if (layerType_ == "objectgroup")
+                {
+                    layer_.type = LayerType::Object;
+                }
+                else
+                {
+                    spdlog::warn("Skipping layer '{}' of unsupported type '{}' in '{}'.", layer_.name, layerType_, level_.path);
+                    return;
+                }
+                level_.layers.push_back(std::move(layer_));
+            }
+        };
+    }  // namespace
+
+    std::optional<LevelData> loadTiledMapStreaming(const std::string& map_path)
+    {
+        [[maybe_unused]] const Uint64 start = SDL_GetTicksNS();  // Only read by SPDLOG_DEBUG
+        engine::utils::MappedFile file;
+        if (!file.open(map_path)) return std::nullopt;
+
+        LevelData level;
+        level.path = map_path;
+        TiledMapSaxHandler handler(level);
+        const char* text = reinterpret_cast<const char*>(file.data());
+        if (!json::sax_parse(text, text + file.size(), &handler))
+        {
+            return std::nullopt;
+        }
+        file.close();
+
+        for (const auto& ref : handler.getTilesetRefs())
+        {
+            if (ref.source.empty())
+            {
+                spdlog::error("Map '{}' embeds a tileset; only external .tsj tilesets are supported.", map_path);
+                return std::nullopt;
+            }
+            Tileset& tileset = level.tilesets.emplace_back();
+            if (!loadTilesetJson(resolveTiledPath(map_path, ref.source), ref.firstGid, tileset))
+            {
+                return std::nullopt;
+            }
+        }
+        std::sort(level.tilesets.begin(), level.tilesets.end(), [](const Tileset& a, const Tileset& b) { return a.firstGid < b.firstGid; });
+
+        SPDLOG_DEBUG("Map '{}' streamed in {:.3f} ms: {}x{} tiles, {} layers, {} tilesets.", map_path, (SDL_GetTicksNS() - start) / 1'000'000.0, level.width,
+                     level.height, level.layers.size(), level.tilesets.size());
+        return level;
+    }
+}  // namespace engine::level
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "LevelData.h"
+
+namespace engine::level
+{
+    /**
+     * @brief Load a Tiled map (.tmj) without building a JSON DOM.
+     *
+     * The memory-mapped file is fed to nlohmann's SAX parser; tile "data" arrays are written into one reusable scratch buffer and
+     * copied once into an exactly sized tile vector, objects and image layers are filled field by field. Only "properties" arrays,
+     * which are small, are collected into a JSON value to share parseProperties(). External tilesets are loaded with loadTilesetJson().
+     * The result is identical to loadTiledMapJson(). Errors are logged.
+     *
+     * @param map_path path of the .tmj file
+     * @return the level, or std::nullopt on failure
+     */
+    std::optional<LevelData> loadTiledMapStreaming(const std::string& map_path);
+}  // namespace engine::level
@@ -0,0 +1,630 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <malloc.h>
+#include <windows.h>
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#define SUNNYLAND_HAS_EXECINFO 1
+#endif
+
+namespace engine::memory
+{
+    namespace
+    {
+        /**
+         * @brief Frames of the hook on top of every captured stack: captureStack(), recordCallSite(), recordAllocation(), operator new
+         */
+        constexpr int HOOK_FRAMES = 4;
+        constexpr std::size_t MAX_PROBES = 64;
+        constexpr std::size_t SITE_MASK = AllocationTracker::MAX_CALL_SITES - 1;
+        static_assert((AllocationTracker::MAX_CALL_SITES & SITE_MASK) == 0, "MAX_CALL_SITES must be a power of two");
+
+        struct CallSite
+        {
+            Uint64 hash = 0;  ///< @brief 0 marks a free slot
+            void* frames[AllocationTracker::CALL_STACK_DEPTH] = {};
+            int depth = 0;
+            AllocTag tag = AllocTag::Untagged;
+            Uint64 allocations = 0;
+            Uint64 bytes = 0;
+            Uint64 lastFrame = 0;         ///< @brief Frame of the last allocation made by the frame thread
+            Uint64 frameAllocations = 0;  ///< @brief Allocations of the frame thread during lastFrame
+        };
+
+        /**
+         * @brief Spin lock around the call site table; it must not allocate and is only held for a table update
+         */
+        class SpinLock
+        {
+          private:
+            std::atomic_flag flag_;
+
+          public:
+            void lock()
+            {
+                while (flag_.test_and_set(std::memory_order_acquire))
+                {
+                    while (flag_.test(std::memory_order_relaxed))
+                    {
+                    }
+                }
+            }
+            void unlock() { flag_.clear(std::memory_order_release); }
+        };
+
+        // Constant initialised, so allocations made during static initialisation find valid (disabled) state
+        std::atomic<bool> g_enabled{false};
+        std::atomic<Uint64> g_frame{1};
+        std::atomic<Uint64> g_frameAllocations[ALLOC_TAG_COUNT];
+        std::atomic<Uint64> g_frameBytes[ALLOC_TAG_COUNT];
+        std::atomic<Uint64> g_frameFrees{0};
+        std::atomic<Uint64> g_droppedSites{0};
+
+        SpinLock g_sitesLock;
+        CallSite g_sites[AllocationTracker::MAX_CALL_SITES];
+
+        thread_local AllocTag t_tag = AllocTag::Untagged;
+        thread_local bool t_inTracker = false;    ///< @brief Set while the tracker itself runs on this thread: its allocations are not counted
+        thread_local bool t_frameThread = false;  ///< @brief The thread calling endFrame()
+        thread_local Uint64 t_allocations = 0;    ///< @brief Allocations of this thread since its last endFrame()
+
+        // --- Main thread only ---
+        AllocationFrameStats g_lastFrame;
+        std::array<Uint64, ALLOC_TAG_COUNT> g_totalAllocations{};
+        std::array<Uint64, ALLOC_TAG_COUNT> g_totalBytes{};
+        AllocationFrameStats g_worstFrame;
+        Uint64 g_worstFrameIndex = 0;
+        Uint64 g_frames = 0;
+        bool g_expectNoAllocations = false;
+
+        /**
+         * @brief Makes the tracker ignore allocations of the current thread for a scope, so reporting cannot recurse into itself
+         */
+        class TrackerGuard
+        {
+          private:
+            bool previous_;
+
+          public:
+            TrackerGuard() : previous_(t_inTracker) { t_inTracker = true; }
+            ~TrackerGuard() { t_inTracker = previous_; }
+        };
+
+        [[gnu::noinline]] int captureStack(void** frames)
+        {
+            void* raw[AllocationTracker::CALL_STACK_DEPTH + HOOK_FRAMES];
+#if defined(_WIN32)
+            const int captured = CaptureStackBackTrace(0, AllocationTracker::CALL_STACK_DEPTH + HOOK_FRAMES, raw, nullptr);
+#elif defined(SUNNYLAND_HAS_EXECINFO)
+            const int captured = backtrace(raw, AllocationTracker::CALL_STACK_DEPTH + HOOK_FRAMES);
+#else
+            const int captured = 0;
+#endif
+            const int depth = std::max(captured - HOOK_FRAMES, 0);
+            std::copy_n(raw + HOOK_FRAMES, depth, frames);
+            return depth;
+        }
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        Uint64 hashStack(void* const* frames, int depth, AllocTag tag)
+        {
+            Uint64 hash = 14695981039346656037ULL ^ static_cast<Uint64>(tag);
+            for (int i = 0; i < depth; ++i)
+            {
+                hash = (hash ^ reinterpret_cast<std::uintptr_t>(frames[i])) * 1099511628211ULL;
+            }
+            return hash == 0 ? 1 : hash;
+        }
+
+        [[gnu::noinline]] void recordCallSite(AllocTag tag, std::size_t size)
+        {
+            void* frames[AllocationTracker::CALL_STACK_DEPTH];
+            const int depth = captureStack(frames);
+            const Uint64 hash = hashStack(frames, depth, tag);
+            const Uint64 frame = g_frame.load(std::memory_order_relaxed);
+
+            g_sitesLock.lock();
+            for (std::size_t probe = 0; probe < MAX_PROBES; ++probe)
+            {
+                CallSite& site = g_sites[(hash + probe) & SITE_MASK];
+                if (site.hash == 0)
+                {
+                    site.hash = hash;
+                    std::copy_n(frames, depth, site.frames);
+                    site.depth = depth;
+                    site.tag = tag;
+                }
+                else if (site.hash != hash)
+                {
+                    continue;
+                }
+
+                ++site.allocations;
+                site.bytes += size;
+                if (t_frameThread)
+                {
+                    if (site.lastFrame != frame)
+                    {
+                        site.lastFrame = frame;
+                        site.frameAllocations = 0;
+                    }
+                    ++site.frameAllocations;
+                }
+                g_sitesLock.unlock();
+                return;
+            }
+            g_sitesLock.unlock();
+            g_droppedSites.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[gnu::noinline]] void recordAllocation(std::size_t size)
+        {
+            if (!g_enabled.load(std::memory_order_relaxed) || t_inTracker) return;
+            t_inTracker = true;
+
+            const auto tag = static_cast<std::size_t>(t_tag);
+            g_frameAllocations[tag].fetch_add(1, std::memory_order_relaxed);
+            g_frameBytes[tag].fetch_add(size, std::memory_order_relaxed);
+            ++t_allocations;
+            recordCallSite(t_tag, size);
+
+            t_inTracker = false;
+        }
+
+        void recordFree(void* pointer)
+        {
+            if (pointer != nullptr && g_enabled.load(std::memory_order_relaxed) && !t_inTracker)
+            {
+                g_frameFrees.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Free for the unaligned operator delete. Not inlined: inlined into the allocating functions of this file,
+         * the plain free() would be reported as a new / free mismatch.
+         */
+        [[gnu::noinline]] void release(void* pointer)
+        {
+            recordFree(pointer);
+            std::free(pointer);
+        }
+#endif
+
+        std::vector<CallSite> copySites()
+        {
+            std::vector<CallSite> sites;
+            sites.reserve(AllocationTracker::MAX_CALL_SITES);
+            g_sitesLock.lock();
+            for (const CallSite& site : g_sites)
+            {
+                if (site.hash != 0) sites.push_back(site);
+            }
+            g_sitesLock.unlock();
+            return sites;
+        }
+
+        /**
+         * @brief "function+offset (module)" when symbols are available, the address otherwise
+         */
+        std::vector<std::string> symbolize(const CallSite& site)
+        {
+            std::vector<std::string> lines;
+#if defined(SUNNYLAND_HAS_EXECINFO)
+            char** symbols = backtrace_symbols(site.frames, site.depth);
+            for (int i = 0; i < site.depth; ++i)
+            {
+                std::string line = symbols ? symbols[i] : fmt::format("{}", site.frames[i]);
+                // glibc: "module(mangled+0x1f) [0x...]"; macOS: "3 module 0x... mangled + 31"
+                const auto open = line.find('(');
+                const auto plus = line.find('+', open);
+                if (open != std::string::npos && plus != std::string::npos && plus > open + 1)
+                {
+                    int status = 0;
+                    char* demangled = abi::__cxa_demangle(line.substr(open + 1, plus - open - 1).c_str(), nullptr, nullptr, &status);
+                    if (status == 0 && demangled) line = fmt::format("{}{} ({})", demangled, line.substr(plus, line.find(')', plus) - plus), line.substr(0, open));
+                    std::free(demangled);
+                }
+                lines.push_back(std::move(line));
+            }
+            std::free(symbols);
+#else
+            for (int i = 0; i < site.depth; ++i)
+            {
+                lines.push_back(fmt::format("{}", site.frames[i]));
+            }
+#endif
+            return lines;
+        }
+
+        void logCallSite(const CallSite& site, const std::string& summary)
+        {
+            spdlog::info("  {} [{}]", summary, getAllocTagName(site.tag));
+            for (const std::string& frame : symbolize(site))
+            {
+                spdlog::info("      {}", frame);
+            }
+        }
+
+        /**
+         * @brief Called with the frame thread's allocations of a frame expected to make none; does not return
+         */
+        [[noreturn]] void reportViolation(const AllocationFrameStats& frame, Uint64 frame_index)
+        {
+            TrackerGuard guard;
+            spdlog::critical("Steady-state frame {} allocated {} times on the frame thread ({} allocations, {} bytes on all threads). Call sites:", frame_index,
+                             frame.frameThreadAllocations, frame.totalAllocations(), frame.totalBytes());
+            for (const CallSite& site : copySites())
+            {
+                if (site.lastFrame == frame_index && site.frameAllocations > 0) logCallSite(site, fmt::format("{:>8} allocs", site.frameAllocations));
+            }
+            spdlog::shutdown();
+            std::abort();
+        }
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        void* allocate(std::size_t size)
+        {
+            if (size == 0) size = 1;
+            while (true)
+            {
+                if (void* pointer = std::malloc(size)) return pointer;
+                std::new_handler handler = std::get_new_handler();
+                if (!handler) return nullptr;
+                handler();
+            }
+        }
+
+        void* allocateAligned(std::size_t size, std::size_t alignment)
+        {
+            if (size == 0) size = 1;
+            while (true)
+            {
+#if defined(_WIN32)
+                if (void* pointer = _aligned_malloc(size, alignment)) return pointer;
+#else
+                void* pointer = nullptr;
+                if (posix_memalign(&pointer, std::max(alignment, sizeof(void*)), size) == 0) return pointer;
+#endif
+                std::new_handler handler = std::get_new_handler();
+                if (!handler) return nullptr;
+                handler();
+            }
+        }
+
+        /**
+         * @brief Free for the aligned operator delete, see release()
+         */
+        [[gnu::noinline]] void releaseAligned(void* pointer)
+        {
+            recordFree(pointer);
+#if defined(_WIN32)
+            _aligned_free(pointer);
+#else
+            std::free(pointer);
+#endif
+        }
+#endif
+    }  // namespace
+
+    const char* getAllocTagName(AllocTag tag)
+    {
+        switch (tag)
+        {
+            case AllocTag::Untagged:
+                return "untagged";
+            case AllocTag::Core:
+                return "core";
+            case AllocTag::Render:
+                return "render";
+            case AllocTag::Resource:
+                return "resource";
+            case AllocTag::Audio:
+                return "audio";
+            case AllocTag::Level:
+                return "level";
+            case AllocTag::Count:
+                break;
+        }
+        return "?";
+    }
+
+    Uint64 AllocationFrameStats::totalAllocations() const
+    {
+        Uint64 total = 0;
+        for (const Uint64 count : allocations)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    Uint64 AllocationFrameStats::totalBytes() const
+    {
+        Uint64 total = 0;
+        for (const Uint64 count : bytes)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    AllocationScope::AllocationScope(AllocTag tag) : previous_(t_tag)
+    {
+        t_tag = tag;
+    }
+
+    AllocationScope::~AllocationScope()
+    {
+        t_tag = previous_;
+    }
+
+    bool AllocationTracker::isAvailable()
+    {
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void AllocationTracker::enable()
+    {
+        {
+            // The first backtrace() loads the unwinder, which must not happen inside the hook
+            TrackerGuard guard;
+            void* frames[CALL_STACK_DEPTH];
+            captureStack(frames);
+        }
+        t_frameThread = true;
+        t_allocations = 0;
+        g_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::disable()
+    {
+        g_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    bool AllocationTracker::isEnabled()
+    {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    const AllocationFrameStats& AllocationTracker::endFrame()
+    {
+        t_frameThread = true;
+        AllocationFrameStats frame;
+        for (std::size_t tag = 0; tag < ALLOC_TAG_COUNT; ++tag)
+        {
+            frame.allocations[tag] = g_frameAllocations[tag].exchange(0, std::memory_order_relaxed);
+            frame.bytes[tag] = g_frameBytes[tag].exchange(0, std::memory_order_relaxed);
+            g_totalAllocations[tag] += frame.allocations[tag];
+            g_totalBytes[tag] += frame.bytes[tag];
+        }
+        frame.frees = g_frameFrees.exchange(0, std::memory_order_relaxed);
+        frame.frameThreadAllocations = t_allocations;
+        t_allocations = 0;
+        const Uint64 frame_index = g_frame.fetch_add(1, std::memory_order_relaxed);
+
+        if (!g_enabled.load(std::memory_order_relaxed)) return g_lastFrame;
+        ++g_frames;
+        if (frame.totalAllocations() > g_worstFrame.totalAllocations())
+        {
+            g_worstFrame = frame;
+            g_worstFrameIndex = frame_index;
+        }
+        g_lastFrame = frame;
+
+        if (g_expectNoAllocations && frame.frameThreadAllocations > 0) reportViolation(frame, frame_index);
+        return g_lastFrame;
+    }
+
+    void AllocationTracker::expectNoAllocations(bool expect)
+    {
+        g_expectNoAllocations = expect;
+        t_frameThread = true;
+        t_allocations = 0;
+    }
+
+    const AllocationFrameStats& AllocationTracker::getLastFrame()
+    {
+        return g_lastFrame;
+    }
+
+    void AllocationTracker::logReport(std::size_t top_sites)
+    {
+        TrackerGuard guard;
+        if (!isAvailable())
+        {
+            spdlog::info("Allocation tracking not built in (SUNNYLAND_ENABLE_ALLOC_TRACKING is off).");
+            return;
+        }
+        if (g_frames == 0)
+        {
+            spdlog::info("Allocation tracking: no frame recorded.");
+            return;
+        }
+
+        spdlog::info("Allocations over {} frames (per frame: allocations / bytes):", g_frames);
+        const double frames = static_cast<double>(g_frames);
+        for (std::size_t tag = 0; tag < ALLOC_TAG_COUNT; ++tag)
+        {
+            if (g_totalAllocations[tag] == 0) continue;
+            spdlog::info("  {:<9} {:>10} allocs {:>12} bytes  ({:.1f} / {:.0f})", getAllocTagName(static_cast<AllocTag>(tag)), g_totalAllocations[tag], g_totalBytes[tag],
+                         g_totalAllocations[tag] / frames, g_totalBytes[tag] / frames);
+        }
+        spdlog::info("  Worst frame {}: {} allocs, {} bytes.", g_worstFrameIndex, g_worstFrame.totalAllocations(), g_worstFrame.totalBytes());
+
+        std::vector<CallSite> sites = copySites();
+        const std::size_t shown = std::min(top_sites, sites.size());
+        std::partial_sort(sites.begin(), sites.begin() + static_cast<std::ptrdiff_t>(shown), sites.end(),
+                          [](const CallSite& a, const CallSite& b) { return a.allocations > b.allocations; });
+        spdlog::info("Top {} of {} allocation call sites{}:", shown, sites.size(),
+                     g_droppedSites.load(std::memory_order_relaxed) > 0 ? fmt::format(" ({} allocations from untracked sites)", g_droppedSites.load()) : "");
+        for (std::size_t i = 0; i < shown; ++i)
+        {
+            logCallSite(sites[i], fmt::format("{:>8} allocs {:>10} bytes", sites[i].allocations, sites[i].bytes));
+        }
+    }
+}  // namespace engine::memory
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+
+// Replacements of the global allocation functions. Every operator new records before allocating, so its own frame is
+// still on the stack that recordAllocation() captures (HOOK_FRAMES). The nothrow forms turn the std::bad_alloc a new_handler may
+// throw into nullptr.
+
+void* operator new(std::size_t size)
+{
+    engine::memory::recordAllocation(size);
+    if (void* pointer = engine::memory::allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    engine::memory::recordAllocation(size);
+    if (void* pointer = engine::memory::allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    engine::memory::recordAllocation(size);
+    try
+    {
+        return engine::memory::allocate(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    engine::memory::recordAllocation(size);
+    try
+    {
+        return engine::memory::allocate(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    engine::memory::recordAllocation(size);
+    if (void* pointer = engine::memory::allocateAligned(size, static_cast<std::size_t>(alignment))) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    engine::memory::recordAllocation(size);
+    if (void* pointer = engine::memory::allocateAligned(size, static_cast<std::size_t>(alignment))) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    engine::memory::recordAllocation(size);
+    try
+    {
+        return engine::memory::allocateAligned(size, static_cast<std::size_t>(alignment));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    engine::memory::recordAllocation(size);
+    try
+    {
+        return engine::memory::allocateAligned(size, static_cast<std::size_t>(alignment));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* pointer) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    engine::memory::release(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    engine::memory::releaseAligned(pointer);
+}
+
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
+
+namespace engine::memory
+{
+    /**
+     * @brief Subsystem an allocation is charged to, taken from the innermost AllocationScope of the allocating thread
+     */
+    enum class AllocTag : Uint8
+    {
+        Untagged,  ///< @brief Outside any scope: startup, third-party threads
+        Core,      ///< @brief Frame loop, input, game logic, saving
+        Render,    ///< @brief Drawing and presenting
+        Resource,  ///< @brief Asset loading, caching and hot reload
+        Audio,     ///< @brief Audio thread and command execution
+        Level,     ///< @brief Level loading and chunk streaming
+        Count
+    };
+
+    inline constexpr std::size_t ALLOC_TAG_COUNT = static_cast<std::size_t>(AllocTag::Count);
+
+    /**
+     * @brief Name of a tag for reports
+     */
+    const char* getAllocTagName(AllocTag tag);
+
+    /**
+     * @brief Allocations made during one frame, per tag
+     */
+    struct AllocationFrameStats
+    {
+        std::array<Uint64, ALLOC_TAG_COUNT> allocations{};  ///< @brief operator new calls
+        std::array<Uint64, ALLOC_TAG_COUNT> bytes{};        ///< @brief Bytes requested from operator new
+        Uint64 frees = 0;                                   ///< @brief operator delete calls, any tag
+        Uint64 frameThreadAllocations = 0;                  ///< @brief Allocations made by the thread calling endFrame()
+
+        [[nodiscard]] Uint64 totalAllocations() const;
+        [[nodiscard]] Uint64 totalBytes() const;
+    };
+
+    /**
+     * @brief Charges allocations made on this thread to a tag until the scope ends. Use ENGINE_ALLOC_SCOPE instead of naming it.
+     */
+    class AllocationScope final
+    {
+      private:
+        AllocTag previous_;
+
+      public:
+        explicit AllocationScope(AllocTag tag);
+        ~AllocationScope();
+
+        // Delete copy and move constructors and assignment operators
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+        AllocationScope(AllocationScope&&) = delete;
+        AllocationScope& operator=(AllocationScope&&) = delete;
+    };
+
+    /**
+     * @brief Global heap allocation counters, per subsystem and per frame.
+     *
+     * With SUNNYLAND_ENABLE_ALLOC_TRACKING defined (see CMakeLists.txt) AllocationTracker.cpp replaces the global
+     * operator new / delete. Once enable() is called, every operator new is counted and charged to the tag of the
+     * allocating thread's innermost AllocationScope; malloc and SDL's own allocations are not seen. Each allocation's
+     * call stack is also recorded into a fixed table (no allocation inside the hook), from which logReport() lists
+     * the call sites that allocated most.
+     *
+     * endFrame() closes the frame's counters. When zero-allocation frames are expected (expectNoAllocations()), a frame
+     * in which the main thread allocated is reported with its call sites and aborts the process, so a test run fails
+     * on the first per-frame allocation regression. Other threads (audio, streaming, logging) are counted but never
+     * fail the check.
+     *
+     * Without the option nothing is hooked: the functions exist but every counter stays zero.
+     */
+    class AllocationTracker final
+    {
+      public:
+        static constexpr std::size_t MAX_CALL_SITES = 4096;  ///< @brief Distinct call stacks recorded; later ones are only counted
+        static constexpr int CALL_STACK_DEPTH = 8;           ///< @brief Frames kept per call site, the hook itself excluded
+
+        AllocationTracker() = delete;
+
+        /**
+         * @brief True when the build replaces operator new / delete
+         */
+        static bool isAvailable();
+
+        /**
+         * @brief Start counting; allocations before this (static initialisation, startup) are ignored
+         */
+        static void enable();
+        static void disable();
+        [[nodiscard]] static bool isEnabled();
+
+        /**
+         * @brief Close the current frame's counters; call once per frame from the main loop
+         * @return the frame that just ended
+         */
+        static const AllocationFrameStats& endFrame();
+
+        /**
+         * @brief Abort on the next frames in which the calling thread of endFrame() allocates. Arm it once the game has
+         * reached a steady state (after loading and warm-up).
+         */
+        static void expectNoAllocations(bool expect);
+
+        /**
+         * @return the last frame closed by endFrame()
+         */
+        [[nodiscard]] static const AllocationFrameStats& getLastFrame();
+
+        /**
+         * @brief Log the per-tag totals, the worst frame and the top_sites call sites with the most allocations
+         */
+        static void logReport(std::size_t top_sites = 10);
+    };
+}  // namespace engine::memory
+
+#define ENGINE_ALLOC_CONCAT_IMPL(a, b) a##b
+#define ENGINE_ALLOC_CONCAT(a, b) ENGINE_ALLOC_CONCAT_IMPL(a, b)
+
+#ifdef SUNNYLAND_ENABLE_ALLOC_TRACKING
+/// @brief Charge the allocations of the rest of the enclosing scope to AllocTag::tag
+#define ENGINE_ALLOC_SCOPE(tag) ::engine::memory::AllocationScope ENGINE_ALLOC_CONCAT(engine_alloc_scope_, __LINE__)(::engine::memory::AllocTag::tag)
+#else
+#define ENGINE_ALLOC_SCOPE(tag) ((void)0)
+#endif
@@ -0,0 +1,57 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <spdlog/spdlog.h>
+
+#include "../core/Log.h"
+
+namespace engine::memory
+{
+    namespace
+    {
+        std::byte* alignPointer(std::byte* pointer, std::size_t alignment)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+            return pointer + (((address + alignment - 1) & ~(alignment - 1)) - address);
+        }
+    }  // namespace
+
+    FrameArena::FrameArena(std::size_t capacity) : capacity_(capacity)
+    {
+        storage_ = std::make_unique<std::byte[]>(capacity_ + BUFFER_ALIGNMENT);
+        buffer_ = alignPointer(storage_.get(), BUFFER_ALIGNMENT);
+    }
+
+    FrameArena::~FrameArena() = default;
+
+    void FrameArena::reset()
+    {
+        const std::size_t used = getUsedBytes();
+        peakBytes_ = std::max(peakBytes_, used);
+
+        if (!overflow_.empty())
+        {
+            // Grow once to this frame's need plus headroom, so the next frames fit in the main buffer again
+            ++overflowFrames_;
+            const std::size_t new_capacity = std::max(capacity_ * 2, used + used / 2);
+            spdlog::warn("FrameArena: frame used {} KiB of a {} KiB buffer, growing to {} KiB.", used / 1024, capacity_ / 1024, new_capacity / 1024);
+
+            overflow_.clear();
+            storage_ = std::make_unique<std::byte[]>(new_capacity + BUFFER_ALIGNMENT);
+            buffer_ = alignPointer(storage_.get(), BUFFER_ALIGNMENT);
+            capacity_ = new_capacity;
+        }
+        offset_ = 0;
+        overflowBytes_ = 0;
+    }
+
+    void* FrameArena::allocateOverflow(std::size_t size, std::size_t alignment)
+    {
+        ENGINE_LOG_WARN_LIMITED("FrameArena: {} KiB buffer exhausted, allocating {} bytes from the heap.", capacity_ / 1024, size);
+
+        overflow_.push_back(std::make_unique<std::byte[]>(size + alignment));
+        overflowBytes_ += size;
+        return alignPointer(overflow_.back().get(), alignment);
+    }
+}  // namespace engine::memory
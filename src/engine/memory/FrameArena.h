@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::memory
+{
+    /**
+     * @brief Linear allocator for data that lives for one frame, reset as a whole by Renderer::present().
+     *
+     * Allocation is a pointer bump in one pre-allocated buffer; nothing is freed individually and no destructor runs,
+     * so only trivially destructible types may be created in it. When a frame needs more than the buffer holds, the
+     * excess comes from overflow blocks and the next reset() grows the buffer to the frame's peak, so after warm-up
+     * frames never touch the general-purpose heap. Main thread only.
+     */
+    class FrameArena final
+    {
+      private:
+        static constexpr std::size_t BUFFER_ALIGNMENT = 64;
+
+        std::unique_ptr<std::byte[]> storage_;                ///< @brief Allocation holding the main buffer
+        std::byte* buffer_ = nullptr;                         ///< @brief Main buffer inside storage_, BUFFER_ALIGNMENT aligned
+        std::size_t capacity_ = 0;                            ///< @brief Size of buffer_
+        std::size_t offset_ = 0;                              ///< @brief First free byte in buffer_
+        std::vector<std::unique_ptr<std::byte[]>> overflow_;  ///< @brief Blocks allocated this frame after buffer_ filled up
+        std::size_t overflowBytes_ = 0;                       ///< @brief Bytes handed out from overflow_ this frame
+        std::size_t peakBytes_ = 0;                           ///< @brief Most bytes used by a single frame so far
+        std::size_t overflowFrames_ = 0;                      ///< @brief Frames that needed overflow blocks
+
+      public:
+        /**
+         * @param capacity initial buffer size in bytes
+         */
+        explicit FrameArena(std::size_t capacity = 256 * 1024);
+        ~FrameArena();
+
+        // Delete copy and move constructors and assignment operators
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        /**
+         * @brief Uninitialised memory valid until the next reset()
+         * @param alignment power of two, at most 64
+         */
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+        {
+            const std::size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (aligned + size <= capacity_)
+            {
+                offset_ = aligned + size;
+                return buffer_ + aligned;
+            }
+            return allocateOverflow(size, alignment);
+        }
+
+        /**
+         * @brief Construct a T in the arena. Its destructor never runs.
+         */
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Value-initialised array of count elements
+         */
+        template <typename T>
+        std::span<T> createArray(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            T* first = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            for (std::size_t i = 0; i < count; ++i) ::new (first + i) T();
+            return {first, count};
+        }
+
+        /**
+         * @brief Release everything allocated since the last reset; grows the buffer if this frame overflowed
+         */
+        void reset();
+
+        std::size_t getUsedBytes() const { return offset_ + overflowBytes_; }
+        std::size_t getCapacity() const { return capacity_; }
+        std::size_t getPeakBytes() const { return peakBytes_; }
+        std::size_t getOverflowFrames() const { return overflowFrames_; }
+
+      private:
+        void* allocateOverflow(std::size_t size, std::size_t alignment);
+    };
+}  // namespace engine::memory
@@ -0,0 +1,266 @@
+#include "NavGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+#include "../physics/TileCollisionMap.h"
+
+namespace engine::navigation
+{
+    namespace
+    {
+        constexpr float SLOPE_STEP_COST = 1.5f;  ///< @brief Walking one cell along a slope, which also changes row
+        constexpr float JUMP_PENALTY = 2.0f;     ///< @brief Extra cost of a jump over walking the same distance
+
+        using engine::physics::TileCollisionMap;
+
+        /**
+         * @brief Cell tests on the collision grid for an agent of a given height
+         */
+        class CellQuery
+        {
+          private:
+            const TileCollisionMap& map_;
+            int height_;
+
+          public:
+            CellQuery(const TileCollisionMap& map, int height) : map_(map), height_(height) {}
+
+            bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < map_.getSize().x && y < map_.getSize().y; }
+            bool isSlope(int x, int y) const { return map_.getSlope(x, y) != engine::physics::SlopeType::None; }
+            bool isLadder(int x, int y) const { return (map_.getFlags(x, y) & engine::physics::TILE_LADDER) != 0; }
+            bool isOneWay(int x, int y) const { return (map_.getFlags(x, y) & engine::physics::TILE_ONE_WAY) != 0 && !blocks(x, y); }
+
+            /**
+             * @brief Solid for a body inside the cell. Slope cells are not, the agent stands on their surface. The map's
+             * sides count as walls, the space above it as free.
+             */
+            bool blocks(int x, int y) const
+            {
+                if (x < 0 || x >= map_.getSize().x) return true;
+                return (map_.getFlags(x, y) & engine::physics::TILE_SOLID) != 0 && !isSlope(x, y);
+            }
+
+            /**
+             * @brief Can be stood on from the cell above
+             */
+            bool supports(int x, int y) const { return (map_.getFlags(x, y) & (engine::physics::TILE_SOLID | engine::physics::TILE_ONE_WAY)) != 0 && !isSlope(x, y); }
+
+            /**
+             * @brief The agent fits with its feet in the cell
+             */
+            bool fits(int x, int y) const
+            {
+                for (int row = y - height_ + 1; row <= y; ++row)
+                {
+                    if (blocks(x, row)) return false;
+                }
+                return true;
+            }
+
+            bool standable(int x, int y) const { return inBounds(x, y) && fits(x, y) && (isSlope(x, y) || isLadder(x, y) || supports(x, y + 1)); }
+
+            /**
+             * @brief Standing on ground, so a jump can start here
+             */
+            bool grounded(int x, int y) const { return isSlope(x, y) || supports(x, y + 1); }
+        };
+    }  // namespace
+
+    bool NavGraph::build(const engine::physics::TileCollisionMap& map, const NavAgentConfig& agent)
+    {
+        agent_ = agent;
+        agent_.height = std::max(agent_.height, 1);
+        size_ = map.getSize();
+        tileSize_ = map.getTileSize();
+        cellNodes_.assign(static_cast<std::size_t>(size_.x) * static_cast<std::size_t>(size_.y), INVALID_NAV_NODE);
+        nodeCells_.clear();
+        edgeBegin_.clear();
+        edges_.clear();
+        incomingBegin_.clear();
+        incoming_.clear();
+        if (cellNodes_.empty())
+        {
+            spdlog::warn("NavGraph: the collision map is empty, no navigation graph built.");
+            return false;
+        }
+
+        const CellQuery cells(map, agent_.height);
+        for (int y = 0; y < size_.y; ++y)
+        {
+            for (int x = 0; x < size_.x; ++x)
+            {
+                if (!cells.standable(x, y)) continue;
+                cellNodes_[index(x, y)] = static_cast<NavNodeId>(nodeCells_.size());
+                nodeCells_.push_back({x, y});
+            }
+        }
+
+        edgeBegin_.reserve(nodeCells_.size() + 1);
+        for (NavNodeId node = 0; node < nodeCells_.size(); ++node)
+        {
+            const auto [x, y] = nodeCells_[node];
+            const std::size_t first_edge = edges_.size();
+            edgeBegin_.push_back(static_cast<Uint32>(first_edge));
+
+            // One link per target, the cheapest kind found first wins
+            auto add = [&](int tx, int ty, float cost, NavLinkType type) {
+                const NavNodeId target = getNode(tx, ty);
+                if (target == INVALID_NAV_NODE || target == node) return;
+                for (std::size_t i = first_edge; i < edges_.size(); ++i)
+                {
+                    if (edges_[i].to == target) return;
+                }
+                edges_.push_back({target, cost, type});
+            };
+
+            for (const int side : {-1, 1})
+            {
+                // Walk: same row, or one row up / down when either end is a slope
+                const int nx = x + side;
+                if (getNode(nx, y) != INVALID_NAV_NODE)
+                {
+                    add(nx, y, 1.0f, NavLinkType::Walk);
+                }
+                else
+                {
+                    for (const int dy : {-1, 1})
+                    {
+                        if (cells.isSlope(x, y) || cells.isSlope(nx, y + dy)) add(nx, y + dy, SLOPE_STEP_COST, NavLinkType::Walk);
+                    }
+                }
+
+                // Drop: walk off the edge into free air and fall straight down
+                if (cells.inBounds(nx, y) && cells.fits(nx, y) && getNode(nx, y) == INVALID_NAV_NODE)
+                {
+                    for (int k = 1; k <= agent_.maxDrop && !cells.blocks(nx, y + k); ++k)
+                    {
+                        if (getNode(nx, y + k) == INVALID_NAV_NODE) continue;
+                        add(nx, y + k, 1.0f + static_cast<float>(k), NavLinkType::Drop);
+                        break;
+                    }
+                }
+            }
+
+            // Ladders: up and down the rungs, onto the top and down from it
+            if (cells.isLadder(x, y)) add(x, y - 1, 1.0f, NavLinkType::Ladder);
+            if (cells.isLadder(x, y) || cells.isLadder(x, y + 1)) add(x, y + 1, 1.0f, NavLinkType::Ladder);
+
+            // Drop through the one-way platform underfoot
+            if (cells.isOneWay(x, y + 1))
+            {
+                for (int k = 2; k <= agent_.maxDrop && !cells.blocks(x, y + k); ++k)
+                {
+                    if (getNode(x, y + k) == INVALID_NAV_NODE) continue;
+                    add(x, y + k, 1.0f + static_cast<float>(k), NavLinkType::Drop);
+                    break;
+                }
+            }
+
+            if (!cells.grounded(x, y)) continue;
+
+            // Jump: rise in place to the apex one row above the higher end, cross at the apex, fall onto the target.
+            // Every cell of that path must fit the agent, and no one-way platform may catch it above the target.
+            for (const int side : {-1, 1})
+            {
+                for (int dx = side > 0 ? 0 : 1; dx <= agent_.maxJumpAcross; ++dx)
+                {
+                    const int tx = x + side * dx;
+                    for (int ty = y - agent_.maxJumpUp + 1; ty <= y + agent_.maxJumpUp; ++ty)
+                    {
+                        if (getNode(tx, ty) == INVALID_NAV_NODE) continue;
+                        if (dx == 0 && ty >= y) continue;
+                        if (dx == 1 && ty >= y) continue;  // walk or drop
+
+                        const int apex = std::min(y, ty) - 1;
+                        if (y - apex > agent_.maxJumpUp) continue;
+
+                        bool walkable = ty == y;
+                        for (int i = 1; walkable && i < dx; ++i)
+                        {
+                            walkable = getNode(x + side * i, y) != INVALID_NAV_NODE;
+                        }
+                        if (walkable) continue;
+
+                        bool clear = true;
+                        for (int row = apex; clear && row < y; ++row)
+                        {
+                            clear = cells.fits(x, row);
+                        }
+                        for (int i = 1; clear && i <= dx; ++i)
+                        {
+                            clear = cells.fits(x + side * i, apex);
+                        }
+                        for (int row = apex + 1; clear && row <= ty; ++row)
+                        {
+                            clear = cells.fits(tx, row) && !cells.isOneWay(tx, row);
+                        }
+                        if (!clear) continue;
+
+                        add(tx, ty, static_cast<float>(dx + std::abs(ty - y)) + JUMP_PENALTY, NavLinkType::Jump);
+                    }
+                }
+            }
+        }
+        edgeBegin_.push_back(static_cast<Uint32>(edges_.size()));
+
+        // Incoming rows: count per target, prefix sum, fill
+        incomingBegin_.assign(nodeCells_.size() + 1, 0);
+        for (const NavEdge& edge : edges_)
+        {
+            ++incomingBegin_[edge.to + 1];
+        }
+        for (std::size_t i = 1; i < incomingBegin_.size(); ++i)
+        {
+            incomingBegin_[i] += incomingBegin_[i - 1];
+        }
+        incoming_.resize(edges_.size());
+        std::vector<Uint32> cursor(incomingBegin_.begin(), incomingBegin_.end() - 1);
+        for (NavNodeId node = 0; node < nodeCells_.size(); ++node)
+        {
+            for (const NavEdge& edge : getEdges(node))
+            {
+                incoming_[cursor[edge.to]++] = {node, edge.cost, edge.type};
+            }
+        }
+
+        SPDLOG_DEBUG("Navigation graph built: {} nodes, {} links, {} bytes.", nodeCells_.size(), edges_.size(), getMemoryBytes());
+        return true;
+    }
+
+    NavNodeId NavGraph::findNode(const glm::vec2& feet) const
+    {
+        if (nodeCells_.empty()) return INVALID_NAV_NODE;
+        const int x = static_cast<int>(std::floor(feet.x / tileSize_.x));
+        // Feet resting on a tile's top edge belong to the cell above it
+        const int y = static_cast<int>(std::ceil(feet.y / tileSize_.y)) - 1;
+
+        if (const NavNodeId node = getNode(x, y); node != INVALID_NAV_NODE) return node;
+        if (const NavNodeId node = getNode(x, y - 1); node != INVALID_NAV_NODE) return node;
+        for (int k = 1; k <= agent_.maxDrop && y + k < size_.y; ++k)
+        {
+            if (const NavNodeId node = getNode(x, y + k); node != INVALID_NAV_NODE) return node;
+        }
+        return INVALID_NAV_NODE;
+    }
+
+    glm::vec2 NavGraph::getNodePosition(NavNodeId node) const
+    {
+        const glm::ivec2 cell = nodeCells_[node];
+        return {(static_cast<float>(cell.x) + 0.5f) * tileSize_.x, static_cast<float>(cell.y + 1) * tileSize_.y};
+    }
+
+    float NavGraph::heuristic(NavNodeId a, NavNodeId b) const
+    {
+        const glm::ivec2 delta = nodeCells_[a] - nodeCells_[b];
+        return static_cast<float>(std::max(std::abs(delta.x), std::abs(delta.y)));
+    }
+
+    std::size_t NavGraph::getMemoryBytes() const
+    {
+        return cellNodes_.size() * sizeof(NavNodeId) + nodeCells_.size() * sizeof(glm::ivec2) + (edgeBegin_.size() + incomingBegin_.size()) * sizeof(Uint32) +
+               (edges_.size() + incoming_.size()) * sizeof(NavEdge);
+    }
+}  // namespace engine::navigation
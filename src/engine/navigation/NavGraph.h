@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+namespace engine::physics
+{
+    class TileCollisionMap;
+}
+
+namespace engine::navigation
+{
+    using NavNodeId = Uint32;  ///< @brief Index of a standable cell in a NavGraph
+    constexpr NavNodeId INVALID_NAV_NODE = ~NavNodeId{0};
+
+    /**
+     * @brief How an agent gets from one node to the next
+     */
+    enum class NavLinkType : Uint8
+    {
+        Walk,    ///< @brief Along the ground, slopes included
+        Ladder,  ///< @brief Climbing up or down a ladder
+        Drop,    ///< @brief Walking off an edge or dropping through a one-way platform
+        Jump,    ///< @brief A jump across a gap or up onto a ledge
+    };
+
+    struct NavEdge
+    {
+        NavNodeId to = INVALID_NAV_NODE;  ///< @brief Target node; for incoming edges, the source
+        float cost = 0.0f;                ///< @brief Never below the Chebyshev distance between the cells, so the search heuristic stays admissible
+        NavLinkType type = NavLinkType::Walk;
+    };
+
+    /**
+     * @brief Movement abilities the links are generated for, in tiles
+     */
+    struct NavAgentConfig
+    {
+        int height = 1;         ///< @brief Free cells needed above the feet cell, the feet cell included
+        int maxJumpUp = 3;      ///< @brief Highest jump apex above the take-off cell
+        int maxJumpAcross = 4;  ///< @brief Widest jump
+        int maxDrop = 10;       ///< @brief Deepest fall a drop link may take
+    };
+
+    /**
+     * @brief Navigation graph of a level for ground-bound enemies, built once at load from the collision grid.
+     *
+     * A node is a cell an agent can stand in: free of solid tiles for the agent's height, and either above a solid
+     * or one-way tile, on a slope or on a ladder. Edges link nodes by walking, climbing, dropping off edges and through
+     * one-way platforms, and jumping; a jump link is only made when the arc through the apex is free of solid tiles.
+     * Outgoing and incoming edges are both kept in compressed rows, so searches can run either way.
+     */
+    class NavGraph final
+    {
+      private:
+        glm::ivec2 size_{0, 0};  ///< @brief Grid size in tiles
+        glm::vec2 tileSize_{0.0f, 0.0f};
+        NavAgentConfig agent_;
+        std::vector<NavNodeId> cellNodes_;   ///< @brief Cell -> node, INVALID_NAV_NODE when not standable
+        std::vector<glm::ivec2> nodeCells_;  ///< @brief Node -> cell
+        std::vector<Uint32> edgeBegin_;      ///< @brief Node -> first outgoing edge, one extra entry at the end
+        std::vector<NavEdge> edges_;
+        std::vector<Uint32> incomingBegin_;  ///< @brief Node -> first incoming edge, one extra entry at the end
+        std::vector<NavEdge> incoming_;      ///< @brief Edges reversed: to holds the source node
+
+      public:
+        NavGraph() = default;
+
+        /**
+         * @brief Build from a level's collision grid, replacing the previous graph
+         * @return false if the map is empty (no tile layer, infinite map)
+         */
+        bool build(const engine::physics::TileCollisionMap& map, const NavAgentConfig& agent = {});
+
+        /**
+         * @brief Node an actor belongs to: the cell of its feet, the one above (feet on the ground edge), or the first
+         * node below within maxDrop (airborne)
+         * @param feet bottom-centre of the actor's box, world pixels
+         * @return INVALID_NAV_NODE if there is none
+         */
+        NavNodeId findNode(const glm::vec2& feet) const;
+
+        NavNodeId getNode(int x, int y) const { return inBounds(x, y) ? cellNodes_[index(x, y)] : INVALID_NAV_NODE; }
+        glm::ivec2 getCell(NavNodeId node) const { return nodeCells_[node]; }
+        glm::vec2 getNodePosition(NavNodeId node) const;  ///< @brief Bottom-centre of the node's cell, world pixels
+
+        std::span<const NavEdge> getEdges(NavNodeId node) const { return {edges_.data() + edgeBegin_[node], edges_.data() + edgeBegin_[node + 1]}; }
+        std::span<const NavEdge> getIncomingEdges(NavNodeId node) const { return {incoming_.data() + incomingBegin_[node], incoming_.data() + incomingBegin_[node + 1]}; }
+
+        /**
+         * @brief Lower bound of the path cost between two nodes
+         */
+        float heuristic(NavNodeId a, NavNodeId b) const;
+
+        std::size_t getNodeCount() const { return nodeCells_.size(); }
+        std::size_t getEdgeCount() const { return edges_.size(); }
+        const NavAgentConfig& getAgent() const { return agent_; }
+        std::size_t getMemoryBytes() const;
+
+      private:
+        bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < size_.x && y < size_.y; }
+        std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * static_cast<std::size_t>(size_.x) + static_cast<std::size_t>(x); }
+    };
+}  // namespace engine::navigation
@@ -0,0 +1,257 @@
+#include "PathQueue.h"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#include "../core/Profiler.h"
+
+namespace engine::navigation
+{
+    namespace
+    {
+        /**
+         * @brief Heap order for std::push_heap / pop_heap: smallest f on top, ties to the entry closest to the target
+         */
+        struct OpenOrder
+        {
+            template <typename Entry>
+            bool operator()(const Entry& lhs, const Entry& rhs) const
+            {
+                return lhs.f != rhs.f ? lhs.f > rhs.f : lhs.g < rhs.g;
+            }
+        };
+    }  // namespace
+
+    PathQueue::PathQueue(const NavGraph& graph) : graph_(graph)
+    {
+        reset();
+    }
+
+    PathRequestId PathQueue::request(const glm::vec2& from, const glm::vec2& to)
+    {
+        PathRequestId id;
+        if (!freeIds_.empty())
+        {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+        }
+        else
+        {
+            id = static_cast<PathRequestId>(requests_.size());
+            requests_.emplace_back();
+        }
+
+        Request& request = requests_[id];
+        request.start = graph_.findNode(from);
+        request.goal = graph_.findNode(to);
+        request.path.waypoints.clear();
+        request.path.cost = 0.0f;
+        if (request.start == INVALID_NAV_NODE || request.goal == INVALID_NAV_NODE)
+        {
+            request.status = PathStatus::NotFound;
+            return id;
+        }
+        request.status = PathStatus::Queued;
+        pending_.push_back(id);
+        return id;
+    }
+
+    void PathQueue::update(double budget_ms)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        const Uint64 start = SDL_GetTicksNS();
+        const auto budget_ns = static_cast<Uint64>(std::max(budget_ms, 0.0) * 1'000'000.0);
+        stats_.completed = 0;
+        stats_.treeHits = 0;
+        stats_.nodesExpanded = 0;
+
+        if (seen_.size() != graph_.getNodeCount())
+        {
+            spdlog::error("PathQueue: the navigation graph changed without reset(); pending requests are dropped.");
+            reset();
+        }
+
+        // Each pass takes a request or runs one slice of the active search, then checks the budget
+        while (active_ != INVALID_PATH_REQUEST || !pending_.empty())
+        {
+            if (active_ == INVALID_PATH_REQUEST)
+            {
+                const std::size_t next = takeNext();
+                active_ = pending_[next];
+                pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(next));
+
+                Request& request = requests_[active_];
+                if (request.goal != treeGoal_) startTree(request.goal);
+                if (isClosed(request.start))
+                {
+                    finish(request);
+                    ++stats_.treeHits;
+                    active_ = INVALID_PATH_REQUEST;
+                }
+                else
+                {
+                    retarget(request.start);
+                }
+            }
+            else
+            {
+                Request& request = requests_[active_];
+                if (search(request.start, EXPANSIONS_PER_CHECK))
+                {
+                    finish(request);
+                    active_ = INVALID_PATH_REQUEST;
+                }
+            }
+
+            if (SDL_GetTicksNS() - start >= budget_ns) break;
+        }
+
+        stats_.pending = pending_.size() + (active_ != INVALID_PATH_REQUEST ? 1 : 0);
+        stats_.updateMs = (SDL_GetTicksNS() - start) / 1'000'000.0;
+    }
+
+    const NavPath* PathQueue::getPath(PathRequestId id) const
+    {
+        return getStatus(id) == PathStatus::Found ? &requests_[id].path : nullptr;
+    }
+
+    void PathQueue::release(PathRequestId id)
+    {
+        if (getStatus(id) == PathStatus::Invalid)
+        {
+            spdlog::warn("PathQueue: release() called with invalid request {}.", id);
+            return;
+        }
+
+        // The search of a released request is kept: it is still a tree towards its goal
+        if (id == active_) active_ = INVALID_PATH_REQUEST;
+        if (const auto it = std::find(pending_.begin(), pending_.end(), id); it != pending_.end()) pending_.erase(it);
+        requests_[id].status = PathStatus::Invalid;
+        freeIds_.push_back(id);
+    }
+
+    void PathQueue::reset()
+    {
+        for (PathRequestId id = 0; id < requests_.size(); ++id)
+        {
+            if (requests_[id].status == PathStatus::Invalid) continue;
+            requests_[id].status = PathStatus::Invalid;
+            freeIds_.push_back(id);
+        }
+        pending_.clear();
+        active_ = INVALID_PATH_REQUEST;
+
+        const std::size_t nodes = graph_.getNodeCount();
+        seen_.assign(nodes, 0);
+        closed_.assign(nodes, 0);
+        g_.resize(nodes);
+        next_.resize(nodes);
+        nextLink_.resize(nodes);
+        open_.clear();
+        generation_ = 0;
+        treeGoal_ = INVALID_NAV_NODE;
+        treeTarget_ = INVALID_NAV_NODE;
+    }
+
+    std::size_t PathQueue::takeNext()
+    {
+        // Requests the current tree may already answer go first
+        for (std::size_t i = 0; i < pending_.size(); ++i)
+        {
+            if (requests_[pending_[i]].goal == treeGoal_) return i;
+        }
+        return 0;
+    }
+
+    void PathQueue::startTree(NavNodeId goal)
+    {
+        if (++generation_ == 0)
+        {
+            // Stamps wrapped around: old ones could look current again
+            std::fill(seen_.begin(), seen_.end(), 0);
+            std::fill(closed_.begin(), closed_.end(), 0);
+            generation_ = 1;
+        }
+        treeGoal_ = goal;
+        treeTarget_ = INVALID_NAV_NODE;
+        open_.clear();
+        next_[goal] = INVALID_NAV_NODE;
+        push(goal, 0.0f);
+    }
+
+    void PathQueue::retarget(NavNodeId start)
+    {
+        if (start == treeTarget_) return;
+        treeTarget_ = start;
+
+        // Drop stale entries, then rebuild the heap with the heuristic towards the new start
+        std::erase_if(open_, [this](const OpenEntry& entry) { return isClosed(entry.node) || entry.g > g_[entry.node]; });
+        for (OpenEntry& entry : open_)
+        {
+            entry.f = entry.g + graph_.heuristic(entry.node, start);
+        }
+        std::make_heap(open_.begin(), open_.end(), OpenOrder{});
+    }
+
+    void PathQueue::push(NavNodeId node, float g)
+    {
+        g_[node] = g;
+        seen_[node] = generation_;
+        const float h = treeTarget_ != INVALID_NAV_NODE ? graph_.heuristic(node, treeTarget_) : 0.0f;
+        open_.push_back({g + h, g, node});
+        std::push_heap(open_.begin(), open_.end(), OpenOrder{});
+    }
+
+    bool PathQueue::search(NavNodeId start, int max_expansions)
+    {
+        for (int i = 0; i < max_expansions && !isClosed(start) && !open_.empty(); ++i)
+        {
+            std::pop_heap(open_.begin(), open_.end(), OpenOrder{});
+            const OpenEntry entry = open_.back();
+            open_.pop_back();
+            if (isClosed(entry.node) || entry.g > g_[entry.node]) continue;
+
+            closed_[entry.node] = generation_;
+            ++stats_.nodesExpanded;
+
+            // Backwards: relax the nodes that have a link into this one
+            for (const NavEdge& edge : graph_.getIncomingEdges(entry.node))
+            {
+                const NavNodeId from = edge.to;
+                if (isClosed(from)) continue;
+                const float g = entry.g + edge.cost;
+                if (seen_[from] == generation_ && g >= g_[from]) continue;
+                next_[from] = entry.node;
+                nextLink_[from] = edge.type;
+                push(from, g);
+            }
+        }
+        return isClosed(start) || open_.empty();
+    }
+
+    void PathQueue::finish(Request& request)
+    {
+        ++stats_.completed;
+        if (!isClosed(request.start))
+        {
+            request.status = PathStatus::NotFound;
+            return;
+        }
+
+        // next_ chains from the start to the goal, so the path comes out in walking order
+        NavPath& path = request.path;
+        path.waypoints.clear();
+        path.cost = g_[request.start];
+        NavNodeId node = request.start;
+        NavLinkType link = NavLinkType::Walk;
+        while (true)
+        {
+            path.waypoints.push_back({graph_.getCell(node), graph_.getNodePosition(node), link});
+            if (node == request.goal) break;
+            link = nextLink_[node];
+            node = next_[node];
+        }
+        request.status = PathStatus::Found;
+    }
+}  // namespace engine::navigation
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "NavGraph.h"
+
+namespace engine::navigation
+{
+    using PathRequestId = Uint32;  ///< @brief Handle of a PathQueue request, reused after release()
+    constexpr PathRequestId INVALID_PATH_REQUEST = ~PathRequestId{0};
+
+    enum class PathStatus : Uint8
+    {
+        Invalid,   ///< @brief Unknown or released id
+        Queued,    ///< @brief Waiting for, or in the middle of, a search
+        Found,     ///< @brief getPath() holds the path
+        NotFound,  ///< @brief No node near one of the ends, or no link sequence between them
+    };
+
+    struct NavWaypoint
+    {
+        glm::ivec2 cell{0, 0};
+        glm::vec2 position{0.0f, 0.0f};        ///< @brief Bottom-centre of the cell, where the agent's feet go
+        NavLinkType link = NavLinkType::Walk;  ///< @brief How this waypoint is reached from the previous one
+    };
+
+    struct NavPath
+    {
+        std::vector<NavWaypoint> waypoints;  ///< @brief From the start node to the goal node, both included
+        float cost = 0.0f;
+    };
+
+    struct PathQueueStats
+    {
+        std::size_t pending = 0;        ///< @brief Requests still waiting after the last update()
+        std::size_t completed = 0;      ///< @brief Requests answered by the last update()
+        std::size_t treeHits = 0;       ///< @brief Of those, answered from an earlier search towards the same goal without expanding
+        std::size_t nodesExpanded = 0;  ///< @brief By the last update()
+        double updateMs = 0.0;          ///< @brief Time of the last update()
+    };
+
+    /**
+     * @brief Time-sliced A* over a NavGraph, for many agents asking for paths every few frames.
+     *
+     * request() only queues. update() works through the queue until its millisecond budget is spent, checking the
+     * clock every EXPANSIONS_PER_CHECK node expansions; a search that does not finish continues on the next update(),
+     * so one long path never costs more than the budget in a frame.
+     *
+     * Searches run backwards, from the goal towards the start, and their state is kept after they finish: the closed
+     * nodes form a tree of shortest paths to the goal. A later request for the same goal (the player's cell, which
+     * every chasing enemy asks for) is answered by walking that tree when its start is already in it, and otherwise
+     * continues the same search with the open list re-keyed for the new start. Queued requests for the goal of the
+     * current tree are served first, before a request for another goal discards it.
+     *
+     * The per-node search arrays use generation stamps instead of being cleared, and paths are written into the
+     * request slots, whose storage is reused by later requests; a warm queue does not allocate. Main thread only.
+     */
+    class PathQueue final
+    {
+      public:
+        static constexpr int EXPANSIONS_PER_CHECK = 32;  ///< @brief Node expansions between two clock reads
+
+      private:
+        struct Request
+        {
+            NavNodeId start = INVALID_NAV_NODE;
+            NavNodeId goal = INVALID_NAV_NODE;
+            PathStatus status = PathStatus::Invalid;
+            NavPath path;
+        };
+
+        struct OpenEntry
+        {
+            float f = 0.0f;
+            float g = 0.0f;  ///< @brief g when pushed; a smaller current g makes the entry stale
+            NavNodeId node = INVALID_NAV_NODE;
+        };
+
+        const NavGraph& graph_;
+        std::vector<Request> requests_;                ///< @brief Indexed by PathRequestId
+        std::vector<PathRequestId> freeIds_;           ///< @brief Released ids, reused last in first out
+        std::vector<PathRequestId> pending_;           ///< @brief Oldest first
+        PathRequestId active_ = INVALID_PATH_REQUEST;  ///< @brief Request the search is currently for
+
+        // --- Search state, towards treeGoal_; kept between requests ---
+        NavNodeId treeGoal_ = INVALID_NAV_NODE;
+        NavNodeId treeTarget_ = INVALID_NAV_NODE;  ///< @brief Start node the open list is keyed for
+        Uint32 generation_ = 0;                    ///< @brief Stamp of the current tree
+        std::vector<Uint32> seen_;                 ///< @brief Node -> generation in which it got a g
+        std::vector<Uint32> closed_;               ///< @brief Node -> generation in which its g became final
+        std::vector<float> g_;                     ///< @brief Cost from the node to treeGoal_
+        std::vector<NavNodeId> next_;              ///< @brief Next node towards treeGoal_
+        std::vector<NavLinkType> nextLink_;        ///< @brief Link from the node to next_
+        std::vector<OpenEntry> open_;              ///< @brief Binary min-heap on f
+
+        PathQueueStats stats_;
+
+      public:
+        /**
+         * @param graph must outlive the queue; call reset() after rebuilding it
+         */
+        explicit PathQueue(const NavGraph& graph);
+
+        // Delete copy and move constructors and assignment operators
+        PathQueue(const PathQueue&) = delete;
+        PathQueue& operator=(const PathQueue&) = delete;
+        PathQueue(PathQueue&&) = delete;
+        PathQueue& operator=(PathQueue&&) = delete;
+
+        /**
+         * @brief Queue a path request between two feet positions (see NavGraph::findNode)
+         * @return the request's id, valid until release()
+         */
+        PathRequestId request(const glm::vec2& from, const glm::vec2& to);
+
+        /**
+         * @brief Run searches for about budget_ms milliseconds. Call once per frame.
+         */
+        void update(double budget_ms);
+
+        PathStatus getStatus(PathRequestId id) const { return id < requests_.size() ? requests_[id].status : PathStatus::Invalid; }
+
+        /**
+         * @return the path of a Found request, nullptr otherwise; valid until release()
+         */
+        const NavPath* getPath(PathRequestId id) const;
+
+        /**
+         * @brief Drop a request, answered or not; its id may be handed out again
+         */
+        void release(PathRequestId id);
+
+        /**
+         * @brief Drop every request and the kept search; required after the graph is rebuilt
+         */
+        void reset();
+
+        const PathQueueStats& getStats() const { return stats_; }
+
+      private:
+        std::size_t takeNext();
+        void startTree(NavNodeId goal);
+        void retarget(NavNodeId start);
+        void push(NavNodeId node, float g);
+
+        /**
+         * @brief Expand nodes until the start is closed, the open list runs out or max_expansions is reached
+         * @return true when the search is over for this start
+         */
+        bool search(NavNodeId start, int max_expansions);
+
+        bool isClosed(NavNodeId node) const { return closed_[node] == generation_; }
+        void finish(Request& request);
+    };
+}  // namespace engine::navigation
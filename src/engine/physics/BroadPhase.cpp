@@ -0,0 +1,258 @@
+#include "BroadPhase.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace engine::physics
+{
+    namespace
+    {
+        bool filtersMatch(Uint32 layer_a, Uint32 mask_a, Uint32 layer_b, Uint32 mask_b) { return (layer_a & mask_b) != 0 && (layer_b & mask_a) != 0; }
+
+        // A query covering at least one cell per this many proxies tests every proxy with the batch kernel instead of walking
+        // the cells: a cell lookup costs about as much as testing a hundred rects (BroadPhaseBenchmark, AVX2)
+        constexpr std::size_t PROXIES_PER_CELL_FOR_BATCH = 128;
+
+        // Stands in for destroyed proxies in the batch: its min edges are above any max edge, so it overlaps nothing
+        constexpr float NOWHERE = std::numeric_limits<float>::infinity();
+        const engine::utils::Rect DEAD_RECT{{NOWHERE, NOWHERE}, {0.0f, 0.0f}};
+    }  // namespace
+
+    BroadPhase::BroadPhase(float cell_size) : cellSize_(std::max(cell_size, 1.0f)) {}
+
+    ProxyId BroadPhase::createProxy(const engine::utils::Rect& rect, Uint32 layer, Uint32 mask)
+    {
+        ProxyId id;
+        if (!freeIds_.empty())
+        {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+        }
+        else
+        {
+            id = static_cast<ProxyId>(proxies_.size());
+            proxies_.emplace_back();
+            rects_.push(rect);
+        }
+
+        Proxy& proxy = proxies_[id];
+        proxy.rect = rect;
+        rects_.set(id, rect);
+        proxy.cellMin = cellMinOf(rect);
+        proxy.cellMax = cellMaxOf(rect);
+        proxy.layer = layer;
+        proxy.mask = mask;
+        proxy.alive = true;
+        insertCells(id, proxy.cellMin, proxy.cellMax);
+        ++proxyCount_;
+        return id;
+    }
+
+    void BroadPhase::destroyProxy(ProxyId id)
+    {
+        if (!isValid(id))
+        {
+            spdlog::warn("BroadPhase: destroyProxy() called with invalid proxy {}.", id);
+            return;
+        }
+        Proxy& proxy = proxies_[id];
+        removeCells(id, proxy.cellMin, proxy.cellMax);
+        proxy.alive = false;
+        rects_.set(id, DEAD_RECT);
+        freeIds_.push_back(id);
+        --proxyCount_;
+    }
+
+    void BroadPhase::moveProxy(ProxyId id, const engine::utils::Rect& rect)
+    {
+        if (!isValid(id))
+        {
+            spdlog::warn("BroadPhase: moveProxy() called with invalid proxy {}.", id);
+            return;
+        }
+        Proxy& proxy = proxies_[id];
+        proxy.rect = rect;
+        rects_.set(id, rect);
+
+        const glm::ivec2 cell_min = cellMinOf(rect);
+        const glm::ivec2 cell_max = cellMaxOf(rect);
+        if (cell_min == proxy.cellMin && cell_max == proxy.cellMax) return;
+
+        // Only touch the cells that enter or leave the covered range
+        for (int y = proxy.cellMin.y; y <= proxy.cellMax.y; ++y)
+        {
+            for (int x = proxy.cellMin.x; x <= proxy.cellMax.x; ++x)
+            {
+                if (x >= cell_min.x && x <= cell_max.x && y >= cell_min.y && y <= cell_max.y) continue;
+                removeCells(id, {x, y}, {x, y});
+            }
+        }
+        for (int y = cell_min.y; y <= cell_max.y; ++y)
+        {
+            for (int x = cell_min.x; x <= cell_max.x; ++x)
+            {
+                if (x >= proxy.cellMin.x && x <= proxy.cellMax.x && y >= proxy.cellMin.y && y <= proxy.cellMax.y) continue;
+                cellAt(cellKey(x, y)).push_back(id);
+            }
+        }
+        proxy.cellMin = cell_min;
+        proxy.cellMax = cell_max;
+    }
+
+    void BroadPhase::setFilter(ProxyId id, Uint32 layer, Uint32 mask)
+    {
+        if (!isValid(id))
+        {
+            spdlog::warn("BroadPhase: setFilter() called with invalid proxy {}.", id);
+            return;
+        }
+        proxies_[id].layer = layer;
+        proxies_[id].mask = mask;
+    }
+
+    const std::vector<BroadPhasePair>& BroadPhase::updatePairs()
+    {
+        pairs_.clear();
+
+        // A pair sharing several cells is only reported from the first cell both cover, so no duplicate set is needed.
+        // The cell walk follows hash order; the final sort makes the result independent of it.
+        for (const auto& [key, ids] : cells_)
+        {
+            const int x = static_cast<int>(static_cast<Uint32>(key >> 32));
+            const int y = static_cast<int>(static_cast<Uint32>(key));
+            for (std::size_t i = 0; i < ids.size(); ++i)
+            {
+                const Proxy& proxy_a = proxies_[ids[i]];
+                if (proxy_a.mask == 0) continue;
+
+                for (std::size_t j = i + 1; j < ids.size(); ++j)
+                {
+                    const Proxy& proxy_b = proxies_[ids[j]];
+                    if (std::max(proxy_a.cellMin.x, proxy_b.cellMin.x) != x || std::max(proxy_a.cellMin.y, proxy_b.cellMin.y) != y) continue;
+                    if (!filtersMatch(proxy_a.layer, proxy_a.mask, proxy_b.layer, proxy_b.mask)) continue;
+                    if (!engine::utils::overlaps(proxy_a.rect, proxy_b.rect)) continue;
+                    pairs_.push_back(ids[i] < ids[j] ? BroadPhasePair{ids[i], ids[j]} : BroadPhasePair{ids[j], ids[i]});
+                }
+            }
+        }
+        std::sort(pairs_.begin(), pairs_.end(), [](const BroadPhasePair& lhs, const BroadPhasePair& rhs) { return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b; });
+        return pairs_;
+    }
+
+    void BroadPhase::query(const engine::utils::Rect& rect, Uint32 mask, std::vector<ProxyId>& out) const
+    {
+        out.clear();
+        const glm::ivec2 cell_min = cellMinOf(rect);
+        const glm::ivec2 cell_max = cellMaxOf(rect);
+
+        // Wide queries (a camera view, an explosion radius) would look up more cells than there are proxies to test
+        const std::size_t cell_count = static_cast<std::size_t>(cell_max.x - cell_min.x + 1) * static_cast<std::size_t>(cell_max.y - cell_min.y + 1);
+        if (cell_count * PROXIES_PER_CELL_FOR_BATCH >= proxies_.size())
+        {
+            engine::utils::overlapMask(rects_, rect, queryMask_);
+            for (std::size_t word = 0; word < queryMask_.size(); ++word)
+            {
+                for (Uint64 bits = queryMask_[word]; bits != 0; bits &= bits - 1)
+                {
+                    const ProxyId id = static_cast<ProxyId>(word * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+                    if (proxies_[id].layer & mask) out.push_back(id);
+                }
+            }
+            return;
+        }
+
+        for (int y = cell_min.y; y <= cell_max.y; ++y)
+        {
+            for (int x = cell_min.x; x <= cell_max.x; ++x)
+            {
+                auto it = cells_.find(cellKey(x, y));
+                if (it == cells_.end()) continue;
+
+                for (const ProxyId id : it->second)
+                {
+                    const Proxy& proxy = proxies_[id];
+                    if (std::max(cell_min.x, proxy.cellMin.x) != x || std::max(cell_min.y, proxy.cellMin.y) != y) continue;
+                    if ((proxy.layer & mask) == 0 || !engine::utils::overlaps(rect, proxy.rect)) continue;
+                    out.push_back(id);
+                }
+            }
+        }
+        std::sort(out.begin(), out.end());
+    }
+
+    void BroadPhase::clear()
+    {
+        while (!cells_.empty())
+        {
+            spareCells_.push_back(cells_.extract(cells_.begin()));
+            spareCells_.back().mapped().clear();
+        }
+        proxies_.clear();
+        rects_.clear();
+        freeIds_.clear();
+        pairs_.clear();
+        proxyCount_ = 0;
+    }
+
+    glm::ivec2 BroadPhase::cellMinOf(const engine::utils::Rect& rect) const
+    {
+        return {static_cast<int>(std::floor(rect.position.x / cellSize_)), static_cast<int>(std::floor(rect.position.y / cellSize_))};
+    }
+
+    glm::ivec2 BroadPhase::cellMaxOf(const engine::utils::Rect& rect) const
+    {
+        // Touching edges do not overlap, so a right / bottom edge exactly on a cell boundary stays out of the next cell
+        const glm::ivec2 cell_min = cellMinOf(rect);
+        const int x = static_cast<int>(std::ceil((rect.position.x + rect.size.x) / cellSize_)) - 1;
+        const int y = static_cast<int>(std::ceil((rect.position.y + rect.size.y) / cellSize_)) - 1;
+        return {std::max(x, cell_min.x), std::max(y, cell_min.y)};
+    }
+
+    std::vector<ProxyId>& BroadPhase::cellAt(Uint64 key)
+    {
+        auto it = cells_.find(key);
+        if (it != cells_.end()) return it->second;
+        if (spareCells_.empty()) return cells_[key];
+
+        CellMap::node_type cell = std::move(spareCells_.back());
+        spareCells_.pop_back();
+        cell.key() = key;
+        return cells_.insert(std::move(cell)).position->second;
+    }
+
+    void BroadPhase::insertCells(ProxyId id, glm::ivec2 cell_min, glm::ivec2 cell_max)
+    {
+        for (int y = cell_min.y; y <= cell_max.y; ++y)
+        {
+            for (int x = cell_min.x; x <= cell_max.x; ++x)
+            {
+                cellAt(cellKey(x, y)).push_back(id);
+            }
+        }
+    }
+
+    void BroadPhase::removeCells(ProxyId id, glm::ivec2 cell_min, glm::ivec2 cell_max)
+    {
+        for (int y = cell_min.y; y <= cell_max.y; ++y)
+        {
+            for (int x = cell_min.x; x <= cell_max.x; ++x)
+            {
+                auto it = cells_.find(cellKey(x, y));
+                if (it == cells_.end()) continue;
+
+                // Order inside a cell does not matter, results are sorted by id
+                auto& ids = it->second;
+                auto found = std::find(ids.begin(), ids.end(), id);
+                if (found == ids.end()) continue;
+                *found = ids.back();
+                ids.pop_back();
+
+                // Only occupied cells stay in the hash, so updatePairs() walks as many cells as the proxies cover
+                if (ids.empty()) spareCells_.push_back(cells_.extract(it));
+            }
+        }
+    }
+}  // namespace engine::physics
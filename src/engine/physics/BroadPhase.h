@@ -0,0 +1,142 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/Math.h"
+
+namespace engine::physics
+{
+    using ProxyId = Uint32;  ///< @brief Handle of a BroadPhase proxy, reused after destroyProxy()
+    constexpr ProxyId INVALID_PROXY = ~ProxyId{0};
+
+    constexpr Uint32 COLLISION_LAYER_ALL = ~Uint32{0};  ///< @brief Mask that accepts every layer
+
+    /**
+     * @brief Two overlapping proxies, always with a < b
+     */
+    struct BroadPhasePair
+    {
+        ProxyId a = INVALID_PROXY;
+        ProxyId b = INVALID_PROXY;
+
+        bool operator==(const BroadPhasePair&) const = default;
+    };
+
+    /**
+     * @brief Entity-versus-entity broadphase: a spatial hash of uniform cells over engine::utils::Rect.
+     *
+     * Each proxy is registered in every cell its rectangle touches. moveProxy() only edits the hash when the rectangle
+     * crosses a cell boundary, so the common case (small moves inside the same cells) is a plain rect copy.
+     * Two proxies pair up when their rectangles overlap and each one's layer bits match the other's mask.
+     * Pairs and query results are ordered by proxy id, so they do not depend on hash iteration order or on movement history.
+     * The cell size should be about the size of a typical entity; very large proxies (level-wide triggers) touch many cells.
+     * A query covering many cells, such as a camera view, skips the hash and tests every proxy with the SIMD batch kernel.
+     */
+    class BroadPhase final
+    {
+      private:
+        struct Proxy
+        {
+            engine::utils::Rect rect{};
+            glm::ivec2 cellMin{0, 0};  ///< @brief First cell covered, inclusive
+            glm::ivec2 cellMax{0, 0};  ///< @brief Last cell covered, inclusive
+            Uint32 layer = 0;          ///< @brief Layers the proxy belongs to
+            Uint32 mask = 0;           ///< @brief Layers the proxy collides with
+            bool alive = false;
+        };
+
+        struct CellKeyHash
+        {
+            std::size_t operator()(Uint64 key) const
+            {
+                // splitmix64 finaliser: neighbouring cells land in unrelated buckets
+                key ^= key >> 30;
+                key *= 0xbf58476d1ce4e5b9ull;
+                key ^= key >> 27;
+                key *= 0x94d049bb133111ebull;
+                key ^= key >> 31;
+                return static_cast<std::size_t>(key);
+            }
+        };
+
+        using CellMap = std::unordered_map<Uint64, std::vector<ProxyId>, CellKeyHash>;
+
+        float cellSize_;                              ///< @brief Edge length of a cell in pixels
+        std::vector<Proxy> proxies_;                  ///< @brief Indexed by ProxyId
+        std::vector<ProxyId> freeIds_;                ///< @brief Destroyed ids, reused last in first out
+        CellMap cells_;                               ///< @brief Occupied cell -> proxies touching it
+        std::vector<CellMap::node_type> spareCells_;  ///< @brief Emptied cells, node and id storage reused for the next new cell
+        engine::utils::RectBatch rects_;              ///< @brief Proxy rects by ProxyId for the batch kernel; dead proxies overlap nothing
+        mutable std::vector<Uint64> queryMask_;       ///< @brief Scratch of the batch query
+        std::vector<BroadPhasePair> pairs_;           ///< @brief Result of the last updatePairs()
+        std::size_t proxyCount_ = 0;                  ///< @brief Live proxies
+
+      public:
+        /**
+         * @param cell_size edge length of a hash cell in pixels, clamped to at least 1
+         */
+        explicit BroadPhase(float cell_size = 64.0f);
+
+        /**
+         * @brief Register a rectangle
+         * @param layer layers the proxy belongs to (bit set)
+         * @param mask layers the proxy collides with; 0 makes it only visible to query()
+         */
+        ProxyId createProxy(const engine::utils::Rect& rect, Uint32 layer = 1, Uint32 mask = COLLISION_LAYER_ALL);
+
+        /**
+         * @brief Unregister a proxy; its id may be handed out again by createProxy()
+         */
+        void destroyProxy(ProxyId id);
+
+        /**
+         * @brief Update the rectangle of a proxy. Cheap unless it crosses a cell boundary.
+         */
+        void moveProxy(ProxyId id, const engine::utils::Rect& rect);
+
+        void setFilter(ProxyId id, Uint32 layer, Uint32 mask);
+
+        /**
+         * @brief Recompute every overlapping pair
+         * @return pairs sorted by (a, b); valid until the next call or until the broadphase changes
+         */
+        const std::vector<BroadPhasePair>& updatePairs();
+
+        /**
+         * @brief Proxies overlapping a rectangle whose layer matches the mask, sorted by id. Not thread-safe, it reuses scratch storage.
+         * @param out cleared, then filled
+         */
+        void query(const engine::utils::Rect& rect, Uint32 mask, std::vector<ProxyId>& out) const;
+
+        /**
+         * @brief Remove every proxy. Cells keep their storage for reuse.
+         */
+        void clear();
+
+        bool isValid(ProxyId id) const { return id < proxies_.size() && proxies_[id].alive; }
+        const engine::utils::Rect& getRect(ProxyId id) const { return proxies_[id].rect; }
+        Uint32 getLayer(ProxyId id) const { return proxies_[id].layer; }
+        Uint32 getMask(ProxyId id) const { return proxies_[id].mask; }
+        const std::vector<BroadPhasePair>& getPairs() const { return pairs_; }
+        std::size_t getProxyCount() const { return proxyCount_; }
+        std::size_t getCellCount() const { return cells_.size(); }  ///< @brief Occupied cells
+        float getCellSize() const { return cellSize_; }
+
+      private:
+        static Uint64 cellKey(int x, int y) { return (static_cast<Uint64>(static_cast<Uint32>(x)) << 32) | static_cast<Uint32>(y); }
+
+        glm::ivec2 cellMinOf(const engine::utils::Rect& rect) const;
+        glm::ivec2 cellMaxOf(const engine::utils::Rect& rect) const;
+
+        /**
+         * @brief Ids of a cell, created from a spare cell if it is not occupied yet
+         */
+        std::vector<ProxyId>& cellAt(Uint64 key);
+
+        void insertCells(ProxyId id, glm::ivec2 cell_min, glm::ivec2 cell_max);
+        void removeCells(ProxyId id, glm::ivec2 cell_min, glm::ivec2 cell_max);
+    };
+}  // namespace engine::physics
@@ -0,0 +1,739 @@
+#include "PhysicsWorld.h"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <spdlog/spdlog.h>
+
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+#include "TileCollisionMap.h"
+
+namespace engine::physics
+{
+    namespace
+    {
+        constexpr Uint32 NO_ISLAND = ~Uint32{0};
+        constexpr float MIN_PUSH = 1e-3f;  ///< @brief Position corrections below this, in pixels, are skipped
+
+        bool filtersMatch(Uint32 layer_a, Uint32 mask_a, Uint32 layer_b, Uint32 mask_b) { return (layer_a & mask_b) != 0 && (layer_b & mask_a) != 0; }
+
+        engine::utils::Rect expanded(const engine::utils::Rect& rect, float margin)
+        {
+            return {rect.position - glm::vec2(margin), rect.size + glm::vec2(2.0f * margin)};
+        }
+
+        /**
+         * @brief Overlap of two boxes along each axis; both positive when they overlap
+         */
+        glm::vec2 overlapOf(const glm::vec2& pos_a, const glm::vec2& size_a, const glm::vec2& pos_b, const glm::vec2& size_b)
+        {
+            return glm::min(pos_a + size_a, pos_b + size_b) - glm::max(pos_a, pos_b);
+        }
+    }  // namespace
+
+    PhysicsWorld::PhysicsWorld(const PhysicsConfig& config) : config_(config), broadPhase_(config.broadPhaseCell)
+    {
+        config_.fixedStep = std::max(config_.fixedStep, 1.0f / 1000.0f);
+        config_.maxSubSteps = std::max(config_.maxSubSteps, 1);
+        config_.solverIterations = std::max(config_.solverIterations, 1);
+
+        const int threads = std::max(config_.solverThreads, 0);
+        workers_.reserve(static_cast<std::size_t>(threads));
+        for (int i = 0; i < threads; ++i)
+        {
+            workers_.emplace_back(&PhysicsWorld::workerLoop, this);
+        }
+        SPDLOG_TRACE("PhysicsWorld constructed successfully with {} solver threads.", threads);
+    }
+
+    PhysicsWorld::~PhysicsWorld()
+    {
+        {
+            std::lock_guard<std::mutex> lock(workerMutex_);
+            workersStopping_ = true;
+        }
+        workerWake_.notify_all();
+        for (std::thread& worker : workers_)
+        {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    BodyId PhysicsWorld::createBody(const BodyDef& def)
+    {
+        BodyId id;
+        if (!freeIds_.empty())
+        {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+        }
+        else
+        {
+            id = static_cast<BodyId>(slots_.size());
+            slots_.push_back(INVALID_BODY);
+        }
+
+        Uint8 flags = 0;
+        if (def.type == BodyType::Dynamic) flags |= FLAG_DYNAMIC;
+        if (def.type == BodyType::Kinematic) flags |= FLAG_KINEMATIC;
+        if (def.sensor) flags |= FLAG_SENSOR;
+        if (def.type == BodyType::Dynamic && def.collidesWithTiles) flags |= FLAG_TILES;
+        const bool movable = def.type == BodyType::Dynamic && !def.sensor && def.mass > 0.0f;
+
+        const engine::utils::Rect rect{def.position, def.size};
+        const ProxyId proxy = broadPhase_.createProxy(rect, def.layer, def.mask);
+        if (proxy >= proxyBodies_.size()) proxyBodies_.resize(proxy + 1, INVALID_BODY);
+        proxyBodies_[proxy] = id;
+
+        // Appended at the end, inside the static range; moved to its own range below
+        const std::size_t slot = bodyCount_++;
+        positions_.push_back(def.position);
+        previous_.push_back(def.position);
+        sizes_.push_back(def.size);
+        velocities_.push_back(def.type == BodyType::Static ? glm::vec2(0.0f) : def.velocity);
+        invMass_.push_back(movable ? 1.0f / def.mass : 0.0f);
+        gravityScale_.push_back(def.gravityScale);
+        sleepTimer_.push_back(0.0f);
+        flags_.push_back(flags);
+        proxies_.push_back(proxy);
+        ids_.push_back(id);
+        slots_[id] = static_cast<Uint32>(slot);
+
+        if (def.type == BodyType::Static)
+        {
+            ++staticCount_;
+        }
+        else
+        {
+            // First slot of the static range becomes the last sleeping one, then the body wakes
+            const std::size_t sleeping_end = bodyCount_ - 1 - staticCount_;
+            swapSlots(slot, sleeping_end);
+            wakeSlot(sleeping_end);
+        }
+        return id;
+    }
+
+    void PhysicsWorld::destroyBody(BodyId id)
+    {
+        if (!isValid(id))
+        {
+            spdlog::warn("PhysicsWorld: destroyBody() called with invalid body {}.", id);
+            return;
+        }
+
+        // Whatever rested on the body must fall now
+        wakeTouching(rectOf(slots_[id]));
+
+        std::size_t slot = slots_[id];
+        const bool is_static = slot >= bodyCount_ - staticCount_;
+        if (slot < awakeCount_)
+        {
+            swapSlots(slot, awakeCount_ - 1);
+            slot = --awakeCount_;
+        }
+        if (is_static)
+        {
+            --staticCount_;
+        }
+        else
+        {
+            // Last sleeping slot; the last static body takes its place and the static range shifts down by one
+            const std::size_t sleeping_end = bodyCount_ - staticCount_;
+            swapSlots(slot, sleeping_end - 1);
+            slot = sleeping_end - 1;
+        }
+        swapSlots(slot, bodyCount_ - 1);
+
+        broadPhase_.destroyProxy(proxies_.back());
+        positions_.pop_back();
+        previous_.pop_back();
+        sizes_.pop_back();
+        velocities_.pop_back();
+        invMass_.pop_back();
+        gravityScale_.pop_back();
+        sleepTimer_.pop_back();
+        flags_.pop_back();
+        proxies_.pop_back();
+        ids_.pop_back();
+        --bodyCount_;
+
+        slots_[id] = INVALID_BODY;
+        freeIds_.push_back(id);
+    }
+
+    void PhysicsWorld::clear()
+    {
+        broadPhase_.clear();
+        positions_.clear();
+        previous_.clear();
+        sizes_.clear();
+        velocities_.clear();
+        invMass_.clear();
+        gravityScale_.clear();
+        sleepTimer_.clear();
+        flags_.clear();
+        proxies_.clear();
+        ids_.clear();
+        slots_.clear();
+        freeIds_.clear();
+        proxyBodies_.clear();
+        contacts_.clear();
+        bodyCount_ = 0;
+        awakeCount_ = 0;
+        staticCount_ = 0;
+        accumulator_ = 0.0f;
+        stats_ = {};
+    }
+
+    float PhysicsWorld::update(float frame_dt)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        const Uint64 start = SDL_GetTicksNS();
+
+        accumulator_ += std::max(frame_dt, 0.0f);
+        int steps = 0;
+        while (accumulator_ >= config_.fixedStep && steps < config_.maxSubSteps)
+        {
+            step();
+            accumulator_ -= config_.fixedStep;
+            ++steps;
+        }
+        // A frame longer than maxSubSteps steps (a stall, a breakpoint) is not caught up, the game slows down instead
+        if (accumulator_ >= config_.fixedStep) accumulator_ = std::fmod(accumulator_, config_.fixedStep);
+
+        stats_.steps = steps;
+        stats_.stepMs = (SDL_GetTicksNS() - start) / 1'000'000.0;
+        return accumulator_ / config_.fixedStep;
+    }
+
+    void PhysicsWorld::step()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        const float dt = config_.fixedStep;
+        std::copy(positions_.begin(), positions_.begin() + static_cast<std::ptrdiff_t>(awakeCount_), previous_.begin());
+
+        integrateVelocities(dt);
+        findContacts();
+        buildIslands();
+        solveIslands();
+        integratePositions(dt);
+
+        stats_.bodies = bodyCount_;
+        stats_.awake = awakeCount_;
+        stats_.contacts = contacts_.size();
+
+        updateSleep(dt);
+        processWakes();
+    }
+
+    glm::vec2 PhysicsWorld::getInterpolatedPosition(BodyId id, float alpha) const
+    {
+        const std::size_t slot = slots_[id];
+        return previous_[slot] + (positions_[slot] - previous_[slot]) * alpha;
+    }
+
+    void PhysicsWorld::setPosition(BodyId id, const glm::vec2& position)
+    {
+        // Whatever rested on the body at its old place must fall; waking may move it to another slot
+        wakeTouching(rectOf(slots_[id]));
+
+        const std::size_t slot = slots_[id];
+        positions_[slot] = position;
+        previous_[slot] = position;
+        broadPhase_.moveProxy(proxies_[slot], rectOf(slot));
+        wake(id);
+    }
+
+    void PhysicsWorld::setVelocity(BodyId id, const glm::vec2& velocity)
+    {
+        if (flags_[slots_[id]] & (FLAG_DYNAMIC | FLAG_KINEMATIC))
+        {
+            velocities_[slots_[id]] = velocity;
+            wake(id);
+        }
+    }
+
+    void PhysicsWorld::applyImpulse(BodyId id, const glm::vec2& impulse)
+    {
+        const std::size_t slot = slots_[id];
+        if (invMass_[slot] > 0.0f)
+        {
+            velocities_[slot] += impulse * invMass_[slot];
+            wake(id);
+        }
+    }
+
+    void PhysicsWorld::wake(BodyId id)
+    {
+        wakeStack_.push_back(id);
+        while (!wakeStack_.empty())
+        {
+            const std::size_t slot = slots_[wakeStack_.back()];
+            wakeStack_.pop_back();
+            if (slot < awakeCount_ || slot >= bodyCount_ - staticCount_) continue;
+
+            wakeSlot(slot);
+            // wakeSlot() moved the body to the end of the awake range
+            const std::size_t woken = awakeCount_ - 1;
+            broadPhase_.query(expanded(rectOf(woken), WAKE_MARGIN), COLLISION_LAYER_ALL, queryResult_);
+            for (const ProxyId proxy : queryResult_)
+            {
+                const std::size_t other = slots_[proxyBodies_[proxy]];
+                if (other >= awakeCount_ && other < bodyCount_ - staticCount_) wakeStack_.push_back(ids_[other]);
+            }
+        }
+    }
+
+    void PhysicsWorld::swapSlots(std::size_t a, std::size_t b)
+    {
+        if (a == b) return;
+        std::swap(positions_[a], positions_[b]);
+        std::swap(previous_[a], previous_[b]);
+        std::swap(sizes_[a], sizes_[b]);
+        std::swap(velocities_[a], velocities_[b]);
+        std::swap(invMass_[a], invMass_[b]);
+        std::swap(gravityScale_[a], gravityScale_[b]);
+        std::swap(sleepTimer_[a], sleepTimer_[b]);
+        std::swap(flags_[a], flags_[b]);
+        std::swap(proxies_[a], proxies_[b]);
+        std::swap(ids_[a], ids_[b]);
+        slots_[ids_[a]] = static_cast<Uint32>(a);
+        slots_[ids_[b]] = static_cast<Uint32>(b);
+    }
+
+    void PhysicsWorld::wakeSlot(std::size_t slot)
+    {
+        swapSlots(slot, awakeCount_);
+        sleepTimer_[awakeCount_] = 0.0f;
+        ++awakeCount_;
+    }
+
+    void PhysicsWorld::sleepSlot(std::size_t slot)
+    {
+        const std::size_t last = --awakeCount_;
+        swapSlots(slot, last);
+        velocities_[last] = glm::vec2(0.0f);
+        previous_[last] = positions_[last];
+        sleepTimer_[last] = 0.0f;
+    }
+
+    void PhysicsWorld::wakeTouching(const engine::utils::Rect& rect)
+    {
+        broadPhase_.query(expanded(rect, WAKE_MARGIN), COLLISION_LAYER_ALL, queryResult_);
+        toWake_.clear();
+        for (const ProxyId proxy : queryResult_)
+        {
+            toWake_.push_back(proxyBodies_[proxy]);
+        }
+        processWakes();
+    }
+
+    void PhysicsWorld::processWakes()
+    {
+        for (const BodyId id : toWake_)
+        {
+            wake(id);
+        }
+        toWake_.clear();
+    }
+
+    void PhysicsWorld::integrateVelocities(float dt)
+    {
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            if (!(flags_[slot] & FLAG_DYNAMIC)) continue;
+            glm::vec2& velocity = velocities_[slot];
+            velocity += config_.gravity * gravityScale_[slot] * dt;
+            velocity.y = std::min(velocity.y, config_.maxFallSpeed);
+        }
+    }
+
+    void PhysicsWorld::integratePositions(float dt)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            glm::vec2& velocity = velocities_[slot];
+            const glm::vec2 motion = velocity * dt;
+            if ((flags_[slot] & FLAG_TILES) && tileMap_)
+            {
+                const TileSweepResult result = tileMap_->sweep(rectOf(slot), motion);
+                positions_[slot] = result.position;
+                if (result.hitX) velocity.x = 0.0f;
+                if (result.hitY) velocity.y = 0.0f;
+                flags_[slot] = result.grounded ? (flags_[slot] | FLAG_ON_TILES) : (flags_[slot] & static_cast<Uint8>(~FLAG_ON_TILES));
+            }
+            else
+            {
+                positions_[slot] += motion;
+            }
+            broadPhase_.moveProxy(proxies_[slot], rectOf(slot));
+        }
+    }
+
+    void PhysicsWorld::findContacts()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        contacts_.clear();
+        toWake_.clear();
+        const float moving_speed_sq = config_.sleepVelocity * config_.sleepVelocity;
+
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            flags_[slot] &= static_cast<Uint8>(~(FLAG_GROUNDED | FLAG_TOUCHED_MOVER | FLAG_SUPPORTED));
+            if (flags_[slot] & FLAG_ON_TILES) flags_[slot] |= FLAG_SUPPORTED;
+        }
+
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            const ProxyId proxy = proxies_[slot];
+            const Uint32 layer = broadPhase_.getLayer(proxy);
+            const Uint32 mask = broadPhase_.getMask(proxy);
+            broadPhase_.query(expanded(rectOf(slot), CONTACT_MARGIN), mask, queryResult_);
+
+            for (const ProxyId other_proxy : queryResult_)
+            {
+                if (other_proxy == proxy) continue;
+                const std::size_t other = slots_[proxyBodies_[other_proxy]];
+                // A pair of awake bodies is found from both sides; the lower slot keeps it
+                if (other < awakeCount_ && other < slot) continue;
+                if (!filtersMatch(layer, mask, broadPhase_.getLayer(other_proxy), broadPhase_.getMask(other_proxy))) continue;
+
+                const Uint8 flags_a = flags_[slot];
+                const Uint8 flags_b = flags_[other];
+                const bool sensor = ((flags_a | flags_b) & FLAG_SENSOR) != 0;
+                // Kinematic and static bodies ignore each other unless one is a sensor
+                if (!sensor && !((flags_a | flags_b) & FLAG_DYNAMIC)) continue;
+
+                // The normal is the axis of least penetration, or the separating axis of two touching boxes; corners do not touch
+                const glm::vec2 overlap = overlapOf(positions_[slot], sizes_[slot], positions_[other], sizes_[other]);
+                const glm::vec2 delta = (positions_[other] + sizes_[other] * 0.5f) - (positions_[slot] + sizes_[slot] * 0.5f);
+                const bool x_axis = overlap.y > 0.0f && (overlap.x <= 0.0f || overlap.x < overlap.y);
+                const bool y_axis = !x_axis && overlap.x > 0.0f;
+                if (!x_axis && !y_axis) continue;
+                // Sensors only report real overlaps
+                if (sensor && (overlap.x <= 0.0f || overlap.y <= 0.0f)) continue;
+
+                BodyContact contact{ids_[slot], ids_[other], {0.0f, 0.0f}, 0.0f, sensor};
+                if (x_axis)
+                {
+                    contact.normal.x = delta.x < 0.0f ? -1.0f : 1.0f;
+                    contact.depth = overlap.x;
+                }
+                else
+                {
+                    contact.normal.y = delta.y < 0.0f ? -1.0f : 1.0f;
+                    contact.depth = overlap.y;
+                }
+                contacts_.push_back(contact);
+                if (sensor) continue;
+
+                // A sleeping body wakes when something moves into it; resting on it does not count
+                const float approach = glm::dot(velocities_[slot] - velocities_[other], contact.normal);
+                if (other >= awakeCount_ && (flags_b & FLAG_DYNAMIC) && other < bodyCount_ - staticCount_ && (contact.depth > 0.0f || approach * approach > moving_speed_sq))
+                {
+                    toWake_.push_back(contact.b);
+                }
+
+                if (contact.normal.y > 0.0f && (flags_a & FLAG_DYNAMIC)) flags_[slot] |= FLAG_GROUNDED;
+                if (contact.normal.y < 0.0f && (flags_b & FLAG_DYNAMIC)) flags_[other] |= FLAG_GROUNDED;
+
+                // Riding a moving platform is not settling, even when the rider's own velocity is zero
+                if ((flags_b & FLAG_KINEMATIC) && glm::dot(velocities_[other], velocities_[other]) > moving_speed_sq) flags_[slot] |= FLAG_TOUCHED_MOVER;
+                if ((flags_a & FLAG_KINEMATIC) && glm::dot(velocities_[slot], velocities_[slot]) > moving_speed_sq) flags_[other] |= FLAG_TOUCHED_MOVER;
+            }
+        }
+    }
+
+    Uint32 PhysicsWorld::findRoot(Uint32 slot)
+    {
+        while (parents_[slot] != slot)
+        {
+            parents_[slot] = parents_[parents_[slot]];
+            slot = parents_[slot];
+        }
+        return slot;
+    }
+
+    void PhysicsWorld::buildIslands()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        parents_.resize(awakeCount_);
+        std::iota(parents_.begin(), parents_.end(), Uint32{0});
+        islandOf_.assign(awakeCount_, NO_ISLAND);
+        islands_.clear();
+        contactOrder_.clear();
+
+        const auto movable = [this](Uint32 slot) { return slot < awakeCount_ && invMass_[slot] > 0.0f; };
+
+        // Union the awake dynamic bodies touching each other; anything else is a wall to the island
+        for (const BodyContact& contact : contacts_)
+        {
+            if (contact.sensor) continue;
+            const Uint32 a = slots_[contact.a];
+            const Uint32 b = slots_[contact.b];
+            if (!movable(a) || !movable(b)) continue;
+            const Uint32 root_a = findRoot(a);
+            const Uint32 root_b = findRoot(b);
+            if (root_a != root_b) parents_[std::max(root_a, root_b)] = std::min(root_a, root_b);
+        }
+
+        // Count the contacts of each island, numbering islands in order of first contact
+        std::size_t solved = 0;
+        for (const BodyContact& contact : contacts_)
+        {
+            if (contact.sensor) continue;
+            const Uint32 a = slots_[contact.a];
+            const Uint32 b = slots_[contact.b];
+            const Uint32 owner = movable(a) ? a : (movable(b) ? b : NO_ISLAND);
+            if (owner == NO_ISLAND) continue;
+
+            const Uint32 root = findRoot(owner);
+            if (islandOf_[root] == NO_ISLAND)
+            {
+                islandOf_[root] = static_cast<Uint32>(islands_.size());
+                islands_.emplace_back();
+            }
+            ++islands_[islandOf_[root]].contactCount;
+            ++solved;
+        }
+
+        Uint32 first = 0;
+        for (Island& island : islands_)
+        {
+            island.firstContact = first;
+            first += island.contactCount;
+            island.contactCount = 0;
+        }
+
+        contactOrder_.resize(solved);
+        for (std::size_t i = 0; i < contacts_.size(); ++i)
+        {
+            const BodyContact& contact = contacts_[i];
+            if (contact.sensor) continue;
+            const Uint32 a = slots_[contact.a];
+            const Uint32 b = slots_[contact.b];
+            const Uint32 owner = movable(a) ? a : (movable(b) ? b : NO_ISLAND);
+            if (owner == NO_ISLAND) continue;
+
+            Island& island = islands_[islandOf_[findRoot(owner)]];
+            contactOrder_[island.firstContact + island.contactCount++] = static_cast<Uint32>(i);
+        }
+
+        std::size_t largest = 0;
+        for (Uint32 slot = 0; slot < awakeCount_; ++slot)
+        {
+            if (!movable(slot)) continue;
+            const Uint32 island = islandOf_[findRoot(slot)];
+            if (island != NO_ISLAND) largest = std::max<std::size_t>(largest, ++islands_[island].bodyCount);
+        }
+        stats_.islands = islands_.size();
+        stats_.largestIsland = largest;
+    }
+
+    void PhysicsWorld::solveIslands()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        // Pack consecutive islands into batches of about BATCH_CONTACTS contacts, so tiny islands do not cost a task each
+        batches_.clear();
+        IslandBatch batch;
+        std::size_t batch_contacts = 0;
+        for (Uint32 i = 0; i < islands_.size(); ++i)
+        {
+            batch_contacts += islands_[i].contactCount;
+            batch.endIsland = i + 1;
+            if (batch_contacts >= BATCH_CONTACTS)
+            {
+                batches_.push_back(batch);
+                batch.firstIsland = batch.endIsland;
+                batch_contacts = 0;
+            }
+        }
+        if (batch.endIsland > batch.firstIsland) batches_.push_back(batch);
+        stats_.batches = batches_.size();
+
+        const bool parallel = !workers_.empty() && batches_.size() > 1 && contactOrder_.size() >= config_.parallelMinContacts;
+        if (!parallel)
+        {
+            for (const IslandBatch& island_batch : batches_)
+            {
+                solveBatch(island_batch);
+            }
+        }
+        else
+        {
+            nextBatch_.store(0, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(workerMutex_);
+                ++workerGeneration_;
+                workersBusy_ = workers_.size();
+            }
+            workerWake_.notify_all();
+
+            // The caller takes batches too instead of idling
+            drainBatches();
+
+            std::unique_lock<std::mutex> lock(workerMutex_);
+            workerDone_.wait(lock, [this] { return workersBusy_ == 0; });
+        }
+
+        // Proxies follow the solved positions; not done by the solver threads, the broadphase is not thread-safe
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            if (invMass_[slot] > 0.0f) broadPhase_.moveProxy(proxies_[slot], rectOf(slot));
+        }
+    }
+
+    void PhysicsWorld::solveBatch(const IslandBatch& batch)
+    {
+        for (Uint32 i = batch.firstIsland; i < batch.endIsland; ++i)
+        {
+            solveIsland(islands_[i]);
+        }
+    }
+
+    void PhysicsWorld::solveIsland(const Island& island)
+    {
+        // Only writes bodies of this island: every movable body belongs to exactly one island, others are read only
+        const float inv_dt = 1.0f / config_.fixedStep;
+        const auto first = contactOrder_.begin() + island.firstContact;
+        const auto last = first + island.contactCount;
+        const auto bottom = [this](Uint32 index) {
+            const BodyContact& contact = contacts_[index];
+            const std::size_t a = slots_[contact.a];
+            const std::size_t b = slots_[contact.b];
+            return std::max(positions_[a].y + sizes_[a].y, positions_[b].y + sizes_[b].y);
+        };
+        // Lowest contacts first, so support propagates up a stack within one pass
+        std::sort(first, last, [&](Uint32 lhs, Uint32 rhs) { return bottom(lhs) > bottom(rhs); });
+
+        const auto push = [this](std::size_t slot, const glm::vec2& motion) {
+            // Float noise from resting contacts; not worth a tile sweep
+            if (std::abs(motion.x) < MIN_PUSH && std::abs(motion.y) < MIN_PUSH) return;
+            if ((flags_[slot] & FLAG_TILES) && tileMap_)
+                positions_[slot] = tileMap_->sweep(rectOf(slot), motion).position;
+            else
+                positions_[slot] += motion;
+        };
+
+        // Gravity already pulled bodies standing on tiles down this step; the tiles will stop them, so what stands on them must not follow
+        const auto restingVelocity = [this](std::size_t slot) {
+            glm::vec2 velocity = velocities_[slot];
+            if (flags_[slot] & FLAG_ON_TILES) velocity.y = std::min(velocity.y, 0.0f);
+            return velocity;
+        };
+
+        for (int iteration = 0; iteration < config_.solverIterations; ++iteration)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                const BodyContact& contact = contacts_[*it];
+                const std::size_t a = slots_[contact.a];
+                const std::size_t b = slots_[contact.b];
+                float inv_a = a < awakeCount_ ? invMass_[a] : 0.0f;
+                float inv_b = b < awakeCount_ ? invMass_[b] : 0.0f;
+
+                // Standing on something supported: the body below does not give way
+                if (contact.normal.y != 0.0f)
+                {
+                    const bool b_below = contact.normal.y > 0.0f;
+                    const std::size_t lower = b_below ? b : a;
+                    const std::size_t upper = b_below ? a : b;
+                    float& inv_lower = b_below ? inv_b : inv_a;
+                    const float inv_upper = b_below ? inv_a : inv_b;
+                    if (inv_upper > 0.0f && (inv_lower == 0.0f || (flags_[lower] & FLAG_SUPPORTED)))
+                    {
+                        inv_lower = 0.0f;
+                        flags_[upper] |= FLAG_SUPPORTED;
+                    }
+                }
+                const float inv_total = inv_a + inv_b;
+                if (inv_total <= 0.0f) continue;
+
+                // Position: push apart along the contact axis by the current penetration, shared by inverse mass
+                const glm::vec2 overlap = overlapOf(positions_[a], sizes_[a], positions_[b], sizes_[b]);
+                const float depth = contact.normal.x != 0.0f ? overlap.x : overlap.y;
+                const float side = contact.normal.x != 0.0f ? overlap.y : overlap.x;
+                if (side <= 0.0f) continue;  // slid off each other during the solve
+                if (depth > 0.0f)
+                {
+                    const glm::vec2 correction = contact.normal * (depth / inv_total);
+                    if (inv_a > 0.0f) push(a, -correction * inv_a);
+                    if (inv_b > 0.0f) push(b, correction * inv_b);
+                }
+
+                // Velocity: remove the approach that would close more than the gap this step, no bounce
+                const float gap = std::max(-depth, 0.0f);
+                const float approach = glm::dot(restingVelocity(b) - restingVelocity(a), contact.normal) + gap * inv_dt;
+                if (approach < 0.0f)
+                {
+                    const glm::vec2 impulse = contact.normal * (-approach / inv_total);
+                    velocities_[a] -= impulse * inv_a;
+                    velocities_[b] += impulse * inv_b;
+                }
+            }
+        }
+    }
+
+    void PhysicsWorld::updateSleep(float dt)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        const float settle_speed_sq = config_.sleepVelocity * config_.sleepVelocity;
+        for (std::size_t slot = 0; slot < awakeCount_; ++slot)
+        {
+            const bool settling = glm::dot(velocities_[slot], velocities_[slot]) < settle_speed_sq && !(flags_[slot] & FLAG_TOUCHED_MOVER);
+            sleepTimer_[slot] = settling ? sleepTimer_[slot] + dt : 0.0f;
+        }
+
+        // An island sleeps as a whole: its least settled body decides. The root slot of each set holds the minimum.
+        for (Uint32 slot = 0; slot < awakeCount_; ++slot)
+        {
+            const Uint32 root = findRoot(slot);
+            if (root != slot) sleepTimer_[root] = std::min(sleepTimer_[root], sleepTimer_[slot]);
+        }
+
+        toSleep_.clear();
+        for (Uint32 slot = 0; slot < awakeCount_; ++slot)
+        {
+            if (sleepTimer_[findRoot(slot)] >= config_.sleepTime) toSleep_.push_back(slot);
+        }
+
+        // Highest slot first, so each swap with the end of the awake range moves a body that stays awake
+        for (auto it = toSleep_.rbegin(); it != toSleep_.rend(); ++it)
+        {
+            sleepSlot(*it);
+        }
+    }
+
+    void PhysicsWorld::drainBatches()
+    {
+        while (true)
+        {
+            const std::size_t index = nextBatch_.fetch_add(1, std::memory_order_relaxed);
+            if (index >= batches_.size()) return;
+            solveBatch(batches_[index]);
+        }
+    }
+
+    void PhysicsWorld::workerLoop()
+    {
+        ENGINE_PROFILE_THREAD("Physics solver");
+        ENGINE_ALLOC_SCOPE(Core);
+        Uint64 seen = 0;
+        std::unique_lock<std::mutex> lock(workerMutex_);
+        while (true)
+        {
+            workerWake_.wait(lock, [&] { return workersStopping_ || workerGeneration_ != seen; });
+            if (workersStopping_) return;
+            seen = workerGeneration_;
+            lock.unlock();
+
+            drainBatches();
+
+            lock.lock();
+            if (--workersBusy_ == 0) workerDone_.notify_one();
+        }
+    }
+}  // namespace engine::physics
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../utils/Math.h"
+#include "BroadPhase.h"
+
+namespace engine::physics
+{
+    class TileCollisionMap;
+
+    using BodyId = Uint32;  ///< @brief Handle of a PhysicsWorld body, reused after destroyBody()
+    constexpr BodyId INVALID_BODY = ~BodyId{0};
+
+    enum class BodyType : Uint8
+    {
+        Static,     ///< @brief Never moves; platforms, walls, triggers
+        Kinematic,  ///< @brief Moves by its velocity only, pushes dynamic bodies and is not pushed (moving platforms)
+        Dynamic,    ///< @brief Gravity, tiles and contacts move it (player, frog, opossum, eagle)
+    };
+
+    /**
+     * @brief Initial state of a body
+     */
+    struct BodyDef
+    {
+        BodyType type = BodyType::Dynamic;
+        glm::vec2 position{0.0f, 0.0f};  ///< @brief Top-left corner, world pixels
+        glm::vec2 size{16.0f, 16.0f};
+        glm::vec2 velocity{0.0f, 0.0f};  ///< @brief Pixels per second
+        float mass = 1.0f;               ///< @brief Dynamic bodies only; a heavier body is pushed less in a contact
+        float gravityScale = 1.0f;       ///< @brief 0 for flying actors (the eagle has no "gravity" property in actor.tsj)
+        Uint32 layer = 1;                ///< @brief Layers the body belongs to, see BroadPhase
+        Uint32 mask = COLLISION_LAYER_ALL;
+        bool sensor = false;            ///< @brief Reports contacts but never pushes or is pushed (items, triggers)
+        bool collidesWithTiles = true;  ///< @brief Dynamic bodies only: move through the TileCollisionMap
+    };
+
+    struct PhysicsConfig
+    {
+        float fixedStep = 1.0f / 60.0f;         ///< @brief Seconds per step
+        int maxSubSteps = 4;                    ///< @brief Steps per update() at most; the rest of a long frame is dropped
+        glm::vec2 gravity{0.0f, 980.0f};        ///< @brief Pixels per second squared, y down
+        float maxFallSpeed = 500.0f;            ///< @brief Vertical speed cap applied after gravity
+        float sleepVelocity = 2.0f;             ///< @brief A body slower than this (pixels per second) is settling
+        float sleepTime = 0.5f;                 ///< @brief Seconds every body of an island must have settled before it sleeps
+        int solverIterations = 4;               ///< @brief Passes over the contacts of an island per step
+        int solverThreads = 0;                  ///< @brief Extra threads solving islands; 0 solves everything on the caller
+        float broadPhaseCell = 64.0f;           ///< @brief BroadPhase cell size in pixels
+        std::size_t parallelMinContacts = 256;  ///< @brief Fewer contacts than this are solved on the caller even with threads
+    };
+
+    /**
+     * @brief Two bodies touching after a step. a is an awake body; b may be asleep, static or kinematic.
+     */
+    struct BodyContact
+    {
+        BodyId a = INVALID_BODY;
+        BodyId b = INVALID_BODY;
+        glm::vec2 normal{0.0f, 0.0f};  ///< @brief Axis from a towards b
+        float depth = 0.0f;            ///< @brief Penetration along the normal before the solver ran; negative for a small gap
+        bool sensor = false;           ///< @brief One of the two is a sensor: reported only, not solved
+    };
+
+    struct PhysicsStats
+    {
+        std::size_t bodies = 0;
+        std::size_t awake = 0;          ///< @brief Bodies the last step integrated, static ones excluded
+        std::size_t contacts = 0;       ///< @brief Including sensor contacts
+        std::size_t islands = 0;        ///< @brief Islands with at least one solved contact
+        std::size_t largestIsland = 0;  ///< @brief Bodies in the largest of them
+        std::size_t batches = 0;        ///< @brief Island batches the solver handed out
+        int steps = 0;                  ///< @brief Fixed steps run by the last update()
+        double stepMs = 0.0;            ///< @brief Time of the last update(), all its steps
+    };
+
+    /**
+     * @brief Fixed-step rigid body simulation of axis-aligned boxes for the platformer actors.
+     *
+     * Body state is structure-of-arrays, indexed by slot. Awake bodies are packed in slots [0, awakeCount_), sleeping
+     * and static ones follow, and a BodyId maps to its slot through slots_. Every per-step loop runs over the awake
+     * range only, so the cost of a step follows the number of active bodies, not the number in the level.
+     *
+     * A step applies gravity, finds body contacts (touching ones included) with one BroadPhase query per awake body,
+     * solves them, then moves the bodies, dynamic ones through the TileCollisionMap. The solver groups the awake dynamic
+     * bodies connected by contacts into islands; static, kinematic and sleeping bodies never join one, they are
+     * immovable within the step. Islands share no body, so they are solved independently: in batches on the solver
+     * threads when there are enough contacts, on the caller otherwise. Each island solves its contacts bottom-up, and a
+     * body standing on a supported one treats it as immovable, so a stack settles in one pass.
+     *
+     * An island whose bodies all stayed slower than sleepVelocity for sleepTime goes to sleep as a whole. A sleeping
+     * body is woken, together with the sleeping bodies touching it, by setVelocity(), applyImpulse(), setPosition(),
+     * by an awake body moving into it, or when a body touching it is destroyed.
+     *
+     * Scratch buffers are kept between steps, so a step in a steady state does not allocate.
+     * Not thread-safe: every public method is main thread only.
+     */
+    class PhysicsWorld final
+    {
+      private:
+        static constexpr Uint8 FLAG_DYNAMIC = 1u << 0;
+        static constexpr Uint8 FLAG_KINEMATIC = 1u << 1;
+        static constexpr Uint8 FLAG_SENSOR = 1u << 2;
+        static constexpr Uint8 FLAG_TILES = 1u << 3;
+        static constexpr Uint8 FLAG_GROUNDED = 1u << 4;       ///< @brief Stands on a body, from this step's contacts
+        static constexpr Uint8 FLAG_TOUCHED_MOVER = 1u << 5;  ///< @brief Touched a moving kinematic body this step, must not sleep
+        static constexpr Uint8 FLAG_SUPPORTED = 1u << 6;      ///< @brief Rests on tiles or on an immovable body, directly or through a stack
+        static constexpr Uint8 FLAG_ON_TILES = 1u << 7;       ///< @brief Stands on the tile map, from the last move
+
+        static constexpr std::size_t BATCH_CONTACTS = 64;  ///< @brief Contacts per solver batch; small islands are packed together
+        static constexpr float WAKE_MARGIN = 1.0f;         ///< @brief Bodies closer than this count as touching when waking
+        static constexpr float CONTACT_MARGIN = 0.5f;      ///< @brief Gap under which two bodies are in contact, so resting ones stay in contact
+
+        /**
+         * @brief Contacts [firstContact, firstContact + contactCount) of contactOrder_ belong to the island
+         */
+        struct Island
+        {
+            Uint32 firstContact = 0;
+            Uint32 contactCount = 0;
+            Uint32 bodyCount = 0;
+        };
+
+        /**
+         * @brief Islands [firstIsland, endIsland) solved by one task
+         */
+        struct IslandBatch
+        {
+            Uint32 firstIsland = 0;
+            Uint32 endIsland = 0;
+        };
+
+        PhysicsConfig config_;
+        BroadPhase broadPhase_;
+        const TileCollisionMap* tileMap_ = nullptr;
+        float accumulator_ = 0.0f;
+
+        // --- Bodies, structure of arrays indexed by slot ---
+        std::vector<glm::vec2> positions_;
+        std::vector<glm::vec2> previous_;  ///< @brief Position before the last step, for interpolation
+        std::vector<glm::vec2> sizes_;
+        std::vector<glm::vec2> velocities_;
+        std::vector<float> invMass_;  ///< @brief 0 for static, kinematic and sensor bodies
+        std::vector<float> gravityScale_;
+        std::vector<float> sleepTimer_;  ///< @brief Seconds the body has been settling
+        std::vector<Uint8> flags_;
+        std::vector<ProxyId> proxies_;
+        std::vector<BodyId> ids_;  ///< @brief Slot -> body
+
+        std::vector<Uint32> slots_;        ///< @brief BodyId -> slot, INVALID_BODY when destroyed
+        std::vector<BodyId> freeIds_;      ///< @brief Destroyed ids, reused last in first out
+        std::vector<BodyId> proxyBodies_;  ///< @brief ProxyId -> body
+        std::size_t bodyCount_ = 0;
+        std::size_t awakeCount_ = 0;   ///< @brief Slots [0, awakeCount_) are awake
+        std::size_t staticCount_ = 0;  ///< @brief Static bodies sit in the last slots and never wake
+
+        // --- Step scratch, kept for reuse ---
+        std::vector<BodyContact> contacts_;  ///< @brief Contacts of the last step, by awake slot of a
+        std::vector<Uint32> parents_;        ///< @brief Union-find over awake slots
+        std::vector<Uint32> islandOf_;       ///< @brief Awake slot -> island index
+        std::vector<Uint32> contactOrder_;   ///< @brief Solved contacts grouped by island
+        std::vector<Island> islands_;
+        std::vector<IslandBatch> batches_;
+        std::vector<ProxyId> queryResult_;
+        std::vector<BodyId> toWake_;
+        std::vector<BodyId> wakeStack_;
+        std::vector<Uint32> toSleep_;  ///< @brief Awake slots whose island fell asleep
+        PhysicsStats stats_;
+
+        // --- Solver threads ---
+        std::vector<std::thread> workers_;
+        std::mutex workerMutex_;
+        std::condition_variable workerWake_;  ///< @brief Signals the workers: a new set of batches or stopping
+        std::condition_variable workerDone_;  ///< @brief Signals the caller: a worker finished its share
+        Uint64 workerGeneration_ = 0;         ///< @brief Incremented per parallel solve, guarded by workerMutex_
+        std::size_t workersBusy_ = 0;
+        bool workersStopping_ = false;
+        std::atomic<std::size_t> nextBatch_{0};
+
+      public:
+        explicit PhysicsWorld(const PhysicsConfig& config = {});
+        ~PhysicsWorld();
+
+        // Delete copy and move constructors and assignment operators
+        PhysicsWorld(const PhysicsWorld&) = delete;
+        PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+        PhysicsWorld(PhysicsWorld&&) = delete;
+        PhysicsWorld& operator=(PhysicsWorld&&) = delete;
+
+        /**
+         * @brief Tiles dynamic bodies collide with; nullptr for none. The map must outlive its use.
+         */
+        void setTileMap(const TileCollisionMap* tile_map) { tileMap_ = tile_map; }
+
+        BodyId createBody(const BodyDef& def);
+
+        /**
+         * @brief Remove a body; sleeping bodies touching it are woken. Its id may be handed out again by createBody().
+         */
+        void destroyBody(BodyId id);
+
+        /**
+         * @brief Remove every body
+         */
+        void clear();
+
+        /**
+         * @brief Advance by a frame's duration in as many fixed steps as fit, carrying the remainder to the next frame
+         * @return how far the simulation is between the last two steps (0..1), for getInterpolatedPosition()
+         */
+        float update(float frame_dt);
+
+        /**
+         * @brief Run one fixed step
+         */
+        void step();
+
+        bool isValid(BodyId id) const { return id < slots_.size() && slots_[id] != INVALID_BODY; }
+        bool isAwake(BodyId id) const { return slots_[id] < awakeCount_; }
+        bool isGrounded(BodyId id) const { return (flags_[slots_[id]] & (FLAG_GROUNDED | FLAG_ON_TILES)) != 0; }  ///< @brief Standing on a tile or a body after the last step
+        const glm::vec2& getPosition(BodyId id) const { return positions_[slots_[id]]; }
+        const glm::vec2& getSize(BodyId id) const { return sizes_[slots_[id]]; }
+        const glm::vec2& getVelocity(BodyId id) const { return velocities_[slots_[id]]; }
+        glm::vec2 getInterpolatedPosition(BodyId id, float alpha) const;
+
+        /**
+         * @brief Teleport a body; wakes it
+         */
+        void setPosition(BodyId id, const glm::vec2& position);
+        void setVelocity(BodyId id, const glm::vec2& velocity);  ///< @brief Wakes the body
+        void applyImpulse(BodyId id, const glm::vec2& impulse);  ///< @brief Velocity change of impulse / mass; wakes the body
+
+        /**
+         * @brief Wake a body and the sleeping bodies touching it, transitively
+         */
+        void wake(BodyId id);
+
+        /**
+         * @brief Contacts found by the last step, including sensor contacts; valid until the next step
+         */
+        const std::vector<BodyContact>& getContacts() const { return contacts_; }
+        const PhysicsStats& getStats() const { return stats_; }
+        const PhysicsConfig& getConfig() const { return config_; }
+        std::size_t getBodyCount() const { return bodyCount_; }
+        std::size_t getAwakeCount() const { return awakeCount_; }
+
+      private:
+        engine::utils::Rect rectOf(std::size_t slot) const { return {positions_[slot], sizes_[slot]}; }
+
+        void swapSlots(std::size_t a, std::size_t b);
+        void wakeSlot(std::size_t slot);
+        void sleepSlot(std::size_t slot);
+        void wakeTouching(const engine::utils::Rect& rect);
+        void processWakes();
+
+        void integrateVelocities(float dt);
+        void integratePositions(float dt);
+        void findContacts();
+        void buildIslands();
+        void solveIslands();
+        void solveBatch(const IslandBatch& batch);
+        void solveIsland(const Island& island);
+        void updateSleep(float dt);
+
+        Uint32 findRoot(Uint32 slot);
+        void drainBatches();
+        void workerLoop();
+    };
+}  // namespace engine::physics
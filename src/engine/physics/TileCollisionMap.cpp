@@ -0,0 +1,380 @@
+#include "TileCollisionMap.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+#include "../level/BakedLevel.h"
+#include "../level/LevelData.h"
+
+namespace engine::physics
+{
+    namespace
+    {
+        constexpr float EPSILON = 1e-3f;    ///< @brief Edges closer than this count as touching
+        constexpr float SLOPE_SNAP = 1.0f;  ///< @brief Extra distance, in pixels, within which a body sticks to a slope
+
+        // Surface height at the left / right edge of each SlopeType, in half tiles
+        constexpr std::array<Uint8, 7> SLOPE_LEFT = {0, 0, 1, 0, 2, 2, 1};
+        constexpr std::array<Uint8, 7> SLOPE_RIGHT = {0, 1, 0, 2, 0, 1, 2};
+
+        SlopeType parseSlope(std::string_view slope)
+        {
+            if (slope == "0_1") return SlopeType::S0_1;
+            if (slope == "1_0") return SlopeType::S1_0;
+            if (slope == "0_2") return SlopeType::S0_2;
+            if (slope == "2_0") return SlopeType::S2_0;
+            if (slope == "2_1") return SlopeType::S2_1;
+            if (slope == "1_2") return SlopeType::S1_2;
+            return SlopeType::None;
+        }
+
+        int cellOf(float coordinate, float tile_size)
+        {
+            return static_cast<int>(std::floor(coordinate / tile_size));
+        }
+    }  // namespace
+
+    bool TileCollisionMap::build(const engine::level::LevelData& level)
+    {
+        if (level.infinite)
+        {
+            spdlog::warn("'{}' is an infinite map; its tiles are streamed by ChunkStreamer, the collision map stays empty.", level.path);
+            reset(0, 0, glm::vec2(level.tileSize));
+            return false;
+        }
+        reset(level.width, level.height, glm::vec2(level.tileSize));
+
+        // Classify every tileset tile once; cells then only copy a byte
+        std::vector<TileClass> classes;
+        for (const auto& tileset : level.tilesets)
+        {
+            classes.resize(static_cast<std::size_t>(tileset.firstGid) + tileset.tiles.size());
+            for (std::size_t id = 0; id < tileset.tiles.size(); ++id)
+            {
+                const auto& tile = tileset.tiles[id];
+                auto flag = [&tile](std::string_view name) {
+                    const auto* property = engine::level::findProperty(tile.properties, name);
+                    return property && property->asBool();
+                };
+                const auto* slope = engine::level::findProperty(tile.properties, "slope");
+                classes[static_cast<std::size_t>(tileset.firstGid) + id] =
+                    classify(flag("solid"), flag("unisolid"), flag("ladder"), slope ? std::string_view(slope->string) : std::string_view(), tile.shapes);
+            }
+        }
+
+        bool has_tile_layer = false;
+        for (const auto& layer : level.layers)
+        {
+            if (layer.type != engine::level::LayerType::Tile) continue;
+            has_tile_layer = true;
+            const std::size_t count = std::min(layer.tiles.size(), cells_.size());
+            for (std::size_t cell = 0; cell < count; ++cell)
+            {
+                const Uint32 gid = layer.tiles[cell] & engine::level::GID_MASK;
+                if (gid < classes.size() && classes[gid].flags != 0) setCell(cell, classes[gid]);
+            }
+        }
+
+        SPDLOG_DEBUG("Collision map for '{}' built: {}x{} cells, {} bytes.", level.path, size_.x, size_.y, getMemoryBytes());
+        return has_tile_layer;
+    }
+
+    bool TileCollisionMap::build(const engine::level::BakedLevel& level)
+    {
+        if (level.isInfinite())
+        {
+            spdlog::warn("'{}' is an infinite map; its tiles are streamed by ChunkStreamer, the collision map stays empty.", level.getPath());
+            reset(0, 0, glm::vec2(level.getTileWidth(), level.getTileHeight()));
+            return false;
+        }
+        reset(static_cast<int>(level.getWidth()), static_cast<int>(level.getHeight()), glm::vec2(level.getTileWidth(), level.getTileHeight()));
+
+        std::vector<TileClass> classes;
+        std::vector<engine::utils::Rect> shapes;
+        for (const auto& tileset : level.getTilesets())
+        {
+            const auto tiles = level.getTiles(tileset);
+            classes.resize(static_cast<std::size_t>(tileset.firstGid) + tiles.size());
+            for (std::size_t id = 0; id < tiles.size(); ++id)
+            {
+                const auto& tile = tiles[id];
+                auto flag = [&](std::string_view name) {
+                    const auto* property = level.findProperty(tile.properties, name);
+                    return property && property->number != 0.0;
+                };
+                const auto* slope = level.findProperty(tile.properties, "slope");
+                const bool is_string = slope && slope->type == engine::level::BakedPropertyType::String;
+
+                shapes.clear();
+                for (const auto& shape : level.getShapes(tile))
+                {
+                    shapes.push_back(engine::utils::Rect{{shape.x, shape.y}, {shape.width, shape.height}});
+                }
+                classes[static_cast<std::size_t>(tileset.firstGid) + id] =
+                    classify(flag("solid"), flag("unisolid"), flag("ladder"), is_string ? level.getString(slope->string) : std::string_view(), shapes);
+            }
+        }
+
+        bool has_tile_layer = false;
+        for (const auto& layer : level.getLayers())
+        {
+            if (layer.type != engine::level::BakedLayerType::Tile) continue;
+            has_tile_layer = true;
+            const auto cells = level.getCells(layer);
+            const std::size_t count = std::min(cells.size(), cells_.size());
+            for (std::size_t cell = 0; cell < count; ++cell)
+            {
+                const Uint32 gid = engine::level::unpackBakedGid(cells[cell]) & engine::level::GID_MASK;
+                if (gid < classes.size() && classes[gid].flags != 0) setCell(cell, classes[gid]);
+            }
+        }
+
+        SPDLOG_DEBUG("Collision map for '{}' built: {}x{} cells, {} bytes.", level.getPath(), size_.x, size_.y, getMemoryBytes());
+        return has_tile_layer;
+    }
+
+    TileSweepResult TileCollisionMap::sweep(const engine::utils::Rect& box, const glm::vec2& motion, bool drop_through) const
+    {
+        TileSweepResult result;
+        engine::utils::Rect moved = box;
+
+        // Horizontal first, then vertical: each axis only scans the band its leading edge sweeps
+        const float dx = sweepX(moved, motion.x, result);
+        moved.position.x += dx;
+
+        const float bottom_before = moved.position.y + moved.size.y;
+        const float dy = sweepY(moved, motion.y, drop_through, result);
+        moved.position.y += dy;
+
+        snapToSlope(moved, bottom_before, std::abs(dx) + SLOPE_SNAP, motion.y < 0.0f, result);
+
+        result.position = moved.position;
+        result.motion = moved.position - box.position;
+        return result;
+    }
+
+    bool TileCollisionMap::overlapsFlags(const engine::utils::Rect& box, Uint8 flags) const
+    {
+        const int x0 = cellOf(box.position.x, tileSize_.x);
+        const int x1 = cellOf(box.position.x + box.size.x - EPSILON, tileSize_.x);
+        const int y0 = cellOf(box.position.y, tileSize_.y);
+        const int y1 = cellOf(box.position.y + box.size.y - EPSILON, tileSize_.y);
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (getFlags(x, y) & flags) return true;
+            }
+        }
+        return false;
+    }
+
+    std::span<const engine::utils::Rect> TileCollisionMap::getShapes(int x, int y) const
+    {
+        if (!(getFlags(x, y) & TILE_HAS_SHAPES)) return {};
+
+        auto it = cellShapes_.find(static_cast<Uint32>(index(x, y)));
+        if (it == cellShapes_.end()) return {};
+        return std::span<const engine::utils::Rect>(shapes_).subspan(it->second.first, it->second.count);
+    }
+
+    float TileCollisionMap::slopeHeight(SlopeType slope, float local_x, const glm::vec2& tile_size)
+    {
+        const auto type = static_cast<std::size_t>(slope);
+        const float t = std::clamp(local_x / tile_size.x, 0.0f, 1.0f);
+        const float left = SLOPE_LEFT[type] * 0.5f * tile_size.y;
+        const float right = SLOPE_RIGHT[type] * 0.5f * tile_size.y;
+        return left + (right - left) * t;
+    }
+
+    void TileCollisionMap::reset(int width, int height, const glm::vec2& tile_size)
+    {
+        size_ = {std::max(width, 0), std::max(height, 0)};
+        tileSize_ = glm::max(tile_size, glm::vec2(1.0f));
+        cells_.assign(static_cast<std::size_t>(size_.x) * static_cast<std::size_t>(size_.y), 0);
+        shapes_.clear();
+        cellShapes_.clear();
+    }
+
+    void TileCollisionMap::setCell(std::size_t cell, const TileClass& tile_class)
+    {
+        // Layers are merged; the first layer that puts a slope in a cell decides its type
+        Uint8& flags = cells_[cell];
+        const Uint8 incoming = (flags & TILE_SLOPE_MASK) ? static_cast<Uint8>(tile_class.flags & ~TILE_SLOPE_MASK) : tile_class.flags;
+        if ((incoming & TILE_HAS_SHAPES) && !(flags & TILE_HAS_SHAPES))
+        {
+            cellShapes_.emplace(static_cast<Uint32>(cell), tile_class.shapes);
+        }
+        flags |= incoming;
+    }
+
+    TileCollisionMap::TileClass TileCollisionMap::classify(bool solid, bool one_way, bool ladder, std::string_view slope, std::span<const engine::utils::Rect> shapes)
+    {
+        TileClass tile_class;
+        tile_class.flags = (solid ? TILE_SOLID : 0) | (one_way ? TILE_ONE_WAY : 0) | (ladder ? TILE_LADDER : 0);
+        tile_class.flags |= static_cast<Uint8>(static_cast<Uint8>(parseSlope(slope)) << TILE_SLOPE_SHIFT);
+
+        // Only blocking tiles need their sub-shapes; they replace the full tile rectangle
+        if ((solid || one_way) && !shapes.empty())
+        {
+            tile_class.flags |= TILE_HAS_SHAPES;
+            tile_class.shapes = ShapeRange{static_cast<Uint32>(shapes_.size()), static_cast<Uint32>(shapes.size())};
+            shapes_.insert(shapes_.end(), shapes.begin(), shapes.end());
+        }
+        return tile_class;
+    }
+
+    template <typename Fn>
+    void TileCollisionMap::forEachBlockingRect(int x, int y, Uint8 flags, Fn&& fn) const
+    {
+        const glm::vec2 origin(static_cast<float>(x) * tileSize_.x, static_cast<float>(y) * tileSize_.y);
+        if (!(flags & TILE_HAS_SHAPES))
+        {
+            fn(engine::utils::Rect{origin, tileSize_});
+            return;
+        }
+        for (const auto& shape : getShapes(x, y))
+        {
+            fn(engine::utils::Rect{origin + shape.position, shape.size});
+        }
+    }
+
+    float TileCollisionMap::sweepX(const engine::utils::Rect& box, float dx, TileSweepResult& result) const
+    {
+        if (dx == 0.0f) return 0.0f;
+
+        const float top = box.position.y;
+        const float bottom = box.position.y + box.size.y;
+        const int y0 = cellOf(top, tileSize_.y);
+        const int y1 = cellOf(bottom - EPSILON, tileSize_.y);
+
+        // Leading edge and the columns it crosses, nearest first
+        const bool right = dx > 0.0f;
+        const float lead = right ? box.position.x + box.size.x : box.position.x;
+        const int x_first = right ? cellOf(lead, tileSize_.x) : cellOf(lead - EPSILON, tileSize_.x);
+        // A motion under EPSILON can put the last column behind the first; the scan must still end
+        const int x_last = right ? std::max(cellOf(lead + dx - EPSILON, tileSize_.x), x_first) : std::min(cellOf(lead + dx, tileSize_.x), x_first);
+        const int step = right ? 1 : -1;
+
+        float allowed = dx;
+        for (int x = x_first;; x += step)
+        {
+            for (int y = y0; y <= y1; ++y)
+            {
+                ++result.tilesVisited;
+                const Uint8 flags = getFlags(x, y);
+                if (!(flags & TILE_SOLID)) continue;
+
+                forEachBlockingRect(x, y, flags, [&](const engine::utils::Rect& rect) {
+                    if (rect.position.y >= bottom || rect.position.y + rect.size.y <= top) return;
+                    // Shapes already overlapping the box are ignored so a stuck body can move out
+                    if (right && rect.position.x >= lead - EPSILON) allowed = std::min(allowed, rect.position.x - lead);
+                    if (!right && rect.position.x + rect.size.x <= lead + EPSILON) allowed = std::max(allowed, rect.position.x + rect.size.x - lead);
+                });
+            }
+            // Anything in a farther column starts beyond this one, so the first column with a hit decides
+            if (allowed != dx || x == x_last) break;
+        }
+
+        if (allowed != dx)
+        {
+            result.hitX = true;
+            return right ? std::max(allowed, 0.0f) : std::min(allowed, 0.0f);
+        }
+        return dx;
+    }
+
+    float TileCollisionMap::sweepY(const engine::utils::Rect& box, float dy, bool drop_through, TileSweepResult& result) const
+    {
+        if (dy == 0.0f) return 0.0f;
+
+        const float left = box.position.x;
+        const float right = box.position.x + box.size.x;
+        const int x0 = cellOf(left, tileSize_.x);
+        const int x1 = cellOf(right - EPSILON, tileSize_.x);
+
+        const bool down = dy > 0.0f;
+        const float lead = down ? box.position.y + box.size.y : box.position.y;
+        const int y_first = down ? cellOf(lead, tileSize_.y) : cellOf(lead - EPSILON, tileSize_.y);
+        const int y_last = down ? std::max(cellOf(lead + dy - EPSILON, tileSize_.y), y_first) : std::min(cellOf(lead + dy, tileSize_.y), y_first);
+        const int step = down ? 1 : -1;
+
+        // One-way platforms only stop bodies moving down whose feet start above them, which the leading edge test below ensures
+        const Uint8 blocking = (down && !drop_through) ? (TILE_SOLID | TILE_ONE_WAY) : TILE_SOLID;
+
+        float allowed = dy;
+        for (int y = y_first;; y += step)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                ++result.tilesVisited;
+                const Uint8 flags = getFlags(x, y);
+                if (!(flags & blocking)) continue;
+
+                forEachBlockingRect(x, y, flags, [&](const engine::utils::Rect& rect) {
+                    if (rect.position.x >= right || rect.position.x + rect.size.x <= left) return;
+                    if (down && rect.position.y >= lead - EPSILON) allowed = std::min(allowed, rect.position.y - lead);
+                    if (!down && rect.position.y + rect.size.y <= lead + EPSILON) allowed = std::max(allowed, rect.position.y + rect.size.y - lead);
+                });
+            }
+            if (allowed != dy || y == y_last) break;
+        }
+
+        if (allowed != dy)
+        {
+            result.hitY = true;
+            result.grounded = down;
+            return down ? std::max(allowed, 0.0f) : std::min(allowed, 0.0f);
+        }
+        return dy;
+    }
+
+    void TileCollisionMap::snapToSlope(engine::utils::Rect& box, float bottom_before, float tolerance, bool rising, TileSweepResult& result) const
+    {
+        // The box rests on the highest slope point under its feet, so it reaches the top of a ramp flush with the ground beyond.
+        // Slopes are linear, so the highest point of each column is at one end of the part of the feet inside it.
+        const float left = box.position.x;
+        const float right = box.position.x + box.size.x;
+        const float bottom = box.position.y + box.size.y;
+        const int x0 = cellOf(left, tileSize_.x);
+        const int x1 = cellOf(right - EPSILON, tileSize_.x);
+        const int y0 = cellOf(std::min(bottom_before, bottom) - tolerance, tileSize_.y);
+        const int y1 = cellOf(bottom + tolerance, tileSize_.y);
+
+        bool found = false;
+        float surface = 0.0f;
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                ++result.tilesVisited;
+                const SlopeType slope = getSlope(x, y);
+                if (slope == SlopeType::None) continue;
+
+                const float tile_left = static_cast<float>(x) * tileSize_.x;
+                const float height = std::max(slopeHeight(slope, std::max(left, tile_left) - tile_left, tileSize_),
+                                              slopeHeight(slope, std::min(right, tile_left + tileSize_.x) - tile_left, tileSize_));
+                const float tile_surface = static_cast<float>(y + 1) * tileSize_.y - height;
+                if (!found || tile_surface < surface)
+                {
+                    surface = tile_surface;
+                    found = true;
+                }
+            }
+        }
+        if (!found) return;
+
+        // Below the surface: push up. Slightly above it while not jumping: stick to it, so walking downhill does not bounce
+        const bool penetrating = bottom > surface + EPSILON && bottom_before <= surface + tolerance;
+        const bool sticking = !rising && bottom >= surface - tolerance && bottom <= surface + EPSILON;
+        if (penetrating || sticking)
+        {
+            box.position.y = surface - box.size.y;
+            result.hitY = true;
+            result.grounded = true;
+            result.onSlope = true;
+        }
+    }
+}  // namespace engine::physics
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/glm.hpp>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/Math.h"
+
+namespace engine::level
+{
+    struct LevelData;
+    class BakedLevel;
+}  // namespace engine::level
+
+namespace engine::physics
+{
+    // --- Per-tile collision bits (TileCollisionMap::getFlags) ---
+    constexpr Uint8 TILE_SOLID = 1u << 0;       ///< @brief Blocks from every side ("solid" tile property)
+    constexpr Uint8 TILE_ONE_WAY = 1u << 1;     ///< @brief Blocks only bodies falling onto its top ("unisolid")
+    constexpr Uint8 TILE_LADDER = 1u << 2;      ///< @brief Climbable, never blocks ("ladder")
+    constexpr Uint8 TILE_HAS_SHAPES = 1u << 3;  ///< @brief Solid area is the tile's sub-shapes instead of the whole tile
+    constexpr Uint8 TILE_SLOPE_SHIFT = 4;       ///< @brief Bits 4-6 hold the SlopeType
+    constexpr Uint8 TILE_SLOPE_MASK = 0x7u << TILE_SLOPE_SHIFT;
+
+    /**
+     * @brief Slope tiles, named after the "slope" property: surface height at the left and right edge in half tiles
+     */
+    enum class SlopeType : Uint8
+    {
+        None,
+        S0_1,  ///< @brief "0_1": rises from the bottom to half height
+        S1_0,  ///< @brief "1_0"
+        S0_2,  ///< @brief "0_2": 45 degree slope up to the right
+        S2_0,  ///< @brief "2_0": 45 degree slope down to the right
+        S2_1,  ///< @brief "2_1"
+        S1_2,  ///< @brief "1_2"
+    };
+
+    /**
+     * @brief Result of TileCollisionMap::sweep()
+     */
+    struct TileSweepResult
+    {
+        glm::vec2 position{0.0f, 0.0f};  ///< @brief Top-left corner of the box after the move
+        glm::vec2 motion{0.0f, 0.0f};    ///< @brief Motion actually applied
+        bool hitX = false;               ///< @brief Horizontal motion was blocked
+        bool hitY = false;               ///< @brief Vertical motion was blocked (floor, one-way platform, slope or ceiling)
+        bool grounded = false;           ///< @brief The box ended up standing on something
+        bool onSlope = false;            ///< @brief The box ended up standing on a slope
+        Uint32 tilesVisited = 0;         ///< @brief Tiles examined, for profiling
+    };
+
+    /**
+     * @brief Collision grid of a level, built once at load from the tile layers.
+     *
+     * Each cell is one byte of TILE_* flags plus an optional slope type; tiles with collision sub-shapes keep them in a side table.
+     * All tile layers are merged. sweep() moves an axis-aligned box one axis at a time and only looks at the tiles the
+     * leading edge passes through, so a body moving less than a tile per step touches a handful of cells.
+     */
+    class TileCollisionMap final
+    {
+      private:
+        /**
+         * @brief Sub-shapes of one cell: [first, first + count) in shapes_
+         */
+        struct ShapeRange
+        {
+            Uint32 first = 0;
+            Uint32 count = 0;
+        };
+
+        glm::ivec2 size_{0, 0};                              ///< @brief Map size in tiles
+        glm::vec2 tileSize_{0.0f, 0.0f};                     ///< @brief Tile size in pixels
+        std::vector<Uint8> cells_;                           ///< @brief size_.x * size_.y flag bytes, row major
+        std::vector<engine::utils::Rect> shapes_;            ///< @brief Sub-shapes in tile local coordinates
+        std::unordered_map<Uint32, ShapeRange> cellShapes_;  ///< @brief Cell index -> sub-shapes, only for TILE_HAS_SHAPES cells
+
+      public:
+        TileCollisionMap() = default;
+
+        /**
+         * @brief Build from a level loaded from JSON
+         * @return false if the level has no tile layer or is infinite
+         */
+        bool build(const engine::level::LevelData& level);
+
+        /**
+         * @brief Build from a baked level
+         * @return false if the level has no tile layer or is infinite
+         */
+        bool build(const engine::level::BakedLevel& level);
+
+        /**
+         * @brief Move a box through the map, stopping at solid tiles, one-way platforms (when falling) and slopes
+         * @param box the box before the move, in world pixels
+         * @param motion the desired displacement this step
+         * @param drop_through ignore one-way platforms (e.g. down + jump)
+         */
+        TileSweepResult sweep(const engine::utils::Rect& box, const glm::vec2& motion, bool drop_through = false) const;
+
+        /**
+         * @brief Whether any tile overlapping the box has one of the flags, e.g. TILE_LADDER
+         */
+        bool overlapsFlags(const engine::utils::Rect& box, Uint8 flags) const;
+
+        /**
+         * @brief Flags of a cell; cells outside the map are empty
+         */
+        Uint8 getFlags(int x, int y) const { return inBounds(x, y) ? cells_[index(x, y)] : Uint8{0}; }
+        SlopeType getSlope(int x, int y) const { return static_cast<SlopeType>((getFlags(x, y) & TILE_SLOPE_MASK) >> TILE_SLOPE_SHIFT); }
+
+        /**
+         * @brief Collision sub-shapes of a cell, in tile local pixels; empty unless the cell has TILE_HAS_SHAPES
+         */
+        std::span<const engine::utils::Rect> getShapes(int x, int y) const;
+
+        glm::ivec2 getSize() const { return size_; }
+        glm::vec2 getTileSize() const { return tileSize_; }
+        std::size_t getMemoryBytes() const { return cells_.size() + shapes_.size() * sizeof(engine::utils::Rect) + cellShapes_.size() * (sizeof(Uint32) + sizeof(ShapeRange)); }
+
+        /**
+         * @brief Surface height of a slope tile at a local x, measured up from the bottom of the tile, in pixels
+         */
+        static float slopeHeight(SlopeType slope, float local_x, const glm::vec2& tile_size);
+
+      private:
+        /**
+         * @brief Collision data of one gid, computed once per tileset tile before the grid is filled
+         */
+        struct TileClass
+        {
+            Uint8 flags = 0;
+            ShapeRange shapes;  ///< @brief Shared by every cell using the tile
+        };
+
+        bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < size_.x && y < size_.y; }
+        std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * static_cast<std::size_t>(size_.x) + static_cast<std::size_t>(x); }
+
+        void reset(int width, int height, const glm::vec2& tile_size);
+        void setCell(std::size_t cell, const TileClass& tile_class);
+
+        /**
+         * @brief Collision class of a tile from its properties (solid / unisolid / ladder / slope); sub-shapes are appended to shapes_
+         */
+        TileClass classify(bool solid, bool one_way, bool ladder, std::string_view slope, std::span<const engine::utils::Rect> shapes);
+
+        /**
+         * @brief Call fn(const Rect&) for each blocking rectangle of a cell, in world pixels: the whole tile or its sub-shapes
+         */
+        template <typename Fn>
+        void forEachBlockingRect(int x, int y, Uint8 flags, Fn&& fn) const;
+
+        float sweepX(const engine::utils::Rect& box, float dx, TileSweepResult& result) const;
+        float sweepY(const engine::utils::Rect& box, float dy, bool drop_through, TileSweepResult& result) const;
+        void snapToSlope(engine::utils::Rect& box, float bottom_before, float tolerance, bool rising, TileSweepResult& result) const;
+    };
+}  // namespace engine::physics
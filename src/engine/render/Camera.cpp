@@ -10,7 +10,7 @@ namespace engine::render
     Camera::Camera(const glm::vec2& viewport_size, const glm::vec2& position, const std::optional<engine::utils::Rect> limit_bounds)
         : viewport_size_(viewport_size), position_(position), limit_bounds_(limit_bounds)
     {
-        spdlog::trace("Camera initialized successfully, position: {},{}", position_.x, position_.y);
+        SPDLOG_TRACE("Camera initialized successfully, position: {},{}", position_.x, position_.y);
     }
 
     void Camera::setPosition(const glm::vec2& position)
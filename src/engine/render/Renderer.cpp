@@ -1,10 +1,16 @@
 #include "Renderer.h"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
 #include <spdlog/spdlog.h>
 #include <stdexcept>  // For std::runtime_error
 
+#include "../core/LatencyTracer.h"
+#include "../core/Log.h"
+#include "../core/Profiler.h"
 #include "../resource/ResourceManager.h"
+#include "../utils/Math.h"
 #include "Camera.h"
 #include "Sprite.h"
 
@@ -14,7 +20,7 @@ namespace engine::render
     // Constructor: perform initialization, add ResourceManager
     Renderer::Renderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager) : renderer_(sdl_renderer), resourceManager_(resource_manager)
     {
-        spdlog::trace("Constructing Renderer...");
+        SPDLOG_TRACE("Constructing Renderer...");
 
         if (!renderer_)
         {
@@ -25,23 +31,91 @@ namespace engine::render
             throw std::runtime_error("Renderer construction failed: Provided ResourceManager pointer is null.");
         }
         setDrawColor(0, 0, 0, 255);
-        spdlog::trace("Renderer constructed successfully.");
+        SPDLOG_TRACE("Renderer constructed successfully.");
+    }
+
+    Renderer::~Renderer()
+    {
+        if (lowResTarget_)
+        {
+            SDL_SetRenderTarget(renderer_, nullptr);
+            SDL_DestroyTexture(lowResTarget_);
+        }
+    }
+
+    bool Renderer::setLowResolutionTarget(const glm::ivec2& size)
+    {
+        SDL_Texture* target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+        if (!target)
+        {
+            spdlog::warn("Unable to create a {}x{} render target: {}", size.x, size.y, SDL_GetError());
+            return false;
+        }
+
+        // Copied as is: no filtering between the art's pixels, no blending with the cleared output
+        SDL_SetTextureScaleMode(target, SDL_SCALEMODE_NEAREST);
+        SDL_SetTextureBlendMode(target, SDL_BLENDMODE_NONE);
+        if (!SDL_SetRenderTarget(renderer_, target))
+        {
+            spdlog::warn("Unable to render to a {}x{} target: {}", size.x, size.y, SDL_GetError());
+            SDL_DestroyTexture(target);
+            return false;
+        }
+
+        if (lowResTarget_) SDL_DestroyTexture(lowResTarget_);
+        lowResTarget_ = target;
+        lowResSize_ = glm::vec2(size);
+        spdlog::info("Rendering at {}x{}, integer-scaled to the output.", size.x, size.y);
+        return true;
     }
 
     void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, double angle)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        renderSprite(camera, sprite, position, scale, angle, true);
+    }
+
+    void Renderer::drawSprites(const Camera& camera, std::span<const SpriteInstance> instances)
+    {
+        ENGINE_PROFILE_FUNCTION();
+        cullBatch_.clear();
+        cullBatch_.reserve(instances.size());
+        for (const SpriteInstance& instance : instances)
+        {
+            // Sprites without a source rect use the whole texture; a missing texture gets an empty rect and is reported, rate-limited, when drawn
+            const auto& src_rect = instance.sprite->getSourceRect();
+            glm::vec2 size(0.0f);
+            if (src_rect)
+            {
+                size = {src_rect->w, src_rect->h};
+            }
+            else if (SDL_Texture* texture = resourceManager_->getTexture(instance.sprite->getTextureId()))
+            {
+                SDL_GetTextureSize(texture, &size.x, &size.y);
+            }
+            cullBatch_.push({instance.position, size});
+        }
+
+        cullRects(camera, cullBatch_, visible_);
+        for (const Uint32 index : visible_)
+        {
+            renderSprite(camera, *instances[index].sprite, instances[index].position, {1.0f, 1.0f}, 0.0, false);
+        }
+    }
+
+    void Renderer::renderSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, double angle, bool check_viewport)
     {
         auto texture = resourceManager_->getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Unable to get texture for ID {}.", sprite.getTextureId());
+            ENGINE_LOG_ERROR_LIMITED("Unable to get texture for ID {}.", sprite.getTextureId());
             return;
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, texture);
         if (!src_rect.has_value())
         {
-            spdlog::error("Unable to get source rectangle for sprite, ID: {}", sprite.getTextureId());
-            return;
+            return;  // getSpriteSrcRect() already reported the reason
         }
 
         // Apply camera transformation
@@ -52,7 +126,7 @@ namespace engine::render
         float scaled_h = src_rect.value().h * scale.y;
         SDL_FRect dest_rect = {position_screen.x, position_screen.y, scaled_w, scaled_h};
 
-        if (!isRectInViewport(camera, dest_rect))
+        if (check_viewport && !isRectInViewport(camera, dest_rect))
         {
             // Viewport culling: skip drawing if the sprite is outside the viewport
             // spdlog::info("精灵超出视口范围，ID: {}", sprite.getTextureId());
@@ -62,25 +136,25 @@ namespace engine::render
         // Perform drawing (default rotation center is the center of the sprite)
         if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
         {
-            spdlog::error("Render rotated texture failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+            ENGINE_LOG_ERROR_LIMITED("Render rotated texture failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
         }
     }
 
     void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scroll_factor, const glm::bvec2& repeat,
                                 const glm::vec2& scale)
     {
+        ENGINE_PROFILE_FUNCTION();
         auto texture = resourceManager_->getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Unable to get texture for ID {}.", sprite.getTextureId());
+            ENGINE_LOG_ERROR_LIMITED("Unable to get texture for ID {}.", sprite.getTextureId());
             return;
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, texture);
         if (!src_rect.has_value())
         {
-            spdlog::error("Unable to get source rectangle for sprite, ID: {}", sprite.getTextureId());
-            return;
+            return;  // getSpriteSrcRect() already reported the reason
         }
 
         // Apply camera transformation with parallax effect
@@ -122,7 +196,7 @@ namespace engine::render
                 SDL_FRect dest_rect = {x, y, scaled_tex_w, scaled_tex_h};
                 if (!SDL_RenderTexture(renderer_, texture, nullptr, &dest_rect))
                 {
-                    spdlog::error("Render parallax texture failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+                    ENGINE_LOG_ERROR_LIMITED("Render parallax texture failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
                     return;
                 }
             }
@@ -131,18 +205,18 @@ namespace engine::render
 
     void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size)
     {
+        ENGINE_PROFILE_FUNCTION();
         auto texture = resourceManager_->getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Unable to get texture for ID {}.", sprite.getTextureId());
+            ENGINE_LOG_ERROR_LIMITED("Unable to get texture for ID {}.", sprite.getTextureId());
             return;
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, texture);
         if (!src_rect.has_value())
         {
-            spdlog::error("Unable to get source rectangle for sprite, ID: {}", sprite.getTextureId());
-            return;
+            return;  // getSpriteSrcRect() already reported the reason
         }
 
         SDL_FRect dest_rect = {position.x, position.y, 0, 0};  // First determine the top-left corner of the destination rectangle
@@ -160,7 +234,7 @@ namespace engine::render
         // Perform drawing (no UI rotation considered here)
         if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
         {
-            spdlog::error("Render UI Sprite failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+            ENGINE_LOG_ERROR_LIMITED("Render UI Sprite failed (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
         }
     }
 
@@ -184,27 +258,60 @@ namespace engine::render
     {
         if (!SDL_RenderClear(renderer_))
         {
-            spdlog::error("Clear renderer failed: {}", SDL_GetError());
+            ENGINE_LOG_ERROR_LIMITED("Clear renderer failed: {}", SDL_GetError());
         }
     }
 
-    void Renderer::present() { SDL_RenderPresent(renderer_); }
+    void Renderer::present()
+    {
+        ENGINE_PROFILE_FUNCTION();
+        if (lowResTarget_) blitLowResolutionTarget();
+        if (latencyTracer_) latencyTracer_->markRenderEnd(SDL_GetTicksNS());
+        SDL_RenderPresent(renderer_);
+        if (latencyTracer_) latencyTracer_->markPresented(SDL_GetTicksNS());
+        // The next frame is drawn into the target again
+        if (lowResTarget_) SDL_SetRenderTarget(renderer_, lowResTarget_);
+        frameArena_.reset();
+    }
 
-    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite)
+    void Renderer::blitLowResolutionTarget()
     {
-        SDL_Texture* texture = resourceManager_->getTexture(sprite.getTextureId());
-        if (!texture)
+        SDL_SetRenderTarget(renderer_, nullptr);
+        int output_w = 0;
+        int output_h = 0;
+        if (!SDL_GetCurrentRenderOutputSize(renderer_, &output_w, &output_h) || output_w <= 0 || output_h <= 0)
         {
-            spdlog::error("Unable to get texture for ID {}.", sprite.getTextureId());
-            return std::nullopt;
+            ENGINE_LOG_ERROR_LIMITED("Unable to get the render output size: {}", SDL_GetError());
+            return;
         }
 
+        // Whole multiples keep every art pixel the same size on screen; an output smaller than the target shrinks it to fit
+        const float fit = std::min(static_cast<float>(output_w) / lowResSize_.x, static_cast<float>(output_h) / lowResSize_.y);
+        const float scale = fit >= 1.0f ? std::floor(fit) : fit;
+        const SDL_FRect dest_rect = {std::floor((static_cast<float>(output_w) - lowResSize_.x * scale) * 0.5f), std::floor((static_cast<float>(output_h) - lowResSize_.y * scale) * 0.5f),
+                                     lowResSize_.x * scale, lowResSize_.y * scale};
+
+        // Bars around the image are black whatever colour the game draws with
+        SDL_Color draw_color = {0, 0, 0, 255};
+        SDL_GetRenderDrawColor(renderer_, &draw_color.r, &draw_color.g, &draw_color.b, &draw_color.a);
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+        SDL_RenderClear(renderer_);
+        SDL_SetRenderDrawColor(renderer_, draw_color.r, draw_color.g, draw_color.b, draw_color.a);
+
+        if (!SDL_RenderTexture(renderer_, lowResTarget_, nullptr, &dest_rect))
+        {
+            ENGINE_LOG_ERROR_LIMITED("Unable to blit the low resolution target: {}", SDL_GetError());
+        }
+    }
+
+    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite, SDL_Texture* texture)
+    {
         auto src_rect = sprite.getSourceRect();
         if (src_rect.has_value())
         {  // If sprite has a specified source rectangle, check if the dimensions are valid
             if (src_rect.value().w <= 0 || src_rect.value().h <= 0)
             {
-                spdlog::error("Source rectangle size is invalid, ID: {}", sprite.getTextureId());
+                ENGINE_LOG_ERROR_LIMITED("Source rectangle size is invalid, ID: {}", sprite.getTextureId());
                 return std::nullopt;
             }
             return src_rect;
@@ -214,13 +321,19 @@ namespace engine::render
             SDL_FRect result = {0, 0, 0, 0};
             if (!SDL_GetTextureSize(texture, &result.w, &result.h))
             {
-                spdlog::error("Unable to get texture size, ID: {}", sprite.getTextureId());
+                ENGINE_LOG_ERROR_LIMITED("Unable to get texture size, ID: {}", sprite.getTextureId());
                 return std::nullopt;
             }
             return result;
         }
     }
 
+    void Renderer::cullRects(const Camera& camera, const engine::utils::RectBatch& world_rects, std::vector<Uint32>& visible) const
+    {
+        ENGINE_PROFILE_FUNCTION();
+        engine::utils::collectOverlaps(world_rects, engine::utils::Rect{camera.getPosition(), camera.getViewportSize()}, visible);
+    }
+
     bool Renderer::isRectInViewport(const Camera& camera, const SDL_FRect& rect)
     {
         glm::vec2 viewport_size = camera.getViewportSize();
@@ -3,21 +3,40 @@
 #include <SDL3/SDL_stdinc.h>
 #include <glm/glm.hpp>
 #include <optional>
+#include <span>
+#include <vector>
 
+#include "../memory/FrameArena.h"
+#include "../utils/Math.h"
 #include "Sprite.h"
 
 struct SDL_Renderer;
 struct SDL_FRect;
+struct SDL_Texture;
 
 namespace engine::resource
 {
     class ResourceManager;
 }
 
+namespace engine::core
+{
+    class LatencyTracer;
+}
+
 namespace engine::render
 {
     class Camera;
 
+    /**
+     * @brief A sprite to draw at a world position, for Renderer::drawSprites()
+     */
+    struct SpriteInstance
+    {
+        const Sprite* sprite = nullptr;
+        glm::vec2 position{0.0f, 0.0f};  ///< @brief Top left, world coordinates
+    };
+
     /**
      * @brief encapsulate the rendering behavior of SDL3
      * encapsulate SDL_Renderer and provide methods to clear the screen, draw sprites, and present the final image.
@@ -29,6 +48,12 @@ namespace engine::render
       private:
         SDL_Renderer* renderer_ = nullptr;                              ///< @brief Non owning pointer to SDL_Renderer
         engine::resource::ResourceManager* resourceManager_ = nullptr;  ///< @brief Non owning pointer to ResourceManager
+        engine::memory::FrameArena frameArena_;                         ///< @brief Scratch memory for the frame being built, reset by present()
+        engine::core::LatencyTracer* latencyTracer_ = nullptr;          ///< @brief Non owning pointer, told when present() starts and ends
+        SDL_Texture* lowResTarget_ = nullptr;                           ///< @brief Owned render target the frame is drawn into, nullptr to draw to the output
+        glm::vec2 lowResSize_{0.0f, 0.0f};                              ///< @brief Size of lowResTarget_ in pixels
+        engine::utils::RectBatch cullBatch_;                            ///< @brief World rects of the sprites passed to drawSprites(), kept for its capacity
+        std::vector<Uint32> visible_;                                   ///< @brief Indices drawSprites() kept after culling
       public:
         /**
          * @brief Construct a new Renderer object
@@ -37,6 +62,19 @@ namespace engine::render
          * @throws std::runtime_error if either pointer is nullptr。
          */
         Renderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager);
+        ~Renderer();
+
+        /**
+         * @brief Draw every frame into a texture of the given size instead of the output, and let present() show it
+         * with a single nearest-neighbour blit, scaled by the largest integer factor that fits the output and centred.
+         * Sprites are then rasterised at the art's resolution whatever the window size. Replaces the renderer's logical
+         * presentation, which must be disabled.
+         *
+         * @param size target size in pixels, e.g. 640x360
+         * @return false if the renderer cannot render to textures; drawing keeps going to the output
+         */
+        bool setLowResolutionTarget(const glm::ivec2& size);
+        bool hasLowResolutionTarget() const { return lowResTarget_ != nullptr; }
 
         /**
          * @brief Draw a sprite on the screen with position, scale and rotation angle
@@ -49,6 +87,12 @@ namespace engine::render
          */
         void drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale = {1.0f, 1.0f}, double angle = 0.0f);
 
+        /**
+         * @brief Draw many unscaled, unrotated sprites in order, culled against the camera view in one cullRects() batch
+         * instead of one viewport test per sprite. For entity and tile layers with hundreds of sprites.
+         */
+        void drawSprites(const Camera& camera, std::span<const SpriteInstance> instances);
+
         /**
          * @brief Draw a parallax scrolling background
          *
@@ -70,13 +114,29 @@ namespace engine::render
          */
         void drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size = std::nullopt);
 
-        void present();      ///< @brief Update screen, wrap SDL_RenderPresent function
+        /**
+         * @brief Viewport culling for many world-space rectangles at once, through the SIMD batch kernels
+         * @param visible cleared, then filled with the indices of the rects overlapping the camera view, ascending
+         */
+        void cullRects(const Camera& camera, const engine::utils::RectBatch& world_rects, std::vector<Uint32>& visible) const;
+
+        void present();      ///< @brief Update screen (blitting the low resolution target first, if any), wrap SDL_RenderPresent function, then reset the frame arena
         void clearScreen();  ///< @brief Clear screen, wrap SDL_RenderClear function
 
         void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);              ///< @brief Set draw color, wrap SDL_SetRenderDrawColor function, use Uint8 type
         void setDrawColorFloat(float r, float g, float b, float a = 1.0f);        ///< @brief Set draw color, wrap SDL_SetRenderDrawColorFloat function, use float type
         [[nodiscard]] SDL_Renderer* getSDLRenderer() const { return renderer_; }  ///< @brief Get the underlying SDL_Renderer pointer
 
+        /**
+         * @brief Per-frame scratch allocator; everything allocated from it is released by the next present()
+         */
+        engine::memory::FrameArena& getFrameArena() { return frameArena_; }
+
+        /**
+         * @brief Report present() to an input latency tracer; nullptr to stop
+         */
+        void setLatencyTracer(engine::core::LatencyTracer* tracer) { latencyTracer_ = tracer; }
+
         // Disable copy and move semantics
         Renderer(const Renderer&) = delete;
         Renderer& operator=(const Renderer&) = delete;
@@ -85,8 +145,15 @@ namespace engine::render
 
       private:
         std::optional<SDL_FRect> getSpriteSrcRect(
-            const Sprite& sprite);  ///< @brief get the source rectangle of a sprite, used for actual drawing. If error occurs, return std::nullopt and skip drawing.
+            const Sprite& sprite,
+            SDL_Texture* texture);                                           ///< @brief get the source rectangle of a sprite whose texture was already fetched. If error occurs, return std::nullopt and skip drawing.
         bool isRectInViewport(const Camera& camera, const SDL_FRect& rect);  ///< @brief check if a rectangle is in the viewport, used for viewport clipping
+        void blitLowResolutionTarget();                                      ///< @brief Draw lowResTarget_ onto the output, black around it
+
+        /**
+         * @brief Body of drawSprite(); drawSprites() has culled already and skips the viewport test
+         */
+        void renderSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, double angle, bool check_viewport);
     };
 }  // namespace engine::render
 // engine
@@ -0,0 +1,153 @@
+#include "AssetWatcher.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine::resource
+{
+#ifdef __linux__
+
+    AssetWatcher::AssetWatcher(const std::string& root) : root_(root), eventBuffer_(64 * 1024)
+    {
+        fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ < 0)
+        {
+            spdlog::error("AssetWatcher: inotify_init1 failed: {}", std::strerror(errno));
+            return;
+        }
+
+        addWatchRecursive(root_);
+        spdlog::info("AssetWatcher watching '{}' ({} directories).", root_, watchedDirs_.size());
+    }
+
+    AssetWatcher::~AssetWatcher()
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);  // Closing the descriptor releases every watch
+        }
+    }
+
+    bool AssetWatcher::poll(std::vector<std::string>& changed_files)
+    {
+        if (fd_ < 0)
+        {
+            return false;
+        }
+
+        const std::size_t first_new = changed_files.size();
+        for (;;)
+        {
+            const ssize_t length = read(fd_, eventBuffer_.data(), eventBuffer_.size());
+            if (length <= 0)
+            {
+                if (length < 0 && errno != EAGAIN)
+                {
+                    spdlog::error("AssetWatcher: read failed: {}", std::strerror(errno));
+                }
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(eventBuffer_.data() + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                auto dir = watchedDirs_.find(event->wd);
+                if (dir == watchedDirs_.end())
+                {
+                    continue;
+                }
+                if (event->mask & IN_IGNORED)  // The directory was removed or unmounted
+                {
+                    watchedDirs_.erase(dir);
+                    continue;
+                }
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                std::string path = dir->second + "/" + event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        addWatchRecursive(path);
+                    }
+                    continue;
+                }
+                // IN_CREATE is only watched for new directories: a created file is still empty, it is reported once closed
+                if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+                {
+                    continue;
+                }
+
+                // Editors save several times in a row: report each file once per poll
+                if (std::find(changed_files.begin() + first_new, changed_files.end(), path) == changed_files.end())
+                {
+                    changed_files.push_back(std::move(path));
+                }
+            }
+        }
+
+        return changed_files.size() > first_new;
+    }
+
+    void AssetWatcher::addWatch(const std::string& directory)
+    {
+        // IN_CLOSE_WRITE: a file finished being written; IN_MOVED_TO: an editor saved through a temporary file and a rename;
+        // IN_CREATE: a new subdirectory to watch, file creations are skipped by poll()
+        const int wd = inotify_add_watch(fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0)
+        {
+            spdlog::warn("AssetWatcher: cannot watch '{}': {}", directory, std::strerror(errno));
+            return;
+        }
+        watchedDirs_[wd] = directory;
+    }
+
+    void AssetWatcher::addWatchRecursive(const std::string& directory)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec))
+        {
+            spdlog::warn("AssetWatcher: '{}' is not a directory.", directory);
+            return;
+        }
+
+        addWatch(directory);
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_directory(ec))
+            {
+                addWatch(it->path().generic_string());
+            }
+        }
+    }
+
+#else
+
+    AssetWatcher::AssetWatcher(const std::string& root) : root_(root)
+    {
+        spdlog::warn("AssetWatcher: file watching is only supported on Linux, hot-reload is disabled.");
+    }
+
+    AssetWatcher::~AssetWatcher() = default;
+
+    bool AssetWatcher::poll(std::vector<std::string>& /* changed_files */) { return false; }
+
+    void AssetWatcher::addWatch(const std::string& /* directory */) {}
+
+    void AssetWatcher::addWatchRecursive(const std::string& /* directory */) {}
+
+#endif
+}  // namespace engine::resource
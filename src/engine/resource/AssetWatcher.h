@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::resource
+{
+    /**
+     * @brief Watches an asset directory tree for modified files, used for hot-reloading.
+     *
+     * On Linux this wraps a non-blocking inotify descriptor with one watch per directory (new sub-directories are picked up
+     * automatically). On other platforms the watcher constructs fine but isSupported() returns false and poll() never reports anything.
+     * poll() never blocks, so it can be called once per frame.
+     */
+    class AssetWatcher final
+    {
+      private:
+        std::string root_;                                  ///< @brief Watched root, prefix of every reported path
+        int fd_ = -1;                                       ///< @brief inotify descriptor, -1 when unsupported or failed
+        std::unordered_map<int, std::string> watchedDirs_;  ///< @brief Watch descriptor -> directory path
+        std::vector<char> eventBuffer_;                     ///< @brief Reused read buffer for inotify events
+
+      public:
+        /**
+         * @brief Start watching a directory tree
+         * @param root directory to watch recursively, e.g. "assets". Reported paths start with it.
+         */
+        explicit AssetWatcher(const std::string& root);
+        ~AssetWatcher();
+
+        // Delete copy and move constructors and assignment operators
+        AssetWatcher(const AssetWatcher&) = delete;
+        AssetWatcher& operator=(const AssetWatcher&) = delete;
+        AssetWatcher(AssetWatcher&&) = delete;
+        AssetWatcher& operator=(AssetWatcher&&) = delete;
+
+        /**
+         * @brief Collect the files that finished being written since the last call. Never blocks.
+         *
+         * @param changed_files receives each modified file path once, in the form "<root>/<relative path>"
+         * @return true if at least one file was reported
+         */
+        bool poll(std::vector<std::string>& changed_files);
+
+        [[nodiscard]] bool isSupported() const { return fd_ >= 0; }         ///< @brief Whether the platform watcher is active
+        [[nodiscard]] const std::string& getRoot() const { return root_; }  ///< @brief Get the watched root directory
+
+      private:
+        void addWatch(const std::string& directory);           ///< @brief Watch one directory (not recursive)
+        void addWatchRecursive(const std::string& directory);  ///< @brief Watch a directory and all of its sub-directories
+    };
+}  // namespace engine::resource
@@ -1,9 +1,14 @@
 #include "AudioManager.h"
 
+#include <SDL3/SDL_timer.h>
 #include <SDL3_mixer/SDL_mixer.h>
+#include <filesystem>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+
 namespace engine::resource
 {
     AudioManager::AudioManager()
@@ -24,7 +29,7 @@ namespace engine::resource
             throw std::runtime_error("AudioManager could not initialize! Mix_OpenAudio Error: " + std::string(SDL_GetError()));
         }
 
-        spdlog::trace("AudioManager constructed and SDL_mixer initialized successfully.");
+        SPDLOG_TRACE("AudioManager constructed and SDL_mixer initialized successfully.");
     };
 
     AudioManager::~AudioManager()
@@ -39,7 +44,7 @@ namespace engine::resource
 
         Mix_Quit();  // Quit SDL_mixer subsystem
 
-        spdlog::trace("AudioManager destructed and SDL_mixer quit successfully.");
+        SPDLOG_TRACE("AudioManager destructed and SDL_mixer quit successfully.");
     };
 
     Mix_Chunk* AudioManager::loadSound(const std::string& file_path)
@@ -48,24 +53,32 @@ namespace engine::resource
         auto it = sounds_.find(file_path);
         if (it != sounds_.end())
         {
-            spdlog::debug("Sound '{}' already loaded, returning cached sound.", file_path);
+            soundStats_.recordHit();
             return it->second.get();
         }
 
         // Load the sound using SDL_mixer
-        spdlog::debug("Loading chunk from file: {}", file_path);
-
+        ENGINE_PROFILE_SCOPE("AudioManager::loadSound");
+        ENGINE_ALLOC_SCOPE(Resource);
+        soundStats_.recordMiss();
+        const Uint64 start = SDL_GetTicksNS();
         Mix_Chunk* rawSound = Mix_LoadWAV(file_path.c_str());
 
         if (!rawSound)
         {
+            soundStats_.recordFailedLoad(SDL_GetTicksNS() - start);
             spdlog::error("Failed to load sound '{}': {}", file_path, SDL_GetError());
             return nullptr;
         }
 
         // Store the sound in the map with automatic memory management
-        sounds_.emplace(file_path, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>(rawSound));
-        spdlog::debug("Sound '{}' loaded and cached successfully.", file_path);
+        {
+            std::lock_guard lock(mutex_);
+            sounds_.emplace(file_path, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>(rawSound));
+            soundSlots_.bind(file_path, rawSound);
+        }
+        soundStats_.recordLoad(SDL_GetTicksNS() - start, rawSound->alen);
+        SPDLOG_TRACE("Sound '{}' loaded and cached successfully.", file_path);
 
         return rawSound;
     }
@@ -75,20 +88,28 @@ namespace engine::resource
         auto it = sounds_.find(file_path);
         if (it != sounds_.end())
         {
+            soundStats_.recordHit();
             return it->second.get();
         }
 
-        spdlog::warn("Sound '{}' not found in cache, attempting to load.", file_path);
+        // Cache miss: counted by loadSound()
         return loadSound(file_path);
     }
 
+    SoundHandle AudioManager::getSoundHandle(const std::string& file_path)
+    {
+        return getSound(file_path) ? soundSlots_.find(file_path) : SoundHandle{};
+    }
+
     void AudioManager::unloadSound(const std::string& file_path)
     {
         auto it = sounds_.find(file_path);
         if (it != sounds_.end())
         {
-            spdlog::debug("Unloading sound '{}' from memory.", file_path);
+            SPDLOG_DEBUG("Unloading sound '{}' from memory.", file_path);
+            std::lock_guard lock(mutex_);
             sounds_.erase(it);
+            soundSlots_.bind(file_path, nullptr);
         }
         else
         {
@@ -100,8 +121,10 @@ namespace engine::resource
     {
         if (!sounds_.empty())
         {
-            spdlog::debug("Clearing all {} loaded sounds from memory.", sounds_.size());
+            SPDLOG_DEBUG("Clearing all {} loaded sounds from memory.", sounds_.size());
+            std::lock_guard lock(mutex_);
             sounds_.clear();
+            soundSlots_.unbindAll();
         }
     }
 
@@ -111,24 +134,35 @@ namespace engine::resource
         auto it = musics_.find(file_path);
         if (it != musics_.end())
         {
-            spdlog::debug("Music '{}' already loaded, returning cached music.", file_path);
+            musicStats_.recordHit();
             return it->second.get();
         }
 
         // Load the music using SDL_mixer
-        spdlog::debug("Loading music from file: {}", file_path);
-
+        ENGINE_PROFILE_SCOPE("AudioManager::loadMusic");
+        ENGINE_ALLOC_SCOPE(Resource);
+        musicStats_.recordMiss();
+        const Uint64 start = SDL_GetTicksNS();
         Mix_Music* rawMusic = Mix_LoadMUS(file_path.c_str());
 
         if (!rawMusic)
         {
+            musicStats_.recordFailedLoad(SDL_GetTicksNS() - start);
             spdlog::error("Failed to load music '{}': {}", file_path, SDL_GetError());
             return nullptr;
         }
 
         // Store the music in the map with automatic memory management
-        musics_.emplace(file_path, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>(rawMusic));
-        spdlog::debug("Music '{}' loaded and cached successfully.", file_path);
+        {
+            std::lock_guard lock(mutex_);
+            musics_.emplace(file_path, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>(rawMusic));
+            musicSlots_.bind(file_path, rawMusic);
+        }
+        // Mix_Music is opaque and streams from disk; the file size is the best available estimate
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(file_path, ec);
+        musicStats_.recordLoad(SDL_GetTicksNS() - start, ec ? 0 : static_cast<std::size_t>(file_size));
+        SPDLOG_TRACE("Music '{}' loaded and cached successfully.", file_path);
 
         return rawMusic;
     }
@@ -138,20 +172,28 @@ namespace engine::resource
         auto it = musics_.find(file_path);
         if (it != musics_.end())
         {
+            musicStats_.recordHit();
             return it->second.get();
         }
 
-        spdlog::warn("Music '{}' not found in cache, attempting to load.", file_path);
+        // Cache miss: counted by loadMusic()
         return loadMusic(file_path);
     }
 
+    MusicHandle AudioManager::getMusicHandle(const std::string& file_path)
+    {
+        return getMusic(file_path) ? musicSlots_.find(file_path) : MusicHandle{};
+    }
+
     void AudioManager::unloadMusic(const std::string& file_path)
     {
         auto it = musics_.find(file_path);
         if (it != musics_.end())
         {
-            spdlog::debug("Unloading music '{}' from memory.", file_path);
+            SPDLOG_DEBUG("Unloading music '{}' from memory.", file_path);
+            std::lock_guard lock(mutex_);
             musics_.erase(it);
+            musicSlots_.bind(file_path, nullptr);
         }
         else
         {
@@ -163,8 +205,10 @@ namespace engine::resource
     {
         if (!musics_.empty())
         {
-            spdlog::debug("Clearing all {} loaded musics from memory.", musics_.size());
+            SPDLOG_DEBUG("Clearing all {} loaded musics from memory.", musics_.size());
+            std::lock_guard lock(mutex_);
             musics_.clear();
+            musicSlots_.unbindAll();
         }
     }
 
@@ -174,4 +218,61 @@ namespace engine::resource
         clearMusics();
     }
 
+    bool AudioManager::reloadSound(const std::string& file_path)
+    {
+        auto it = sounds_.find(file_path);
+        if (it == sounds_.end())
+        {
+            return false;
+        }
+
+        std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter> fresh(Mix_LoadWAV(file_path.c_str()));
+        if (!fresh)
+        {
+            spdlog::error("Failed to reload sound '{}', keeping the old one: {}", file_path, SDL_GetError());
+            return false;
+        }
+
+        // The mixer reads the sample buffer while a channel plays it, stop those channels before swapping.
+        // Under the lock, so the audio thread cannot start the sound again in between.
+        std::lock_guard lock(mutex_);
+        Mix_Chunk* chunk = it->second.get();
+        const int channels = Mix_AllocateChannels(-1);
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            if (Mix_Playing(channel) && Mix_GetChunk(channel) == chunk)
+            {
+                Mix_HaltChannel(channel);
+            }
+        }
+
+        // Swap the contents so the cached Mix_Chunk* stays valid; `fresh` now owns and frees the old samples
+        std::swap(*chunk, *fresh);
+        spdlog::info("Sound '{}' reloaded in place.", file_path);
+        return true;
+    }
+
+    bool AudioManager::reloadMusic(const std::string& file_path)
+    {
+        auto it = musics_.find(file_path);
+        if (it == musics_.end())
+        {
+            return false;
+        }
+
+        Mix_Music* rawMusic = Mix_LoadMUS(file_path.c_str());
+        if (!rawMusic)
+        {
+            spdlog::error("Failed to reload music '{}', keeping the old one: {}", file_path, SDL_GetError());
+            return false;
+        }
+
+        // Mix_Music is opaque and cannot be patched; freeing the old one also stops it if it is playing
+        std::lock_guard lock(mutex_);
+        it->second.reset(rawMusic);
+        musicSlots_.bind(file_path, rawMusic);
+        spdlog::info("Music '{}' was replaced behind its handle.", file_path);
+        return true;
+    }
+
 }  // namespace engine::resource
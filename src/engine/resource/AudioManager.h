@@ -2,9 +2,13 @@
 
 #include <SDL3_mixer/SDL_mixer.h>
 #include <memory>
+#include <mutex>
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 
+#include "ResourceHandle.h"
+#include "ResourceStats.h"
+
 namespace engine::resource
 {
     class AudioManager
@@ -19,7 +23,7 @@ namespace engine::resource
                 if (chunk)
                 {
                     Mix_FreeChunk(chunk);
-                    spdlog::trace("Mix_Chunk has been freed.");
+                    SPDLOG_TRACE("Mix_Chunk has been freed.");
                 }
             }
         };
@@ -30,7 +34,7 @@ namespace engine::resource
                 if (music)
                 {
                     Mix_FreeMusic(music);
-                    spdlog::trace("Mix_Music has been freed.");
+                    SPDLOG_TRACE("Mix_Music has been freed.");
                 }
             }
         };
@@ -39,6 +43,14 @@ namespace engine::resource
         std::unordered_map<std::string, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>> sounds_;
         // the map storing Mix_Music with automatic memory management
         std::unordered_map<std::string, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>> musics_;
+        ResourceSlots<Mix_Chunk> soundSlots_;  ///< @brief Sound behind each SoundHandle
+        ResourceSlots<Mix_Music> musicSlots_;  ///< @brief Music behind each MusicHandle
+
+        // The audio thread resolves handles and starts playback under this lock; main thread changes to the slots and frees take it too
+        mutable std::mutex mutex_;
+
+        ResourceCacheStats soundStats_;  ///< @brief Cache counters of sounds
+        ResourceCacheStats musicStats_;  ///< @brief Cache counters of musics
 
       public:
         AudioManager();
@@ -51,14 +63,25 @@ namespace engine::resource
         AudioManager& operator=(AudioManager&&) = delete;
 
       private:
-        Mix_Chunk* loadSound(const std::string& file_path);  ///< @brief Load sound from file
-        Mix_Chunk* getSound(const std::string& file_path);   ///< @brief try to get the pointer of loaded sound from cache, if not found, try to load it
-        Mix_Music* loadMusic(const std::string& file_path);  ///< @brief Load music from file
-        Mix_Music* getMusic(const std::string& file_path);   ///< @brief try to get the pointer of loaded music from cache, if not found, try to load it
-        void unloadSound(const std::string& file_path);      ///< @brief Unload sound from memory
-        void unloadMusic(const std::string& file_path);      ///< @brief Unload music from memory
-        void clearSounds();                                  ///< @brief Clear all loaded sounds from memory
-        void clearMusics();                                  ///< @brief Clear all loaded musics from memory
-        void clearAudio();                                   ///< @brief Clear all loaded audio from memory
+        Mix_Chunk* loadSound(const std::string& file_path);                                ///< @brief Load sound from file
+        Mix_Chunk* getSound(const std::string& file_path);                                 ///< @brief try to get the pointer of loaded sound from cache, if not found, try to load it
+        Mix_Music* loadMusic(const std::string& file_path);                                ///< @brief Load music from file
+        Mix_Music* getMusic(const std::string& file_path);                                 ///< @brief try to get the pointer of loaded music from cache, if not found, try to load it
+        SoundHandle getSoundHandle(const std::string& file_path);                          ///< @brief Like getSound(), but returns a handle that survives reloads, invalid on failure
+        MusicHandle getMusicHandle(const std::string& file_path);                          ///< @brief Like getMusic(), but returns a handle that survives reloads, invalid on failure
+        Mix_Chunk* getSound(SoundHandle handle) const { return soundSlots_.get(handle); }  ///< @brief Resolve a handle, nullptr while its sound is unloaded
+        Mix_Music* getMusic(MusicHandle handle) const { return musicSlots_.get(handle); }  ///< @brief Resolve a handle, nullptr while its music is unloaded
+        void unloadSound(const std::string& file_path);                                    ///< @brief Unload sound from memory
+        void unloadMusic(const std::string& file_path);                                    ///< @brief Unload music from memory
+        void clearSounds();                                                                ///< @brief Clear all loaded sounds from memory
+        void clearMusics();                                                                ///< @brief Clear all loaded musics from memory
+        void clearAudio();                                                                 ///< @brief Clear all loaded audio from memory
+        bool reloadSound(const std::string& file_path);                                    ///< @brief Reload a cached sound from disk in place, the Mix_Chunk* stays valid
+        bool reloadMusic(const std::string& file_path);                                    ///< @brief Reload a cached music from disk, the music is replaced behind its handle
+
+        std::unique_lock<std::mutex> lock() const { return std::unique_lock(mutex_); }  ///< @brief Keep resolved sounds and musics alive until released
+
+        const ResourceCacheStats& getSoundStats() const { return soundStats_; }  ///< @brief Get the sound cache counters
+        const ResourceCacheStats& getMusicStats() const { return musicStats_; }  ///< @brief Get the music cache counters
     };
 }  // namespace engine::resource
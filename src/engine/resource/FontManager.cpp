@@ -1,8 +1,13 @@
 #include "FontManager.h"
 
+#include <SDL3/SDL_timer.h>
+#include <filesystem>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+
 namespace engine::resource
 {
     FontManager::FontManager()
@@ -11,21 +16,21 @@ namespace engine::resource
         {
             throw std::runtime_error("FontManager could not initialize! TTF_Init Error: " + std::string(SDL_GetError()));
         }
-        spdlog::trace("SDL_ttf initialized successfully.");
-        spdlog::trace("FontManager constructed.");
+        SPDLOG_TRACE("SDL_ttf initialized successfully.");
+        SPDLOG_TRACE("FontManager constructed.");
     }
 
     FontManager::~FontManager()
     {
         if (!fonts_.empty())
         {
-            spdlog::trace("FontManager destructor called, unloading {} loaded fonts.", fonts_.size());
+            SPDLOG_TRACE("FontManager destructor called, unloading {} loaded fonts.", fonts_.size());
             clearFonts();
         }
 
         if (TTF_WasInit()) TTF_Quit();
 
-        spdlog::trace("FontManager destructed.");
+        SPDLOG_TRACE("FontManager destructed.");
     }
 
     TTF_Font* FontManager::loadFont(const std::string& file_path, int point_size)
@@ -42,24 +47,32 @@ namespace engine::resource
         auto it = fonts_.find(key);
         if (it != fonts_.end())
         {
-            spdlog::debug("Font '{}' ({}pt) already loaded, returning cached font.", file_path, point_size);
+            stats_.recordHit();
             return it->second.get();
         }
 
         // Load the font using SDL_ttf
-        spdlog::debug("Loading font from file: {} with size {}", file_path, point_size);
-
+        ENGINE_PROFILE_SCOPE("FontManager::loadFont");
+        ENGINE_ALLOC_SCOPE(Resource);
+        stats_.recordMiss();
+        const Uint64 start = SDL_GetTicksNS();
         TTF_Font* rawFont = TTF_OpenFont(file_path.c_str(), point_size);
 
         if (!rawFont)
         {
+            stats_.recordFailedLoad(SDL_GetTicksNS() - start);
             spdlog::error("Failed to load font '{}': {}", file_path, SDL_GetError());
             return nullptr;
         }
 
         // Store the font in the map with automatic memory management
         fonts_.emplace(key, std::unique_ptr<TTF_Font, SDLTTFFontDeleter>(rawFont));
-        spdlog::debug("Font '{}' ({}pt) loaded and cached successfully.", file_path, point_size);
+        slots_.bind(key, rawFont);
+        // TTF_Font is opaque; the font file size is the best available estimate
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(file_path, ec);
+        stats_.recordLoad(SDL_GetTicksNS() - start, ec ? 0 : static_cast<std::size_t>(file_size));
+        SPDLOG_TRACE("Font '{}' ({}pt) loaded and cached successfully.", file_path, point_size);
 
         return rawFont;
     }
@@ -71,13 +84,19 @@ namespace engine::resource
         auto it = fonts_.find(key);
         if (it != fonts_.end())
         {
+            stats_.recordHit();
             return it->second.get();
         }
 
-        spdlog::warn("Font '{}' ({}pt) not found in cache, attempting to load.", file_path, point_size);
+        // Cache miss: counted by loadFont()
         return loadFont(file_path, point_size);
     }
 
+    FontHandle FontManager::getFontHandle(const std::string& file_path, int point_size)
+    {
+        return getFont(file_path, point_size) ? slots_.find(std::make_pair(file_path, point_size)) : FontHandle{};
+    }
+
     void FontManager::unloadFont(const std::string& file_path, int point_size)
     {
         FontKey key = std::make_pair(file_path, point_size);
@@ -85,8 +104,9 @@ namespace engine::resource
         auto it = fonts_.find(key);
         if (it != fonts_.end())
         {
-            spdlog::debug("Unloading font '{}' ({}pt) from memory.", file_path, point_size);
+            SPDLOG_DEBUG("Unloading font '{}' ({}pt) from memory.", file_path, point_size);
             fonts_.erase(it);
+            slots_.bind(key, nullptr);
         }
         else
         {
@@ -98,8 +118,35 @@ namespace engine::resource
     {
         if (!fonts_.empty())
         {
-            spdlog::debug("Clearing all {} loaded fonts from memory.", fonts_.size());
+            SPDLOG_DEBUG("Clearing all {} loaded fonts from memory.", fonts_.size());
             fonts_.clear();
+            slots_.unbindAll();
+        }
+    }
+
+    bool FontManager::reloadFont(const std::string& file_path)
+    {
+        bool reloaded = false;
+        for (auto& [key, font] : fonts_)
+        {
+            if (key.first != file_path)
+            {
+                continue;
+            }
+
+            TTF_Font* rawFont = TTF_OpenFont(file_path.c_str(), key.second);
+            if (!rawFont)
+            {
+                spdlog::error("Failed to reload font '{}' ({}pt), keeping the old one: {}", file_path, key.second, SDL_GetError());
+                continue;
+            }
+
+            // TTF_Font is opaque and cannot be patched, the entry is replaced and its handles follow
+            font.reset(rawFont);
+            slots_.bind(key, rawFont);
+            reloaded = true;
+            spdlog::info("Font '{}' ({}pt) was replaced behind its handle.", file_path, key.second);
         }
+        return reloaded;
     }
-}  // namespace engine::resource
+}  // namespace engine::resource
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include <unordered_map>
 #include <utility>
 
+#include "ResourceHandle.h"
+#include "ResourceStats.h"
+
 namespace engine::resource
 {
     using FontKey = std::pair<std::string, int>;  // pair of file path and point size
@@ -35,6 +38,9 @@ namespace engine::resource
 
         // the map storing TTF_Font with automatic memory management
         std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLTTFFontDeleter>, FontKeyHash> fonts_;
+        ResourceSlots<TTF_Font, FontKey, FontKeyHash> slots_;  ///< @brief Font behind each FontHandle
+
+        ResourceCacheStats stats_;  ///< @brief Cache hit/miss/load counters
 
       public:
         FontManager();
@@ -47,9 +53,13 @@ namespace engine::resource
         FontManager& operator=(FontManager&&) = delete;
 
       private:
-        TTF_Font* loadFont(const std::string& file_path, int point_size);  ///< @brief Load font from file with specific point size
-        TTF_Font* getFont(const std::string& file_path, int point_size);   ///< @brief try to get the pointer of loaded font from cache, if not found, try to load it
-        void unloadFont(const std::string& file_path, int point_size);     ///< @brief Unload font from memory
-        void clearFonts();                                                 ///< @brief Clear all loaded fonts from memory
+        TTF_Font* loadFont(const std::string& file_path, int point_size);          ///< @brief Load font from file with specific point size
+        TTF_Font* getFont(const std::string& file_path, int point_size);           ///< @brief try to get the pointer of loaded font from cache, if not found, try to load it
+        FontHandle getFontHandle(const std::string& file_path, int point_size);    ///< @brief Like getFont(), but returns a handle that survives reloads, invalid on failure
+        TTF_Font* getFont(FontHandle handle) const { return slots_.get(handle); }  ///< @brief Resolve a handle, nullptr while its font is unloaded
+        void unloadFont(const std::string& file_path, int point_size);             ///< @brief Unload font from memory
+        void clearFonts();                                                         ///< @brief Clear all loaded fonts from memory
+        bool reloadFont(const std::string& file_path);                             ///< @brief Reopen every cached point size of a font file, the fonts are replaced behind their handles
+        const ResourceCacheStats& getStats() const { return stats_; }              ///< @brief Get the cache counters
     };
 }  // namespace engine::resource
\ No newline at end of file
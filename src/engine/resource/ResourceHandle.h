@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SDL_Texture;
+struct Mix_Chunk;
+struct Mix_Music;
+struct TTF_Font;
+
+namespace engine::resource
+{
+    constexpr Uint32 INVALID_RESOURCE_HANDLE = ~Uint32{0};
+
+    /**
+     * @brief Stable reference to a cached resource, resolved through the ResourceManager where it is used.
+     *
+     * Hot-reload sometimes has to replace the object behind a file: a texture whose size changed, a music or a font,
+     * which cannot be patched in place. Pointers fetched before the reload would dangle; a handle names the cache slot
+     * of the file instead, and the slot is pointed at the new object. It resolves to nullptr while the file is unloaded
+     * and to the object again once the file is loaded back. Plain data, so it can be copied into command queues.
+     */
+    template <typename T>
+    struct ResourceHandle
+    {
+        Uint32 id = INVALID_RESOURCE_HANDLE;
+
+        [[nodiscard]] bool isValid() const { return id != INVALID_RESOURCE_HANDLE; }
+        bool operator==(const ResourceHandle&) const = default;
+    };
+
+    using TextureHandle = ResourceHandle<SDL_Texture>;
+    using SoundHandle = ResourceHandle<Mix_Chunk>;
+    using MusicHandle = ResourceHandle<Mix_Music>;
+    using FontHandle = ResourceHandle<TTF_Font>;
+
+    /**
+     * @brief The object currently behind every handle of one kind of resource.
+     *
+     * A slot is allocated the first time a key is bound and is never reused for another key, so a handle stays bound
+     * to its file across unloads and reloads. The owning manager keeps the objects themselves.
+     */
+    template <typename T, typename Key = std::string, typename Hash = std::hash<Key>>
+    class ResourceSlots
+    {
+      private:
+        std::vector<T*> objects_;                                   ///< @brief Indexed by ResourceHandle::id
+        std::unordered_map<Key, ResourceHandle<T>, Hash> handles_;  ///< @brief Slot of every key bound so far
+
+      public:
+        /**
+         * @brief Point the slot of key at object, nullptr when the key is unloaded
+         */
+        ResourceHandle<T> bind(const Key& key, T* object)
+        {
+            auto [it, inserted] = handles_.try_emplace(key);
+            if (inserted)
+            {
+                it->second.id = static_cast<Uint32>(objects_.size());
+                objects_.push_back(object);
+            }
+            else
+            {
+                objects_[it->second.id] = object;
+            }
+            return it->second;
+        }
+
+        /**
+         * @return an invalid handle if key was never bound
+         */
+        ResourceHandle<T> find(const Key& key) const
+        {
+            auto it = handles_.find(key);
+            return it != handles_.end() ? it->second : ResourceHandle<T>{};
+        }
+
+        T* get(ResourceHandle<T> handle) const { return handle.id < objects_.size() ? objects_[handle.id] : nullptr; }
+
+        void unbindAll() { std::fill(objects_.begin(), objects_.end(), nullptr); }  ///< @brief Every handle resolves to nullptr, e.g. after clearing the cache
+    };
+}  // namespace engine::resource
@@ -1,10 +1,12 @@
 #include "ResourceManager.h"
 
+#include <SDL3/SDL_timer.h>
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <glm/glm.hpp>
 #include <spdlog/spdlog.h>
 
+#include "AssetWatcher.h"
 #include "AudioManager.h"
 #include "FontManager.h"
 #include "TextureManager.h"
@@ -22,7 +24,7 @@ namespace engine::resource
         audioManager_ = std::make_unique<AudioManager>();
         fontManager_ = std::make_unique<FontManager>();
 
-        spdlog::trace("ResourceManager 构造成功。");
+        SPDLOG_TRACE("ResourceManager 构造成功。");
         // RAII: 构造成功即代表资源管理器可以正常工作，无需再初始化，无需检查指针是否为空
     }
 
@@ -31,7 +33,7 @@ namespace engine::resource
         fontManager_->clearFonts();
         audioManager_->clearAudio();
         textureManager_->clearTextures();
-        spdlog::trace("ResourceManager 中的资源通过 clear() 清空。");
+        SPDLOG_TRACE("ResourceManager 中的资源通过 clear() 清空。");
     }
 
     // --- 纹理接口实现 ---
@@ -41,19 +43,87 @@ namespace engine::resource
         return textureManager_->loadTexture(file_path);
     }
 
+    SDL_Texture* ResourceManager::loadTexture(const std::string& file_path, SDL_Surface* surface, const std::string& level_name, Uint64 decode_time_ns)
+    {
+        return textureManager_->loadTexture(file_path, surface, level_name, decode_time_ns);
+    }
+
     SDL_Texture* ResourceManager::getTexture(const std::string& file_path) { return textureManager_->getTexture(file_path); }
 
+    TextureHandle ResourceManager::getTextureHandle(const std::string& file_path) { return textureManager_->getTextureHandle(file_path); }
+
+    SDL_Texture* ResourceManager::getTexture(TextureHandle handle) const { return textureManager_->getTexture(handle); }
+
     glm::vec2 ResourceManager::getTextureSize(const std::string& file_path) { return textureManager_->getTextureSize(file_path); }
 
     void ResourceManager::unloadTexture(const std::string& file_path) { textureManager_->unloadTexture(file_path); }
 
     void ResourceManager::clearTextures() { textureManager_->clearTextures(); }
 
+    void ResourceManager::beginFrame()
+    {
+        textureManager_->beginFrame();
+
+        // --- 周期性采样缓存统计 ---
+        if (statsSampleIntervalNs_ == 0)
+        {
+            return;
+        }
+        const Uint64 now = SDL_GetTicksNS();
+        if (!statsHistory_.empty() && now - statsHistory_.back().timestampNs < statsSampleIntervalNs_)
+        {
+            return;
+        }
+
+        ResourceStatsSnapshot snapshot = getStats();
+        snapshot.timestampNs = now;
+        if (!statsHistory_.empty())
+        {
+            // 只有在采样区间内发生了加载（冷加载）时才输出日志
+            const auto& previous = statsHistory_.back();
+            const ResourceCacheStats textures = snapshot.textures - previous.textures;
+            const ResourceCacheStats sounds = snapshot.sounds - previous.sounds;
+            const ResourceCacheStats music = snapshot.music - previous.music;
+            const ResourceCacheStats fonts = snapshot.fonts - previous.fonts;
+            const Uint64 misses = textures.misses + sounds.misses + music.misses + fonts.misses;
+            if (misses > 0)
+            {
+                SPDLOG_DEBUG("Resource cache misses in the last {:.1f}s: textures {} ({:.2f} ms), sounds {} ({:.2f} ms), music {} ({:.2f} ms), fonts {} ({:.2f} ms)",
+                             (now - previous.timestampNs) / 1e9, textures.misses, textures.loadTimeNs / 1e6, sounds.misses, sounds.loadTimeNs / 1e6, music.misses,
+                             music.loadTimeNs / 1e6, fonts.misses, fonts.loadTimeNs / 1e6);
+            }
+        }
+
+        statsHistory_.push_back(snapshot);
+        while (statsHistory_.size() > statsHistoryCapacity_)
+        {
+            statsHistory_.pop_front();
+        }
+    }
+
+    void ResourceManager::setCurrentLevel(const std::string& level_name) { textureManager_->setCurrentLevel(level_name); }
+
+    void ResourceManager::addTextureLevel(const std::string& file_path, const std::string& level_name) { textureManager_->addTextureLevel(file_path, level_name); }
+
+    std::vector<std::string> ResourceManager::getCachedTexturePaths() const { return textureManager_->getTexturePaths(); }
+
+    void ResourceManager::setTextureBudget(std::size_t bytes) { textureManager_->setBudget(bytes); }
+
+    const TextureInfo* ResourceManager::getTextureInfo(const std::string& file_path) const { return textureManager_->getTextureInfo(file_path); }
+
+    TextureMemoryReport ResourceManager::getTextureMemoryReport() const { return textureManager_->getMemoryReport(); }
+
+    void ResourceManager::logTextureMemoryReport() const { textureManager_->logMemoryReport(); }
+
     // --- 音频接口实现 ---
     Mix_Chunk* ResourceManager::loadSound(const std::string& file_path) { return audioManager_->loadSound(file_path); }
 
     Mix_Chunk* ResourceManager::getSound(const std::string& file_path) { return audioManager_->getSound(file_path); }
 
+    SoundHandle ResourceManager::getSoundHandle(const std::string& file_path) { return audioManager_->getSoundHandle(file_path); }
+
+    Mix_Chunk* ResourceManager::getSound(SoundHandle handle) const { return audioManager_->getSound(handle); }
+
     void ResourceManager::unloadSound(const std::string& file_path) { audioManager_->unloadSound(file_path); }
 
     void ResourceManager::clearSounds() { audioManager_->clearSounds(); }
@@ -62,17 +132,138 @@ namespace engine::resource
 
     Mix_Music* ResourceManager::getMusic(const std::string& file_path) { return audioManager_->getMusic(file_path); }
 
+    MusicHandle ResourceManager::getMusicHandle(const std::string& file_path) { return audioManager_->getMusicHandle(file_path); }
+
+    Mix_Music* ResourceManager::getMusic(MusicHandle handle) const { return audioManager_->getMusic(handle); }
+
     void ResourceManager::unloadMusic(const std::string& file_path) { audioManager_->unloadMusic(file_path); }
 
     void ResourceManager::clearMusic() { audioManager_->clearMusics(); }
 
+    std::unique_lock<std::mutex> ResourceManager::lockAudio() const { return audioManager_->lock(); }
+
     // --- 字体接口实现 ---
     TTF_Font* ResourceManager::loadFont(const std::string& file_path, int point_size) { return fontManager_->loadFont(file_path, point_size); }
 
     TTF_Font* ResourceManager::getFont(const std::string& file_path, int point_size) { return fontManager_->getFont(file_path, point_size); }
 
+    FontHandle ResourceManager::getFontHandle(const std::string& file_path, int point_size) { return fontManager_->getFontHandle(file_path, point_size); }
+
+    TTF_Font* ResourceManager::getFont(FontHandle handle) const { return fontManager_->getFont(handle); }
+
     void ResourceManager::unloadFont(const std::string& file_path, int point_size) { fontManager_->unloadFont(file_path, point_size); }
 
     void ResourceManager::clearFonts() { fontManager_->clearFonts(); }
 
+    // --- 缓存统计接口实现 ---
+    ResourceStatsSnapshot ResourceManager::getStats() const
+    {
+        ResourceStatsSnapshot snapshot;
+        snapshot.timestampNs = SDL_GetTicksNS();
+        snapshot.textures = textureManager_->getStats();
+        snapshot.sounds = audioManager_->getSoundStats();
+        snapshot.music = audioManager_->getMusicStats();
+        snapshot.fonts = fontManager_->getStats();
+        return snapshot;
+    }
+
+    void ResourceManager::setStatsSampling(Uint64 interval_ns, std::size_t history_capacity)
+    {
+        statsSampleIntervalNs_ = interval_ns;
+        statsHistoryCapacity_ = history_capacity;
+        while (statsHistory_.size() > statsHistoryCapacity_)
+        {
+            statsHistory_.pop_front();
+        }
+    }
+
+    void ResourceManager::logStats() const
+    {
+        const ResourceStatsSnapshot snapshot = getStats();
+        const std::pair<const char*, const ResourceCacheStats*> managers[] = {
+            {"textures", &snapshot.textures},
+            {"sounds", &snapshot.sounds},
+            {"music", &snapshot.music},
+            {"fonts", &snapshot.fonts},
+        };
+
+        for (const auto& [name, stats] : managers)
+        {
+            const Uint64 lookups = stats->hits + stats->misses;
+            spdlog::info("Resource cache {:<8}: {} hits, {} misses ({:.1f}% hit rate), {} loads, {} failed, {:.1f} KiB loaded, {:.2f} ms loading, slowest {:.2f} ms", name,
+                         stats->hits, stats->misses, lookups > 0 ? 100.0 * stats->hits / lookups : 100.0, stats->loads, stats->failedLoads, stats->bytesLoaded / 1024.0,
+                         stats->loadTimeNs / 1e6, stats->maxLoadTimeNs / 1e6);
+
+            std::string histogram;
+            for (std::size_t i = 0; i < stats->loadLatency.size(); ++i)
+            {
+                if (stats->loadLatency[i] == 0) continue;
+                if (i < ResourceCacheStats::LATENCY_BUCKET_BOUNDS_NS.size())
+                {
+                    histogram += fmt::format(" <={:.2f}ms:{}", ResourceCacheStats::LATENCY_BUCKET_BOUNDS_NS[i] / 1e6, stats->loadLatency[i]);
+                }
+                else
+                {
+                    histogram += fmt::format(" >{:.2f}ms:{}", ResourceCacheStats::LATENCY_BUCKET_BOUNDS_NS.back() / 1e6, stats->loadLatency[i]);
+                }
+            }
+            if (!histogram.empty())
+            {
+                spdlog::info("  load latency{}", histogram);
+            }
+        }
+    }
+
+    // --- 热重载接口实现 ---
+    bool ResourceManager::enableHotReload(const std::string& root)
+    {
+        assetWatcher_ = std::make_unique<AssetWatcher>(root);
+        if (!assetWatcher_->isSupported())
+        {
+            assetWatcher_.reset();
+            return false;
+        }
+        return true;
+    }
+
+    void ResourceManager::disableHotReload() { assetWatcher_.reset(); }
+
+    int ResourceManager::processHotReloads()
+    {
+        if (!assetWatcher_)
+        {
+            return 0;
+        }
+
+        changedFiles_.clear();
+        if (!assetWatcher_->poll(changedFiles_))
+        {
+            return 0;
+        }
+
+        int reloaded = 0;
+        for (const auto& file_path : changedFiles_)
+        {
+            if (reloadResource(file_path))
+            {
+                ++reloaded;
+            }
+            else
+            {
+                SPDLOG_TRACE("Changed file '{}' is not cached, nothing to reload.", file_path);
+            }
+        }
+        return reloaded;
+    }
+
+    bool ResourceManager::reloadResource(const std::string& file_path)
+    {
+        // 同一文件可能以多种形式被缓存，因此全部尝试，不短路
+        bool reloaded = textureManager_->reloadTexture(file_path);
+        reloaded = audioManager_->reloadSound(file_path) || reloaded;
+        reloaded = audioManager_->reloadMusic(file_path) || reloaded;
+        reloaded = fontManager_->reloadFont(file_path) || reloaded;
+        return reloaded;
+    }
+
 }  // namespace engine::resource
\ No newline at end of file
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <SDL3/SDL_stdinc.h>
+#include <deque>
 #include <glm/glm.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "ResourceHandle.h"
+#include "ResourceStats.h"
+#include "TextureInfo.h"
 
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Surface;
 struct Mix_Chunk;
 struct Mix_Music;
 struct TTF_Font;
@@ -15,6 +24,7 @@ namespace engine::resource
     class TextureManager;
     class AudioManager;
     class FontManager;
+    class AssetWatcher;
 
     class ResourceManager
     {
@@ -22,6 +32,13 @@ namespace engine::resource
         std::unique_ptr<TextureManager> textureManager_;
         std::unique_ptr<AudioManager> audioManager_;
         std::unique_ptr<FontManager> fontManager_;
+        std::unique_ptr<AssetWatcher> assetWatcher_;  ///< @brief Optional file watcher for hot-reload, null when disabled
+        std::vector<std::string> changedFiles_;       ///< @brief Reused buffer of files reported by the watcher
+
+        // -- Cache statistics sampling --
+        Uint64 statsSampleIntervalNs_ = 1'000'000'000;    ///< @brief Interval between two samples, 0 disables sampling
+        std::size_t statsHistoryCapacity_ = 120;          ///< @brief Number of samples kept in statsHistory_
+        std::deque<ResourceStatsSnapshot> statsHistory_;  ///< @brief Periodic snapshots, oldest first
 
        public:
         /**
@@ -44,27 +61,89 @@ namespace engine::resource
 
         // -- Texture --
         SDL_Texture* loadTexture(const std::string& file_path);  ///< @brief Load texture resource
-        SDL_Texture* getTexture(const std::string& file_path);   ///< @brief Try to get a pointer to a loaded texture, or try to load it if not loaded
-        void unloadTexture(const std::string& file_path);        ///< @brief Unload a specific texture resource
-        glm::vec2 getTextureSize(const std::string& file_path);  ///< @brief Get the size of a specific texture
-        void clearTextures();                                    ///< @brief Clear all texture resources
+
+        /**
+         * @brief Cache a texture from an image decoded off the main thread (IMG_Load is thread safe, texture creation is not)
+         * @param surface decoded image, still owned by the caller
+         * @param level_name level the texture is loaded for, attributed to it instead of the current level
+         * @param decode_time_ns time spent decoding, counted in the load latency
+         * @return the cached texture if file_path is already loaded, nullptr on failure
+         */
+        SDL_Texture* loadTexture(const std::string& file_path, SDL_Surface* surface, const std::string& level_name, Uint64 decode_time_ns = 0);
+
+        SDL_Texture* getTexture(const std::string& file_path);         ///< @brief Try to get a pointer to a loaded texture, or try to load it if not loaded
+        TextureHandle getTextureHandle(const std::string& file_path);  ///< @brief Get a handle that follows the texture across hot-reloads, loading it if needed
+        SDL_Texture* getTexture(TextureHandle handle) const;           ///< @brief Resolve a texture handle, nullptr while the texture is unloaded
+        void unloadTexture(const std::string& file_path);              ///< @brief Unload a specific texture resource
+        glm::vec2 getTextureSize(const std::string& file_path);        ///< @brief Get the size of a specific texture
+        void clearTextures();                                          ///< @brief Clear all texture resources
+
+        // -- Texture memory accounting --
+        void beginFrame();                                                                  ///< @brief Advance the frame counter recorded as TextureInfo::lastUsedFrame and sample the cache statistics when due
+        void setCurrentLevel(const std::string& level_name);                                ///< @brief Attribute textures used from now on to this level in the memory report
+        void addTextureLevel(const std::string& file_path, const std::string& level_name);  ///< @brief Attribute a cached texture to one more level, e.g. one the next level reuses
+        std::vector<std::string> getCachedTexturePaths() const;                             ///< @brief Paths of all cached textures, sorted
+        void setTextureBudget(std::size_t bytes);                                           ///< @brief Warn when cached textures exceed this many bytes, 0 disables the budget
+        const TextureInfo* getTextureInfo(const std::string& file_path) const;              ///< @brief Get the bookkeeping of a cached texture, nullptr if not cached
+        TextureMemoryReport getTextureMemoryReport() const;                                 ///< @brief Texture memory totals per directory and per level
+        void logTextureMemoryReport() const;                                                ///< @brief Dump the texture memory report to the log
         // -- Sound Effects (Chunks) --
-        Mix_Chunk* loadSound(const std::string& file_path);  ///< @brief Load sound effect resource
-        Mix_Chunk* getSound(const std::string& file_path);   ///< @brief Try to get a pointer to a loaded sound effect, or try to load it if not loaded
-        void unloadSound(const std::string& file_path);      ///< @brief Unload a specific sound effect resource
-        void clearSounds();                                  ///< @brief Clear all sound effect resources
+        Mix_Chunk* loadSound(const std::string& file_path);        ///< @brief Load sound effect resource
+        Mix_Chunk* getSound(const std::string& file_path);         ///< @brief Try to get a pointer to a loaded sound effect, or try to load it if not loaded
+        SoundHandle getSoundHandle(const std::string& file_path);  ///< @brief Get a handle that follows the sound effect across hot-reloads, loading it if needed
+        Mix_Chunk* getSound(SoundHandle handle) const;             ///< @brief Resolve a sound effect handle, nullptr while the sound is unloaded
+        void unloadSound(const std::string& file_path);            ///< @brief Unload a specific sound effect resource
+        void clearSounds();                                        ///< @brief Clear all sound effect resources
 
         // -- Music --
-        Mix_Music* loadMusic(const std::string& file_path);  ///< @brief Load music resource
-        Mix_Music* getMusic(const std::string& file_path);   ///< @brief Try to get a pointer to a loaded music, or try to load it if not loaded
-        void unloadMusic(const std::string& file_path);      ///< @brief Unload a specific music resource
-        void clearMusic();                                   ///< @brief Clear all music resources
+        Mix_Music* loadMusic(const std::string& file_path);        ///< @brief Load music resource
+        Mix_Music* getMusic(const std::string& file_path);         ///< @brief Try to get a pointer to a loaded music, or try to load it if not loaded
+        MusicHandle getMusicHandle(const std::string& file_path);  ///< @brief Get a handle that follows the music across hot-reloads, loading it if needed
+        Mix_Music* getMusic(MusicHandle handle) const;             ///< @brief Resolve a music handle, nullptr while the music is unloaded
+        void unloadMusic(const std::string& file_path);            ///< @brief Unload a specific music resource
+        void clearMusic();                                         ///< @brief Clear all music resources
+
+        /**
+         * @brief Lock the sound and music caches. Held by the thread executing audio commands from resolving a handle until
+         * the mixer has started playing it, so the main thread cannot unload or reload the resource in between.
+         */
+        std::unique_lock<std::mutex> lockAudio() const;
 
         // -- Fonts --
-        TTF_Font* loadFont(const std::string& file_path, int point_size);  ///< @brief Load font resource
-        TTF_Font* getFont(const std::string& file_path, int point_size);   ///< @brief Try to get a pointer to a loaded font, or try to load it if not loaded
-        void unloadFont(const std::string& file_path, int point_size);     ///< @brief Unload a specific font resource
-        void clearFonts();                                                 ///< @brief Clear all font resources
+        TTF_Font* loadFont(const std::string& file_path, int point_size);        ///< @brief Load font resource
+        TTF_Font* getFont(const std::string& file_path, int point_size);         ///< @brief Try to get a pointer to a loaded font, or try to load it if not loaded
+        FontHandle getFontHandle(const std::string& file_path, int point_size);  ///< @brief Get a handle that follows the font across hot-reloads, loading it if needed
+        TTF_Font* getFont(FontHandle handle) const;                              ///< @brief Resolve a font handle, nullptr while the font is unloaded
+        void unloadFont(const std::string& file_path, int point_size);           ///< @brief Unload a specific font resource
+        void clearFonts();                                                       ///< @brief Clear all font resources
+
+        // -- Cache statistics --
+        ResourceStatsSnapshot getStats() const;                                                     ///< @brief Current hit/miss/load counters of every manager
+        const std::deque<ResourceStatsSnapshot>& getStatsHistory() const { return statsHistory_; }  ///< @brief Periodic samples taken by beginFrame(), oldest first
+        void setStatsSampling(Uint64 interval_ns, std::size_t history_capacity);                    ///< @brief Configure periodic sampling, interval 0 disables it
+        void logStats() const;                                                                      ///< @brief Log the counters and load latency histograms
+
+        // -- Hot-reload --
+        /**
+         * @brief Start watching an asset directory. Modified files that are cached get reloaded by processHotReloads().
+         * @param root directory to watch recursively, e.g. "assets"
+         * @return false if file watching is not supported on this platform
+         */
+        bool enableHotReload(const std::string& root);
+        void disableHotReload();  ///< @brief Stop watching the asset directory
+
+        /**
+         * @brief Reload the cached resources whose files changed since the last call.
+         * Must be called at a point of the frame where no resource is being used, e.g. before handling events.
+         * @return Number of resources reloaded
+         */
+        int processHotReloads();
+
+        /**
+         * @brief Reload every cached resource loaded from a file (texture, sound, music and all point sizes of a font).
+         * @return true if at least one cache entry was reloaded
+         */
+        bool reloadResource(const std::string& file_path);
     };
 
 }  // namespace engine::resource
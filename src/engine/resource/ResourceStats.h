@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
+
+namespace engine::resource
+{
+    /**
+     * @brief Cache counters of one resource manager. Updated on the main thread only, so plain integers suffice.
+     */
+    struct ResourceCacheStats
+    {
+        static constexpr std::size_t LATENCY_BUCKET_COUNT = 10;
+
+        /// @brief Upper bound (inclusive, nanoseconds) of each load latency bucket; the last bucket collects everything slower
+        static constexpr std::array<Uint64, LATENCY_BUCKET_COUNT - 1> LATENCY_BUCKET_BOUNDS_NS = {
+            100'000, 250'000, 500'000, 1'000'000, 2'000'000, 4'000'000, 8'000'000, 16'000'000, 33'000'000,
+        };
+
+        Uint64 hits = 0;                                         ///< @brief Lookups served from the cache
+        Uint64 misses = 0;                                       ///< @brief Lookups that had to load from disk
+        Uint64 loads = 0;                                        ///< @brief Successful loads
+        Uint64 failedLoads = 0;                                  ///< @brief Loads that failed
+        Uint64 bytesLoaded = 0;                                  ///< @brief Estimated bytes created by successful loads
+        Uint64 loadTimeNs = 0;                                   ///< @brief Total time spent in loads, successful or not
+        Uint64 maxLoadTimeNs = 0;                                ///< @brief Slowest single load
+        std::array<Uint64, LATENCY_BUCKET_COUNT> loadLatency{};  ///< @brief Load latency histogram, see LATENCY_BUCKET_BOUNDS_NS
+
+        void recordHit() { ++hits; }
+        void recordMiss() { ++misses; }
+
+        void recordLoad(Uint64 time_ns, std::size_t bytes)
+        {
+            ++loads;
+            bytesLoaded += bytes;
+            recordLatency(time_ns);
+        }
+
+        void recordFailedLoad(Uint64 time_ns)
+        {
+            ++failedLoads;
+            recordLatency(time_ns);
+        }
+
+        /**
+         * @brief Counter differences between two snapshots, used for periodic sampling
+         */
+        ResourceCacheStats operator-(const ResourceCacheStats& older) const
+        {
+            ResourceCacheStats delta;
+            delta.hits = hits - older.hits;
+            delta.misses = misses - older.misses;
+            delta.loads = loads - older.loads;
+            delta.failedLoads = failedLoads - older.failedLoads;
+            delta.bytesLoaded = bytesLoaded - older.bytesLoaded;
+            delta.loadTimeNs = loadTimeNs - older.loadTimeNs;
+            delta.maxLoadTimeNs = maxLoadTimeNs;
+            for (std::size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i)
+            {
+                delta.loadLatency[i] = loadLatency[i] - older.loadLatency[i];
+            }
+            return delta;
+        }
+
+      private:
+        void recordLatency(Uint64 time_ns)
+        {
+            loadTimeNs += time_ns;
+            if (time_ns > maxLoadTimeNs) maxLoadTimeNs = time_ns;
+
+            std::size_t bucket = 0;
+            while (bucket < LATENCY_BUCKET_BOUNDS_NS.size() && time_ns > LATENCY_BUCKET_BOUNDS_NS[bucket]) ++bucket;
+            ++loadLatency[bucket];
+        }
+    };
+
+    /**
+     * @brief Counters of every resource manager at one point in time
+     */
+    struct ResourceStatsSnapshot
+    {
+        Uint64 timestampNs = 0;       ///< @brief SDL_GetTicksNS() when the snapshot was taken
+        ResourceCacheStats textures;  ///< @brief TextureManager counters
+        ResourceCacheStats sounds;    ///< @brief AudioManager sound (Mix_Chunk) counters
+        ResourceCacheStats music;     ///< @brief AudioManager music (Mix_Music) counters
+        ResourceCacheStats fonts;     ///< @brief FontManager counters
+    };
+}  // namespace engine::resource
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace engine::resource
+{
+    /**
+     * @brief Bookkeeping recorded for every cached texture
+     */
+    struct TextureInfo
+    {
+        int width = 0;             ///< @brief Width in pixels
+        int height = 0;            ///< @brief Height in pixels
+        Uint32 format = 0;         ///< @brief SDL_PixelFormat of the texture
+        std::size_t bytes = 0;     ///< @brief Estimated memory used: width * height * bytes per pixel
+        Uint64 loadTimeNs = 0;     ///< @brief Time spent loading the file and creating the texture
+        Uint64 lastUsedFrame = 0;  ///< @brief Last frame (see ResourceManager::beginFrame) the texture was fetched
+        Uint64 levelMask = 0;      ///< @brief Bit i set if the texture was used while level i was current
+    };
+
+    /**
+     * @brief Aggregated texture memory, one entry per directory or per level
+     */
+    struct TextureMemoryGroup
+    {
+        std::string name;       ///< @brief Directory (Actors, Layers, UI, ...) or level name
+        std::size_t count = 0;  ///< @brief Number of textures
+        std::size_t bytes = 0;  ///< @brief Estimated bytes
+    };
+
+    /**
+     * @brief Snapshot of the texture memory usage, see ResourceManager::getTextureMemoryReport()
+     */
+    struct TextureMemoryReport
+    {
+        std::size_t textureCount = 0;                 ///< @brief Number of cached textures
+        std::size_t totalBytes = 0;                   ///< @brief Estimated bytes of all cached textures
+        std::size_t budgetBytes = 0;                  ///< @brief Configured budget, 0 means no budget
+        std::vector<TextureMemoryGroup> byDirectory;  ///< @brief Totals per texture directory, largest first
+        std::vector<TextureMemoryGroup> byLevel;      ///< @brief Totals per level that used the textures, largest first
+    };
+}  // namespace engine::resource
@@ -1,9 +1,16 @@
 #include "TextureManager.h"
 
+#include <SDL3/SDL_timer.h>
 #include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <map>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
+#include "../core/Log.h"
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+
 namespace engine::resource
 {
     TextureManager::TextureManager(SDL_Renderer* renderer) : renderer_(renderer)
@@ -13,47 +20,73 @@ namespace engine::resource
             throw std::runtime_error("TextureManager build failed: SDL_Renderer pointer is null.");
         }
 
-        spdlog::trace("TextureManager constructed successfully.");
+        SPDLOG_TRACE("TextureManager constructed successfully.");
     }
 
     SDL_Texture* TextureManager::loadTexture(const std::string& file_path)
     {
         // Check if texture is already loaded
         auto it = textures_.find(file_path);
-        if (it != textures_.end())
-        {
-            spdlog::debug("Texture '{}' already loaded, returning cached texture.", file_path);
-            return it->second.get();
-        }
+        if (it != textures_.end()) return useCached(it->second, currentLevelMask_);
 
         // Load the texture using SDL_image
+        ENGINE_PROFILE_SCOPE("TextureManager::loadTexture");
+        ENGINE_ALLOC_SCOPE(Resource);
+        stats_.recordMiss();
+        const Uint64 start = SDL_GetTicksNS();
         SDL_Texture* rawTexture = IMG_LoadTexture(renderer_, file_path.c_str());
 
         if (!rawTexture)
         {
-            spdlog::error("Failed to load texture '{}': {}", file_path, SDL_GetError());
+            stats_.recordFailedLoad(SDL_GetTicksNS() - start);
+            // A missing texture is retried on every draw, keep the log from flooding
+            ENGINE_LOG_ERROR_LIMITED("Failed to load texture '{}': {}", file_path, SDL_GetError());
             return nullptr;
         }
 
-        // Store the texture in the map with automatic memory management
-        textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(rawTexture));
-        spdlog::debug("Texture '{}' loaded and cached successfully.", file_path);
+        cacheTexture(file_path, rawTexture, SDL_GetTicksNS() - start, currentLevelMask_);
+        SPDLOG_TRACE("Texture '{}' loaded and cached successfully.", file_path);
 
         return rawTexture;
     }
 
-    SDL_Texture* TextureManager::getTexture(const std::string& file_path)
+    SDL_Texture* TextureManager::loadTexture(const std::string& file_path, SDL_Surface* surface, const std::string& level_name, Uint64 decode_time_ns)
     {
         auto it = textures_.find(file_path);
-        if (it != textures_.end())
+        if (it != textures_.end()) return useCached(it->second, levelBit(level_name));
+
+        ENGINE_PROFILE_SCOPE("TextureManager::uploadTexture");
+        ENGINE_ALLOC_SCOPE(Resource);
+        stats_.recordMiss();
+        const Uint64 start = SDL_GetTicksNS();
+        SDL_Texture* rawTexture = SDL_CreateTextureFromSurface(renderer_, surface);
+        if (!rawTexture)
         {
-            return it->second.get();
+            stats_.recordFailedLoad(decode_time_ns + SDL_GetTicksNS() - start);
+            spdlog::error("Failed to create texture '{}' from its decoded image: {}", file_path, SDL_GetError());
+            return nullptr;
         }
 
-        spdlog::warn("Texture '{}' not found in cache, attempting to load.", file_path);
+        cacheTexture(file_path, rawTexture, decode_time_ns + SDL_GetTicksNS() - start, levelBit(level_name));
+        SPDLOG_TRACE("Texture '{}' uploaded from a decoded image and cached.", file_path);
+
+        return rawTexture;
+    }
+
+    SDL_Texture* TextureManager::getTexture(const std::string& file_path)
+    {
+        auto it = textures_.find(file_path);
+        if (it != textures_.end()) return useCached(it->second, currentLevelMask_);
+
+        // Cache miss: counted by loadTexture(), no per-miss logging on the draw path
         return loadTexture(file_path);
     }
 
+    TextureHandle TextureManager::getTextureHandle(const std::string& file_path)
+    {
+        return getTexture(file_path) ? slots_.find(file_path) : TextureHandle{};
+    }
+
     glm::vec2 TextureManager::getTextureSize(const std::string& file_path)
     {
         SDL_Texture* texture = getTexture(file_path);
@@ -79,8 +112,10 @@ namespace engine::resource
         auto it = textures_.find(file_path);
         if (it != textures_.end())
         {
-            spdlog::debug("Unloading Texture '{}' from memory.", file_path);
+            SPDLOG_DEBUG("Unloading Texture '{}' from memory.", file_path);
+            removeBytes(it->second.info.bytes);
             textures_.erase(it);
+            slots_.bind(file_path, nullptr);
         }
         else
         {
@@ -92,12 +127,270 @@ namespace engine::resource
     {
         if (!textures_.empty())
         {
-            spdlog::debug("Clearing all {} loaded textures from memory.", textures_.size());
+            SPDLOG_DEBUG("Clearing all {} loaded textures from memory.", textures_.size());
             textures_.clear();
+            slots_.unbindAll();
+            removeBytes(totalBytes_);
         }
         else
         {
-            spdlog::debug("No textures to clear; texture cache is already empty.");
+            SPDLOG_DEBUG("No textures to clear; texture cache is already empty.");
+        }
+    }
+
+    bool TextureManager::reloadTexture(const std::string& file_path)
+    {
+        auto it = textures_.find(file_path);
+        if (it == textures_.end())
+        {
+            return false;
+        }
+
+        const Uint64 start = SDL_GetTicksNS();
+        SDL_Surface* surface = IMG_Load(file_path.c_str());
+        if (!surface)
+        {
+            spdlog::error("Failed to reload texture '{}', keeping the old one: {}", file_path, SDL_GetError());
+            return false;
+        }
+
+        SDL_Texture* texture = it->second.texture.get();
+        if (surface->w == texture->w && surface->h == texture->h)
+        {
+            // Same size: upload in place, every SDL_Texture* handed out so far stays valid
+            SDL_Surface* converted = SDL_ConvertSurface(surface, texture->format);
+            SDL_DestroySurface(surface);
+            if (!converted)
+            {
+                spdlog::error("Failed to convert reloaded texture '{}': {}", file_path, SDL_GetError());
+                return false;
+            }
+
+            const bool updated = SDL_UpdateTexture(texture, nullptr, converted->pixels, converted->pitch);
+            SDL_DestroySurface(converted);
+            if (!updated)
+            {
+                spdlog::error("Failed to update texture '{}' in place: {}", file_path, SDL_GetError());
+                return false;
+            }
+
+            it->second.info.loadTimeNs = SDL_GetTicksNS() - start;
+            spdlog::info("Texture '{}' reloaded in place.", file_path);
+            return true;
+        }
+
+        // Size changed: a new texture is needed, the cache entry and the slot behind the handles are swapped
+        SDL_Texture* rawTexture = SDL_CreateTextureFromSurface(renderer_, surface);
+        SDL_DestroySurface(surface);
+        if (!rawTexture)
+        {
+            spdlog::error("Failed to create reloaded texture '{}': {}", file_path, SDL_GetError());
+            return false;
+        }
+
+        TextureInfo info = makeInfo(rawTexture, SDL_GetTicksNS() - start);
+        info.lastUsedFrame = it->second.info.lastUsedFrame;
+        info.levelMask = it->second.info.levelMask;
+        removeBytes(it->second.info.bytes);
+        addBytes(info.bytes);
+        it->second.texture.reset(rawTexture);
+        it->second.info = info;
+        slots_.bind(file_path, rawTexture);
+        spdlog::info("Texture '{}' changed size and was replaced behind its handle.", file_path);
+        return true;
+    }
+
+    void TextureManager::setCurrentLevel(const std::string& level_name)
+    {
+        currentLevelMask_ = levelBit(level_name);
+    }
+
+    void TextureManager::addTextureLevel(const std::string& file_path, const std::string& level_name)
+    {
+        auto it = textures_.find(file_path);
+        if (it != textures_.end()) it->second.info.levelMask |= levelBit(level_name);
+    }
+
+    std::vector<std::string> TextureManager::getTexturePaths() const
+    {
+        std::vector<std::string> paths;
+        paths.reserve(textures_.size());
+        for (const auto& [path, entry] : textures_)
+        {
+            paths.push_back(path);
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    Uint64 TextureManager::levelBit(const std::string& level_name)
+    {
+        auto it = std::find(levelNames_.begin(), levelNames_.end(), level_name);
+        std::size_t index = static_cast<std::size_t>(it - levelNames_.begin());
+        if (it == levelNames_.end())
+        {
+            if (levelNames_.size() >= 64)
+            {
+                spdlog::warn("Texture accounting tracks at most 64 levels, '{}' is counted with '{}'.", level_name, levelNames_.back());
+                index = 63;
+            }
+            else
+            {
+                levelNames_.push_back(level_name);
+            }
+        }
+        return Uint64{1} << index;
+    }
+
+    void TextureManager::setBudget(std::size_t bytes)
+    {
+        budgetBytes_ = bytes;
+        overBudget_ = false;
+        addBytes(0);  // Re-evaluate against the new budget
+    }
+
+    const TextureInfo* TextureManager::getTextureInfo(const std::string& file_path) const
+    {
+        auto it = textures_.find(file_path);
+        return it != textures_.end() ? &it->second.info : nullptr;
+    }
+
+    TextureMemoryReport TextureManager::getMemoryReport() const
+    {
+        TextureMemoryReport report;
+        report.textureCount = textures_.size();
+        report.totalBytes = totalBytes_;
+        report.budgetBytes = budgetBytes_;
+
+        std::map<std::string, TextureMemoryGroup> directories;
+        std::vector<TextureMemoryGroup> levels(levelNames_.size());
+        for (std::size_t i = 0; i < levelNames_.size(); ++i)
+        {
+            levels[i].name = levelNames_[i];
+        }
+
+        for (const auto& [path, entry] : textures_)
+        {
+            // "assets/textures/UI/buttons/Start1.png" -> "UI": the first directory below "textures/", or the parent directory otherwise
+            std::string directory;
+            const auto textures_pos = path.find("textures/");
+            if (textures_pos != std::string::npos)
+            {
+                const auto begin = textures_pos + 9;
+                const auto end = path.find('/', begin);
+                directory = end == std::string::npos ? "(root)" : path.substr(begin, end - begin);
+            }
+            else
+            {
+                const auto slash = path.find_last_of('/');
+                directory = slash == std::string::npos ? "(root)" : path.substr(0, slash);
+            }
+
+            auto& group = directories[directory];
+            group.name = directory;
+            ++group.count;
+            group.bytes += entry.info.bytes;
+
+            for (std::size_t i = 0; i < levels.size(); ++i)
+            {
+                if (entry.info.levelMask & (Uint64{1} << i))
+                {
+                    ++levels[i].count;
+                    levels[i].bytes += entry.info.bytes;
+                }
+            }
+        }
+
+        for (auto& [name, group] : directories)
+        {
+            report.byDirectory.push_back(std::move(group));
+        }
+        report.byLevel = std::move(levels);
+
+        auto by_bytes = [](const TextureMemoryGroup& a, const TextureMemoryGroup& b) { return a.bytes > b.bytes; };
+        std::sort(report.byDirectory.begin(), report.byDirectory.end(), by_bytes);
+        std::sort(report.byLevel.begin(), report.byLevel.end(), by_bytes);
+        return report;
+    }
+
+    void TextureManager::logMemoryReport() const
+    {
+        const TextureMemoryReport report = getMemoryReport();
+        constexpr double KIB = 1024.0;
+
+        spdlog::info("Texture memory: {} textures, {:.1f} KiB{}", report.textureCount, report.totalBytes / KIB,
+                     report.budgetBytes > 0 ? fmt::format(" (budget {:.1f} KiB)", report.budgetBytes / KIB) : std::string());
+        for (const auto& group : report.byDirectory)
+        {
+            spdlog::info("  dir   {:<12} {:>4} textures {:>10.1f} KiB", group.name, group.count, group.bytes / KIB);
+        }
+        for (const auto& group : report.byLevel)
+        {
+            spdlog::info("  level {:<12} {:>4} textures {:>10.1f} KiB", group.name, group.count, group.bytes / KIB);
+            if (report.budgetBytes > 0 && group.bytes > report.budgetBytes)
+            {
+                spdlog::warn("Level '{}' uses {:.1f} KiB of textures, over the {:.1f} KiB budget.", group.name, group.bytes / KIB, report.budgetBytes / KIB);
+            }
+        }
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+        // Per-texture lines only in builds that keep debug logging, the loop goes with them
+        for (const auto& [path, entry] : textures_)
+        {
+            const auto& info = entry.info;
+            SPDLOG_DEBUG("  {} {}x{} {} {:.1f} KiB, loaded in {:.3f} ms, last used frame {}", path, info.width, info.height,
+                         SDL_GetPixelFormatName(static_cast<SDL_PixelFormat>(info.format)), info.bytes / KIB, info.loadTimeNs / 1'000'000.0, info.lastUsedFrame);
+        }
+#endif
+    }
+
+    TextureInfo TextureManager::makeInfo(SDL_Texture* texture, Uint64 load_time_ns) const
+    {
+        TextureInfo info;
+        info.width = texture->w;
+        info.height = texture->h;
+        info.format = static_cast<Uint32>(texture->format);
+        info.bytes = static_cast<std::size_t>(texture->w) * static_cast<std::size_t>(texture->h) * SDL_BYTESPERPIXEL(texture->format);
+        info.loadTimeNs = load_time_ns;
+        info.lastUsedFrame = currentFrame_;
+        info.levelMask = currentLevelMask_;
+        return info;
+    }
+
+    SDL_Texture* TextureManager::useCached(TextureEntry& entry, Uint64 level_mask)
+    {
+        entry.info.lastUsedFrame = currentFrame_;
+        entry.info.levelMask |= level_mask;
+        stats_.recordHit();
+        return entry.texture.get();
+    }
+
+    void TextureManager::cacheTexture(const std::string& file_path, SDL_Texture* texture, Uint64 load_time_ns, Uint64 level_mask)
+    {
+        // Store the texture in the map with automatic memory management
+        TextureInfo info = makeInfo(texture, load_time_ns);
+        info.levelMask = level_mask;
+        textures_.emplace(file_path, TextureEntry{std::unique_ptr<SDL_Texture, SDLTextureDeleter>(texture), info});
+        slots_.bind(file_path, texture);
+        addBytes(info.bytes);
+        stats_.recordLoad(info.loadTimeNs, info.bytes);
+    }
+
+    void TextureManager::addBytes(std::size_t bytes)
+    {
+        totalBytes_ += bytes;
+        if (budgetBytes_ > 0 && totalBytes_ > budgetBytes_ && !overBudget_)
+        {
+            overBudget_ = true;
+            spdlog::warn("Texture memory over budget: {:.1f} KiB used, budget {:.1f} KiB.", totalBytes_ / 1024.0, budgetBytes_ / 1024.0);
+        }
+    }
+
+    void TextureManager::removeBytes(std::size_t bytes)
+    {
+        totalBytes_ -= std::min(bytes, totalBytes_);
+        if (overBudget_ && totalBytes_ <= budgetBytes_)
+        {
+            overBudget_ = false;
         }
     }
 }  // namespace engine::resource
\ No newline at end of file
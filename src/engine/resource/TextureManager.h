@@ -4,7 +4,13 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "ResourceHandle.h"
+#include "ResourceStats.h"
+#include "TextureInfo.h"
 
 namespace engine::resource
 {
@@ -20,17 +26,34 @@ namespace engine::resource
                 if (texture)
                 {
                     SDL_DestroyTexture(texture);
-                    spdlog::trace("SDL_Texture has been destroyed.");
+                    SPDLOG_TRACE("SDL_Texture has been destroyed.");
                 }
             }
         };
 
+        struct TextureEntry
+        {
+            std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+            TextureInfo info;
+        };
+
         // the map storing textures with automatic memory management
-        std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_;
+        std::unordered_map<std::string, TextureEntry> textures_;
+        ResourceSlots<SDL_Texture> slots_;  ///< @brief Texture behind each TextureHandle
 
         // pointer to the SDL_Renderer, not owned
         SDL_Renderer* renderer_ = nullptr;
 
+        // --- memory accounting ---
+        std::size_t totalBytes_ = 0;           ///< @brief Sum of TextureInfo::bytes of all cached textures
+        std::size_t budgetBytes_ = 0;          ///< @brief Warn when totalBytes_ exceeds this, 0 disables the check
+        bool overBudget_ = false;              ///< @brief Whether the last check was over budget, so the warning fires once per crossing
+        Uint64 currentFrame_ = 0;              ///< @brief Frame counter stamped into TextureInfo::lastUsedFrame
+        Uint64 currentLevelMask_ = 0;          ///< @brief Bit of the current level, OR-ed into TextureInfo::levelMask
+        std::vector<std::string> levelNames_;  ///< @brief Level name for each bit of the level masks
+
+        ResourceCacheStats stats_;  ///< @brief Cache hit/miss/load counters
+
       public:
         explicit TextureManager(SDL_Renderer* renderer);
 
@@ -42,9 +65,58 @@ namespace engine::resource
 
       private:
         SDL_Texture* loadTexture(const std::string& file_path);  ///< @brief Load texture from file
-        SDL_Texture* getTexture(const std::string& file_path);   ///< @brief try to get the pointer of loaded texture from cache, if not found, try to load it
-        glm::vec2 getTextureSize(const std::string& file_path);  ///< @brief Get texture size
-        void unloadTexture(const std::string& file_path);        ///< @brief Unload texture from memory
-        void clearTextures();                                    ///< @brief Clear all loaded textures from memory
+
+        /**
+         * @brief Cache a texture created from an image decoded elsewhere, e.g. on a loader thread
+         * @param surface decoded image, still owned by the caller
+         * @param level_name level the texture is loaded for, tagged instead of the current level
+         * @param decode_time_ns time spent decoding, added to the recorded load time
+         * @return the cached texture if file_path is already loaded (the surface is then unused), nullptr on failure
+         */
+        SDL_Texture* loadTexture(const std::string& file_path, SDL_Surface* surface, const std::string& level_name, Uint64 decode_time_ns);
+
+        SDL_Texture* getTexture(const std::string& file_path);                              ///< @brief try to get the pointer of loaded texture from cache, if not found, try to load it
+        TextureHandle getTextureHandle(const std::string& file_path);                       ///< @brief Like getTexture(), but returns a handle that survives reloads, invalid on failure
+        SDL_Texture* getTexture(TextureHandle handle) const { return slots_.get(handle); }  ///< @brief Resolve a handle, nullptr while its file is unloaded
+        glm::vec2 getTextureSize(const std::string& file_path);                             ///< @brief Get texture size
+        void unloadTexture(const std::string& file_path);                                   ///< @brief Unload texture from memory
+        void clearTextures();                                                               ///< @brief Clear all loaded textures from memory
+
+        /**
+         * @brief Reload a cached texture from disk.
+         *
+         * If the new image has the same size, its pixels are uploaded into the existing SDL_Texture so pointers handed out earlier stay valid.
+         * Otherwise the cache entry is replaced by a new texture: handles resolve to it from now on, raw pointers fetched before dangle.
+         *
+         * @return false if the texture is not cached or the new file could not be loaded (the old texture is kept)
+         */
+        bool reloadTexture(const std::string& file_path);
+
+        // --- memory accounting ---
+        void beginFrame() { ++currentFrame_; }                                              ///< @brief Advance the frame counter used for lastUsedFrame
+        void setCurrentLevel(const std::string& level_name);                                ///< @brief Tag textures used from now on with this level
+        void addTextureLevel(const std::string& file_path, const std::string& level_name);  ///< @brief Tag a cached texture with a level, e.g. one the next level reuses
+        std::vector<std::string> getTexturePaths() const;                                   ///< @brief Paths of all cached textures, sorted
+        void setBudget(std::size_t bytes);                                                  ///< @brief Set the memory budget in bytes, 0 disables it
+        const TextureInfo* getTextureInfo(const std::string& file_path) const;              ///< @brief Get the bookkeeping of a cached texture, nullptr if not cached
+        TextureMemoryReport getMemoryReport() const;                                        ///< @brief Aggregate memory per directory and per level
+        void logMemoryReport() const;                                                       ///< @brief Dump the memory report to the log
+        const ResourceCacheStats& getStats() const { return stats_; }                       ///< @brief Get the cache counters
+
+      private:
+        TextureInfo makeInfo(SDL_Texture* texture, Uint64 load_time_ns) const;  ///< @brief Build the bookkeeping of a freshly created texture
+        Uint64 levelBit(const std::string& level_name);                         ///< @brief Bit of a level in the level masks, assigned on first use
+        void addBytes(std::size_t bytes);                                       ///< @brief Account for new texture memory and check the budget
+        void removeBytes(std::size_t bytes);                                    ///< @brief Account for released texture memory
+
+        /**
+         * @brief Take ownership of a new texture: cache entry, handle slot, memory accounting and load statistics
+         */
+        void cacheTexture(const std::string& file_path, SDL_Texture* texture, Uint64 load_time_ns, Uint64 level_mask);
+
+        /**
+         * @brief Cache hit: count it and record that the texture is still in use, by the levels in level_mask
+         */
+        SDL_Texture* useCached(TextureEntry& entry, Uint64 level_mask);
     };
 }  // namespace engine::resource
@@ -0,0 +1,234 @@
+#include "SaveService.h"
+
+#include <SDL3/SDL_timer.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../core/Profiler.h"
+#include "../memory/AllocationTracker.h"
+#include "../utils/AtomicFile.h"
+#include "../utils/Hash.h"
+
+namespace engine::save
+{
+    namespace
+    {
+        // --- Binary save: BinarySaveHeader, BinarySaveRecord, then the map path (not null-terminated) ---
+        constexpr char BINARY_SAVE_MAGIC[4] = {'S', 'L', 'S', 'V'};
+        constexpr Uint32 BINARY_SAVE_VERSION = 1;
+
+        struct BinarySaveHeader
+        {
+            char magic[4];
+            Uint32 version;
+            Uint64 checksum;  ///< @brief fnv1a64() of everything after the header
+        };
+
+        struct BinarySaveRecord
+        {
+            Sint32 highScore;
+            Sint32 levelScore;
+            Sint32 levelHealth;
+            Sint32 maxHealth;
+            Uint32 mapPathLength;
+            Uint32 reserved;
+        };
+
+        static_assert(sizeof(BinarySaveHeader) == 16 && sizeof(BinarySaveRecord) == 24);
+
+        void serializeBinary(const SaveData& data, std::vector<std::byte>& out)
+        {
+            const BinarySaveRecord record{data.highScore, data.levelScore, data.levelHealth, data.maxHealth, static_cast<Uint32>(data.mapPath.size()), 0};
+            out.resize(sizeof(BinarySaveHeader) + sizeof(BinarySaveRecord) + data.mapPath.size());
+            std::memcpy(out.data() + sizeof(BinarySaveHeader), &record, sizeof(record));
+            std::memcpy(out.data() + sizeof(BinarySaveHeader) + sizeof(record), data.mapPath.data(), data.mapPath.size());
+
+            BinarySaveHeader header{};
+            std::memcpy(header.magic, BINARY_SAVE_MAGIC, sizeof(header.magic));
+            header.version = BINARY_SAVE_VERSION;
+            header.checksum = engine::utils::fnv1a64(out.data() + sizeof(header), out.size() - sizeof(header));
+            std::memcpy(out.data(), &header, sizeof(header));
+        }
+
+        std::optional<SaveData> deserializeBinary(const std::byte* bytes, std::size_t size, const std::string& source)
+        {
+            BinarySaveHeader header{};
+            BinarySaveRecord record{};
+            if (size < sizeof(header) + sizeof(record))
+            {
+                spdlog::error("Save '{}' is truncated ({} bytes).", source, size);
+                return std::nullopt;
+            }
+            std::memcpy(&header, bytes, sizeof(header));
+            std::memcpy(&record, bytes + sizeof(header), sizeof(record));
+            if (header.version != BINARY_SAVE_VERSION)
+            {
+                spdlog::error("Save '{}' has version {}, expected {}.", source, header.version, BINARY_SAVE_VERSION);
+                return std::nullopt;
+            }
+            if (sizeof(header) + sizeof(record) + record.mapPathLength != size ||
+                engine::utils::fnv1a64(bytes + sizeof(header), size - sizeof(header)) != header.checksum)
+            {
+                spdlog::error("Save '{}' is corrupt.", source);
+                return std::nullopt;
+            }
+
+            SaveData data;
+            data.highScore = record.highScore;
+            data.levelScore = record.levelScore;
+            data.levelHealth = record.levelHealth;
+            data.maxHealth = record.maxHealth;
+            data.mapPath.assign(reinterpret_cast<const char*>(bytes + sizeof(header) + sizeof(record)), record.mapPathLength);
+            return data;
+        }
+
+        void serializeJson(const SaveData& data, std::vector<std::byte>& out)
+        {
+            const nlohmann::json json = {
+                {"high_score", data.highScore}, {"level_score", data.levelScore}, {"level_health", data.levelHealth},
+                {"max_health", data.maxHealth}, {"map_path", data.mapPath},
+            };
+            const std::string text = json.dump(4);
+            out.resize(text.size());
+            std::memcpy(out.data(), text.data(), text.size());
+        }
+
+        std::optional<SaveData> deserializeJson(const std::byte* bytes, std::size_t size, const std::string& source)
+        {
+            const char* text = reinterpret_cast<const char*>(bytes);
+            const nlohmann::json json = nlohmann::json::parse(text, text + size, nullptr, false);
+            if (json.is_discarded() || !json.is_object())
+            {
+                spdlog::error("Save '{}' is not valid JSON.", source);
+                return std::nullopt;
+            }
+
+            // Missing keys keep their defaults, so older saves still load
+            SaveData data;
+            try
+            {
+                data.highScore = json.value("high_score", data.highScore);
+                data.levelScore = json.value("level_score", data.levelScore);
+                data.levelHealth = json.value("level_health", data.levelHealth);
+                data.maxHealth = json.value("max_health", data.maxHealth);
+                data.mapPath = json.value("map_path", data.mapPath);
+            }
+            catch (const nlohmann::json::exception& e)
+            {
+                spdlog::error("Save '{}' has a value of the wrong type: {}", source, e.what());
+                return std::nullopt;
+            }
+            return data;
+        }
+    }  // namespace
+
+    SaveService::SaveService(std::string file_path, SaveFormat format) : path_(std::move(file_path)), format_(format)
+    {
+        worker_ = std::thread(&SaveService::workerLoop, this);
+    }
+
+    SaveService::~SaveService()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    void SaveService::save(const SaveData& snapshot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (hasPending_) ++stats_.coalesced;
+            pending_ = snapshot;
+            hasPending_ = true;
+            ++stats_.requested;
+        }
+        wake_.notify_one();
+    }
+
+    void SaveService::flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return !hasPending_ && !writing_; });
+    }
+
+    std::optional<SaveData> SaveService::load() const
+    {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file.is_open())
+        {
+            spdlog::info("No save found at '{}'.", path_);
+            return std::nullopt;
+        }
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return deserialize(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size(), path_);
+    }
+
+    SaveStats SaveService::getStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void SaveService::serialize(const SaveData& data, SaveFormat format, std::vector<std::byte>& out)
+    {
+        if (format == SaveFormat::Binary)
+        {
+            serializeBinary(data, out);
+        }
+        else
+        {
+            serializeJson(data, out);
+        }
+    }
+
+    std::optional<SaveData> SaveService::deserialize(const std::byte* data, std::size_t size, const std::string& source)
+    {
+        if (size >= sizeof(BINARY_SAVE_MAGIC) && std::memcmp(data, BINARY_SAVE_MAGIC, sizeof(BINARY_SAVE_MAGIC)) == 0)
+        {
+            return deserializeBinary(data, size, source);
+        }
+        return deserializeJson(data, size, source);
+    }
+
+    void SaveService::workerLoop()
+    {
+        ENGINE_PROFILE_THREAD("Save");
+        ENGINE_ALLOC_SCOPE(Core);
+        SaveData snapshot;
+        std::vector<std::byte> buffer;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this] { return stopping_ || hasPending_; });
+            if (!hasPending_) return;  // Stopping with nothing left to write
+
+            std::swap(snapshot, pending_);
+            hasPending_ = false;
+            writing_ = true;
+            lock.unlock();
+
+            const Uint64 start = SDL_GetTicksNS();
+            bool ok = false;
+            {
+                ENGINE_PROFILE_SCOPE("SaveService::write");
+                serialize(snapshot, format_, buffer);
+                ok = engine::utils::writeFileAtomically(path_, buffer);
+            }
+            const double elapsed_ms = (SDL_GetTicksNS() - start) / 1'000'000.0;
+
+            lock.lock();
+            writing_ = false;
+            ++(ok ? stats_.written : stats_.failed);
+            stats_.lastWriteMs = elapsed_ms;
+            if (ok) SPDLOG_DEBUG("Saved '{}' in {:.3f} ms ({} bytes).", path_, elapsed_ms, buffer.size());
+            idle_.notify_all();
+        }
+    }
+}  // namespace engine::save
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine::save
+{
+    /**
+     * @brief Everything that is persisted between sessions. Plain data: copying it is the snapshot.
+     */
+    struct SaveData
+    {
+        int highScore = 0;
+        int levelScore = 0;   ///< @brief Score when the current level was entered
+        int levelHealth = 3;  ///< @brief Health when the current level was entered
+        int maxHealth = 3;
+        std::string mapPath;  ///< @brief Level to resume, e.g. "assets/maps/level1.tmj"
+    };
+
+    /**
+     * @brief On-disk encoding of a save
+     */
+    enum class SaveFormat : Uint8
+    {
+        Json,    ///< @brief Human readable, the layout of assets/save.json
+        Binary,  ///< @brief Fixed little-endian layout with a checksum, see SaveService.cpp
+    };
+
+    /**
+     * @brief Snapshot of the save counters
+     */
+    struct SaveStats
+    {
+        Uint64 requested = 0;    ///< @brief Calls to save()
+        Uint64 coalesced = 0;    ///< @brief Snapshots replaced by a newer one before the worker wrote them
+        Uint64 written = 0;      ///< @brief Saves that reached the disk
+        Uint64 failed = 0;       ///< @brief Saves that could not be written
+        double lastWriteMs = 0;  ///< @brief Serialize + write + sync time of the last save, on the worker
+    };
+
+    /**
+     * @brief Writes saves on a worker thread so a slow disk never stalls a frame.
+     *
+     * save() copies the SaveData into a single pending slot and returns; the worker serializes it and replaces the file
+     * through writeFileAtomically(), so a crash mid-save leaves the previous save intact. If several saves are requested
+     * while one is being written, only the newest is written next. The destructor writes whatever is still pending.
+     * load() is synchronous and recognises both formats by their contents.
+     */
+    class SaveService final
+    {
+      private:
+        std::string path_;
+        SaveFormat format_;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;  ///< @brief Signals the worker: a snapshot is pending or the service stops
+        std::condition_variable idle_;  ///< @brief Signals flush(): the worker ran out of work
+        SaveData pending_;              ///< @brief Latest snapshot, reused so its string keeps its capacity
+        bool hasPending_ = false;
+        bool writing_ = false;
+        bool stopping_ = false;
+        SaveStats stats_;
+        std::thread worker_;
+
+      public:
+        /**
+         * @param file_path file the saves go to, e.g. "assets/save.json"
+         * @param format encoding used by save(); load() accepts either
+         */
+        explicit SaveService(std::string file_path, SaveFormat format = SaveFormat::Json);
+        ~SaveService();
+
+        // Delete copy and move constructors and assignment operators
+        SaveService(const SaveService&) = delete;
+        SaveService& operator=(const SaveService&) = delete;
+        SaveService(SaveService&&) = delete;
+        SaveService& operator=(SaveService&&) = delete;
+
+        /**
+         * @brief Queue a snapshot for writing. Copies the data and returns without touching the disk.
+         */
+        void save(const SaveData& snapshot);
+
+        /**
+         * @brief Block until every queued snapshot is on the disk
+         */
+        void flush();
+
+        /**
+         * @brief Read the save file
+         * @return the data, or nullopt if the file is missing or corrupt; errors are logged
+         */
+        std::optional<SaveData> load() const;
+
+        const std::string& getPath() const { return path_; }
+        SaveFormat getFormat() const { return format_; }
+        SaveStats getStats();
+
+        static void serialize(const SaveData& data, SaveFormat format, std::vector<std::byte>& out);
+        static std::optional<SaveData> deserialize(const std::byte* data, std::size_t size, const std::string& source);
+
+      private:
+        void workerLoop();
+    };
+}  // namespace engine::save
@@ -0,0 +1,109 @@
+#include "AtomicFile.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace engine::utils
+{
+#ifdef _WIN32
+    bool writeFileAtomically(const std::string& file_path, std::span<const std::byte> data)
+    {
+        const std::string temp_path = file_path + ".tmp";
+        HANDLE file = CreateFileA(temp_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            spdlog::error("Failed to create '{}': error {}", temp_path, GetLastError());
+            return false;
+        }
+
+        bool ok = true;
+        std::size_t written = 0;
+        while (ok && written < data.size())
+        {
+            DWORD chunk = 0;
+            const DWORD request = static_cast<DWORD>(std::min<std::size_t>(data.size() - written, 1u << 30));
+            ok = WriteFile(file, data.data() + written, request, &chunk, nullptr) && chunk > 0;
+            written += chunk;
+        }
+        ok = ok && FlushFileBuffers(file);
+        CloseHandle(file);
+
+        ok = ok && MoveFileExA(temp_path.c_str(), file_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+        if (!ok)
+        {
+            spdlog::error("Failed to write '{}': error {}", file_path, GetLastError());
+            DeleteFileA(temp_path.c_str());
+        }
+        return ok;
+    }
+#else
+    namespace
+    {
+        bool writeAll(int fd, std::span<const std::byte> data)
+        {
+            std::size_t written = 0;
+            while (written < data.size())
+            {
+                const ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+                if (result < 0)
+                {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                written += static_cast<std::size_t>(result);
+            }
+            return true;
+        }
+
+        void syncDirectory(const std::string& file_path)
+        {
+            std::string directory = std::filesystem::path(file_path).parent_path().string();
+            if (directory.empty()) directory = ".";
+
+            const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0 || ::fsync(fd) != 0)
+            {
+                // The contents are durable already; only the rename may be lost on power failure
+                SPDLOG_DEBUG("Could not sync directory '{}': {}", directory, std::strerror(errno));
+            }
+            if (fd >= 0) ::close(fd);
+        }
+    }  // namespace
+
+    bool writeFileAtomically(const std::string& file_path, std::span<const std::byte> data)
+    {
+        const std::string temp_path = file_path + ".tmp";
+        const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            spdlog::error("Failed to create '{}': {}", temp_path, std::strerror(errno));
+            return false;
+        }
+
+        const bool ok = writeAll(fd, data) && ::fsync(fd) == 0;
+        const int error = errno;
+        if (::close(fd) != 0 || !ok || ::rename(temp_path.c_str(), file_path.c_str()) != 0)
+        {
+            spdlog::error("Failed to write '{}': {}", file_path, std::strerror(ok ? errno : error));
+            ::unlink(temp_path.c_str());
+            return false;
+        }
+
+        syncDirectory(file_path);
+        return true;
+    }
+#endif
+}  // namespace engine::utils
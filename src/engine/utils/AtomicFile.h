@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace engine::utils
+{
+    /**
+     * @brief Replace a file so that a crash or power loss leaves either the old or the new contents, never a mix.
+     *
+     * The data goes to "<file_path>.tmp", is flushed to the disk (fsync / FlushFileBuffers), then renamed over file_path;
+     * on POSIX the directory is synced too so the rename itself survives a power loss. Blocks on disk I/O, call it
+     * from a worker thread when the caller must not stall.
+     * @return true on success; errors are logged and the temporary file is removed
+     */
+    bool writeFileAtomically(const std::string& file_path, std::span<const std::byte> data);
+}  // namespace engine::utils
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+
+namespace engine::utils
+{
+    /**
+     * @brief FNV-1a 64-bit hash, used as the checksum of baked levels and binary saves
+     * @param hash result of a previous call, to hash data given in pieces
+     */
+    constexpr Uint64 fnv1a64(const std::byte* data, std::size_t size, Uint64 hash = 0xcbf29ce484222325ULL)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<Uint64>(data[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+}  // namespace engine::utils
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace engine::utils
+{
+    /**
+     * @brief Bounded lock-free multi-producer / single-consumer ring queue.
+     *
+     * Every slot carries a sequence number, so producers only race on the tail index (one CAS per push)
+     * and the consumer never writes the tail. The capacity is fixed at construction and rounded up to a power of two;
+     * tryPush() fails instead of blocking or allocating when the queue is full.
+     *
+     * @tparam T must be trivially copyable, elements are copied in and out of the slots.
+     */
+    template <typename T>
+    class MPSCQueue final
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "MPSCQueue only stores trivially copyable types");
+
+      private:
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        std::unique_ptr<Slot[]> slots_;  ///< @brief Ring storage, allocated once
+        std::size_t mask_ = 0;           ///< @brief capacity - 1
+
+        alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};  ///< @brief Next position producers write to
+        alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};  ///< @brief Next position the consumer reads from
+
+      public:
+        /**
+         * @brief Construct the queue
+         * @param capacity Minimum number of slots, rounded up to the next power of two. Must be greater than 0.
+         * @throws std::invalid_argument if capacity is 0
+         */
+        explicit MPSCQueue(std::size_t capacity)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("MPSCQueue capacity must be greater than 0.");
+            }
+
+            std::size_t rounded = 1;
+            while (rounded < capacity) rounded <<= 1;
+
+            slots_ = std::make_unique<Slot[]>(rounded);
+            mask_ = rounded - 1;
+            for (std::size_t i = 0; i < rounded; ++i)
+            {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Delete copy and move constructors and assignment operators
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+        MPSCQueue(MPSCQueue&&) = delete;
+        MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+        /**
+         * @brief Push an element, safe to call from any number of threads.
+         * @return false if the queue is full, the element is not stored.
+         */
+        bool tryPush(const T& value)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = slots_[pos & mask_];
+                const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = value;
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;  // The consumer has not released this slot yet: full
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Pop an element. Must only be called from the single consumer thread.
+         * @return false if the queue is empty (or the next element is still being written).
+         */
+        bool tryPop(T& out)
+        {
+            const std::size_t pos = head_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0)
+            {
+                return false;
+            }
+
+            out = slot.value;
+            slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+            head_.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Approximate number of queued elements, may be stale by the time it returns.
+         */
+        std::size_t sizeApprox() const
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            return tail >= head ? tail - head : 0;
+        }
+
+        std::size_t capacity() const { return mask_ + 1; }  ///< @brief Number of slots
+    };
+}  // namespace engine::utils
@@ -0,0 +1,135 @@
+#include "MappedFile.h"
+
+#include <spdlog/spdlog.h>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::utils
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+            mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string& file_path)
+    {
+        close();
+
+        HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            spdlog::error("Failed to open '{}' for mapping: error {}", file_path, GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            spdlog::error("Cannot map '{}': empty file or size unavailable.", file_path);
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            spdlog::error("Failed to map '{}': error {}", file_path, GetLastError());
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        data_ = static_cast<const std::byte*>(view);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        fileHandle_ = file;
+        mappingHandle_ = mapping;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data_) UnmapViewOfFile(data_);
+        if (mappingHandle_) CloseHandle(mappingHandle_);
+        if (fileHandle_) CloseHandle(fileHandle_);
+        data_ = nullptr;
+        size_ = 0;
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+    }
+#else
+    bool MappedFile::open(const std::string& file_path)
+    {
+        close();
+
+        const int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            spdlog::error("Failed to open '{}' for mapping: {}", file_path, std::strerror(errno));
+            return false;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            spdlog::error("Cannot map '{}': empty file or size unavailable.", file_path);
+            ::close(fd);
+            return false;
+        }
+
+        // The descriptor is not needed once the mapping exists
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            spdlog::error("Failed to map '{}': {}", file_path, std::strerror(errno));
+            return false;
+        }
+
+        data_ = static_cast<const std::byte*>(mapping);
+        size_ = static_cast<std::size_t>(st.st_size);
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data_) munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+}  // namespace engine::utils
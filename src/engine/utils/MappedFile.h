@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace engine::utils
+{
+    /**
+     * @brief Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows).
+     *
+     * The mapping is page aligned and stays valid until close() or destruction. Move-only.
+     */
+    class MappedFile final
+    {
+      private:
+        const std::byte* data_ = nullptr;  ///< @brief Start of the mapping
+        std::size_t size_ = 0;             ///< @brief File size in bytes
+#ifdef _WIN32
+        void* fileHandle_ = nullptr;     ///< @brief HANDLE of the file
+        void* mappingHandle_ = nullptr;  ///< @brief HANDLE of the file mapping object
+#endif
+
+      public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Delete copy constructor and assignment operator
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map a file, closing any previous mapping
+         * @param file_path path of the file
+         * @return true on success; errors are logged
+         */
+        bool open(const std::string& file_path);
+
+        /**
+         * @brief Unmap the file. Pointers into the mapping become invalid.
+         */
+        void close();
+
+        const std::byte* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        bool isOpen() const { return data_ != nullptr; }
+    };
+}  // namespace engine::utils
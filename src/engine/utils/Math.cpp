@@ -0,0 +1,353 @@
+#include "Math.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ENGINE_MATH_X86 1
+#include <immintrin.h>
+#else
+#define ENGINE_MATH_X86 0
+#endif
+
+// GCC / Clang only emit SSE2 / AVX2 instructions in functions marked for them; the build keeps its baseline flags
+// and the kernels are picked at run time. MSVC accepts the intrinsics anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define ENGINE_TARGET_SSE2 __attribute__((target("sse2")))
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ENGINE_TARGET_SSE2
+#define ENGINE_TARGET_AVX2
+#endif
+
+namespace engine::utils
+{
+    namespace
+    {
+        /**
+         * @brief The rectangle every batch rect is tested against, as edges
+         */
+        struct Edges
+        {
+            float minX, minY, maxX, maxY;
+        };
+
+        Edges edgesOf(const Rect& rect)
+        {
+            return {rect.position.x, rect.position.y, rect.position.x + rect.size.x, rect.position.y + rect.size.y};
+        }
+
+        Edges edgesOf(const RectBatch& batch, std::size_t index)
+        {
+            return {batch.minX[index], batch.minY[index], batch.maxX[index], batch.maxY[index]};
+        }
+
+        enum class Test
+        {
+            Overlap,    ///< @brief Same rule as overlaps(): touching edges do not overlap
+            Contained,  ///< @brief Entirely inside, edges inclusive
+        };
+
+        template <Test TEST>
+        bool testScalar(const RectBatch& batch, std::size_t i, const Edges& q)
+        {
+            if constexpr (TEST == Test::Overlap)
+            {
+                return batch.minX[i] < q.maxX && q.minX < batch.maxX[i] && batch.minY[i] < q.maxY && q.minY < batch.maxY[i];
+            }
+            else
+            {
+                return batch.minX[i] >= q.minX && batch.maxX[i] <= q.maxX && batch.minY[i] >= q.minY && batch.maxY[i] <= q.maxY;
+            }
+        }
+
+        /**
+         * @brief Test rects [first, first + count) of the batch, count <= 64; bit i of the result is rect first + i
+         */
+        using WordKernel = Uint64 (*)(const RectBatch& batch, std::size_t first, std::size_t count, const Edges& q);
+        using ClampKernel = void (*)(RectBatch& batch, const Edges& bounds);
+
+        struct Kernels
+        {
+            WordKernel overlap;
+            WordKernel contained;
+            ClampKernel clamp;
+        };
+
+        template <Test TEST>
+        Uint64 wordScalar(const RectBatch& batch, std::size_t first, std::size_t count, const Edges& q)
+        {
+            Uint64 bits = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (testScalar<TEST>(batch, first + i, q)) bits |= Uint64{1} << i;
+            }
+            return bits;
+        }
+
+        void clampScalar(RectBatch& batch, const Edges& bounds)
+        {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                // shift rather than min + size: an untouched rect keeps its exact edges
+                const float x = std::max(std::min(batch.minX[i], bounds.maxX - (batch.maxX[i] - batch.minX[i])), bounds.minX);
+                const float y = std::max(std::min(batch.minY[i], bounds.maxY - (batch.maxY[i] - batch.minY[i])), bounds.minY);
+                batch.maxX[i] += x - batch.minX[i];
+                batch.maxY[i] += y - batch.minY[i];
+                batch.minX[i] = x;
+                batch.minY[i] = y;
+            }
+        }
+
+        constexpr Kernels SCALAR_KERNELS{wordScalar<Test::Overlap>, wordScalar<Test::Contained>, clampScalar};
+
+#if ENGINE_MATH_X86
+        template <Test TEST>
+        ENGINE_TARGET_SSE2 Uint64 wordSse2(const RectBatch& batch, std::size_t first, std::size_t count, const Edges& q)
+        {
+            const __m128 q_min_x = _mm_set1_ps(q.minX);
+            const __m128 q_min_y = _mm_set1_ps(q.minY);
+            const __m128 q_max_x = _mm_set1_ps(q.maxX);
+            const __m128 q_max_y = _mm_set1_ps(q.maxY);
+
+            Uint64 bits = 0;
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 min_x = _mm_loadu_ps(batch.minX.data() + first + i);
+                const __m128 min_y = _mm_loadu_ps(batch.minY.data() + first + i);
+                const __m128 max_x = _mm_loadu_ps(batch.maxX.data() + first + i);
+                const __m128 max_y = _mm_loadu_ps(batch.maxY.data() + first + i);
+                __m128 hit;
+                if constexpr (TEST == Test::Overlap)
+                {
+                    hit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(min_x, q_max_x), _mm_cmplt_ps(q_min_x, max_x)), _mm_and_ps(_mm_cmplt_ps(min_y, q_max_y), _mm_cmplt_ps(q_min_y, max_y)));
+                }
+                else
+                {
+                    hit = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(min_x, q_min_x), _mm_cmple_ps(max_x, q_max_x)), _mm_and_ps(_mm_cmpge_ps(min_y, q_min_y), _mm_cmple_ps(max_y, q_max_y)));
+                }
+                bits |= static_cast<Uint64>(_mm_movemask_ps(hit)) << i;
+            }
+            for (; i < count; ++i)
+            {
+                if (testScalar<TEST>(batch, first + i, q)) bits |= Uint64{1} << i;
+            }
+            return bits;
+        }
+
+        ENGINE_TARGET_SSE2 void clampSse2(RectBatch& batch, const Edges& bounds)
+        {
+            const __m128 lo_x = _mm_set1_ps(bounds.minX);
+            const __m128 lo_y = _mm_set1_ps(bounds.minY);
+            const __m128 hi_x = _mm_set1_ps(bounds.maxX);
+            const __m128 hi_y = _mm_set1_ps(bounds.maxY);
+
+            std::size_t i = 0;
+            for (; i + 4 <= batch.size(); i += 4)
+            {
+                const __m128 min_x = _mm_loadu_ps(batch.minX.data() + i);
+                const __m128 min_y = _mm_loadu_ps(batch.minY.data() + i);
+                const __m128 max_x = _mm_loadu_ps(batch.maxX.data() + i);
+                const __m128 max_y = _mm_loadu_ps(batch.maxY.data() + i);
+                const __m128 x = _mm_max_ps(_mm_min_ps(min_x, _mm_sub_ps(hi_x, _mm_sub_ps(max_x, min_x))), lo_x);
+                const __m128 y = _mm_max_ps(_mm_min_ps(min_y, _mm_sub_ps(hi_y, _mm_sub_ps(max_y, min_y))), lo_y);
+                _mm_storeu_ps(batch.maxX.data() + i, _mm_add_ps(max_x, _mm_sub_ps(x, min_x)));
+                _mm_storeu_ps(batch.maxY.data() + i, _mm_add_ps(max_y, _mm_sub_ps(y, min_y)));
+                _mm_storeu_ps(batch.minX.data() + i, x);
+                _mm_storeu_ps(batch.minY.data() + i, y);
+            }
+            for (; i < batch.size(); ++i)
+            {
+                const float x = std::max(std::min(batch.minX[i], bounds.maxX - (batch.maxX[i] - batch.minX[i])), bounds.minX);
+                const float y = std::max(std::min(batch.minY[i], bounds.maxY - (batch.maxY[i] - batch.minY[i])), bounds.minY);
+                batch.maxX[i] += x - batch.minX[i];
+                batch.maxY[i] += y - batch.minY[i];
+                batch.minX[i] = x;
+                batch.minY[i] = y;
+            }
+        }
+
+        template <Test TEST>
+        ENGINE_TARGET_AVX2 Uint64 wordAvx2(const RectBatch& batch, std::size_t first, std::size_t count, const Edges& q)
+        {
+            const __m256 q_min_x = _mm256_set1_ps(q.minX);
+            const __m256 q_min_y = _mm256_set1_ps(q.minY);
+            const __m256 q_max_x = _mm256_set1_ps(q.maxX);
+            const __m256 q_max_y = _mm256_set1_ps(q.maxY);
+
+            Uint64 bits = 0;
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 min_x = _mm256_loadu_ps(batch.minX.data() + first + i);
+                const __m256 min_y = _mm256_loadu_ps(batch.minY.data() + first + i);
+                const __m256 max_x = _mm256_loadu_ps(batch.maxX.data() + first + i);
+                const __m256 max_y = _mm256_loadu_ps(batch.maxY.data() + first + i);
+                __m256 hit;
+                if constexpr (TEST == Test::Overlap)
+                {
+                    hit = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(min_x, q_max_x, _CMP_LT_OQ), _mm256_cmp_ps(q_min_x, max_x, _CMP_LT_OQ)),
+                                        _mm256_and_ps(_mm256_cmp_ps(min_y, q_max_y, _CMP_LT_OQ), _mm256_cmp_ps(q_min_y, max_y, _CMP_LT_OQ)));
+                }
+                else
+                {
+                    hit = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(min_x, q_min_x, _CMP_GE_OQ), _mm256_cmp_ps(max_x, q_max_x, _CMP_LE_OQ)),
+                                        _mm256_and_ps(_mm256_cmp_ps(min_y, q_min_y, _CMP_GE_OQ), _mm256_cmp_ps(max_y, q_max_y, _CMP_LE_OQ)));
+                }
+                bits |= static_cast<Uint64>(_mm256_movemask_ps(hit)) << i;
+            }
+            for (; i < count; ++i)
+            {
+                if (testScalar<TEST>(batch, first + i, q)) bits |= Uint64{1} << i;
+            }
+            return bits;
+        }
+
+        ENGINE_TARGET_AVX2 void clampAvx2(RectBatch& batch, const Edges& bounds)
+        {
+            const __m256 lo_x = _mm256_set1_ps(bounds.minX);
+            const __m256 lo_y = _mm256_set1_ps(bounds.minY);
+            const __m256 hi_x = _mm256_set1_ps(bounds.maxX);
+            const __m256 hi_y = _mm256_set1_ps(bounds.maxY);
+
+            std::size_t i = 0;
+            for (; i + 8 <= batch.size(); i += 8)
+            {
+                const __m256 min_x = _mm256_loadu_ps(batch.minX.data() + i);
+                const __m256 min_y = _mm256_loadu_ps(batch.minY.data() + i);
+                const __m256 max_x = _mm256_loadu_ps(batch.maxX.data() + i);
+                const __m256 max_y = _mm256_loadu_ps(batch.maxY.data() + i);
+                const __m256 x = _mm256_max_ps(_mm256_min_ps(min_x, _mm256_sub_ps(hi_x, _mm256_sub_ps(max_x, min_x))), lo_x);
+                const __m256 y = _mm256_max_ps(_mm256_min_ps(min_y, _mm256_sub_ps(hi_y, _mm256_sub_ps(max_y, min_y))), lo_y);
+                _mm256_storeu_ps(batch.maxX.data() + i, _mm256_add_ps(max_x, _mm256_sub_ps(x, min_x)));
+                _mm256_storeu_ps(batch.maxY.data() + i, _mm256_add_ps(max_y, _mm256_sub_ps(y, min_y)));
+                _mm256_storeu_ps(batch.minX.data() + i, x);
+                _mm256_storeu_ps(batch.minY.data() + i, y);
+            }
+            for (; i < batch.size(); ++i)
+            {
+                const float x = std::max(std::min(batch.minX[i], bounds.maxX - (batch.maxX[i] - batch.minX[i])), bounds.minX);
+                const float y = std::max(std::min(batch.minY[i], bounds.maxY - (batch.maxY[i] - batch.minY[i])), bounds.minY);
+                batch.maxX[i] += x - batch.minX[i];
+                batch.maxY[i] += y - batch.minY[i];
+                batch.minX[i] = x;
+                batch.minY[i] = y;
+            }
+        }
+
+        constexpr Kernels SSE2_KERNELS{wordSse2<Test::Overlap>, wordSse2<Test::Contained>, clampSse2};
+        constexpr Kernels AVX2_KERNELS{wordAvx2<Test::Overlap>, wordAvx2<Test::Contained>, clampAvx2};
+#endif
+
+        SimdLevel& activeLevel()
+        {
+            static SimdLevel level = getSupportedSimdLevel();
+            return level;
+        }
+
+        const Kernels& kernels()
+        {
+#if ENGINE_MATH_X86
+            switch (activeLevel())
+            {
+                case SimdLevel::AVX2:
+                    return AVX2_KERNELS;
+                case SimdLevel::SSE2:
+                    return SSE2_KERNELS;
+                case SimdLevel::Scalar:
+                    break;
+            }
+#endif
+            return SCALAR_KERNELS;
+        }
+
+        void fillMask(WordKernel kernel, const RectBatch& batch, const Edges& q, Uint64* out)
+        {
+            const std::size_t count = batch.size();
+            for (std::size_t first = 0, word = 0; first < count; first += 64, ++word)
+            {
+                out[word] = kernel(batch, first, std::min<std::size_t>(64, count - first), q);
+            }
+        }
+    }  // namespace
+
+    SimdLevel getSupportedSimdLevel()
+    {
+#if ENGINE_MATH_X86
+        static const SimdLevel level = SDL_HasAVX2() ? SimdLevel::AVX2 : SDL_HasSSE2() ? SimdLevel::SSE2 : SimdLevel::Scalar;
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    SimdLevel getSimdLevel()
+    {
+        return activeLevel();
+    }
+
+    void setSimdLevel(SimdLevel level)
+    {
+        activeLevel() = std::min(level, getSupportedSimdLevel());
+    }
+
+    const char* getSimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+            case SimdLevel::AVX2:
+                return "AVX2";
+            case SimdLevel::SSE2:
+                return "SSE2";
+            case SimdLevel::Scalar:
+                break;
+        }
+        return "Scalar";
+    }
+
+    void overlapMask(const RectBatch& batch, const Rect& rect, std::vector<Uint64>& out)
+    {
+        out.resize(maskWordCount(batch.size()));
+        fillMask(kernels().overlap, batch, edgesOf(rect), out.data());
+    }
+
+    void collectOverlaps(const RectBatch& batch, const Rect& rect, std::vector<Uint32>& out)
+    {
+        out.clear();
+        const WordKernel kernel = kernels().overlap;
+        const Edges q = edgesOf(rect);
+        const std::size_t count = batch.size();
+        for (std::size_t first = 0; first < count; first += 64)
+        {
+            for (Uint64 bits = kernel(batch, first, std::min<std::size_t>(64, count - first), q); bits != 0; bits &= bits - 1)
+            {
+                out.push_back(static_cast<Uint32>(first + std::countr_zero(bits)));
+            }
+        }
+    }
+
+    void overlapMatrix(const RectBatch& rects, const RectBatch& batch, std::vector<Uint64>& out)
+    {
+        const std::size_t row_words = maskWordCount(batch.size());
+        out.resize(rects.size() * row_words);
+        const WordKernel kernel = kernels().overlap;
+        for (std::size_t row = 0; row < rects.size(); ++row)
+        {
+            fillMask(kernel, batch, edgesOf(rects, row), out.data() + row * row_words);
+        }
+    }
+
+    void containedMask(const RectBatch& batch, const Rect& bounds, std::vector<Uint64>& out)
+    {
+        out.resize(maskWordCount(batch.size()));
+        fillMask(kernels().contained, batch, edgesOf(bounds), out.data());
+    }
+
+    void clampToBounds(RectBatch& batch, const Rect& bounds)
+    {
+        kernels().clamp(batch, edgesOf(bounds));
+    }
+
+}  // namespace engine::utils
@@ -1,5 +1,8 @@
 #pragma once
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
 #include <glm/glm.hpp>
+#include <vector>
 
 namespace engine::utils
 {
@@ -10,4 +13,137 @@ namespace engine::utils
         glm::vec2 size;
     };
 
-}  // namespace engine::utils
\ No newline at end of file
+    /**
+     * @brief Whether two rectangles overlap. Touching edges do not count as overlap.
+     */
+    inline bool overlaps(const Rect& a, const Rect& b)
+    {
+        return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x && a.position.y < b.position.y + b.size.y &&
+               b.position.y < a.position.y + a.size.y;
+    }
+
+    /**
+     * @brief Whether a point lies inside a rectangle (left / top edges inclusive, right / bottom exclusive)
+     */
+    inline bool contains(const Rect& rect, const glm::vec2& point)
+    {
+        return point.x >= rect.position.x && point.x < rect.position.x + rect.size.x && point.y >= rect.position.y && point.y < rect.position.y + rect.size.y;
+    }
+
+    /**
+     * @brief Many rectangles in structure-of-arrays form, as min / max edges, for the batch kernels below.
+     *
+     * Storing the far edges instead of the size saves the additions every overlap test would repeat. A rectangle read
+     * back with get() can therefore differ from the one passed to push() by float rounding of size.
+     */
+    struct RectBatch
+    {
+        std::vector<float> minX;
+        std::vector<float> minY;
+        std::vector<float> maxX;
+        std::vector<float> maxY;
+
+        std::size_t size() const { return minX.size(); }
+        bool empty() const { return minX.empty(); }
+
+        void reserve(std::size_t count)
+        {
+            minX.reserve(count);
+            minY.reserve(count);
+            maxX.reserve(count);
+            maxY.reserve(count);
+        }
+
+        void clear()
+        {
+            minX.clear();
+            minY.clear();
+            maxX.clear();
+            maxY.clear();
+        }
+
+        void push(const Rect& rect)
+        {
+            minX.push_back(rect.position.x);
+            minY.push_back(rect.position.y);
+            maxX.push_back(rect.position.x + rect.size.x);
+            maxY.push_back(rect.position.y + rect.size.y);
+        }
+
+        void set(std::size_t index, const Rect& rect)
+        {
+            minX[index] = rect.position.x;
+            minY[index] = rect.position.y;
+            maxX[index] = rect.position.x + rect.size.x;
+            maxY[index] = rect.position.y + rect.size.y;
+        }
+
+        Rect get(std::size_t index) const { return Rect{{minX[index], minY[index]}, {maxX[index] - minX[index], maxY[index] - minY[index]}}; }
+    };
+
+    /**
+     * @brief Instruction set used by the RectBatch kernels
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    /**
+     * @brief Best level the CPU supports, detected once
+     */
+    SimdLevel getSupportedSimdLevel();
+
+    /**
+     * @brief Level the kernels currently run with; the supported level unless lowered by setSimdLevel()
+     */
+    SimdLevel getSimdLevel();
+
+    /**
+     * @brief Force a lower level, for benchmarks and for comparing results. Clamped to the supported level; not thread-safe.
+     */
+    void setSimdLevel(SimdLevel level);
+
+    const char* getSimdLevelName(SimdLevel level);
+
+    /**
+     * @brief Words of a bit mask covering `count` rectangles, 64 per word
+     */
+    constexpr std::size_t maskWordCount(std::size_t count)
+    {
+        return (count + 63) / 64;
+    }
+
+    /**
+     * @brief Many-against-one: bit i of the mask is set when batch rect i overlaps `rect` (same rule as overlaps())
+     * @param out resized to maskWordCount(batch.size()), then filled; bits past the last rect are 0
+     */
+    void overlapMask(const RectBatch& batch, const Rect& rect, std::vector<Uint64>& out);
+
+    /**
+     * @brief Many-against-one, as indices: the batch rects overlapping `rect`, in ascending order
+     * @param out cleared, then filled
+     */
+    void collectOverlaps(const RectBatch& batch, const Rect& rect, std::vector<Uint32>& out);
+
+    /**
+     * @brief Many-against-many: row i holds the overlap mask of rects[i] against `batch`
+     * @param out resized to rects.size() * maskWordCount(batch.size()) words, then filled row after row
+     */
+    void overlapMatrix(const RectBatch& rects, const RectBatch& batch, std::vector<Uint64>& out);
+
+    /**
+     * @brief Bit i is set when batch rect i lies entirely inside `bounds` (touching the edges counts as inside)
+     * @param out resized to maskWordCount(batch.size()), then filled
+     */
+    void containedMask(const RectBatch& batch, const Rect& bounds, std::vector<Uint64>& out);
+
+    /**
+     * @brief Move every rect the least distance that puts it inside `bounds`, keeping its size.
+     * A rect larger than the bounds is aligned to their left / top edge.
+     */
+    void clampToBounds(RectBatch& batch, const Rect& bounds);
+
+}  // namespace engine::utils
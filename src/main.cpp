@@ -1,14 +1,30 @@
 #include <spdlog/spdlog.h>
 
 #include "engine/core/GameApp.h"
+#include "engine/core/Log.h"
 
 using namespace engine::core;
 
 int main(int argc, char* argv[])
 {
+    initLogging();
     // spdlog::set_level(spdlog::level::trace);
 
-    GameApp app;
-    app.run();
+    // --stress [--sprites MIN:MAX] [--frames N] [--out FILE]: sprite stress sweep, frame time curve written as CSV
+    bool args_ok = true;
+    const auto stress_config = StressTestConfig::fromArgs(argc, argv, args_ok);
+    if (!args_ok)
+    {
+        shutdownLogging();
+        return 1;
+    }
+
+    {
+        GameApp app;
+        if (stress_config) app.setStressTest(*stress_config);
+        app.run();
+    }
+
+    shutdownLogging();
     return 0;
 }
\ No newline at end of file
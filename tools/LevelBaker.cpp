@@ -0,0 +1,264 @@
+/**
+ * @file LevelBaker.cpp
+ * @brief Compiles Tiled maps (.tmj + referenced .tsj) into baked levels (.slvl).
+ *
+ * Usage: SunnyLand-LevelBaker <map.tmj> [output.slvl]
+ *        SunnyLand-LevelBaker --compare <map.tmj>...
+ *
+ * Run from the project root so the asset paths stored in the baked file ("assets/...") match the game's working directory.
+ * The default output path is the map path with the .slvl extension. The baked file is mapped back and checked against the source.
+ *
+ * --compare loads each map with the DOM loader and the streaming (SAX) loader and reports time, heap allocations and peak heap use.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <spdlog/spdlog.h>
+#include <string>
+
+#include "engine/level/BakedLevel.h"
+#include "engine/level/BakedLevelWriter.h"
+#include "engine/level/TiledJson.h"
+#include "engine/level/TiledMapStream.h"
+
+using namespace engine::level;
+
+// --- Heap accounting for --compare: every allocation carries its size in a 16-byte prefix ---
+namespace
+{
+    std::atomic<std::size_t> heap_current{0};
+    std::atomic<std::size_t> heap_peak{0};
+    std::atomic<std::size_t> heap_allocations{0};
+
+    constexpr std::size_t HEAP_PREFIX = 16;
+
+    void* countedAlloc(std::size_t size)
+    {
+        auto* block = static_cast<unsigned char*>(std::malloc(size + HEAP_PREFIX));
+        if (!block) return nullptr;
+
+        *reinterpret_cast<std::size_t*>(block) = size;
+        const std::size_t current = heap_current.fetch_add(size, std::memory_order_relaxed) + size;
+        std::size_t peak = heap_peak.load(std::memory_order_relaxed);
+        while (current > peak && !heap_peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+        heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        return block + HEAP_PREFIX;
+    }
+
+    void countedFree(void* pointer)
+    {
+        if (!pointer) return;
+        auto* block = static_cast<unsigned char*>(pointer) - HEAP_PREFIX;
+        heap_current.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    if (void* pointer = countedAlloc(size)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+void operator delete(void* pointer) noexcept
+{
+    countedFree(pointer);
+}
+void operator delete[](void* pointer) noexcept
+{
+    countedFree(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+
+namespace
+{
+    /**
+     * @brief Time and heap use of one loader over several runs
+     */
+    struct LoaderMeasurement
+    {
+        double averageMs = 0.0;
+        std::size_t allocations = 0;  ///< @brief Heap allocations per load
+        std::size_t peakBytes = 0;    ///< @brief Peak heap growth during one load
+        std::size_t resultBytes = 0;  ///< @brief Heap still held by the returned LevelData
+    };
+
+    template <typename Loader>
+    LoaderMeasurement measureLoader(Loader loader, const std::string& map_path, int runs)
+    {
+        LoaderMeasurement measurement;
+        double total_ms = 0.0;
+        for (int run = 0; run < runs; ++run)
+        {
+            const std::size_t baseline = heap_current.load();
+            heap_peak.store(baseline);
+            const std::size_t allocations_before = heap_allocations.load();
+
+            const auto start = std::chrono::steady_clock::now();
+            auto level = loader(map_path);
+            total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            measurement.allocations = heap_allocations.load() - allocations_before;
+            measurement.peakBytes = heap_peak.load() - baseline;
+            measurement.resultBytes = heap_current.load() - baseline;
+        }
+        measurement.averageMs = total_ms / runs;
+        return measurement;
+    }
+
+    bool sameLevel(const LevelData& a, const LevelData& b)
+    {
+        if (a.width != b.width || a.height != b.height || a.layers.size() != b.layers.size() || a.tilesets.size() != b.tilesets.size()) return false;
+        for (std::size_t i = 0; i < a.layers.size(); ++i)
+        {
+            const Layer& la = a.layers[i];
+            const Layer& lb = b.layers[i];
+            if (la.type != lb.type || la.name != lb.name || la.tiles != lb.tiles || la.image != lb.image || la.objects.size() != lb.objects.size()) return false;
+            if (la.chunks.size() != lb.chunks.size()) return false;
+            for (std::size_t c = 0; c < la.chunks.size(); ++c)
+            {
+                if (la.chunks[c].x != lb.chunks[c].x || la.chunks[c].y != lb.chunks[c].y || la.chunks[c].tiles != lb.chunks[c].tiles) return false;
+            }
+            for (std::size_t o = 0; o < la.objects.size(); ++o)
+            {
+                if (la.objects[o].gid != lb.objects[o].gid || la.objects[o].position != lb.objects[o].position ||
+                    la.objects[o].properties.size() != lb.objects[o].properties.size())
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    int compareLoaders(int argc, char* argv[])
+    {
+        constexpr int RUNS = 50;
+        bool ok = true;
+        for (int i = 2; i < argc; ++i)
+        {
+            const std::string map_path = argv[i];
+            const auto dom = loadTiledMapJson(map_path);
+            const auto streamed = loadTiledMapStreaming(map_path);
+            if (!dom || !streamed || !sameLevel(*dom, *streamed))
+            {
+                spdlog::error("'{}': the DOM and streaming loaders disagree.", map_path);
+                ok = false;
+                continue;
+            }
+
+            const auto dom_result = measureLoader(loadTiledMapJson, map_path, RUNS);
+            const auto sax_result = measureLoader(loadTiledMapStreaming, map_path, RUNS);
+            spdlog::info("{} ({} runs, tilesets included)", map_path, RUNS);
+            spdlog::info("  {:<9} {:>9} {:>12} {:>14} {:>14}", "loader", "ms", "allocations", "peak KiB", "result KiB");
+            for (const auto& [name, result] : {std::pair{"DOM", dom_result}, std::pair{"streaming", sax_result}})
+            {
+                spdlog::info("  {:<9} {:>9.3f} {:>12} {:>14.1f} {:>14.1f}", name, result.averageMs, result.allocations, result.peakBytes / 1024.0,
+                             result.resultBytes / 1024.0);
+            }
+        }
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    bool verifyBakedLevel(const LevelData& level, const BakedLevel& baked)
+    {
+        if (baked.getWidth() != static_cast<Uint32>(level.width) || baked.getHeight() != static_cast<Uint32>(level.height) ||
+            baked.getLayers().size() != level.layers.size() || baked.getTilesets().size() != level.tilesets.size())
+        {
+            spdlog::error("Baked level '{}' does not match its source: map header differs.", baked.getPath());
+            return false;
+        }
+
+        for (std::size_t i = 0; i < level.layers.size(); ++i)
+        {
+            const Layer& layer = level.layers[i];
+            const BakedLayer& baked_layer = baked.getLayers()[i];
+            if (baked.getString(baked_layer.name) != layer.name || baked.getObjects(baked_layer).size() != layer.objects.size())
+            {
+                spdlog::error("Baked level '{}' does not match its source: layer '{}' differs.", baked.getPath(), layer.name);
+                return false;
+            }
+
+            const auto cells = baked.getCells(baked_layer);
+            for (std::size_t cell = 0; cell < cells.size(); ++cell)
+            {
+                if (unpackBakedGid(cells[cell]) != layer.tiles[cell])
+                {
+                    spdlog::error("Baked level '{}' does not match its source: layer '{}' cell {} differs.", baked.getPath(), layer.name, cell);
+                    return false;
+                }
+            }
+
+            const auto chunks = baked.getChunks(baked_layer);
+            if (chunks.size() != layer.chunks.size())
+            {
+                spdlog::error("Baked level '{}' does not match its source: layer '{}' has {} chunks, expected {}.", baked.getPath(), layer.name, chunks.size(),
+                              layer.chunks.size());
+                return false;
+            }
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+            {
+                const auto chunk_cells = baked.getCells(chunks[c]);
+                for (std::size_t cell = 0; cell < chunk_cells.size(); ++cell)
+                {
+                    if (unpackBakedGid(chunk_cells[cell]) != layer.chunks[c].tiles[cell])
+                    {
+                        spdlog::error("Baked level '{}' does not match its source: layer '{}' chunk {} differs.", baked.getPath(), layer.name, c);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && std::string(argv[1]) == "--compare")
+    {
+        return compareLoaders(argc, argv);
+    }
+    if (argc < 2 || argc > 3)
+    {
+        spdlog::error("Usage: {0} <map.tmj> [output.slvl] | {0} --compare <map.tmj>...", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string map_path = argv[1];
+    const std::string output_path = argc == 3 ? argv[2] : BakedLevel::bakedPathFor(map_path);
+
+    const auto level = loadTiledMapStreaming(map_path);
+    if (!level || !writeBakedLevel(*level, output_path))
+    {
+        return EXIT_FAILURE;
+    }
+
+    const auto baked = BakedLevel::open(output_path);
+    if (!baked || !verifyBakedLevel(*level, *baked))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}